@@ -3,6 +3,7 @@
 #type vertex
 #version 330 core
 
+//a_Vertices is a corner of the unit quad, the other attributes are per circle
 layout(location = 0) in vec2 a_Vertices;
 layout(location = 1) in vec2 a_Position;
 layout(location = 2) in float a_Radius;
@@ -27,7 +28,8 @@ void main()
 	v_OutlineSize = a_OutlineSize;
 	v_Radius = a_Radius;
 
-	gl_Position = u_ViewProjection * vec4(a_Vertices, 0.0, 1.0);
+	vec2 vertex = a_Position + a_Vertices * (a_Radius + a_OutlineSize);
+	gl_Position = u_ViewProjection * vec4(vertex, 0.0, 1.0);
 }
 
 #type fragment
@@ -0,0 +1,75 @@
+// Polyline Segment Shader, builds the same mitered quads as LineRenderer.glsl without a geometry shader
+
+#type vertex
+#version 330 core
+
+//a_Corner is a corner of the shared segment quad, x is 0 at the start and 1 at the end, y is the side of the line.
+//The other attributes are per segment, the previous and next points are only used for the miter directions
+layout(location = 0) in vec2 a_Corner;
+layout(location = 1) in vec2 a_Previous;
+layout(location = 2) in vec2 a_Start;
+layout(location = 3) in vec2 a_End;
+layout(location = 4) in vec2 a_Next;
+layout(location = 5) in vec4 a_Color;
+layout(location = 6) in float a_LineWidth;
+
+uniform mat4 u_ViewProjection;
+uniform vec2 u_Viewport;
+
+out vec4 f_Color;
+
+vec2 toScreenSpace( vec2 vertex )
+{
+	vec4 position = u_ViewProjection * vec4( vertex, 0.0, 1.0 );
+	return vec2( position.xy / position.w ) * u_Viewport;
+}
+
+void main()
+{
+	f_Color = a_Color;
+
+	vec2 p0 = toScreenSpace( a_Previous );	// start of previous segment
+	vec2 p1 = toScreenSpace( a_Start );		// end of previous segment, start of current segment
+	vec2 p2 = toScreenSpace( a_End );		// end of current segment, start of next segment
+	vec2 p3 = toScreenSpace( a_Next );		// end of next segment
+
+	//Perform culling, all four corners end up on the same point outside of the clip volume
+	vec2 area = u_Viewport * 1.2;
+	if( any( greaterThan( abs( p1 ), area ) ) || any( greaterThan( abs( p2 ), area ) ) )
+	{
+		gl_Position = vec4( 2.0, 2.0, 2.0, 1.0 );
+		return;
+	}
+
+	//Determine the direction of each of the 3 segments (previous, current, next)
+	vec2 v0 = normalize( p1 - p0 );
+	vec2 v1 = normalize( p2 - p1 );
+	vec2 v2 = normalize( p3 - p2 );
+
+	//Determine the normal of each of the 3 segments (previous, current, next)
+	vec2 n0 = vec2( -v0.y, v0.x );
+	vec2 n1 = vec2( -v1.y, v1.x );
+	vec2 n2 = vec2( -v2.y, v2.x );
+
+	//Only the miter at this corner's end of the segment is needed
+	vec2 point = a_Corner.x < 0.5 ? p1 : p2;
+	vec2 miter = a_Corner.x < 0.5 ? normalize( n0 + n1 ) : normalize( n1 + n2 );
+
+	//Determine the length of the miter by projecting it onto normal and then inverse it
+	float miterLength = a_LineWidth / dot( miter, n1 );
+
+	gl_Position = vec4( ( point + a_Corner.y * miterLength * miter ) / u_Viewport, 0.0, 1.0 );
+}
+
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 f_Color;
+
+void main()
+{
+    color = f_Color;
+}
@@ -0,0 +1,29 @@
+// Polyline Quad Shader, the mitered quads are built by LineExpander on the CPU
+
+#type vertex
+#version 330 core
+
+//The positions are already in normalized device coordinates
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec4 a_Color;
+
+out vec4 f_Color;
+
+void main()
+{
+	f_Color = a_Color;
+	gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 f_Color;
+
+void main()
+{
+    color = f_Color;
+}
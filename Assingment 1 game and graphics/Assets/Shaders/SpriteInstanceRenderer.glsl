@@ -0,0 +1,104 @@
+// Instanced Texture Shader
+
+#type vertex
+#version 330 core
+
+//a_Corner is a corner of the unit quad, the other attributes are per quad
+layout(location = 0) in vec2 a_Corner;
+layout(location = 1) in vec2 a_Origin;
+layout(location = 2) in vec2 a_AxisX;
+layout(location = 3) in vec2 a_AxisY;
+layout(location = 4) in vec2 a_TextureUVOrigin;
+layout(location = 5) in vec2 a_TextureUVSize;
+layout(location = 6) in vec4 a_Color;
+layout(location = 7) in float a_TexureIndex;
+layout(location = 8) in float a_TextureLayer;
+layout(location = 9) in float a_TilingFactor;
+layout(location = 10) in float a_DistanceField;
+
+uniform mat4 u_ViewProjection;
+
+out vec4 v_Color;
+out vec2 v_TextureUV;
+out float v_TextureIndex;
+out float v_TextureLayer;
+out float v_TilingFactor;
+out float v_DistanceField;
+
+void main()
+{
+	v_Color = a_Color;
+	v_TextureUV = a_TextureUVOrigin + a_Corner * a_TextureUVSize;
+	v_TextureIndex = a_TexureIndex;
+	v_TextureLayer = a_TextureLayer;
+	v_TilingFactor = a_TilingFactor;
+	v_DistanceField = a_DistanceField;
+
+	vec2 vertex = a_Origin + a_AxisX * a_Corner.x + a_AxisY * a_Corner.y;
+	gl_Position = u_ViewProjection * vec4(vertex, 0.0, 1.0);
+}
+
+#type fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TextureUV;
+in float v_TextureIndex;
+in float v_TextureLayer;
+in float v_TilingFactor;
+in float v_DistanceField;
+
+//Units 0-23 hold textures and units 24-31 hold texture arrays, v_TextureLayer picks the array's layer. A texture
+//in an array only covers part of its layer, so it can't be tiled
+uniform sampler2D u_Textures[24];
+uniform sampler2DArray u_TextureArrays[8];
+
+void main()
+{
+	vec4 texColor = vec4(1.0);
+	switch(int(v_TextureIndex))
+	{
+		case 0: texColor = texture(u_Textures[0], v_TextureUV * v_TilingFactor); break;
+		case 1: texColor = texture(u_Textures[1], v_TextureUV * v_TilingFactor); break;
+		case 2: texColor = texture(u_Textures[2], v_TextureUV * v_TilingFactor); break;
+		case 3: texColor = texture(u_Textures[3], v_TextureUV * v_TilingFactor); break;
+		case 4: texColor = texture(u_Textures[4], v_TextureUV * v_TilingFactor); break;
+		case 5: texColor = texture(u_Textures[5], v_TextureUV * v_TilingFactor); break;
+		case 6: texColor = texture(u_Textures[6], v_TextureUV * v_TilingFactor); break;
+		case 7: texColor = texture(u_Textures[7], v_TextureUV * v_TilingFactor); break;
+		case 8: texColor = texture(u_Textures[8], v_TextureUV * v_TilingFactor); break;
+		case 9: texColor = texture(u_Textures[9], v_TextureUV * v_TilingFactor); break;
+		case 10: texColor = texture(u_Textures[10], v_TextureUV * v_TilingFactor); break;
+		case 11: texColor = texture(u_Textures[11], v_TextureUV * v_TilingFactor); break;
+		case 12: texColor = texture(u_Textures[12], v_TextureUV * v_TilingFactor); break;
+		case 13: texColor = texture(u_Textures[13], v_TextureUV * v_TilingFactor); break;
+		case 14: texColor = texture(u_Textures[14], v_TextureUV * v_TilingFactor); break;
+		case 15: texColor = texture(u_Textures[15], v_TextureUV * v_TilingFactor); break;
+		case 16: texColor = texture(u_Textures[16], v_TextureUV * v_TilingFactor); break;
+		case 17: texColor = texture(u_Textures[17], v_TextureUV * v_TilingFactor); break;
+		case 18: texColor = texture(u_Textures[18], v_TextureUV * v_TilingFactor); break;
+		case 19: texColor = texture(u_Textures[19], v_TextureUV * v_TilingFactor); break;
+		case 20: texColor = texture(u_Textures[20], v_TextureUV * v_TilingFactor); break;
+		case 21: texColor = texture(u_Textures[21], v_TextureUV * v_TilingFactor); break;
+		case 22: texColor = texture(u_Textures[22], v_TextureUV * v_TilingFactor); break;
+		case 23: texColor = texture(u_Textures[23], v_TextureUV * v_TilingFactor); break;
+		case 24: texColor = texture(u_TextureArrays[0], vec3(v_TextureUV, v_TextureLayer)); break;
+		case 25: texColor = texture(u_TextureArrays[1], vec3(v_TextureUV, v_TextureLayer)); break;
+		case 26: texColor = texture(u_TextureArrays[2], vec3(v_TextureUV, v_TextureLayer)); break;
+		case 27: texColor = texture(u_TextureArrays[3], vec3(v_TextureUV, v_TextureLayer)); break;
+		case 28: texColor = texture(u_TextureArrays[4], vec3(v_TextureUV, v_TextureLayer)); break;
+		case 29: texColor = texture(u_TextureArrays[5], vec3(v_TextureUV, v_TextureLayer)); break;
+		case 30: texColor = texture(u_TextureArrays[6], vec3(v_TextureUV, v_TextureLayer)); break;
+		case 31: texColor = texture(u_TextureArrays[7], vec3(v_TextureUV, v_TextureLayer)); break;
+	}
+
+	//Distance field fonts store the distance to the glyph's edge in alpha, 0.5 is on the edge. The edge is
+	//smoothed over about a pixel on screen, whatever size the text is drawn at
+	float edgeWidth = fwidth(texColor.a) * 0.5;
+	float coverage = smoothstep(0.5 - edgeWidth, 0.5 + edgeWidth, texColor.a);
+	texColor = mix(texColor, vec4(1.0, 1.0, 1.0, coverage), v_DistanceField);
+
+	color = v_Color * texColor;
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <GameDev2D.h>
+#include "Memory/AllocationCounter.h"
+#include "../Source/Game.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+namespace
+{
+	using namespace GameDev2D;
+
+	struct Options
+	{
+		Options() : ticks(10000), asteroids(NUM_OF_ASTEROIDS), width(1280), height(720), fireEvery(10), tickRate(60), render(false), parallelRecording(false) {}
+
+		unsigned int ticks;
+		unsigned int asteroids;
+		unsigned int width;
+		unsigned int height;
+		unsigned int fireEvery;
+		unsigned int tickRate;
+		bool render;
+		bool parallelRecording;
+	};
+
+	void PrintUsage()
+	{
+		printf("Usage: GameBenchmark [--ticks N] [--asteroids N] [--width N] [--height N] [--fire-every N] [--tick-rate N] [--render] [--parallel-recording]\n");
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* argument = argv[i];
+			const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+			if (strcmp(argument, "--render") == 0)
+			{
+				options.render = true;
+				continue;
+			}
+			if (strcmp(argument, "--parallel-recording") == 0)
+			{
+				options.parallelRecording = true;
+				continue;
+			}
+
+			unsigned int* target = nullptr;
+			if (strcmp(argument, "--ticks") == 0) target = &options.ticks;
+			else if (strcmp(argument, "--asteroids") == 0) target = &options.asteroids;
+			else if (strcmp(argument, "--width") == 0) target = &options.width;
+			else if (strcmp(argument, "--height") == 0) target = &options.height;
+			else if (strcmp(argument, "--fire-every") == 0) target = &options.fireEvery;
+			else if (strcmp(argument, "--tick-rate") == 0) target = &options.tickRate;
+
+			if (target == nullptr || value == nullptr)
+			{
+				return false;
+			}
+
+			*target = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+			i++;
+		}
+
+		return options.tickRate > 0 && options.width > 0 && options.height > 0;
+	}
+
+	//Scripted input: the ship turns left then right in 1.5 second sweeps, thrusts for every third sweep
+	//and fires every fireEvery ticks, so the lasers keep sweeping through the asteroid field
+	void ApplyInput(Game& game, const Options& options, unsigned int tick)
+	{
+		unsigned int sweep = tick / 90;
+		SetKeyDown(KeyCode::A, sweep % 2 == 0);
+		SetKeyDown(KeyCode::D, sweep % 2 == 1);
+		SetKeyDown(KeyCode::W, sweep % 3 == 0);
+
+		if (options.fireEvery > 0 && tick % options.fireEvery == 0)
+		{
+			game.OnKeyEvent(KeyCode::Space, KeyState::Down);
+			game.OnKeyEvent(KeyCode::Space, KeyState::Up);
+		}
+	}
+
+	void PrintPhase(const char* name, double seconds, unsigned int ticks)
+	{
+		printf("  %-10s %10.3f ms %10.3f us/tick\n", name, seconds * 1000.0, ticks > 0 ? seconds * 1000000.0 / ticks : 0.0);
+	}
+}
+
+
+//Runs the game simulation without a window or GPU and reports how long each phase of the update takes
+int main(int argc, char** argv)
+{
+	Options options;
+	if (ParseOptions(argc, argv, options) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	SetScreenSize(options.width, options.height);
+
+	AllocationCounter::Snapshot setupStart = AllocationCounter::Get();
+	double constructStart = GameLoop::Now();
+	Game* game = new Game(options.asteroids);
+	double constructTime = GameLoop::Now() - constructStart;
+	AllocationCounter::Snapshot setupEnd = AllocationCounter::Get();
+
+	BatchRenderer batchRenderer;
+	batchRenderer.EnableParallelRecording(options.parallelRecording);
+	const float delta = 1.0f / static_cast<float>(options.tickRate);
+	double renderTime = 0.0;
+
+	AllocationCounter::Snapshot runStart = AllocationCounter::Get();
+	double start = GameLoop::Now();
+
+	for (unsigned int tick = 0; tick < options.ticks; tick++)
+	{
+		ApplyInput(*game, options, tick);
+		game->OnUpdate(delta);
+
+		if (options.render)
+		{
+			double renderStart = GameLoop::Now();
+			game->OnRender(batchRenderer, 1.0f);
+			renderTime += GameLoop::Now() - renderStart;
+		}
+	}
+
+	double total = GameLoop::Now() - start;
+	AllocationCounter::Snapshot runEnd = AllocationCounter::Get();
+
+	const Game::Stats& stats = game->GetStats();
+
+	printf("GameBenchmark: %u ticks, %u asteroids, %ux%u, %u Hz\n", options.ticks, options.asteroids, options.width, options.height, options.tickRate);
+	printf("  %-10s %10.3f ms %10.0f ticks/sec\n", "total", total * 1000.0, total > 0.0 ? options.ticks / total : 0.0);
+	PrintPhase("update", stats.updateTime, stats.updates);
+	PrintPhase("collision", stats.collisionTime, stats.updates);
+	PrintPhase("spawn", stats.spawnTime, stats.updates);
+	if (options.render)
+	{
+		PrintPhase("render", renderTime, options.ticks);
+		printf("  %-10s %10llu primitives, %llu points\n", "submitted", batchRenderer.GetPrimitiveCount(), batchRenderer.GetPointCount());
+	}
+	printf("  %-10s %10llu tested, %llu brute force\n", "pairs", stats.candidatePairs, stats.bruteForcePairs);
+	printf("  %-10s %10llu allocations (%llu bytes) constructing the game in %.3f ms\n", "setup", setupEnd.allocations - setupStart.allocations, setupEnd.bytes - setupStart.bytes, constructTime * 1000.0);
+	printf("  %-10s %10llu allocations, %llu frees (%llu bytes) during the ticks\n", "ticks", runEnd.allocations - runStart.allocations, runEnd.deallocations - runStart.deallocations, runEnd.bytes - runStart.bytes);
+
+	delete game;
+	return 0;
+}
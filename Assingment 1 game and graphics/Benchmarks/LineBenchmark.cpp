@@ -0,0 +1,202 @@
+#include <GameDev2D.h>
+#include "Graphics/LineExpander.h"
+#include "Math/Random.h"
+#include "../Source/Constants.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+namespace
+{
+	using namespace GameDev2D;
+
+	struct Options
+	{
+		Options() : frames(1000), outlines(2000), width(1280), height(720) {}
+
+		unsigned int frames;
+		unsigned int outlines;
+		unsigned int width;
+		unsigned int height;
+	};
+
+	//An asteroid outline, with the point it was drawn at and its rotation speed
+	struct Outline
+	{
+		std::vector<Vector2> points;
+		Vector2 position;
+		float angularVelocity;
+	};
+
+	//What one expansion did over all the frames
+	struct Result
+	{
+		Result() : time(0.0), quads(0), uploadedBytes(0), vertexShaderRuns(0), geometryShaderRuns(0) {}
+
+		double time;
+		unsigned long long quads;
+		unsigned long long uploadedBytes;
+		unsigned long long vertexShaderRuns;
+		unsigned long long geometryShaderRuns;
+	};
+
+	void PrintUsage()
+	{
+		printf("Usage: LineBenchmark [--frames N] [--outlines N] [--width N] [--height N]\n");
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* argument = argv[i];
+			const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+			unsigned int* target = nullptr;
+			if (strcmp(argument, "--frames") == 0) target = &options.frames;
+			else if (strcmp(argument, "--outlines") == 0) target = &options.outlines;
+			else if (strcmp(argument, "--width") == 0) target = &options.width;
+			else if (strcmp(argument, "--height") == 0) target = &options.height;
+
+			if (target == nullptr || value == nullptr)
+			{
+				return false;
+			}
+
+			*target = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+			i++;
+		}
+
+		return options.frames > 0 && options.outlines > 0 && options.width > 0 && options.height > 0;
+	}
+
+	//Closed asteroid outlines scattered over the screen, like AsteroidField makes them
+	void MakeOutlines(const Options& options, std::vector<Outline>& outlines)
+	{
+		Random random(1);
+		outlines.resize(options.outlines);
+
+		for (Outline& outline : outlines)
+		{
+			unsigned int sides = (unsigned int)random.RandomInt(MIN_NUM_OF_SIDES, MAX_NUM_OF_SIDES);
+			float radiansPerSide = 2.0f * (float)M_PI / (float)sides;
+			for (unsigned int i = 0; i < sides; i++)
+			{
+				float radius = random.RandomFloat(MIN_RADIUS, MAX_RADIUS);
+				outline.points.push_back(Vector2(cosf(radiansPerSide * i) * radius, sinf(radiansPerSide * i) * radius));
+			}
+			outline.points.push_back(outline.points.front());
+
+			outline.position = Vector2(random.RandomFloat(0.0f, (float)options.width), random.RandomFloat(0.0f, (float)options.height));
+			outline.angularVelocity = random.RandomFloat(-1.0f, 1.0f);
+		}
+	}
+
+	//Writes every outline once per frame the way LineRenderer does for the expansion, into buffers that stand in for
+	//the mapped vertex buffers. The strip's points go through the same transforms as in LineRenderer::RenderLineStrip()
+	Result Run(LineExpansion expansion, const Options& options, const std::vector<Outline>& outlines)
+	{
+		const Vector2 viewport((float)options.width, (float)options.height);
+		const Vector2 farAway = viewport * 10.0f;
+		const Affine2D screenTransform = Affine2D::MakeScale(viewport) * Affine2D(Matrix::Orthographic(0.0f, viewport.x, 0.0f, viewport.y, -1.0f, 1.0f));
+
+		unsigned int maxPoints = 0;
+		unsigned int totalPoints = 0;
+		for (const Outline& outline : outlines)
+		{
+			maxPoints = maxPoints > outline.points.size() ? maxPoints : (unsigned int)outline.points.size();
+			totalPoints += (unsigned int)outline.points.size();
+		}
+
+		std::vector<Vector2> stripPoints(maxPoints);
+		std::vector<LineVertex> lineVertices(totalPoints + outlines.size() * 2);
+		std::vector<LineSegmentInstance> segmentInstances(totalPoints);
+		std::vector<LineQuadVertex> quadVertices(totalPoints * 4);
+
+		Result result;
+		double start = GameLoop::Now();
+
+		for (unsigned int frame = 0; frame < options.frames; frame++)
+		{
+			LineVertex* lineVertex = lineVertices.data();
+			LineSegmentInstance* segmentInstance = segmentInstances.data();
+			LineQuadVertex* quadVertex = quadVertices.data();
+
+			for (const Outline& outline : outlines)
+			{
+				const Vector2* points = outline.points.data();
+				const unsigned int count = (unsigned int)outline.points.size();
+				const float radians = outline.angularVelocity * frame / 60.0f;
+
+				switch (expansion)
+				{
+				case LineExpansion::Instanced:
+					BatchMath::RotateTranslate(points, count, radians, outline.position, stripPoints.data());
+					segmentInstance += LineExpander::WriteSegments(stripPoints.data(), count, ColorList::White, 2.0f, segmentInstance);
+					break;
+
+				case LineExpansion::Cpu:
+					BatchMath::Transform(screenTransform * Affine2D::Make(outline.position, radians), points, count, stripPoints.data());
+					quadVertex += LineExpander::WriteQuads(stripPoints.data(), count, ColorList::White, 2.0f, viewport, quadVertex) * 4;
+					break;
+
+				default:
+					lineVertex += LineExpander::WriteStrip(points, count, outline.position, radians, farAway, ColorList::White, 2.0f, lineVertex);
+					result.quads += count - 1;
+					break;
+				}
+			}
+
+			//Every expansion ends up rasterizing 4 vertices per quad, only the GPU work to get there differs. The geometry
+			//shader runs for every 4 consecutive vertices, including the ones joining two strips that it culls
+			unsigned long long lineVertexCount = lineVertex - lineVertices.data();
+			unsigned long long segmentCount = segmentInstance - segmentInstances.data();
+			unsigned long long quadVertexCount = quadVertex - quadVertices.data();
+
+			result.quads += segmentCount + quadVertexCount / 4;
+			result.uploadedBytes += lineVertexCount * sizeof(LineVertex) + segmentCount * sizeof(LineSegmentInstance) + quadVertexCount * sizeof(LineQuadVertex);
+			result.vertexShaderRuns += lineVertexCount + segmentCount * 4 + quadVertexCount;
+			result.geometryShaderRuns += lineVertexCount > 3 ? lineVertexCount - 3 : 0;
+		}
+
+		result.time = GameLoop::Now() - start;
+		return result;
+	}
+}
+
+
+//Compares the CPU side of LineRenderer's line expansions: how fast each one turns asteroid outlines into what it uploads,
+//in millions of expanded (rasterized) vertices per second, and what it leaves the GPU to do each frame. The GPU side can
+//only be timed in the game, by switching the renderer.lineExpansion option
+int main(int argc, char** argv)
+{
+	Options options;
+	if (ParseOptions(argc, argv, options) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<Outline> outlines;
+	MakeOutlines(options, outlines);
+
+	const LineExpansion expansions[] = { LineExpansion::GeometryShader, LineExpansion::Instanced, LineExpansion::Cpu };
+	const char* names[] = { "geometry", "instanced", "cpu" };
+
+	printf("LineBenchmark: %u frames, %u outlines, %ux%u\n", options.frames, options.outlines, options.width, options.height);
+	printf("  %-10s %10s %12s %12s %12s %12s %12s\n", "expansion", "ms/frame", "Mverts/sec", "quads", "bytes", "vs runs", "gs runs");
+
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		Result result = Run(expansions[i], options, outlines);
+		printf("  %-10s %10.3f %12.1f %12llu %12llu %12llu %12llu\n", names[i],
+			result.time * 1000.0 / options.frames,
+			result.time > 0.0 ? (double)result.quads * 4.0 / result.time / 1000000.0 : 0.0,
+			result.quads / options.frames,
+			result.uploadedBytes / options.frames,
+			result.vertexShaderRuns / options.frames,
+			result.geometryShaderRuns / options.frames);
+	}
+
+	return 0;
+}
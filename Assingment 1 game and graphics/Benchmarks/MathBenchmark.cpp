@@ -0,0 +1,288 @@
+#include <GameDev2D.h>
+#include "Math/Random.h"
+#include "../Source/Constants.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+namespace
+{
+	using namespace GameDev2D;
+
+	struct Options
+	{
+		Options() : iterations(200000), circles(20000) {}
+
+		unsigned int iterations;
+		unsigned int circles;
+	};
+
+	//Same layout as LineRenderer's vertices, so the strided stores are measured the way the renderer uses them
+	struct LineVertex
+	{
+		Vector2 vertices;
+		Color color;
+		float lineWidth;
+	};
+
+	const SimdLevel kLevels[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 };
+	const char* kLevelNames[] = { "scalar", "sse2", "avx2" };
+
+	void PrintUsage()
+	{
+		printf("Usage: MathBenchmark [--iterations N] [--circles N]\n");
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* argument = argv[i];
+			const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+			unsigned int* target = nullptr;
+			if (strcmp(argument, "--iterations") == 0) target = &options.iterations;
+			else if (strcmp(argument, "--circles") == 0) target = &options.circles;
+
+			if (target == nullptr || value == nullptr)
+			{
+				return false;
+			}
+
+			*target = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+			i++;
+		}
+
+		return options.iterations > 0 && options.circles > 0;
+	}
+
+	//Returns millions of points (or circles) per second
+	double Throughput(unsigned long long count, double seconds)
+	{
+		return seconds > 0.0 ? (double)count / seconds / 1000000.0 : 0.0;
+	}
+
+	//An asteroid outline with the given number of sides, plus the closing point like AsteroidField makes them
+	void MakeOutline(Random& random, unsigned int sides, std::vector<Vector2>& points)
+	{
+		points.clear();
+		float radiansPerSide = 2.0f * (float)M_PI / (float)sides;
+		for (unsigned int i = 0; i < sides; i++)
+		{
+			float radius = random.RandomFloat(MIN_RADIUS, MAX_RADIUS);
+			points.push_back(Vector2(cosf(radiansPerSide * i) * radius, sinf(radiansPerSide * i) * radius));
+		}
+		points.push_back(points.front());
+	}
+
+	//Rotates and offsets one outline per iteration, each iteration uses a different angle and position
+	void BenchmarkOutlines(const Options& options)
+	{
+		Random random(1);
+		std::vector<Vector2> points;
+		std::vector<Vector2> packed(MAX_NUM_OF_SIDES + 1);
+		std::vector<LineVertex> vertices(MAX_NUM_OF_SIDES + 1);
+
+		printf("RotateTranslate, Mpoints/sec (packed output / LineVertex output, which always runs the scalar loop)\n");
+		printf("  %-6s", "sides");
+		for (unsigned int level = 0; level <= (unsigned int)BatchMath::GetSupportedLevel(); level++)
+		{
+			printf(" %21s", kLevelNames[level]);
+		}
+		printf("\n");
+
+		for (unsigned int sides = MIN_NUM_OF_SIDES; sides <= MAX_NUM_OF_SIDES; sides++)
+		{
+			MakeOutline(random, sides, points);
+			const unsigned int count = (unsigned int)points.size();
+			std::vector<Vector2> reference(count);
+
+			printf("  %-6u", sides);
+			for (unsigned int level = 0; level <= (unsigned int)BatchMath::GetSupportedLevel(); level++)
+			{
+				BatchMath::SetLevel(kLevels[level]);
+
+				double start = GameLoop::Now();
+				for (unsigned int i = 0; i < options.iterations; i++)
+				{
+					BatchMath::RotateTranslate(points.data(), count, i * 0.001f, Vector2((float)i, 0.0f), packed.data());
+				}
+				double packedTime = GameLoop::Now() - start;
+
+				start = GameLoop::Now();
+				for (unsigned int i = 0; i < options.iterations; i++)
+				{
+					BatchMath::RotateTranslate(points.data(), count, i * 0.001f, Vector2((float)i, 0.0f), &vertices[0].vertices, sizeof(LineVertex));
+				}
+				double strideTime = GameLoop::Now() - start;
+
+				//Every level has to give exactly the same points as the scalar code
+				bool matches = true;
+				for (unsigned int i = 0; i < count; i++)
+				{
+					if (level == 0)
+					{
+						reference[i] = packed[i];
+					}
+					matches = matches && packed[i] == reference[i] && vertices[i].vertices == reference[i];
+				}
+
+				unsigned long long total = (unsigned long long)count * options.iterations;
+				printf(" %9.1f / %9.1f%s", Throughput(total, packedTime), Throughput(total, strideTime), matches ? " " : "!");
+			}
+			printf("\n");
+		}
+	}
+
+	//Tests a circle against the candidates a broadphase query returns, scattered through the asteroid arrays
+	void BenchmarkCircles(const Options& options)
+	{
+		Random random(2);
+		std::vector<Vector2> centers(options.circles);
+		std::vector<float> radii(options.circles);
+		for (unsigned int i = 0; i < options.circles; i++)
+		{
+			centers[i] = Vector2(random.RandomFloat(0.0f, 1280.0f), random.RandomFloat(0.0f, 720.0f));
+			radii[i] = random.RandomFloat(MIN_RADIUS, MAX_RADIUS);
+		}
+
+		const Vector2 screenSize(1280.0f, 720.0f);
+		const unsigned int candidateCounts[] = { 8, 32, 128, 1024 };
+		std::vector<unsigned int> indices(1024);
+		std::vector<unsigned char> overlaps(1024);
+
+		printf("CircleOverlaps with indices on a wrapped screen, Mcircles/sec\n");
+		printf("  %-6s", "count");
+		for (unsigned int level = 0; level <= (unsigned int)BatchMath::GetSupportedLevel(); level++)
+		{
+			printf(" %10s", kLevelNames[level]);
+		}
+		printf("\n");
+
+		for (unsigned int candidates : candidateCounts)
+		{
+			for (unsigned int i = 0; i < candidates; i++)
+			{
+				indices[i] = (unsigned int)random.RandomInt(0, options.circles - 1);
+			}
+
+			unsigned long long referenceHits = 0;
+			printf("  %-6u", candidates);
+			for (unsigned int level = 0; level <= (unsigned int)BatchMath::GetSupportedLevel(); level++)
+			{
+				BatchMath::SetLevel(kLevels[level]);
+
+				unsigned long long hits = 0;
+				const unsigned int iterations = options.iterations * 8 / candidates + 1;
+				double start = GameLoop::Now();
+				for (unsigned int i = 0; i < iterations; i++)
+				{
+					Vector2 center = centers[i % options.circles];
+					hits += BatchMath::CircleOverlaps(center, MAX_RADIUS, centers.data(), radii.data(), indices.data(), candidates, screenSize, overlaps.data());
+				}
+				double time = GameLoop::Now() - start;
+
+				if (level == 0)
+				{
+					referenceHits = hits;
+				}
+
+				printf(" %9.1f%s", Throughput((unsigned long long)candidates * iterations, time), hits == referenceHits ? " " : "!");
+			}
+			printf("\n");
+		}
+	}
+
+	//Compares testing a few broadphase candidates one by one against gathering them for the batch kernel the way
+	//Game::TestAsteroids does, to pick COLLISION_MIN_BATCH_CANDIDATES
+	void BenchmarkNarrowPhase(const Options& options)
+	{
+		Random random(3);
+		std::vector<Vector2> centers(options.circles);
+		std::vector<float> radii(options.circles);
+		for (unsigned int i = 0; i < options.circles; i++)
+		{
+			centers[i] = Vector2(random.RandomFloat(0.0f, 1280.0f), random.RandomFloat(0.0f, 720.0f));
+			radii[i] = random.RandomFloat(MIN_RADIUS, MAX_RADIUS);
+		}
+
+		const Vector2 screenSize(1280.0f, 720.0f);
+		const unsigned int candidateCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+		std::vector<unsigned int> indices(64);
+		std::vector<unsigned int> gathered;
+		gathered.reserve(64);
+		std::vector<unsigned char> overlaps(64);
+		BatchMath::SetLevel(BatchMath::GetSupportedLevel());
+
+		printf("Narrow phase per query, inline tests vs gathered for the %s kernel, ns/query\n", kLevelNames[(unsigned int)BatchMath::GetSupportedLevel()]);
+		printf("  %-6s %10s %10s\n", "count", "inline", "batch");
+
+		for (unsigned int candidates : candidateCounts)
+		{
+			for (unsigned int i = 0; i < candidates; i++)
+			{
+				indices[i] = (unsigned int)random.RandomInt(0, options.circles - 1);
+			}
+
+			const unsigned int iterations = options.iterations * 8 / candidates + 1;
+
+			unsigned long long inlineHits = 0;
+			double start = GameLoop::Now();
+			for (unsigned int i = 0; i < iterations; i++)
+			{
+				Vector2 center = centers[i % options.circles];
+				for (unsigned int j = 0; j < candidates; j++)
+				{
+					unsigned int index = indices[j];
+					if (Math::DoCirclesOverlap(center, MAX_RADIUS, centers[index], radii[index], screenSize))
+					{
+						inlineHits++;
+					}
+				}
+			}
+			double inlineTime = GameLoop::Now() - start;
+
+			unsigned long long batchHits = 0;
+			start = GameLoop::Now();
+			for (unsigned int i = 0; i < iterations; i++)
+			{
+				Vector2 center = centers[i % options.circles];
+				gathered.clear();
+				for (unsigned int j = 0; j < candidates; j++)
+				{
+					gathered.push_back(indices[j]);
+				}
+				BatchMath::CircleOverlaps(center, MAX_RADIUS, centers.data(), radii.data(), gathered.data(), candidates, screenSize, overlaps.data());
+				for (unsigned int j = 0; j < candidates; j++)
+				{
+					if (overlaps[j])
+					{
+						batchHits++;
+					}
+				}
+			}
+			double batchTime = GameLoop::Now() - start;
+
+			printf("  %-6u %10.1f %9.1f%s\n", candidates, inlineTime * 1000000000.0 / iterations, batchTime * 1000000000.0 / iterations, batchHits == inlineHits ? " " : "!");
+		}
+	}
+}
+
+
+//Compares the scalar, SSE2 and AVX2 BatchMath kernels on the point and circle counts the game uses,
+//a ! after a number means that level didn't return the same results as the scalar code
+int main(int argc, char** argv)
+{
+	Options options;
+	if (ParseOptions(argc, argv, options) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	printf("MathBenchmark: %u iterations, supported level %s\n", options.iterations, kLevelNames[(unsigned int)BatchMath::GetSupportedLevel()]);
+	BenchmarkOutlines(options);
+	BenchmarkCircles(options);
+	BenchmarkNarrowPhase(options);
+	return 0;
+}
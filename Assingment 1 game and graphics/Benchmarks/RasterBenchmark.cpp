@@ -0,0 +1,238 @@
+#include <GameDev2D.h>
+#include "Graphics/LineExpander.h"
+#include "Graphics/SoftwareBackend.h"
+#include "../Source/Game.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+namespace
+{
+	using namespace GameDev2D;
+
+	struct Options
+	{
+		Options() : frames(300), threads(8), width(1280), height(720), asteroids(NUM_OF_ASTEROIDS), fireEvery(10) {}
+
+		unsigned int frames;
+		unsigned int threads;
+		unsigned int width;
+		unsigned int height;
+		unsigned int asteroids;
+		unsigned int fireEvery;
+		std::string output;
+	};
+
+	//What one thread count did over all the frames
+	struct Result
+	{
+		Result() : updateTime(0.0), renderTime(0.0), rasterizeTime(0.0), triangles(0), skippedDrawCalls(0), checksum(0) {}
+
+		double updateTime;
+		double renderTime;
+		double rasterizeTime;
+		unsigned long long triangles;
+		unsigned long long skippedDrawCalls;
+		unsigned int checksum;
+		std::vector<unsigned char> pixels;
+	};
+
+	void PrintUsage()
+	{
+		printf("Usage: RasterBenchmark [--frames N] [--threads N] [--width N] [--height N] [--asteroids N] [--fire-every N] [--output file.ppm]\n");
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* argument = argv[i];
+			const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+			if (value == nullptr)
+			{
+				return false;
+			}
+
+			if (strcmp(argument, "--output") == 0)
+			{
+				options.output = value;
+				i++;
+				continue;
+			}
+
+			unsigned int* target = nullptr;
+			if (strcmp(argument, "--frames") == 0) target = &options.frames;
+			else if (strcmp(argument, "--threads") == 0) target = &options.threads;
+			else if (strcmp(argument, "--width") == 0) target = &options.width;
+			else if (strcmp(argument, "--height") == 0) target = &options.height;
+			else if (strcmp(argument, "--asteroids") == 0) target = &options.asteroids;
+			else if (strcmp(argument, "--fire-every") == 0) target = &options.fireEvery;
+
+			if (target == nullptr)
+			{
+				return false;
+			}
+
+			*target = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+			i++;
+		}
+
+		return options.frames > 0 && options.threads > 0 && options.width > 0 && options.height > 0;
+	}
+
+	//Same scripted input as GameBenchmark: the ship sweeps left and right, thrusts every third sweep and keeps firing
+	void ApplyInput(Game& game, const Options& options, unsigned int frame)
+	{
+		unsigned int sweep = frame / 90;
+		SetKeyDown(KeyCode::A, sweep % 2 == 0);
+		SetKeyDown(KeyCode::D, sweep % 2 == 1);
+		SetKeyDown(KeyCode::W, sweep % 3 == 0);
+
+		if (options.fireEvery > 0 && frame % options.fireEvery == 0)
+		{
+			game.OnKeyEvent(KeyCode::Space, KeyState::Down);
+			game.OnKeyEvent(KeyCode::Space, KeyState::Up);
+		}
+	}
+
+	//FNV-1a of the frame, two runs drew the same image if their checksums match
+	unsigned int Checksum(const std::vector<unsigned char>& pixels)
+	{
+		unsigned int hash = 2166136261u;
+		for (unsigned char byte : pixels)
+		{
+			hash = (hash ^ byte) * 16777619u;
+		}
+		return hash;
+	}
+
+	//Plays the game for the given number of frames, drawing every frame with the BatchRenderer into a SoftwareBackend
+	//with the given number of threads, and reads the last frame back
+	Result Run(const Options& options, unsigned int threads)
+	{
+		Application application(std::make_unique<SoftwareBackend>(options.width, options.height, threads), options.width, options.height);
+		SoftwareBackend& backend = static_cast<SoftwareBackend&>(application.GetGraphics().GetBackend());
+
+		//The software backend can't run geometry shaders, the Application expands the lines on the CPU for it too
+		BatchRenderer& batchRenderer = application.GetBatchRenderer();
+		batchRenderer.SetLineExpansion(LineExpansion::Cpu);
+
+		//Every run plays the same game, so every thread count has to draw the same frames
+		Math::SetRandomSeed(RANDOM_SEED);
+		std::unique_ptr<Game> game = std::make_unique<Game>(options.asteroids);
+
+		const float delta = 1.0f / 60.0f;
+		Result result;
+		unsigned long long trianglesBefore = backend.GetRasterizer().GetTotalTriangles();
+
+		for (unsigned int frame = 0; frame < options.frames; frame++)
+		{
+			double updateStart = GameLoop::Now();
+			ApplyInput(*game, options, frame);
+			game->OnUpdate(delta);
+
+			//Rendering includes the vertex shading, triangle setup and binning, the triangles are rasterized in Flush()
+			double renderStart = GameLoop::Now();
+			application.NewFrame();
+			game->OnRender(batchRenderer, 1.0f);
+
+			double flushStart = GameLoop::Now();
+			backend.Flush();
+			double flushEnd = GameLoop::Now();
+
+			result.updateTime += renderStart - updateStart;
+			result.renderTime += flushStart - renderStart;
+			result.rasterizeTime += flushEnd - flushStart;
+		}
+
+		result.triangles = backend.GetRasterizer().GetTotalTriangles() - trianglesBefore;
+		result.skippedDrawCalls = backend.GetSkippedDrawCalls();
+
+		result.pixels.resize(options.width * options.height * 3);
+		backend.CopyFrameBufferContents(0, PixelFormat(PixelLayout::RGB, PixelSize::UnsignedByte), options.width, options.height, result.pixels.data());
+		result.checksum = Checksum(result.pixels);
+
+		//The game's sprites and text are destroyed before the Application they were created with
+		game.reset();
+		return result;
+	}
+
+	//Binary PPM, top row first, so the frame buffer's rows are flipped
+	bool WritePpm(const std::string& filename, const Options& options, const std::vector<unsigned char>& pixels)
+	{
+		FILE* file = fopen(filename.c_str(), "wb");
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		fprintf(file, "P6\n%u %u\n255\n", options.width, options.height);
+		for (unsigned int y = options.height; y > 0; y--)
+		{
+			fwrite(&pixels[(size_t)(y - 1) * options.width * 3], 1, options.width * 3, file);
+		}
+
+		fclose(file);
+		return true;
+	}
+}
+
+
+//Plays the game with scripted input and draws every frame with the real BatchRenderer and renderers into a
+//SoftwareBackend, with 1, 2, 4 and 8 threads (up to --threads). The tiles are rasterized in a fixed order, so every
+//thread count has to draw the same frames: the checksums are there to compare, and --output saves the last frame as a
+//golden image. update is the game, render is the BatchRenderer plus the single threaded vertex shading, triangle setup
+//and binning, only raster scales with the threads
+int main(int argc, char** argv)
+{
+	Options options;
+	if (ParseOptions(argc, argv, options) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<unsigned int> threadCounts;
+	for (unsigned int threads = 1; threads <= options.threads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+
+	printf("RasterBenchmark: %u frames, %ux%u, %u asteroids, %u hardware threads\n", options.frames, options.width, options.height, options.asteroids, ThreadPool(0).GetNumberOfThreads());
+	printf("  %-8s %10s %10s %10s %10s %8s %12s %10s %10s\n", "threads", "ms/frame", "update ms", "render ms", "raster ms", "fps", "triangles", "speedup", "checksum");
+
+	double singleThreadTime = 0.0;
+	Result result;
+	for (unsigned int threadCount : threadCounts)
+	{
+		result = Run(options, threadCount);
+		double time = result.updateTime + result.renderTime + result.rasterizeTime;
+		if (threadCount == 1)
+		{
+			singleThreadTime = time;
+		}
+
+		printf("  %-8u %10.3f %10.3f %10.3f %10.3f %8.1f %12llu %9.2fx   %08x\n", threadCount,
+			time * 1000.0 / options.frames,
+			result.updateTime * 1000.0 / options.frames,
+			result.renderTime * 1000.0 / options.frames,
+			result.rasterizeTime * 1000.0 / options.frames,
+			time > 0.0 ? options.frames / time : 0.0,
+			result.triangles / options.frames,
+			time > 0.0 ? singleThreadTime / time : 0.0,
+			result.checksum);
+
+		if (result.skippedDrawCalls > 0)
+		{
+			printf("  %llu draw calls were skipped\n", result.skippedDrawCalls);
+		}
+	}
+
+	if (options.output.empty() == false && WritePpm(options.output, options, result.pixels) == false)
+	{
+		printf("Couldn't write %s\n", options.output.c_str());
+		return 1;
+	}
+
+	return 0;
+}
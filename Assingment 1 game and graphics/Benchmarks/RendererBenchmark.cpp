@@ -0,0 +1,221 @@
+#include <GameDev2D.h>
+#include "Graphics/LineExpander.h"
+#include "Graphics/RecordingBackend.h"
+#include "Math/Random.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+namespace
+{
+	using namespace GameDev2D;
+
+	struct Options
+	{
+		Options() : frames(100), items(6000), width(1280), height(720) {}
+
+		unsigned int frames;
+		unsigned int items;
+		unsigned int width;
+		unsigned int height;
+	};
+
+	//One way of configuring the BatchRenderer, each one draws the same frames
+	struct Configuration
+	{
+		const char* name;
+		RenderOrder renderOrder;
+		SpriteSubmission spriteSubmission;
+		LineExpansion lineExpansion;
+		bool culling;
+	};
+
+	const Configuration kConfigurations[] =
+	{
+		{ "strict", RenderOrder::Strict, SpriteSubmission::PerVertex, LineExpansion::GeometryShader, false },
+		{ "deferred", RenderOrder::Deferred, SpriteSubmission::PerVertex, LineExpansion::GeometryShader, false },
+		{ "inst sprites", RenderOrder::Deferred, SpriteSubmission::Instanced, LineExpansion::GeometryShader, false },
+		{ "inst lines", RenderOrder::Deferred, SpriteSubmission::Instanced, LineExpansion::Instanced, false },
+		{ "cpu lines", RenderOrder::Deferred, SpriteSubmission::Instanced, LineExpansion::Cpu, false },
+		{ "culled", RenderOrder::Deferred, SpriteSubmission::Instanced, LineExpansion::Instanced, true }
+	};
+
+	//Something to draw, what kind of primitive it is drawn as depends on its index
+	struct Item
+	{
+		Vector2 position;
+		Vector2 size;
+		float radians;
+		float angularVelocity;
+		Color color;
+	};
+
+	void PrintUsage()
+	{
+		printf("Usage: RendererBenchmark [--frames N] [--items N] [--width N] [--height N]\n");
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const char* argument = argv[i];
+			const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+			unsigned int* target = nullptr;
+			if (strcmp(argument, "--frames") == 0) target = &options.frames;
+			else if (strcmp(argument, "--items") == 0) target = &options.items;
+			else if (strcmp(argument, "--width") == 0) target = &options.width;
+			else if (strcmp(argument, "--height") == 0) target = &options.height;
+
+			if (target == nullptr || value == nullptr)
+			{
+				return false;
+			}
+
+			*target = static_cast<unsigned int>(strtoul(value, nullptr, 10));
+			i++;
+		}
+
+		return options.frames > 0 && options.width > 0 && options.height > 0;
+	}
+
+	//A quarter of the items are off screen, so culling has something to skip
+	std::vector<Item> CreateItems(const Options& options)
+	{
+		Random random(RANDOM_SEED);
+		std::vector<Item> items(options.items);
+		for (Item& item : items)
+		{
+			item.position = Vector2(random.RandomFloat(-0.25f, 1.25f) * options.width, random.RandomFloat(0.0f, 1.0f) * options.height);
+			item.size = Vector2(random.RandomFloat(4.0f, 32.0f), random.RandomFloat(4.0f, 32.0f));
+			item.radians = random.RandomFloat(0.0f, 2.0f * static_cast<float>(M_PI));
+			item.angularVelocity = random.RandomFloat(-2.0f, 2.0f);
+			item.color = Color(random.RandomFloat(), random.RandomFloat(), random.RandomFloat(), 1.0f);
+		}
+		return items;
+	}
+
+	//The primitive types are interleaved, so the strict render order has to switch renderers for every item
+	void RenderFrame(BatchRenderer& batchRenderer, const std::vector<Item>& items, const std::vector<Vector2>& outline, unsigned int outlineShape, Sprite& sprite, float time)
+	{
+		batchRenderer.BeginScene();
+
+		for (unsigned int i = 0; i < items.size(); i++)
+		{
+			const Item& item = items[i];
+			const float radians = item.radians + item.angularVelocity * time;
+
+			switch (i % 6)
+			{
+			case 0:
+				batchRenderer.RenderQuad(item.position, item.size, item.color);
+				break;
+			case 1:
+				batchRenderer.RenderRotatedQuad(item.position, item.size, radians, Vector2(0.5f, 0.5f), item.color);
+				break;
+			case 2:
+				batchRenderer.RenderCircle(item.position, item.size.x, item.color, ColorList::White, 2.0f);
+				break;
+			case 3:
+				batchRenderer.RenderLineStrip(outline.data(), static_cast<unsigned int>(outline.size()), item.color, 2.0f, item.position, radians);
+				break;
+			case 4:
+				batchRenderer.RenderLineShape(outlineShape, item.color, 2.0f, item.position, radians);
+				break;
+			default:
+				sprite.SetPosition(item.position);
+				sprite.SetRadians(radians);
+				sprite.SetScale(item.size);
+				sprite.SetColor(item.color);
+				batchRenderer.RenderSprite(sprite);
+				break;
+			}
+		}
+
+		batchRenderer.EndScene();
+	}
+
+	double PerFrame(unsigned long long total, unsigned int frames)
+	{
+		return static_cast<double>(total) / frames;
+	}
+}
+
+
+//Draws the same frames with the real BatchRenderer and renderers over a RecordingBackend, once per configuration,
+//and reports what each frame cost in graphics calls, draw calls and uploaded bytes
+int main(int argc, char** argv)
+{
+	Options options;
+	if (ParseOptions(argc, argv, options) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	const std::vector<Item> items = CreateItems(options);
+
+	//An asteroid like outline, drawn both as a strip and as a registered shape
+	std::vector<Vector2> outline;
+	for (unsigned int i = 0; i <= 12; i++)
+	{
+		const float angle = static_cast<float>(i % 12) / 12.0f * 2.0f * static_cast<float>(M_PI);
+		const float radius = i % 2 == 0 ? 16.0f : 12.0f;
+		outline.push_back(Vector2(cosf(angle) * radius, sinf(angle) * radius));
+	}
+
+	printf("RendererBenchmark: %u frames, %u items, %ux%u, per frame averages\n", options.frames, options.items, options.width, options.height);
+	printf("  %-12s %12s %12s %12s %12s %12s %12s %12s %10s\n", "", "calls", "draw calls", "vertices", "buffer B", "uniform B", "texture B", "states", "ms");
+
+	for (const Configuration& configuration : kConfigurations)
+	{
+		Application application(std::make_unique<RecordingBackend>(), options.width, options.height);
+		RecordingBackend& backend = static_cast<RecordingBackend&>(application.GetGraphics().GetBackend());
+
+		BatchRenderer& batchRenderer = application.GetBatchRenderer();
+		batchRenderer.SetRenderOrder(configuration.renderOrder);
+		batchRenderer.SetSpriteSubmission(configuration.spriteSubmission);
+		batchRenderer.SetLineExpansion(configuration.lineExpansion);
+		batchRenderer.EnableCulling(configuration.culling);
+
+		const unsigned int outlineShape = batchRenderer.RegisterLineShape(outline.data(), static_cast<unsigned int>(outline.size()));
+		Sprite sprite;
+		sprite.SetAnchor(0.5f, 0.5f);
+
+		//The first frame creates the buffers and uploads the textures, it isn't counted
+		application.NewFrame();
+		RenderFrame(batchRenderer, items, outline, outlineShape, sprite, 0.0f);
+
+		GraphicsCounters counters;
+		unsigned long long stateChanges = 0;
+		double time = 0.0;
+
+		for (unsigned int frame = 0; frame < options.frames; frame++)
+		{
+			//NewFrame() moves the frame before to the last frame counters
+			double start = GameLoop::Now();
+			application.NewFrame();
+			if (frame > 0)
+			{
+				counters.Add(backend.GetLastFrameCounters());
+				stateChanges += application.GetGraphics().GetLastFrameIssuedStateChanges();
+			}
+
+			RenderFrame(batchRenderer, items, outline, outlineShape, sprite, static_cast<float>(frame + 1) / 60.0f);
+			time += GameLoop::Now() - start;
+		}
+
+		//The last frame's counters are only moved by the next NewFrame()
+		application.NewFrame();
+		counters.Add(backend.GetLastFrameCounters());
+		stateChanges += application.GetGraphics().GetLastFrameIssuedStateChanges();
+
+		printf("  %-12s %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %10.3f\n", configuration.name,
+			PerFrame(counters.calls, options.frames), PerFrame(counters.drawCalls, options.frames), PerFrame(counters.vertices, options.frames),
+			PerFrame(counters.bufferBytes, options.frames), PerFrame(counters.uniformBytes, options.frames), PerFrame(counters.textureBytes, options.frames),
+			PerFrame(stateChanges, options.frames), time * 1000.0 / options.frames);
+	}
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+#include "GameDev2D.h"
+
+
+namespace GameDev2D
+{
+	SpriteFont::SpriteFont(const std::string& /*filename*/) :
+		m_Text(),
+		m_Position(Vector2::Zero),
+		m_Anchor(Vector2::Zero)
+	{
+	}
+
+	void SpriteFont::SetPosition(float x, float y)
+	{
+		m_Position = Vector2(x, y);
+	}
+
+	void SpriteFont::SetAnchor(float x, float y)
+	{
+		m_Anchor = Vector2(x, y);
+	}
+
+	void SpriteFont::SetText(const std::string& text)
+	{
+		m_Text = text;
+	}
+
+	RenderCommandBuffer::RenderCommandBuffer() :
+		m_PrimitiveCount(0)
+	{
+	}
+
+	void RenderCommandBuffer::RenderLineShape(unsigned int /*shapeId*/, const Color& /*color*/, float /*lineWidth*/, const Vector2& /*position*/, float /*radians*/)
+	{
+		m_PrimitiveCount++;
+	}
+
+	BatchRenderer::BatchRenderer() :
+		m_PrimitiveCount(0),
+		m_PointCount(0),
+		m_NumberOfShapes(0),
+		m_RecordingThreadPool(nullptr),
+		m_RecordingBuffers{},
+		m_MinParallelRecording(2000)
+	{
+	}
+
+	void BatchRenderer::BeginScene()
+	{
+	}
+
+	void BatchRenderer::EndScene()
+	{
+	}
+
+	void BatchRenderer::RenderSpriteFont(SpriteFont& /*spriteFont*/)
+	{
+		m_PrimitiveCount++;
+	}
+
+	void BatchRenderer::RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		RenderLineStrip(points.data(), static_cast<unsigned int>(points.size()), color, lineWidth, position, radians);
+	}
+
+	void BatchRenderer::RenderLineStrip(const Vector2* /*points*/, unsigned int numberOfPoints, const Color& /*color*/, float /*lineWidth*/, const Vector2& /*position*/, float /*radians*/)
+	{
+		m_PrimitiveCount++;
+		m_PointCount += numberOfPoints;
+	}
+
+	unsigned int BatchRenderer::RegisterLineShape(const Vector2* /*points*/, unsigned int /*numberOfPoints*/)
+	{
+		return m_NumberOfShapes++;
+	}
+
+	void BatchRenderer::RenderLineShape(unsigned int /*shapeId*/, const Color& /*color*/, float /*lineWidth*/, const Vector2& /*position*/, float /*radians*/)
+	{
+		m_PrimitiveCount++;
+	}
+
+	void BatchRenderer::PrepareCommandBuffer(RenderCommandBuffer& buffer)
+	{
+		buffer.m_PrimitiveCount = 0;
+	}
+
+	void BatchRenderer::SubmitCommandBuffer(RenderCommandBuffer& buffer)
+	{
+		m_PrimitiveCount += buffer.m_PrimitiveCount;
+	}
+
+	void BatchRenderer::EnableParallelRecording(bool enable)
+	{
+		m_RecordingThreadPool = enable ? std::make_unique<ThreadPool>() : nullptr;
+		m_RecordingBuffers.resize(enable ? m_RecordingThreadPool->GetNumberOfThreads() : 0);
+	}
+
+	void BatchRenderer::SetMinParallelRecording(unsigned int count)
+	{
+		m_MinParallelRecording = count;
+	}
+
+	void BatchRenderer::RenderCircle(const Vector2& /*position*/, float /*radius*/, const Color& /*fillColor*/)
+	{
+		m_PrimitiveCount++;
+		m_PointCount++;
+	}
+
+	unsigned long long BatchRenderer::GetPrimitiveCount() const
+	{
+		return m_PrimitiveCount;
+	}
+
+	unsigned long long BatchRenderer::GetPointCount() const
+	{
+		return m_PointCount;
+	}
+
+	void BatchRenderer::ResetCounters()
+	{
+		m_PrimitiveCount = 0;
+		m_PointCount = 0;
+	}
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+//Stand-in for Source/Framework/GameDev2D.h used by the headless benchmarks. It is found first on the include
+//path, so the game code builds without a window, OpenGL or XAudio2. The math, color and input headers are
+//the real ones; the window, renderer, text and game loop are replaced with the few calls the game makes.
+
+#include "Window.h"
+#include "Graphics/Color.h"
+#include "Graphics/ColorList.h"
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+#include "Math/BatchMath.h"
+#include "Math/Math.h"
+#include "Math/SpatialHash.h"
+#include "Math/Vector2.h"
+#include "Memory/DensePool.h"
+#include "Utils/ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <math.h>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+	//Records what the game submits instead of drawing it, so the cost of building a frame can still be measured
+	class SpriteFont
+	{
+	public:
+		SpriteFont(const std::string& filename);
+
+		void SetPosition(float x, float y);
+		void SetAnchor(float x, float y);
+		void SetText(const std::string& text);
+
+	private:
+		std::string m_Text;
+		Vector2 m_Position;
+		Vector2 m_Anchor;
+	};
+
+	//Counts what the game records on the worker threads, the counts are added to the BatchRenderer's when it's submitted
+	class RenderCommandBuffer
+	{
+	public:
+		RenderCommandBuffer();
+
+		void RenderLineShape(unsigned int shapeId, const Color& color, float lineWidth, const Vector2& position, float radians);
+
+	private:
+		friend class BatchRenderer;
+
+		unsigned long long m_PrimitiveCount;
+	};
+
+	class BatchRenderer
+	{
+	public:
+		BatchRenderer();
+
+		void BeginScene();
+		void EndScene();
+
+		void RenderSpriteFont(SpriteFont& spriteFont);
+		void RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth, const Vector2& position, float radians);
+		void RenderLineStrip(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians);
+		void RenderCircle(const Vector2& position, float radius, const Color& fillColor);
+
+		//Shapes are kept on the GPU, so an instance counts as a primitive without any points
+		unsigned int RegisterLineShape(const Vector2* points, unsigned int numberOfPoints);
+		void RenderLineShape(unsigned int shapeId, const Color& color, float lineWidth, const Vector2& position, float radians);
+
+		void PrepareCommandBuffer(RenderCommandBuffer& buffer);
+		void SubmitCommandBuffer(RenderCommandBuffer& buffer);
+
+		//Same as the real BatchRenderer, the items are only split between the threads when it's enabled and there are enough
+		void EnableParallelRecording(bool enable);
+		void SetMinParallelRecording(unsigned int count);
+
+		template <typename Record>
+		void RecordItems(unsigned int count, const Record& record);
+
+		//Returns the number of primitives and points submitted since the last ResetCounters()
+		unsigned long long GetPrimitiveCount() const;
+		unsigned long long GetPointCount() const;
+		void ResetCounters();
+
+	private:
+		unsigned long long m_PrimitiveCount;
+		unsigned long long m_PointCount;
+		unsigned int m_NumberOfShapes;
+		std::unique_ptr<ThreadPool> m_RecordingThreadPool;
+		std::vector<RenderCommandBuffer> m_RecordingBuffers;
+		unsigned int m_MinParallelRecording;
+	};
+
+	template <typename Record>
+	void BatchRenderer::RecordItems(unsigned int count, const Record& record)
+	{
+		if (m_RecordingThreadPool == nullptr || count < m_MinParallelRecording)
+		{
+			for (unsigned int i = 0; i < count; i++)
+			{
+				record(*this, i);
+			}
+			return;
+		}
+
+		for (RenderCommandBuffer& buffer : m_RecordingBuffers)
+		{
+			PrepareCommandBuffer(buffer);
+		}
+
+		const unsigned int numberOfChunks = (unsigned int)m_RecordingBuffers.size();
+		const unsigned int chunkSize = (count + numberOfChunks - 1) / numberOfChunks;
+		m_RecordingThreadPool->ParallelFor(numberOfChunks, [&](unsigned int chunk, unsigned int)
+		{
+			const unsigned int end = std::min(count, (chunk + 1) * chunkSize);
+			for (unsigned int i = chunk * chunkSize; i < end; i++)
+			{
+				record(m_RecordingBuffers[chunk], i);
+			}
+		});
+
+		for (RenderCommandBuffer& buffer : m_RecordingBuffers)
+		{
+			SubmitCommandBuffer(buffer);
+		}
+	}
+}
@@ -0,0 +1,207 @@
+#include "GameDev2D.h"
+#include "Application/RenderThread.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifndef SHADER_DIRECTORY
+#define SHADER_DIRECTORY "Assets/Shaders"
+#endif
+
+
+namespace GameDev2D
+{
+	Application* Application::s_Instance = nullptr;
+
+	Application::Application(std::unique_ptr<IGraphicsBackend> backend, unsigned int width, unsigned int height) :
+		m_Graphics(nullptr),
+		m_ResourceManager(nullptr),
+		m_BatchRenderer(nullptr)
+	{
+		s_Instance = this;
+		SetScreenSize(width, height);
+
+		//Same order as the Application, the resources are created with the Graphics and the renderers need the shaders
+		m_Graphics = std::make_unique<Graphics>(std::move(backend), width, height);
+		m_Graphics->SetClearColor(ColorList::Black);
+		m_ResourceManager = std::make_unique<ResourceManager>(*m_Graphics);
+		m_BatchRenderer = std::make_unique<BatchRenderer>(*m_Graphics, m_ResourceManager->GetShaderCache(), false);
+	}
+
+	Application::~Application()
+	{
+		//The renderers and resources are destroyed before the Graphics they were created with
+		m_BatchRenderer.reset();
+		m_ResourceManager.reset();
+		m_Graphics.reset();
+		s_Instance = nullptr;
+	}
+
+	Application& Application::Get()
+	{
+		return *s_Instance;
+	}
+
+	Graphics& Application::GetGraphics()
+	{
+		return *m_Graphics;
+	}
+
+	ResourceManager& Application::GetResourceManager()
+	{
+		return *m_ResourceManager;
+	}
+
+	BatchRenderer& Application::GetBatchRenderer()
+	{
+		return *m_BatchRenderer;
+	}
+
+	void Application::NewFrame()
+	{
+		m_BatchRenderer->NewFrame();
+		m_Graphics->NewFrame();
+		m_Graphics->Clear();
+	}
+
+	ResourceManager::ResourceManager(Graphics& graphics) :
+		m_TextureCache(entt::connect_arg_t<&ResourceManager::LoadTexture>()),
+		m_ShaderCache(entt::connect_arg_t<&ResourceManager::LoadShader>()),
+		m_FontCache(entt::connect_arg_t<&ResourceManager::LoadFont>())
+	{
+		PixelFormat format(PixelLayout::RGBA, PixelSize::UnsignedByte);
+		ImageData imageData(format, 1, 1);
+		imageData.data.assign(4, 255);
+		m_TextureCache.SetDefaultResource(CreateRef<Texture>(graphics, imageData));
+
+		FontData fontData;
+		m_FontCache.SetDefaultResource(CreateRef<Font>(graphics, imageData, fontData));
+
+		//Every shader the renderers use, under the keys they look them up with
+		const std::string shaders[][2] =
+		{
+			{ "SpriteRenderer", SPRITE_RENDERER_SHADER_KEY },
+			{ "SpriteInstanceRenderer", SPRITE_INSTANCE_RENDERER_SHADER_KEY },
+			{ "LineRenderer", LINE_RENDERER_SHADER_KEY },
+			{ "LineShapeRenderer", LINE_SHAPE_RENDERER_SHADER_KEY },
+			{ "LineInstanceRenderer", LINE_INSTANCE_RENDERER_SHADER_KEY },
+			{ "LineQuadRenderer", LINE_QUAD_RENDERER_SHADER_KEY },
+			{ "PointRenderer", POINT_RENDERER_SHADER_KEY },
+			{ "CircleRenderer", CIRCLE_RENDERER_SHADER_KEY }
+		};
+
+		for (const auto& shader : shaders)
+		{
+			m_ShaderCache.Load(Resource(shader[0], "glsl", "Shaders"), shader[1]);
+		}
+	}
+
+	ResourceCache<Texture>& ResourceManager::GetTextureCache()
+	{
+		return m_TextureCache;
+	}
+
+	ResourceCache<Shader>& ResourceManager::GetShaderCache()
+	{
+		return m_ShaderCache;
+	}
+
+	ResourceCache<Font>& ResourceManager::GetFontCache()
+	{
+		return m_FontCache;
+	}
+
+	void ResourceManager::LoadTexture(const Resource& /*resource*/, Ref<Texture>& /*texture*/)
+	{
+	}
+
+	void ResourceManager::LoadShader(const Resource& resource, Ref<Shader>& shader)
+	{
+		std::string path = std::string(SHADER_DIRECTORY) + "/" + resource.filename + "." + resource.extension;
+		std::ifstream file(path);
+		if (!file)
+		{
+			Log::Error(true, LogVerbosity::Resources, "[Resource Manager] Failed to load Shader : %s", path.c_str());
+			return;
+		}
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+		std::string source = stream.str();
+
+		//Splits the source at each #type line, the same as ResourceManager::PreProcessShader()
+		std::unordered_map<ShaderType, std::string> sources;
+		const std::string typeToken = "#type";
+		size_t position = source.find(typeToken);
+		while (position != std::string::npos)
+		{
+			size_t endOfLine = source.find_first_of("\r\n", position);
+			size_t begin = position + typeToken.length() + 1;
+			ShaderType type = Shader::GetShaderType(source.substr(begin, endOfLine - begin));
+
+			size_t nextLine = source.find_first_not_of("\r\n", endOfLine);
+			position = source.find(typeToken, nextLine);
+			sources[type] = position == std::string::npos ? source.substr(nextLine) : source.substr(nextLine, position - nextLine);
+		}
+
+		shader = CreateRef<Shader>(Application::Get().GetGraphics(), sources[ShaderType::Vertex], sources[ShaderType::Fragment], sources[ShaderType::Geometry]);
+	}
+
+	void ResourceManager::LoadFont(const Resource& /*resource*/, Ref<Font>& /*font*/)
+	{
+	}
+
+	//There's no render thread, the BatchRenderer never has one to wait for
+	void RenderThread::WaitUntilIdle()
+	{
+	}
+
+	bool Log::s_IsInitialized = false;
+
+	void Log::Init()
+	{
+		s_IsInitialized = true;
+	}
+
+	void Log::Message(std::string message, ...)
+	{
+		va_list arguments;
+		va_start(arguments, message);
+		Output(false, LogVerbosity::Debug, message.c_str(), arguments);
+		va_end(arguments);
+	}
+
+	void Log::Message(LogVerbosity verbosity, std::string message, ...)
+	{
+		va_list arguments;
+		va_start(arguments, message);
+		Output(false, verbosity, message.c_str(), arguments);
+		va_end(arguments);
+	}
+
+	void Log::Error(bool throwException, LogVerbosity /*verbosity*/, std::string message, ...)
+	{
+		char buffer[8192];
+		va_list arguments;
+		va_start(arguments, message);
+		vsnprintf(buffer, sizeof(buffer), message.c_str(), arguments);
+		va_end(arguments);
+
+		fprintf(stderr, "%s\n", buffer);
+		if (throwException)
+		{
+			throw std::runtime_error(buffer);
+		}
+	}
+
+	//The benchmarks print their own results, only errors are written out
+	void Log::Output(bool error, LogVerbosity /*verbosity*/, const char* output, va_list arguments)
+	{
+		if (error)
+		{
+			vfprintf(stderr, output, arguments);
+			fprintf(stderr, "\n");
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+//Stand-in for Source/Framework/GameDev2D.h used by the benchmarks that draw with the real BatchRenderer. Unlike
+//Stubs/GameDev2D.h the renderers, sprites and text are the real ones, only the Application and ResourceManager are
+//replaced: there's no window, the Graphics draws with whichever backend the benchmark gives it (RecordingBackend,
+//SoftwareBackend) and the shaders are read from SHADER_DIRECTORY.
+
+#include "../Window.h"
+#include "Debug/Log.h"
+#include "Graphics/BatchRenderer.h"
+#include "Graphics/Camera.h"
+#include "Graphics/Color.h"
+#include "Graphics/ColorList.h"
+#include "Graphics/Font.h"
+#include "Graphics/Graphics.h"
+#include "Graphics/GraphicTypes.h"
+#include "Graphics/IGraphicsBackend.h"
+#include "Graphics/Shader.h"
+#include "Graphics/Sprite.h"
+#include "Graphics/SpriteFont.h"
+#include "Graphics/Texture.h"
+#include "Input/Keyboard.h"
+#include "Input/Mouse.h"
+#include "Math/BatchMath.h"
+#include "Math/Math.h"
+#include "Math/SpatialHash.h"
+#include "Math/Vector2.h"
+#include "Memory/DensePool.h"
+#include "Resources/Resource.h"
+#include "Resources/ResourceCache.h"
+#include "Utils/ThreadPool/ThreadPool.h"
+#include <algorithm>
+#include <math.h>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+	//The caches the renderers, sprites and text use. Only shaders are loaded, every texture and font is the default one:
+	//a white texture, and a font without any glyphs
+	class ResourceManager
+	{
+	public:
+		ResourceManager(Graphics& graphics);
+		~ResourceManager() = default;
+
+		ResourceCache<Texture>& GetTextureCache();
+		ResourceCache<Shader>& GetShaderCache();
+		ResourceCache<Font>& GetFontCache();
+
+	private:
+		static void LoadTexture(const Resource& resource, Ref<Texture>& texture);
+		static void LoadShader(const Resource& resource, Ref<Shader>& shader);
+		static void LoadFont(const Resource& resource, Ref<Font>& font);
+
+		ResourceCache<Texture> m_TextureCache;
+		ResourceCache<Shader> m_ShaderCache;
+		ResourceCache<Font> m_FontCache;
+	};
+
+	//An Application without a window, input or game loop. The benchmark owns the loop: it calls NewFrame(), renders
+	//with GetBatchRenderer() and then reads the backend's results
+	class Application
+	{
+	public:
+		//The screen size is set to width by height, and the Graphics draws into a width by height viewport with backend
+		Application(std::unique_ptr<IGraphicsBackend> backend, unsigned int width, unsigned int height);
+		~Application();
+
+		static Application& Get();
+
+		Graphics& GetGraphics();
+		ResourceManager& GetResourceManager();
+		BatchRenderer& GetBatchRenderer();
+
+		//Starts a frame the same way the Application does when it draws without a render thread
+		void NewFrame();
+
+	private:
+		static Application* s_Instance;
+
+		std::unique_ptr<Graphics> m_Graphics;
+		std::unique_ptr<ResourceManager> m_ResourceManager;
+		std::unique_ptr<BatchRenderer> m_BatchRenderer;
+	};
+}
@@ -0,0 +1,59 @@
+#include "Window.h"
+#include <chrono>
+#include <unordered_map>
+
+
+namespace GameDev2D
+{
+	static unsigned int s_ScreenWidth = 1280;
+	static unsigned int s_ScreenHeight = 720;
+	static std::unordered_map<int, bool> s_KeyStates;
+
+	double GameLoop::Now()
+	{
+		static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void SetScreenSize(unsigned int width, unsigned int height)
+	{
+		s_ScreenWidth = width;
+		s_ScreenHeight = height;
+	}
+
+	void SetKeyDown(KeyCode key, bool isDown)
+	{
+		s_KeyStates[static_cast<int>(key)] = isDown;
+	}
+
+	unsigned int GetScreenWidth()
+	{
+		return s_ScreenWidth;
+	}
+
+	unsigned int GetScreenHeight()
+	{
+		return s_ScreenHeight;
+	}
+
+	unsigned int GetHalfScreenWidth()
+	{
+		return s_ScreenWidth / 2;
+	}
+
+	unsigned int GetHalfScreenHeight()
+	{
+		return s_ScreenHeight / 2;
+	}
+
+	bool IsKeyUp(KeyCode key)
+	{
+		return !IsKeyDown(key);
+	}
+
+	bool IsKeyDown(KeyCode key)
+	{
+		auto it = s_KeyStates.find(static_cast<int>(key));
+		return it != s_KeyStates.end() && it->second;
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+//The window, keyboard and clock the game code reads, shared by Stubs/GameDev2D.h and Stubs/Renderer/GameDev2D.h.
+//There's no window, the benchmark sets the screen size and which keys are down
+
+#include "Input/Keyboard.h"
+
+
+namespace GameDev2D
+{
+	//Only Now() is used by the game code
+	class GameLoop
+	{
+	public:
+		static double Now();
+	};
+
+	//The screen size and key states are set by the benchmark
+	void SetScreenSize(unsigned int width, unsigned int height);
+	void SetKeyDown(KeyCode key, bool isDown);
+
+	unsigned int GetScreenWidth();
+	unsigned int GetScreenHeight();
+	unsigned int GetHalfScreenWidth();
+	unsigned int GetHalfScreenHeight();
+
+	bool IsKeyUp(KeyCode key);
+	bool IsKeyDown(KeyCode key);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+//Stand-in for Source/Framework/Platform/Windows/stdafx.h, the framework sources expect the standard headers
+//from the precompiled header to already be included
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <memory>
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
@@ -0,0 +1,229 @@
+#include "AsteroidField.h"
+#include "Constants.h"
+
+namespace GameDev2D
+{
+	AsteroidField::AsteroidField(unsigned int capacity) :
+		m_Positions{},
+		m_PreviousPositions{},
+		m_Velocities{},
+		m_AngularVelocities{},
+		m_Radians{},
+		m_PreviousRadians{},
+		m_Radii{},
+		m_Active{},
+		m_Shapes{},
+		m_Points{},
+		m_PointOffsets{},
+		m_PointCounts{},
+		m_ShapeIds{},
+		m_Capacity(capacity),
+		m_NumberOfActive(0)
+	{
+		m_Positions.reserve(capacity);
+		m_PreviousPositions.reserve(capacity);
+		m_Velocities.reserve(capacity);
+		m_AngularVelocities.reserve(capacity);
+		m_Radians.reserve(capacity);
+		m_PreviousRadians.reserve(capacity);
+		m_Radii.reserve(capacity);
+		m_Active.reserve(capacity);
+		m_Shapes.reserve(capacity);
+
+		//every outline has at most MAX_NUM_OF_SIDES points plus the closing point
+		m_Points.reserve(NUM_OF_ASTEROID_SHAPES * (MAX_NUM_OF_SIDES + 1));
+		m_PointOffsets.reserve(NUM_OF_ASTEROID_SHAPES);
+		m_PointCounts.reserve(NUM_OF_ASTEROID_SHAPES);
+
+		for (int i = 0; i < NUM_OF_ASTEROID_SHAPES; i++)
+		{
+			CreateShape();
+		}
+	}
+
+	void AsteroidField::OnUpdate(float delta)
+	{
+		const unsigned int count = GetCount();
+		const float screenWidth = (float)GetScreenWidth();
+		const float screenHeight = (float)GetScreenHeight();
+
+		//keep last update's positions and rotations to draw in between updates
+		m_PreviousPositions.assign(m_Positions.begin(), m_Positions.end());
+		m_PreviousRadians.assign(m_Radians.begin(), m_Radians.end());
+
+		//inactive asteroids are moved too, they're never drawn or collided with and skipping them would only add a branch
+		for (unsigned int i = 0; i < count; i++)
+		{
+			//turn, a full turn is taken off both rotations so the interpolation between them doesn't change
+			m_Radians[i] += m_AngularVelocities[i] * delta;
+			if (m_Radians[i] >= MAX_RADIANS)
+			{
+				m_Radians[i] -= MAX_RADIANS;
+				m_PreviousRadians[i] -= MAX_RADIANS;
+			}
+
+			//Move
+			Vector2& position = m_Positions[i];
+			position += m_Velocities[i] * delta;
+
+			//used for wrapping the asteroids across the screen
+			if (position.x >= screenWidth)
+			{
+				position.x -= screenWidth;
+			}
+			if (position.x < 0)
+			{
+				position.x += screenWidth;
+			}
+			if (position.y > screenHeight)
+			{
+				position.y -= screenHeight;
+			}
+			if (position.y < 0)
+			{
+				position.y += screenHeight;
+			}
+		}
+	}
+
+	void AsteroidField::OnRender(BatchRenderer& batchRenderer, float alpha)
+	{
+		//upload the outlines once, after that only the position and rotation of each asteroid is sent
+		if (m_ShapeIds.empty())
+		{
+			for (size_t i = 0; i < m_PointOffsets.size(); i++)
+			{
+				m_ShapeIds.push_back(batchRenderer.RegisterLineShape(&m_Points[m_PointOffsets[i]], m_PointCounts[i]));
+			}
+		}
+
+		//the items only read the field, so they can be recorded on any thread
+		const Vector2 screenSize((float)GetScreenWidth(), (float)GetScreenHeight());
+		batchRenderer.RecordItems(GetCount(), [&](auto& renderer, unsigned int i)
+		{
+			if (m_Active[i])
+			{
+				Vector2 position = Math::InterpolateWrapped(m_PreviousPositions[i], m_Positions[i], alpha, screenSize);
+				float radians = m_PreviousRadians[i] + (m_Radians[i] - m_PreviousRadians[i]) * alpha;
+				renderer.RenderLineShape(m_ShapeIds[m_Shapes[i]], ColorList::White, 2.0f, position, radians);
+			}
+		});
+	}
+
+	bool AsteroidField::Spawn()
+	{
+		if (GetCount() >= m_Capacity)
+		{
+			return false;
+		}
+
+		float radians = Math::RandomFloat(0.0f, MAX_RADIANS);
+
+		//this spawns the asteroid on either the left side or the bottom of the screen
+		Vector2 position = Vector2::Zero;
+		int whereSpawn = Math::RandomInt(0, 1);
+		if (whereSpawn == 0)
+		{
+			position.x = Math::RandomFloat(0.0f, (float)GetScreenWidth());
+		}
+		else
+		{
+			position.y = Math::RandomFloat(0.0f, (float)GetScreenHeight());
+		}
+
+		//Initialize liniar velocity
+		float angleRadians = Math::RandomFloat(0, (float)M_PI * 2);
+		Vector2 direction = Vector2(cos(angleRadians), sin(angleRadians));
+
+		m_Positions.push_back(position);
+		m_PreviousPositions.push_back(position);
+		m_Velocities.push_back(direction * Math::RandomFloat(MIN_SPEED_A, MAX_SPEED_A));
+		m_AngularVelocities.push_back(Math::DegreesToRadians(Math::RandomFloat(MIN_A_SPEED_A, MAX_A_SPEED_A)));
+		m_Radians.push_back(radians);
+		m_PreviousRadians.push_back(radians);
+		m_Radii.push_back(MAX_RADIUS);
+		m_Active.push_back(1);
+		m_Shapes.push_back((unsigned int)Math::RandomInt(0, NUM_OF_ASTEROID_SHAPES - 1));
+		m_NumberOfActive++;
+
+		return true;
+	}
+
+	void AsteroidField::CreateShape()
+	{
+		//random numbers of sides, the points are appended to the shared pool
+		int numSides = Math::RandomInt(MIN_NUM_OF_SIDES, MAX_NUM_OF_SIDES);
+		float radiansPerSide = 2.0f * (float)M_PI / (float)numSides;
+		unsigned int offset = (unsigned int)m_Points.size();
+
+		for (int i = 0; i < numSides; i++)
+		{
+			//random radius for each point
+			float radius = Math::RandomFloat(MIN_RADIUS, MAX_RADIUS);
+
+			//creates the point
+			float angle = i * radiansPerSide;
+			m_Points.push_back(Vector2(cos(angle), sin(angle)) * radius);
+		}
+
+		//Add one last point to connect back to the first point to create the connected asteroid
+		m_Points.push_back(m_Points[offset]);
+
+		m_PointOffsets.push_back(offset);
+		m_PointCounts.push_back(numSides + 1);
+	}
+
+	void AsteroidField::Colided(unsigned int index)
+	{
+		if (m_Active[index])
+		{
+			m_Active[index] = 0;
+			m_NumberOfActive--;
+		}
+	}
+
+	unsigned int AsteroidField::GetCount() const
+	{
+		return (unsigned int)m_Positions.size();
+	}
+
+	unsigned int AsteroidField::GetCapacity() const
+	{
+		return m_Capacity;
+	}
+
+	unsigned int AsteroidField::GetNumberOfActive() const
+	{
+		return m_NumberOfActive;
+	}
+
+	bool AsteroidField::IsActive(unsigned int index) const
+	{
+		return m_Active[index] != 0;
+	}
+
+	const Vector2& AsteroidField::getPosition(unsigned int index) const
+	{
+		return m_Positions[index];
+	}
+
+	float AsteroidField::getRadius(unsigned int index) const
+	{
+		return m_Radii[index];
+	}
+
+	const Vector2* AsteroidField::GetPositions() const
+	{
+		return m_Positions.data();
+	}
+
+	const float* AsteroidField::GetRadii() const
+	{
+		return m_Radii.data();
+	}
+
+	const unsigned char* AsteroidField::GetActiveFlags() const
+	{
+		return m_Active.data();
+	}
+}
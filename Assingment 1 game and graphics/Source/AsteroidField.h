@@ -0,0 +1,61 @@
+#pragma once
+
+#include <GameDev2D.h>
+
+namespace GameDev2D
+{
+	//Holds every asteroid in parallel arrays (one array per field) instead of one object per asteroid,
+	//each asteroid uses one of a small set of outlines that are uploaded once and drawn as instances
+	class AsteroidField
+	{
+	public:
+		AsteroidField(unsigned int capacity);
+
+		void OnUpdate(float delta);
+		//A large field is recorded in parallel when the BatchRenderer has parallel recording enabled, see RecordItems()
+		void OnRender(BatchRenderer& batchRenderer, float alpha);
+
+		//Adds an asteroid with a random outline on the left or bottom edge of the screen, returns false if the field is full
+		bool Spawn();
+
+		void Colided(unsigned int index);
+
+		unsigned int GetCount() const;
+		unsigned int GetCapacity() const;
+		unsigned int GetNumberOfActive() const;
+
+		bool IsActive(unsigned int index) const;
+		const Vector2& getPosition(unsigned int index) const;
+		float getRadius(unsigned int index) const;
+
+		//Direct access to the arrays, for loops that go over every asteroid
+		const Vector2* GetPositions() const;
+		const float* GetRadii() const;
+		const unsigned char* GetActiveFlags() const;
+
+	private:
+		//Appends a random outline to the shape pool
+		void CreateShape();
+
+		std::vector<Vector2> m_Positions;
+		std::vector<Vector2> m_PreviousPositions;
+		std::vector<Vector2> m_Velocities;
+		std::vector<float> m_AngularVelocities;
+		std::vector<float> m_Radians;
+		std::vector<float> m_PreviousRadians;
+		std::vector<float> m_Radii;
+		std::vector<unsigned char> m_Active;
+		std::vector<unsigned int> m_Shapes;
+
+		//Outline of shape i is m_Points[m_PointOffsets[i]] to m_Points[m_PointOffsets[i] + m_PointCounts[i] - 1]
+		std::vector<Vector2> m_Points;
+		std::vector<unsigned int> m_PointOffsets;
+		std::vector<unsigned int> m_PointCounts;
+
+		//The renderer's id for each shape, filled in the first time the field is rendered
+		std::vector<unsigned int> m_ShapeIds;
+
+		unsigned int m_Capacity;
+		unsigned int m_NumberOfActive;
+	};
+}
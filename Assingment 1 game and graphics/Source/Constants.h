@@ -22,10 +22,17 @@ const float MIN_A_SPEED_A = 50.0f;
 const int NUM_OF_ASTEROIDS = 20;//for the vector holding the objects
 const int MIN_NUM_OF_SIDES = 7;//  for the number of sides each asteroid can have
 const int MAX_NUM_OF_SIDES = 17;//^
+const int NUM_OF_ASTEROID_SHAPES = 16;//outlines shared by all the asteroids, each one is uploaded to the GPU once
 const float MIN_RADIUS = 15.0f;//for how far away from center each point is
 const float MAX_RADIUS = 27.0f;//^
 
 
+//collision broadphase, should be at least as big as the largest asteroid
+const float COLLISION_CELL_SIZE = 64.0f;
+//below this many asteroids in a ship's or laser's cells they're tested one by one instead of gathered for BatchMath,
+//MathBenchmark's narrow phase table shows where gathering starts to pay off
+const unsigned int COLLISION_MIN_BATCH_CANDIDATES = 4;
+
 const float LASER_SPEED = 600.0f;
 const int LASER_POOL_SIZE = 20;
 const int SHEILD_POOL_SIZE = 10;
@@ -2,6 +2,9 @@
 #include "Config.h"
 #include "../Debug/Log.h"
 #include "../Graphics/BatchRenderer.h"
+#include "../Graphics/OpenGLBackend.h"
+#include "../Graphics/RecordingBackend.h"
+#include "../Graphics/SoftwareBackend.h"
 
 
 namespace GameDev2D
@@ -30,12 +33,15 @@ namespace GameDev2D
         m_FileSystem(),
         m_HardwareInfo(),
         m_BatchRenderer(nullptr),
+        m_RenderThread(nullptr),
         m_State(State::Splash),
         m_SplashElapsed(0.0),
         m_FadeElapsed(0.0),
         m_FadeAlpha(0.0f),
         m_IsSuspended(false),
-        m_IsRunning(true)
+        m_IsRunning(true),
+        m_IsRenderThreadEnabled(false),
+        m_RenderQueueDepth(1)
     {
         //Set the static instance variable
         s_Instance = this;
@@ -47,16 +53,40 @@ namespace GameDev2D
         //Create the Game window
         m_GameWindow = std::make_unique<GameWindow>(this, config);
 
-        //Create the Graphics instance
-        m_Graphics = std::make_unique<Graphics>();
+        //Create the Graphics instance, the recording backend logs the calls instead of drawing anything and the
+        //software backend draws on the CPU
+        std::unique_ptr<IGraphicsBackend> backend;
+        if (config.renderer.backend == "recording")
+            backend = std::make_unique<RecordingBackend>();
+        else if (config.renderer.backend == "software")
+            backend = std::make_unique<SoftwareBackend>(m_GameWindow->GetWidth(), m_GameWindow->GetHeight(), config.renderer.softwareThreads);
+        else
+            backend = std::make_unique<OpenGLBackend>();
+        m_Graphics = std::make_unique<Graphics>(std::move(backend), m_GameWindow->GetWidth(), m_GameWindow->GetHeight());
         m_Graphics->SetClearColor(config.renderer.clearColor);
 
+        //The Cameras don't know about the Application, it updates and resizes all of them
+        UpdateSlot.connect<&Camera::UpdateCameras>();
+        WindowResizedSlot.connect<&Camera::ResizeCameras>();
+
         //Create the rest of the Application's services
-        m_GameLoop = std::make_unique<GameLoop>(this);
+        m_GameLoop = std::make_unique<GameLoop>(this, config.simulation);
         m_InputManager = std::make_unique<InputManager>();
         m_AudioEngine = std::make_unique<AudioEngine>();
-        m_ResourceManager = std::make_unique<ResourceManager>(config.resources.autoLoad);
-        m_BatchRenderer = std::make_unique<BatchRenderer>(config.debug.drawSpriteOutline);
+        m_ResourceManager = std::make_unique<ResourceManager>(config.resources.autoLoad, config.resources.textureArrays);
+        m_BatchRenderer = std::make_unique<BatchRenderer>(*m_Graphics, m_ResourceManager->GetShaderCache(), config.debug.drawSpriteOutline);
+        m_BatchRenderer->SetRenderOrder(config.renderer.deferred ? RenderOrder::Deferred : RenderOrder::Strict);
+        m_BatchRenderer->SetSpriteSubmission(config.renderer.instancedSprites ? SpriteSubmission::Instanced : SpriteSubmission::PerVertex);
+        m_BatchRenderer->EnableCulling(config.renderer.culling);
+        m_BatchRenderer->EnableParallelRecording(config.renderer.parallelRecording);
+        if (config.renderer.minParallelRecording > 0)
+            m_BatchRenderer->SetMinParallelRecording(config.renderer.minParallelRecording);
+
+        //The software backend can't run geometry shaders, it expands the lines on the CPU unless they're instanced
+        if (config.renderer.lineExpansion == "instanced")
+            m_BatchRenderer->SetLineExpansion(LineExpansion::Instanced);
+        else if (config.renderer.lineExpansion == "cpu" || config.renderer.backend == "software")
+            m_BatchRenderer->SetLineExpansion(LineExpansion::Cpu);
         m_DebugUI = std::make_unique<DebugUI>();
 
         if (config.debug.drawFps)
@@ -70,6 +100,18 @@ namespace GameDev2D
             m_DebugUI->UnsignedLongLongSlot.connect<&BatchRenderer::GetTotalDrawCalls>(m_BatchRenderer);
         if (config.debug.drawFrameDrawCalls)
             m_DebugUI->UnsignedLongLongSlot.connect<&BatchRenderer::GetLastFrameDrawCalls>(m_BatchRenderer);
+        if (config.debug.drawLineAllocations)
+            m_DebugUI->UnsignedLongLongSlot.connect<&BatchRenderer::GetLastFrameLineAllocations>(m_BatchRenderer);
+        if (config.debug.drawStateChanges)
+        {
+            m_DebugUI->UnsignedLongLongSlot.connect<&Graphics::GetLastFrameIssuedStateChanges>(m_Graphics);
+            m_DebugUI->UnsignedLongLongSlot.connect<&Graphics::GetLastFrameElidedStateChanges>(m_Graphics);
+        }
+        if (config.debug.drawCulledItems)
+        {
+            m_DebugUI->UnsignedLongLongSlot.connect<&BatchRenderer::GetLastFrameSubmittedItems>(m_BatchRenderer);
+            m_DebugUI->UnsignedLongLongSlot.connect<&BatchRenderer::GetLastFrameCulledItems>(m_BatchRenderer);
+        }
         if (config.debug.drawCameraPosition)
             m_DebugUI->Vector2Slot.connect<&Camera::GetPosition>(m_Graphics->GetMainCamera());
 #endif
@@ -100,6 +142,12 @@ namespace GameDev2D
 
         //Log the platform details (CPU, RAM, GPU and hardware info)
         m_HardwareInfo.Log();
+
+        //Resources are loaded on the main thread, which can't use the graphics API once the render thread has started
+        m_IsRenderThreadEnabled = config.renderer.renderThread && config.resources.autoLoad;
+        m_RenderQueueDepth = config.renderer.renderQueueDepth > 0 ? config.renderer.renderQueueDepth : 1;
+        if (config.renderer.renderThread && config.resources.autoLoad == false)
+            Log::Message(LogVerbosity::Application, "[Application] the render thread needs resources to be auto loaded, drawing on the main thread instead");
     }
 
     Application& Application::Get()
@@ -149,6 +197,13 @@ namespace GameDev2D
 
     void Application::Run()
     {
+        //The render thread takes the graphics context over from the main thread until the loop ends
+        if (m_IsRenderThreadEnabled)
+        {
+            m_RenderThread = std::make_unique<RenderThread>(*m_GameWindow, *m_Graphics, *m_BatchRenderer, m_RenderQueueDepth);
+            Log::Message(LogVerbosity::Application, "[Application] drawing on a render thread, up to %u frames queued", m_RenderQueueDepth);
+        }
+
         do
         {
             m_GameWindow->PollEvents();
@@ -158,6 +213,25 @@ namespace GameDev2D
                 m_GameLoop->Step();
             }
         } while (m_IsRunning);
+
+        m_RenderThread.reset();
+
+        RecordingBackend* recordingBackend = dynamic_cast<RecordingBackend*>(&m_Graphics->GetBackend());
+        if (recordingBackend != nullptr)
+        {
+            const GraphicsCounters& total = recordingBackend->GetTotalCounters();
+            const GraphicsCounters& lastFrame = recordingBackend->GetLastFrameCounters();
+            Log::Message(LogVerbosity::Profiling, "[Application] recorded %llu graphics calls, %llu draw calls, %llu vertices", total.calls, total.drawCalls, total.vertices);
+            Log::Message(LogVerbosity::Profiling, "[Application] uploaded %llu buffer bytes, %llu texture bytes, %llu uniform bytes", total.bufferBytes, total.textureBytes, total.uniformBytes);
+            Log::Message(LogVerbosity::Profiling, "[Application] last frame: %llu graphics calls, %llu draw calls, %llu buffer bytes", lastFrame.calls, lastFrame.drawCalls, lastFrame.bufferBytes);
+        }
+
+        SoftwareBackend* softwareBackend = dynamic_cast<SoftwareBackend*>(&m_Graphics->GetBackend());
+        if (softwareBackend != nullptr)
+        {
+            const SoftwareRasterizer& rasterizer = softwareBackend->GetRasterizer();
+            Log::Message(LogVerbosity::Profiling, "[Application] rasterized %llu of %llu triangles on %u threads, skipped %llu draw calls", rasterizer.GetTotalBinnedTriangles(), rasterizer.GetTotalTriangles(), rasterizer.GetNumberOfThreads(), softwareBackend->GetSkippedDrawCalls());
+        }
     }
 
     void Application::OnUpdate(float delta)
@@ -200,53 +274,76 @@ namespace GameDev2D
         }
     }
 
-    void Application::OnDraw()
+    void Application::OnDraw(float alpha)
     {
         if (m_IsRunning == true && (m_State == State::Game || m_State == State::FadeOut || m_State == State::FadeIn))
         {
+            //The render thread clears, draws and swaps the recorded frame while the next one is updated. Nothing is
+            //recorded while suspended, the Render calls can't be made here since this thread can't use the graphics API
+            if (m_RenderThread != nullptr)
+            {
+                if (m_IsSuspended == true)
+                {
+                    return;
+                }
+
+                m_BatchRenderer->NewRecordingFrame();
+                m_BatchRenderer->BeginRecording(m_RenderThread->BeginFrame());
+                RenderScenes(alpha);
+                m_BatchRenderer->EndRecording();
+                m_RenderThread->SubmitFrame();
+                return;
+            }
+
             if (m_IsSuspended == false)
             {
                 m_BatchRenderer->NewFrame();
+                m_Graphics->NewFrame();
                 m_Graphics->Clear();
             }
 
-            if (m_State == State::Game || m_State == State::FadeIn)
-            {
-                m_RenderSignal.publish(*m_BatchRenderer);
-                m_LateRenderSignal.publish(*m_BatchRenderer);
+            RenderScenes(alpha);
 
-                if (m_State == State::FadeIn)
+            if (m_IsSuspended == false)
+            {
+                if (m_GameWindow != nullptr)
                 {
-                    Color color = ColorList::Black;
-                    color.a = m_FadeAlpha;
-
-                    m_BatchRenderer->BeginScene();
-                    m_BatchRenderer->RenderQuad(Vector2::Zero, Vector2(static_cast<float>(m_GameWindow->GetWidth()), static_cast<float>(m_GameWindow->GetHeight())), color);
-                    m_BatchRenderer->EndScene();
+                    m_GameWindow->SwapDrawBuffer();
                 }
             }
-            else if (m_State == State::FadeOut)
-            {
-                float windowWidth = static_cast<float>(m_GameWindow->GetWidth());
-                float windowHeight = static_cast<float>(m_GameWindow->GetHeight());
+        }
+    }
 
+    void Application::RenderScenes(float alpha)
+    {
+        if (m_State == State::Game || m_State == State::FadeIn)
+        {
+            m_RenderSignal.publish(*m_BatchRenderer, alpha);
+            m_LateRenderSignal.publish(*m_BatchRenderer);
+
+            if (m_State == State::FadeIn)
+            {
                 Color color = ColorList::Black;
                 color.a = m_FadeAlpha;
 
                 m_BatchRenderer->BeginScene();
-                m_BatchRenderer->RenderQuad(Vector2::Zero, Vector2(windowWidth, windowHeight), kSplashBackgroundColor);
-                m_BatchRenderer->RenderSprite(m_SplashLogo.get());
-                m_BatchRenderer->RenderQuad(Vector2::Zero, Vector2(windowWidth, windowHeight), color);
+                m_BatchRenderer->RenderQuad(Vector2::Zero, Vector2(static_cast<float>(m_GameWindow->GetWidth()), static_cast<float>(m_GameWindow->GetHeight())), color);
                 m_BatchRenderer->EndScene();
             }
+        }
+        else if (m_State == State::FadeOut)
+        {
+            float windowWidth = static_cast<float>(m_GameWindow->GetWidth());
+            float windowHeight = static_cast<float>(m_GameWindow->GetHeight());
 
-            if (m_IsSuspended == false)
-            {
-                if (m_GameWindow != nullptr)
-                {
-                    m_GameWindow->SwapDrawBuffer();
-                }
-            }
+            Color color = ColorList::Black;
+            color.a = m_FadeAlpha;
+
+            m_BatchRenderer->BeginScene();
+            m_BatchRenderer->RenderQuad(Vector2::Zero, Vector2(windowWidth, windowHeight), kSplashBackgroundColor);
+            m_BatchRenderer->RenderSprite(m_SplashLogo.get());
+            m_BatchRenderer->RenderQuad(Vector2::Zero, Vector2(windowWidth, windowHeight), color);
+            m_BatchRenderer->EndScene();
         }
     }
 
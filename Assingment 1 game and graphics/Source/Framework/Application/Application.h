@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GameLoop.h"
+#include "RenderThread.h"
 #include "../Platform/GameWindow.h"
 #include "../Platform/Windows/FileSystem.h"
 #include "../Platform/Windows/HardwareInfo.h"
@@ -28,7 +29,7 @@ namespace GameDev2D
         ~Application() = default;
 
         entt::sink<void(float)> UpdateSlot;
-        entt::sink<void(BatchRenderer&)> RenderSlot;
+        entt::sink<void(BatchRenderer&, float)> RenderSlot;
         entt::sink<void(BatchRenderer&)> LateRenderSlot;
         entt::sink<void(unsigned int, unsigned int)> WindowResizedSlot;
         entt::sink<void(bool)> WindowFocusChangedSlot;
@@ -58,7 +59,10 @@ namespace GameDev2D
 
         //GameLoopCallback methods
         void OnUpdate(float delta) override;
-        void OnDraw() override;
+        void OnDraw(float alpha) override;
+
+        //Renders the splash, fade and game scenes, either drawing them or recording them for the render thread
+        void RenderScenes(float alpha);
 
         //GameWindowCallback methods
         void OnWindowResized(unsigned int, unsigned int) override;
@@ -69,7 +73,7 @@ namespace GameDev2D
         std::function<void()> m_ShutdownCallback;
 
         entt::sigh<void(float)> m_UpdateSignal;
-        entt::sigh<void(BatchRenderer&)> m_RenderSignal;
+        entt::sigh<void(BatchRenderer&, float)> m_RenderSignal;
         entt::sigh<void(BatchRenderer&)> m_LateRenderSignal;
         entt::sigh<void(unsigned int, unsigned int)> m_WindowResizedSignal;
         entt::sigh<void(bool)> m_WindowFocusChangedSignal;
@@ -92,6 +96,7 @@ namespace GameDev2D
         std::unique_ptr<InputManager> m_InputManager;
         std::unique_ptr<DebugUI> m_DebugUI;
         std::unique_ptr<BatchRenderer> m_BatchRenderer;
+        std::unique_ptr<RenderThread> m_RenderThread;
         FileSystem m_FileSystem;
         HardwareInfo m_HardwareInfo;
         State m_State;
@@ -101,6 +106,8 @@ namespace GameDev2D
         float m_FadeAlpha;
         bool m_IsSuspended;
         bool m_IsRunning;
+        bool m_IsRenderThreadEnabled;
+        unsigned int m_RenderQueueDepth;
 
         static const Color kSplashBackgroundColor;
         static const double kSplashDuration;
@@ -11,6 +11,7 @@ namespace GameDev2D
 		window(),
 		renderer(),
 		resources(),
+		simulation(),
 		debug()
 	{}
 
@@ -40,9 +41,25 @@ namespace GameDev2D
 				const Json::Value rendererValue = root["renderer"];
 				std::string hexString = rendererValue["clearColor"].asString();
 				renderer.clearColor = strtoul(hexString.c_str(), nullptr, 16);
+				renderer.deferred = rendererValue["deferred"].asBool();
+				renderer.instancedSprites = rendererValue["instancedSprites"].asBool();
+				renderer.culling = rendererValue["culling"].asBool();
+				renderer.lineExpansion = rendererValue["lineExpansion"].asString();
+				renderer.backend = rendererValue["backend"].asString();
+				renderer.softwareThreads = rendererValue["softwareThreads"].asUInt();
+				renderer.renderThread = rendererValue["renderThread"].asBool();
+				renderer.renderQueueDepth = rendererValue["renderQueueDepth"].asUInt();
+				renderer.parallelRecording = rendererValue["parallelRecording"].asBool();
+				renderer.minParallelRecording = rendererValue["minParallelRecording"].asUInt();
 
 				const Json::Value resourcesValue = root["resources"];
 				resources.autoLoad = resourcesValue["autoLoad"].asBool();
+				resources.textureArrays = resourcesValue["textureArrays"].asBool();
+
+				const Json::Value simulationValue = root["simulation"];
+				simulation.fixedTimestep = simulationValue["fixedTimestep"].asBool();
+				simulation.tickRate = simulationValue["tickRate"].asUInt();
+				simulation.maxStepsPerFrame = simulationValue["maxStepsPerFrame"].asUInt();
 
 				const Json::Value debugValue = root["debug"];
 				debug.drawFps = debugValue["drawFps"].asBool();
@@ -50,6 +67,9 @@ namespace GameDev2D
 				debug.drawDelta = debugValue["drawDelta"].asBool();
 				debug.drawTotalDrawCalls = debugValue["drawTotalDrawCalls"].asBool();
 				debug.drawFrameDrawCalls = debugValue["drawFrameDrawCalls"].asBool();
+				debug.drawLineAllocations = debugValue["drawLineAllocations"].asBool();
+				debug.drawStateChanges = debugValue["drawStateChanges"].asBool();
+				debug.drawCulledItems = debugValue["drawCulledItems"].asBool();
 				debug.drawCameraPosition = debugValue["drawCameraPosition"].asBool();	
 				debug.drawSpriteOutline = debugValue["drawSpriteOutline"].asBool();
 			}
@@ -71,11 +91,28 @@ namespace GameDev2D
 	{}
 
 	Config::Renderer::Renderer() :
-		clearColor(0x000000ff)
+		clearColor(0x000000ff),
+		deferred(false),
+		instancedSprites(false),
+		culling(false),
+		lineExpansion("geometryShader"),
+		backend("openGL"),
+		softwareThreads(0),
+		renderThread(false),
+		renderQueueDepth(1),
+		parallelRecording(false),
+		minParallelRecording(2000)
 	{}
 
 	Config::Resources::Resources() :
-		autoLoad(false)
+		autoLoad(false),
+		textureArrays(false)
+	{}
+
+	Config::Simulation::Simulation() :
+		fixedTimestep(false),
+		tickRate(60),
+		maxStepsPerFrame(5)
 	{}
 
 	Config::Debug::Debug() :
@@ -84,6 +121,9 @@ namespace GameDev2D
 		drawDelta(false),
 		drawTotalDrawCalls(false),
 		drawFrameDrawCalls(false),
+		drawLineAllocations(false),
+		drawStateChanges(false),
+		drawCulledItems(false),
 		drawCameraPosition(false),
 		drawSpriteOutline(false)
 	{}
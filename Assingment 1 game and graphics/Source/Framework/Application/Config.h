@@ -34,6 +34,16 @@ namespace GameDev2D
 			Renderer();
 
 			unsigned int clearColor;
+			bool deferred;
+			bool instancedSprites;
+			bool culling;
+			std::string lineExpansion;
+			std::string backend;
+			unsigned int softwareThreads;
+			bool renderThread;
+			unsigned int renderQueueDepth;
+			bool parallelRecording;
+			unsigned int minParallelRecording;
 		};
 
 		struct Resources
@@ -41,6 +51,16 @@ namespace GameDev2D
 			Resources();
 
 			bool autoLoad;
+			bool textureArrays;
+		};
+
+		struct Simulation
+		{
+			Simulation();
+
+			bool fixedTimestep;
+			unsigned int tickRate;
+			unsigned int maxStepsPerFrame;
 		};
 
 		struct Debug
@@ -52,6 +72,9 @@ namespace GameDev2D
 			bool drawDelta;
 			bool drawTotalDrawCalls;
 			bool drawFrameDrawCalls;
+			bool drawLineAllocations;
+			bool drawStateChanges;
+			bool drawCulledItems;
 			bool drawCameraPosition;
 			bool drawSpriteOutline;
 		};
@@ -60,6 +83,7 @@ namespace GameDev2D
 		Window window;
 		Renderer renderer;
 		Resources resources;
+		Simulation simulation;
 		Debug debug;
 	};
 }
\ No newline at end of file
@@ -1,14 +1,20 @@
 #include "GameLoop.h"
 #include "Application.h"
 #include <GLFW/glfw3.h>
+#include <math.h>
 
 
 namespace GameDev2D
 {
-	GameLoop::GameLoop(GameLoopCallback* callback) :
+	GameLoop::GameLoop(GameLoopCallback* callback, const Config::Simulation& simulation) :
 		m_Callback(callback),
 		m_TimeStep(0),
 		m_Stats(),
+		m_FixedDelta(simulation.tickRate > 0 ? 1.0 / static_cast<double>(simulation.tickRate) : 0.0),
+		m_Accumulator(0.0),
+		m_MaxStepsPerFrame(simulation.maxStepsPerFrame > 0 ? simulation.maxStepsPerFrame : 1),
+		m_InterpolationAlpha(1.0f),
+		m_IsFixedTimestep(simulation.fixedTimestep && simulation.tickRate > 0),
 		m_Frames(0),
 		m_Updates(0),
 		m_UpdateTimer(0),
@@ -27,16 +33,43 @@ namespace GameDev2D
 		double now = Now();
 		m_TimeStep.Update(now);
 
-		m_Callback->OnUpdate(static_cast<float>(m_TimeStep.GetDelta()));
-		m_Updates++; 
+		if (m_IsFixedTimestep)
+		{
+			//Run as many fixed updates as the elapsed time allows, the leftover time carries over to the next frame
+			m_Accumulator += m_TimeStep.GetDelta();
+
+			unsigned int steps = 0;
+			while (m_Accumulator >= m_FixedDelta && steps < m_MaxStepsPerFrame)
+			{
+				m_Callback->OnUpdate(static_cast<float>(m_FixedDelta));
+				m_Accumulator -= m_FixedDelta;
+				m_Updates++;
+				steps++;
+			}
+
+			//If the updates can't keep up, drop the time that's left instead of letting it pile up every frame
+			if (m_Accumulator >= m_FixedDelta)
+			{
+				m_Accumulator = fmod(m_Accumulator, m_FixedDelta);
+			}
+
+			m_InterpolationAlpha = static_cast<float>(m_Accumulator / m_FixedDelta);
+		}
+		else
+		{
+			m_Callback->OnUpdate(static_cast<float>(m_TimeStep.GetDelta()));
+			m_Updates++;
+			m_InterpolationAlpha = 1.0f;
+		}
 
-		m_Callback->OnDraw();
+		m_Callback->OnDraw(m_InterpolationAlpha);
 		m_Frames++;
 
 		if (glfwGetTime() - m_SecondTimer > 1.0f)
 		{
 			m_SecondTimer += 1.0f;
 			m_Stats.fps = m_Frames;
+			m_Stats.ups = m_Updates;
 			m_Stats.frameTime = 1000.0f / static_cast<float>(m_Frames);
 			m_Updates = 0;
 			m_Frames = 0;
@@ -58,6 +91,26 @@ namespace GameDev2D
 		return m_Stats.fps;
 	}
 
+	unsigned int GameLoop::GetUPS()
+	{
+		return m_Stats.ups;
+	}
+
+	float GameLoop::GetInterpolationAlpha()
+	{
+		return m_InterpolationAlpha;
+	}
+
+	float GameLoop::GetFixedDelta()
+	{
+		return static_cast<float>(m_FixedDelta);
+	}
+
+	bool GameLoop::IsFixedTimestep()
+	{
+		return m_IsFixedTimestep;
+	}
+
 	double GameLoop::Now()
 	{
 		return glfwGetTime();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TimeStep.h"
+#include "Config.h"
 #include <entt.hpp>
 
 
@@ -11,13 +12,13 @@ namespace GameDev2D
     public:
         virtual ~GameLoopCallback() {}
         virtual void OnUpdate(float delta) = 0;
-        virtual void OnDraw() = 0;
+        virtual void OnDraw(float alpha) = 0;
     };
 
     class GameLoop
     {
     public:
-        GameLoop(GameLoopCallback* callback);
+        GameLoop(GameLoopCallback* callback, const Config::Simulation& simulation);
         ~GameLoop();
 
         void Step();
@@ -26,6 +27,17 @@ namespace GameDev2D
         float GetElapsed();
         unsigned int GetFPS();
 
+        //Returns the number of simulation updates in the last second
+        unsigned int GetUPS();
+
+        //Returns how far (0 to 1) the last drawn frame was between the previous and current update,
+        //always 1 when the loop isn't running with a fixed timestep
+        float GetInterpolationAlpha();
+
+        //Returns the delta passed to every update when running with a fixed timestep
+        float GetFixedDelta();
+        bool IsFixedTimestep();
+
         static double Now();
 
     private:
@@ -33,15 +45,21 @@ namespace GameDev2D
 
         struct Stats
         {
-            Stats() : fps(0), frameTime(0.0f) {}
+            Stats() : fps(0), ups(0), frameTime(0.0f) {}
 
             unsigned int fps;
+            unsigned int ups;
             float frameTime;
         };
 
         GameLoopCallback* m_Callback;
         TimeStep m_TimeStep;
         Stats m_Stats;
+        double m_FixedDelta;
+        double m_Accumulator;
+        unsigned int m_MaxStepsPerFrame;
+        float m_InterpolationAlpha;
+        bool m_IsFixedTimestep;
         uint32_t m_Frames;
         uint32_t m_Updates;
         float m_UpdateTimer;
@@ -0,0 +1,108 @@
+#include "RenderThread.h"
+#include "../Graphics/BatchRenderer.h"
+#include "../Graphics/Graphics.h"
+#include "../Platform/GameWindow.h"
+
+
+namespace GameDev2D
+{
+    RenderThread::RenderThread(GameWindow& aWindow, Graphics& aGraphics, BatchRenderer& aBatchRenderer, unsigned int aQueueDepth) :
+        m_Window(aWindow),
+        m_Graphics(aGraphics),
+        m_BatchRenderer(aBatchRenderer),
+        m_RecordingSnapshot(nullptr),
+        m_IsDrawing(false),
+        m_IsRunning(true)
+    {
+        //One snapshot is being recorded and one drawn, on top of the ones waiting in the queue
+        unsigned int numberOfSnapshots = aQueueDepth + 2;
+        for (unsigned int i = 0; i < numberOfSnapshots; i++)
+        {
+            m_Snapshots.push_back(std::make_unique<FrameSnapshot>());
+            m_FreeSnapshots.push_back(m_Snapshots.back().get());
+        }
+
+        m_BatchRenderer.m_RenderThread = this;
+
+        //The context has to be released before another thread can make it current
+        m_Window.ReleaseContext();
+        m_Thread = std::thread(&RenderThread::RenderLoop, this);
+    }
+
+    RenderThread::~RenderThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IsRunning = false;
+        }
+        m_FrameQueued.notify_all();
+        m_Thread.join();
+
+        m_BatchRenderer.m_RenderThread = nullptr;
+        m_Window.MakeContextCurrent();
+    }
+
+    FrameSnapshot& RenderThread::BeginFrame()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_FrameDrawn.wait(lock, [this] { return m_FreeSnapshots.empty() == false; });
+
+        m_RecordingSnapshot = m_FreeSnapshots.back();
+        m_FreeSnapshots.pop_back();
+        return *m_RecordingSnapshot;
+    }
+
+    void RenderThread::SubmitFrame()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_QueuedSnapshots.push_back(m_RecordingSnapshot);
+            m_RecordingSnapshot = nullptr;
+        }
+        m_FrameQueued.notify_one();
+    }
+
+    void RenderThread::WaitUntilIdle()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_FrameDrawn.wait(lock, [this] { return m_QueuedSnapshots.empty() && m_IsDrawing == false; });
+    }
+
+    void RenderThread::RenderLoop()
+    {
+        m_Window.MakeContextCurrent();
+
+        while (true)
+        {
+            FrameSnapshot* snapshot = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_FrameQueued.wait(lock, [this] { return m_QueuedSnapshots.empty() == false || m_IsRunning == false; });
+
+                //Frames that are still queued when the thread is stopped are dropped
+                if (m_IsRunning == false)
+                    break;
+
+                snapshot = m_QueuedSnapshots.front();
+                m_QueuedSnapshots.pop_front();
+                m_IsDrawing = true;
+            }
+
+            m_BatchRenderer.NewRendererFrame();
+            m_Graphics.NewFrame();
+            m_Graphics.Clear();
+            m_BatchRenderer.DrawSnapshot(*snapshot);
+            m_Window.SwapDrawBuffer();
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_FreeSnapshots.push_back(snapshot);
+                m_IsDrawing = false;
+            }
+            m_FrameDrawn.notify_all();
+        }
+
+        m_Window.ReleaseContext();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    class BatchRenderer;
+    class GameWindow;
+    class Graphics;
+    struct FrameSnapshot;
+
+    //Draws the frames recorded on the main thread, so that the next frame can be updated while the last one is drawn
+    //and swapped. The render thread owns the graphics context for as long as it runs, the main thread can't use the
+    //graphics API until it's destroyed. Only the main thread should call its methods
+    class RenderThread
+    {
+    public:
+        //Takes the graphics context from the calling thread. The queue depth is the number of recorded frames that
+        //can wait to be drawn, recording blocks once that many are waiting, which caps the latency it adds
+        RenderThread(GameWindow& window, Graphics& graphics, BatchRenderer& batchRenderer, unsigned int queueDepth);
+        ~RenderThread();
+
+        //Returns a snapshot to record the next frame into, blocks until one isn't queued or being drawn
+        FrameSnapshot& BeginFrame();
+
+        //Queues the snapshot returned by BeginFrame() to be drawn and swapped
+        void SubmitFrame();
+
+        //Blocks until every submitted frame has been drawn
+        void WaitUntilIdle();
+
+    private:
+        void RenderLoop();
+
+        //Member variables
+        GameWindow& m_Window;
+        Graphics& m_Graphics;
+        BatchRenderer& m_BatchRenderer;
+        std::vector<std::unique_ptr<FrameSnapshot>> m_Snapshots;
+        std::vector<FrameSnapshot*> m_FreeSnapshots;
+        std::deque<FrameSnapshot*> m_QueuedSnapshots;
+        FrameSnapshot* m_RecordingSnapshot;
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_FrameQueued;
+        std::condition_variable m_FrameDrawn;
+        bool m_IsDrawing;
+        bool m_IsRunning;
+    };
+}
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "Graphics/GraphicTypes.h"
 #include "Graphics/LineRenderer.h"
 #include "Graphics/PointRenderer.h"
+#include "Graphics/RenderCommandBuffer.h"
 #include "Graphics/Shader.h"
 #include "Graphics/Sprite.h"
 #include "Graphics/SpriteAtlas.h"
@@ -34,12 +35,16 @@
 #include "Input/Keyboard.h"
 #include "Input/Mouse.h"
 #include "Input/InputManager.h"
+#include "Math/Affine2D.h"
+#include "Math/BatchMath.h"
 #include "Math/LineSegment.h"
 #include "Math/Math.h"
 #include "Math/Matrix.h"
 #include "Math/Random.h"
+#include "Math/SpatialHash.h"
 #include "Math/Transformable.h"
 #include "Math/Vector2.h"
+#include "Memory/DensePool.h"
 #include "Memory/MemoryBlock.h"
 #include "Memory/ObjectPool.h"
 #include "Platform/GameWindow.h"
@@ -51,6 +56,7 @@
 #include "Resources/ResourceManager.h"
 #include "Utils/Png/Png.h"
 #include "Utils/Text/Text.h"
+#include "Utils/ThreadPool/ThreadPool.h"
 #include "Utils/Wave/Wave.h"
 #include "crtdbg.h"
 #include <functional>
@@ -1,53 +1,132 @@
 #include "BatchRenderer.h"
 #include "Camera.h"
+#include "Graphics.h"
 #include "Sprite.h"
 #include "SpriteFont.h"
 #include "Texture.h"
-#include "../Application/Application.h"
-#include "../Resources/ResourceManager.h"
+#include "../Application/RenderThread.h"
+#include "../Debug/Log.h"
 #include "../Utils/Text/Text.h"
 
 
 namespace GameDev2D
 {
-	BatchRenderer::BatchRenderer(bool enableSpriteOutline) :
+	BatchRenderer::BatchRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache, bool enableSpriteOutline) :
+		m_Graphics(graphics),
 		m_SpriteRenderer(nullptr),
 		m_LineRenderer(nullptr),
 		m_ActiveRenderer(nullptr),
-		m_SceneCamera(nullptr)
-	{
-		m_SpriteRenderer = std::make_unique<SpriteRenderer>();
+		m_DrawViewProjection(),
+		m_DrawViewport(0, 0),
+		m_IsDrawing(false),
+		m_SceneViewProjection(),
+		m_SceneViewport(0, 0),
+		m_HasSceneView(false),
+		m_Commands(),
+		m_Snapshot(nullptr),
+		m_RenderThread(nullptr),
+		m_RenderOrder(RenderOrder::Strict),
+		m_IsCullingEnabled(false),
+		m_FrameSubmittedItems(0),
+		m_FrameCulledItems(0),
+		m_LastFrameSubmittedItems(0),
+		m_LastFrameCulledItems(0),
+		m_RecordingThreadPool(nullptr),
+		m_RecordingBuffers{},
+		m_MinParallelRecording(2000)
+	{
+		m_SpriteRenderer = std::make_unique<SpriteRenderer>(graphics, shaderCache);
 		m_SpriteRenderer->EnableDebugSpriteOutline(enableSpriteOutline);
-		m_LineRenderer = std::make_unique<LineRenderer>();
-		m_PointRenderer = std::make_unique<PointRenderer>();
-		m_CircleRenderer = std::make_unique<CircleRenderer>();
+		m_LineRenderer = std::make_unique<LineRenderer>(graphics, shaderCache);
+		m_PointRenderer = std::make_unique<PointRenderer>(graphics, shaderCache);
+		m_CircleRenderer = std::make_unique<CircleRenderer>(graphics, shaderCache);
+		m_Commands.SetLineRenderer(m_LineRenderer.get());
 
 		SwitchRenderer(RendererType::Sprite);
 	}
 
 	void BatchRenderer::BeginScene(Camera* camera)
 	{
-		m_SceneCamera = camera;
+		m_Commands.ClearCullRect();
+		m_HasSceneView = camera != nullptr;
 
-		if (m_ActiveRenderer != nullptr)
+		if (m_HasSceneView == false)
 		{
-			m_ActiveRenderer->BeginScene(m_SceneCamera);
+			return;
+		}
+
+		//The view is kept rather than the camera, a recorded scene is drawn after the camera has moved on
+		m_SceneViewProjection = camera->GetViewProjectionMatrix();
+		m_SceneViewport = camera->GetViewport();
+
+		if (m_IsCullingEnabled)
+		{
+			//The corners of clip space are taken back into world space, the camera can be rotated so all four are needed
+			Matrix inverseViewProjection = m_SceneViewProjection.GetInverse();
+			const Vector2 corners[] = { Vector2(-1.0f, -1.0f), Vector2(1.0f, -1.0f), Vector2(1.0f, 1.0f), Vector2(-1.0f, 1.0f) };
+
+			Vector2 cullMin = inverseViewProjection * corners[0];
+			Vector2 cullMax = cullMin;
+			for (unsigned int i = 1; i < 4; i++)
+			{
+				Vector2 corner = inverseViewProjection * corners[i];
+				cullMin = Vector2(fminf(cullMin.x, corner.x), fminf(cullMin.y, corner.y));
+				cullMax = Vector2(fmaxf(cullMax.x, corner.x), fmaxf(cullMax.y, corner.y));
+			}
+			m_Commands.SetCullRect(cullMin, cullMax);
+		}
+
+		//Recording and the deferred render order begin the renderers when the commands are drawn
+		if (IsQueueingCommands() == false)
+		{
+			BeginDrawing(m_SceneViewProjection, m_SceneViewport);
 		}
 	}
 
 	void BatchRenderer::BeginScene()
 	{
-		BeginScene(Application::Get().GetGraphics().GetActiveCamera());
+		BeginScene(m_Graphics.GetActiveCamera());
 	}
 
 	void BatchRenderer::EndScene()
 	{
-		if (m_ActiveRenderer != nullptr)
+		//The commands were culled and counted when they were queued, the strict render order's culling is counted the same way
+		m_FrameSubmittedItems += m_Commands.GetSubmittedItems();
+		m_FrameCulledItems += m_Commands.GetCulledItems();
+
+		if (m_Snapshot != nullptr)
 		{
-			m_ActiveRenderer->EndScene();
+			//The commands are traded into one of the snapshot's scenes instead of being copied
+			if (m_HasSceneView)
+			{
+				if (m_Snapshot->numberOfScenes == m_Snapshot->scenes.size())
+				{
+					m_Snapshot->scenes.emplace_back();
+				}
+
+				FrameSnapshot::Scene& scene = m_Snapshot->scenes[m_Snapshot->numberOfScenes];
+				scene.viewProjection = m_SceneViewProjection;
+				scene.viewport = m_SceneViewport;
+				scene.renderOrder = m_RenderOrder;
+				scene.commands.SwapCommands(m_Commands);
+				m_Snapshot->numberOfScenes++;
+			}
+		}
+		else if (m_RenderOrder == RenderOrder::Deferred)
+		{
+			if (m_HasSceneView)
+			{
+				DrawCommands(m_Commands, m_SceneViewProjection, m_SceneViewport, true);
+			}
+		}
+		else
+		{
+			EndDrawing();
 		}
 
-		m_SceneCamera = nullptr;
+		m_Commands.Clear();
+		m_Commands.ClearCullRect();
+		m_HasSceneView = false;
 	}
 
 	void BatchRenderer::RenderSprite(Sprite* sprite)
@@ -57,6 +136,17 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderSprite(Sprite& sprite)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderSprite(sprite);
+			return;
+		}
+
+		if (m_Commands.IsSpriteCulled(sprite))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Sprite)
 		{
 			SwitchRenderer(RendererType::Sprite);
@@ -72,6 +162,17 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderSpriteFont(SpriteFont& spriteFont)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderSpriteFont(spriteFont);
+			return;
+		}
+
+		if (m_Commands.IsSpriteFontCulled(spriteFont))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Sprite)
 		{
 			SwitchRenderer(RendererType::Sprite);
@@ -102,6 +203,17 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderQuad(position, size, anchor, fillColor);
+			return;
+		}
+
+		if (m_Commands.IsQuadCulled(position, size, 0.0f, anchor, 0.0f))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Sprite)
 		{
 			SwitchRenderer(RendererType::Sprite);
@@ -117,6 +229,17 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderQuad(position, size, anchor, fillColor, outlineColor, outlineSize);
+			return;
+		}
+
+		if (m_Commands.IsQuadCulled(position, size, 0.0f, anchor, outlineSize))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Sprite)
 		{
 			SwitchRenderer(RendererType::Sprite);
@@ -152,6 +275,17 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderRotatedQuad(position, size, radians, anchor, fillColor);
+			return;
+		}
+
+		if (m_Commands.IsQuadCulled(position, size, radians, anchor, 0.0f))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Sprite)
 		{
 			SwitchRenderer(RendererType::Sprite);
@@ -166,6 +300,17 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderRotatedQuad(position, size, radians, anchor, fillColor, outlineColor, outlineSize);
+			return;
+		}
+
+		if (m_Commands.IsQuadCulled(position, size, radians, anchor, outlineSize))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Sprite)
 		{
 			SwitchRenderer(RendererType::Sprite);
@@ -180,38 +325,84 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderLine(const Vector2& start, const Vector2& end, const Color& color, float lineWidth)
 	{
-		if (m_ActiveRenderer->GetType() != RendererType::Line)
-		{
-			SwitchRenderer(RendererType::Line);
-		}
-
-		m_LineRenderer->RenderLine(start, end, color, lineWidth);
+		Vector2 points[2] = { start, end };
+		RenderLineStrip(points, 2, color, lineWidth, Vector2::Zero, 0.0f);
 	}
 
 	void BatchRenderer::RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth)
 	{
+		RenderLineStrip(points.data(), (unsigned int)points.size(), color, lineWidth, Vector2::Zero, 0.0f);
+	}
+
+	void BatchRenderer::RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		RenderLineStrip(points.data(), (unsigned int)points.size(), color, lineWidth, position, radians);
+	}
+
+	void BatchRenderer::RenderLineStrip(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderLineStrip(points, numberOfPoints, color, lineWidth, position, radians);
+			return;
+		}
+
+		if (m_Commands.IsLineStripCulled(points, numberOfPoints, lineWidth, position, radians))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Line)
 		{
 			SwitchRenderer(RendererType::Line);
 		}
 
-		m_LineRenderer->RenderLineStrip(points, color, lineWidth);
+		m_LineRenderer->RenderLineStrip(points, numberOfPoints, color, lineWidth, position, radians);
 	}
 
-	void BatchRenderer::RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth, const Vector2& position, float radians)
+	unsigned int BatchRenderer::RegisterLineShape(const Vector2* points, unsigned int numberOfPoints)
+	{
+		//The render thread reads the shapes while it draws
+		WaitForRenderThread();
+		return m_LineRenderer->RegisterShape(points, numberOfPoints);
+	}
+
+	void BatchRenderer::RenderLineShape(unsigned int shapeId, const Color& color, float lineWidth, const Vector2& position, float radians)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderLineShape(shapeId, color, lineWidth, position, radians);
+			return;
+		}
+
+		if (m_Commands.IsLineShapeCulled(shapeId, lineWidth, position))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Line)
 		{
 			SwitchRenderer(RendererType::Line);
 		}
 
-		m_LineRenderer->RenderLineStrip(points, color, lineWidth, position, radians);
+		m_LineRenderer->RenderShape(shapeId, position, radians, color, lineWidth);
 	}
 
 	void BatchRenderer::RenderPoint(const Vector2& position, const Color& color, float size)
 	{
 		if (size == 1.0f)
 		{
+			if (IsQueueingCommands())
+			{
+				m_Commands.RenderPoint(position, color);
+				return;
+			}
+
+			if (m_Commands.IsCulled(position, position))
+			{
+				return;
+			}
+
 			if (m_ActiveRenderer->GetType() != RendererType::Point)
 			{
 				SwitchRenderer(RendererType::Point);
@@ -236,6 +427,17 @@ namespace GameDev2D
 
 	void BatchRenderer::RenderCircle(const Vector2& position, float radius, const Color& fillColor, const Color& outlineColor, float outlineSize)
 	{
+		if (IsQueueingCommands())
+		{
+			m_Commands.RenderCircle(position, radius, fillColor, outlineColor, outlineSize);
+			return;
+		}
+
+		if (m_Commands.IsCircleCulled(position, radius, outlineSize))
+		{
+			return;
+		}
+
 		if (m_ActiveRenderer->GetType() != RendererType::Circle)
 		{
 			SwitchRenderer(RendererType::Circle);
@@ -258,9 +460,30 @@ namespace GameDev2D
 		return m_SpriteRenderer->GetLastFrameDrawCalls() + m_LineRenderer->GetLastFrameDrawCalls() + m_CircleRenderer->GetLastFrameDrawCalls() + m_PointRenderer->GetLastFrameDrawCalls();
 	}
 
+	unsigned long long BatchRenderer::GetLastFrameLineAllocations()
+	{
+		return m_LineRenderer->GetLastFrameAllocations();
+	}
+
+	unsigned long long BatchRenderer::GetLastFrameSubmittedItems()
+	{
+		return m_LastFrameSubmittedItems;
+	}
+
+	unsigned long long BatchRenderer::GetLastFrameCulledItems()
+	{
+		return m_LastFrameCulledItems;
+	}
+
 	void BatchRenderer::EnableDebugSpriteOutline(bool enable)
 	{
+		WaitForRenderThread();
 		m_SpriteRenderer->EnableDebugSpriteOutline(enable);
+
+		if (m_Snapshot != nullptr)
+		{
+			m_Commands.m_CopiesSpriteOutlines = enable;
+		}
 	}
 
 	bool BatchRenderer::IsDebugSpriteOutlineEnabled()
@@ -268,6 +491,238 @@ namespace GameDev2D
 		return m_SpriteRenderer->IsDebugSpriteOutlineEnabled();
 	}
 
+	void BatchRenderer::SetRenderOrder(RenderOrder renderOrder)
+	{
+		m_RenderOrder = renderOrder;
+	}
+
+	RenderOrder BatchRenderer::GetRenderOrder()
+	{
+		return m_RenderOrder;
+	}
+
+	void BatchRenderer::SetSpriteSubmission(SpriteSubmission submission)
+	{
+		WaitForRenderThread();
+		m_SpriteRenderer->SetSubmission(submission);
+	}
+
+	SpriteSubmission BatchRenderer::GetSpriteSubmission()
+	{
+		return m_SpriteRenderer->GetSubmission();
+	}
+
+	void BatchRenderer::SetLineExpansion(LineExpansion expansion)
+	{
+		WaitForRenderThread();
+		m_LineRenderer->SetExpansion(expansion);
+	}
+
+	LineExpansion BatchRenderer::GetLineExpansion()
+	{
+		return m_LineRenderer->GetExpansion();
+	}
+
+	void BatchRenderer::EnableCulling(bool enable)
+	{
+		m_IsCullingEnabled = enable;
+	}
+
+	bool BatchRenderer::IsCullingEnabled()
+	{
+		return m_IsCullingEnabled;
+	}
+
+	void BatchRenderer::SetLayer(unsigned char layer)
+	{
+		m_Commands.SetLayer(layer);
+	}
+
+	unsigned char BatchRenderer::GetLayer()
+	{
+		return m_Commands.GetLayer();
+	}
+
+	void BatchRenderer::PrepareCommandBuffer(RenderCommandBuffer& buffer)
+	{
+		buffer.Clear();
+		buffer.CopySceneState(m_Commands);
+	}
+
+	void BatchRenderer::SubmitCommandBuffer(RenderCommandBuffer& buffer)
+	{
+		if (IsQueueingCommands())
+		{
+			//The buffer's commands are sorted along with the rest of the queue, after everything queued before them
+			m_Commands.Append(buffer);
+			return;
+		}
+
+		//The commands were culled when they were recorded, so they aren't culled or counted again
+		m_FrameSubmittedItems += buffer.GetSubmittedItems();
+		m_FrameCulledItems += buffer.GetCulledItems();
+
+		for (const RenderCommandBuffer::RenderCommand& command : buffer.m_Commands)
+		{
+			DrawCommand(command, buffer);
+		}
+	}
+
+	void BatchRenderer::EnableParallelRecording(bool enable)
+	{
+		if (enable == (m_RecordingThreadPool != nullptr))
+		{
+			return;
+		}
+
+		m_RecordingThreadPool = enable ? std::make_unique<ThreadPool>() : nullptr;
+		m_RecordingBuffers.resize(enable ? m_RecordingThreadPool->GetNumberOfThreads() : 0);
+	}
+
+	bool BatchRenderer::IsParallelRecordingEnabled()
+	{
+		return m_RecordingThreadPool != nullptr;
+	}
+
+	void BatchRenderer::SetMinParallelRecording(unsigned int count)
+	{
+		m_MinParallelRecording = count;
+	}
+
+	unsigned int BatchRenderer::GetMinParallelRecording()
+	{
+		return m_MinParallelRecording;
+	}
+
+	bool BatchRenderer::IsQueueingCommands()
+	{
+		return m_Snapshot != nullptr || m_RenderOrder == RenderOrder::Deferred;
+	}
+
+	void BatchRenderer::BeginRecording(FrameSnapshot& snapshot)
+	{
+		m_Snapshot = &snapshot;
+		m_Snapshot->numberOfScenes = 0;
+		m_Commands.m_CopiesSprites = true;
+		m_Commands.m_CopiesSpriteOutlines = m_SpriteRenderer->IsDebugSpriteOutlineEnabled();
+	}
+
+	void BatchRenderer::EndRecording()
+	{
+		m_Snapshot = nullptr;
+		m_Commands.m_CopiesSprites = false;
+		m_Commands.m_CopiesSpriteOutlines = false;
+	}
+
+	void BatchRenderer::DrawSnapshot(FrameSnapshot& snapshot)
+	{
+		for (unsigned int i = 0; i < snapshot.numberOfScenes; i++)
+		{
+			FrameSnapshot::Scene& scene = snapshot.scenes[i];
+			DrawCommands(scene.commands, scene.viewProjection, scene.viewport, scene.renderOrder == RenderOrder::Deferred);
+		}
+	}
+
+	void BatchRenderer::BeginDrawing(const Matrix& viewProjection, const Viewport& viewport)
+	{
+		m_DrawViewProjection = viewProjection;
+		m_DrawViewport = viewport;
+		m_IsDrawing = true;
+		m_ActiveRenderer->BeginScene(viewProjection, viewport);
+	}
+
+	void BatchRenderer::EndDrawing()
+	{
+		m_ActiveRenderer->EndScene();
+		m_IsDrawing = false;
+	}
+
+	void BatchRenderer::DrawCommands(RenderCommandBuffer& buffer, const Matrix& viewProjection, const Viewport& viewport, bool sort)
+	{
+		if (buffer.m_CommandKeys.empty())
+		{
+			return;
+		}
+
+		//The renderer only switches when the key's renderer type changes, a strict scene's keys are already in the order they were queued
+		if (sort)
+		{
+			std::sort(buffer.m_CommandKeys.begin(), buffer.m_CommandKeys.end());
+		}
+
+		BeginDrawing(viewProjection, viewport);
+
+		for (unsigned long long key : buffer.m_CommandKeys)
+		{
+			DrawCommand(buffer.m_Commands[(unsigned int)(key & 0xffffffff)], buffer);
+		}
+
+		EndDrawing();
+	}
+
+	void BatchRenderer::DrawCommand(const RenderCommandBuffer::RenderCommand& command, const RenderCommandBuffer& buffer)
+	{
+		typedef RenderCommandBuffer::RenderCommandType RenderCommandType;
+
+		switch (command.type)
+		{
+		case RenderCommandType::Sprite:
+			UseRenderer(RendererType::Sprite);
+			m_SpriteRenderer->RenderSprite(*command.sprite);
+			break;
+		case RenderCommandType::SpriteFont:
+			UseRenderer(RendererType::Sprite);
+			m_SpriteRenderer->RenderSpriteFont(*static_cast<SpriteFont*>(command.sprite));
+			break;
+		case RenderCommandType::TexturedQuad:
+			UseRenderer(RendererType::Sprite);
+			m_SpriteRenderer->RenderTexturedQuad(command.texture, command.position, command.axisX, command.axisY, command.uvOrigin, command.uvSize, command.fillColor, command.distanceField);
+			break;
+		case RenderCommandType::SpriteOutline:
+			UseRenderer(RendererType::Sprite);
+			m_SpriteRenderer->RenderDebugSpriteOutline(command.transform, command.size, command.anchor);
+			break;
+		case RenderCommandType::Quad:
+			UseRenderer(RendererType::Sprite);
+			if (command.hasOutline)
+				m_SpriteRenderer->RenderQuad(command.position, command.size, command.anchor, command.fillColor, command.outlineColor, command.outlineSize);
+			else
+				m_SpriteRenderer->RenderQuad(command.position, command.size, command.anchor, command.fillColor);
+			break;
+		case RenderCommandType::RotatedQuad:
+			UseRenderer(RendererType::Sprite);
+			if (command.hasOutline)
+				m_SpriteRenderer->RenderRotatedQuad(command.position, command.size, command.radians, command.anchor, command.fillColor, command.outlineColor, command.outlineSize);
+			else
+				m_SpriteRenderer->RenderRotatedQuad(command.position, command.size, command.radians, command.anchor, command.fillColor);
+			break;
+		case RenderCommandType::LineStrip:
+			UseRenderer(RendererType::Line);
+			m_LineRenderer->RenderLineStrip(&buffer.m_CommandPoints[command.firstPoint], command.numberOfPoints, command.fillColor, command.lineWidth, command.position, command.radians);
+			break;
+		case RenderCommandType::LineShapes:
+			UseRenderer(RendererType::Line);
+			m_LineRenderer->RenderShapes(&buffer.m_ShapeInstances[command.firstInstance], &buffer.m_ShapeInstanceIds[command.firstInstance], command.numberOfInstances);
+			break;
+		case RenderCommandType::Point:
+			UseRenderer(RendererType::Point);
+			m_PointRenderer->RenderPoint(command.position, command.fillColor);
+			break;
+		case RenderCommandType::Circle:
+			UseRenderer(RendererType::Circle);
+			m_CircleRenderer->RenderCircle(command.position, command.size.x, command.fillColor, command.outlineColor, command.outlineSize);
+			break;
+		}
+	}
+
+	void BatchRenderer::UseRenderer(RendererType type)
+	{
+		if (m_ActiveRenderer->GetType() != type)
+		{
+			SwitchRenderer(type);
+		}
+	}
+
 	void BatchRenderer::SwitchRenderer(RendererType type)
 	{
 		if (m_ActiveRenderer != nullptr)
@@ -294,17 +749,39 @@ namespace GameDev2D
 			break;
 		}
 
-		if (m_SceneCamera != nullptr)
+		if (m_IsDrawing)
+		{
+			m_ActiveRenderer->BeginScene(m_DrawViewProjection, m_DrawViewport);
+		}
+	}
+
+	void BatchRenderer::WaitForRenderThread()
+	{
+		if (m_RenderThread != nullptr)
 		{
-			m_ActiveRenderer->BeginScene(m_SceneCamera);
+			m_RenderThread->WaitUntilIdle();
 		}
 	}
 
 	void BatchRenderer::NewFrame()
+	{
+		NewRendererFrame();
+		NewRecordingFrame();
+	}
+
+	void BatchRenderer::NewRendererFrame()
 	{
 		m_SpriteRenderer->NewFrame();
 		m_LineRenderer->NewFrame();
 		m_CircleRenderer->NewFrame();
 		m_PointRenderer->NewFrame();
 	}
+
+	void BatchRenderer::NewRecordingFrame()
+	{
+		m_LastFrameSubmittedItems = m_FrameSubmittedItems;
+		m_LastFrameCulledItems = m_FrameCulledItems;
+		m_FrameSubmittedItems = 0;
+		m_FrameCulledItems = 0;
+	}
 }
\ No newline at end of file
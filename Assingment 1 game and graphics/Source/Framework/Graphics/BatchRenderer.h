@@ -4,21 +4,58 @@
 #include "LineRenderer.h"
 #include "PointRenderer.h"
 #include "CircleRenderer.h"
+#include "RenderCommandBuffer.h"
+#include "../Utils/ThreadPool/ThreadPool.h"
+#include <algorithm>
 #include <array>
+#include <memory>
+#include <vector>
 
 
 namespace GameDev2D
 {
 	class Camera;
+	class Graphics;
+	class RenderThread;
 	class Sprite;
 	class SpriteFont;
 	class Texture;
 
+	//Strict renders everything in the order it was submitted, switching renderers (and flushing them) whenever the
+	//type of primitive changes. Deferred queues everything and sorts it by layer, renderer and texture in EndScene(),
+	//so that each renderer is only flushed once or twice per scene
+	enum class RenderOrder
+	{
+		Strict = 0,
+		Deferred
+	};
+
+	//A frame recorded on the main thread for the render thread to draw: the commands recorded between each BeginScene()
+	//and EndScene(), along with the camera view they're drawn with. Sprites are copied, so nothing points at game objects
+	struct FrameSnapshot
+	{
+		struct Scene
+		{
+			Scene() : viewProjection(), viewport(0, 0), renderOrder(RenderOrder::Strict), commands() {}
+
+			Matrix viewProjection;
+			Viewport viewport;
+			RenderOrder renderOrder;
+			RenderCommandBuffer commands;
+		};
+
+		FrameSnapshot() : scenes(), numberOfScenes(0) {}
+
+		//The scenes are reused from frame to frame, only the first numberOfScenes belong to this frame
+		std::vector<Scene> scenes;
+		unsigned int numberOfScenes;
+	};
 
 	class BatchRenderer
 	{
 	public:
-		BatchRenderer(bool enableSpriteOutline);
+		//The renderers draw with graphics and take their shaders from shaderCache
+		BatchRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache, bool enableSpriteOutline);
 		~BatchRenderer() = default;
 
 		void BeginScene(Camera* camera);
@@ -54,6 +91,12 @@ namespace GameDev2D
 		void RenderLine(const Vector2& start, const Vector2& end, const Color& color, float lineWidth);
 		void RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth);
 		void RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth, const Vector2& position, float radians);
+		void RenderLineStrip(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians);
+
+		//Line shapes are uploaded once and then rendered as instances, see LineRenderer::RegisterShape(). When there's a
+		//render thread this waits for it to draw the frames it was given first
+		unsigned int RegisterLineShape(const Vector2* points, unsigned int numberOfPoints);
+		void RenderLineShape(unsigned int shapeId, const Color& color, float lineWidth, const Vector2& position, float radians);
 
 		void RenderPoint(const Vector2& position, const Color& color, float size = 1.0f); //size is the radius of the point
 
@@ -65,21 +108,150 @@ namespace GameDev2D
 
 		unsigned long long GetTotalDrawCalls();
 		unsigned long long GetLastFrameDrawCalls();
+		unsigned long long GetLastFrameLineAllocations();
+
+		//The number of Render calls made last frame, and how many of them were culled for being outside of the camera's view
+		unsigned long long GetLastFrameSubmittedItems();
+		unsigned long long GetLastFrameCulledItems();
 
 		void EnableDebugSpriteOutline(bool enable);
 		bool IsDebugSpriteOutlineEnabled();
 
+		//Should be set outside of BeginScene() and EndScene()
+		void SetRenderOrder(RenderOrder renderOrder);
+		RenderOrder GetRenderOrder();
+
+		//Should be set outside of BeginScene() and EndScene()
+		void SetSpriteSubmission(SpriteSubmission submission);
+		SpriteSubmission GetSpriteSubmission();
+
+		//Should be set outside of BeginScene() and EndScene()
+		void SetLineExpansion(LineExpansion expansion);
+		LineExpansion GetLineExpansion();
+
+		//Culling skips anything whose bounds are outside of the scene camera's view, before any vertices are written
+		//or any commands are queued. Should be set outside of BeginScene() and EndScene()
+		void EnableCulling(bool enable);
+		bool IsCullingEnabled();
+
+		//Primitives on a higher layer are drawn on top of lower layers, only used by the deferred render order
+		void SetLayer(unsigned char layer);
+		unsigned char GetLayer();
+
+		//Clears a command buffer and gives it the scene's cull rect and the current layer, so it can be filled on
+		//another thread. Should be called between BeginScene() and EndScene(), after any line shapes are registered
+		void PrepareCommandBuffer(RenderCommandBuffer& buffer);
+
+		//Replays a filled command buffer, as if its Render calls were made here. Buffers are drawn in the order they're
+		//submitted, so submitting them in a fixed order draws the same frame no matter which thread filled which buffer.
+		//Should be called between BeginScene() and EndScene(), once the buffer is no longer being filled
+		void SubmitCommandBuffer(RenderCommandBuffer& buffer);
+
+		//Parallel recording gives RecordItems() a thread pool with one command buffer per thread. It's off by default,
+		//waking the threads and replaying their buffers only pays off for thousands of items. Should be set outside of
+		//BeginScene() and EndScene()
+		void EnableParallelRecording(bool enable);
+		bool IsParallelRecordingEnabled();
+
+		//RecordItems() records fewer items than this on the calling thread, even with parallel recording enabled. The
+		//default is 2000
+		void SetMinParallelRecording(unsigned int count);
+		unsigned int GetMinParallelRecording();
+
+		//Calls record(renderer, index) for every index in [0, count). With parallel recording and at least the minimum
+		//number of items the indices are split into one chunk per thread, each chunk is recorded into its own command
+		//buffer and the buffers are submitted in order, so the frame is the same either way. Otherwise renderer is the
+		//BatchRenderer itself, so record has to be a generic lambda that only makes Render calls RenderCommandBuffer has.
+		//Should be called between BeginScene() and EndScene()
+		template <typename Record>
+		void RecordItems(unsigned int count, const Record& record);
+
 	private:
 		friend class Application;
+		friend class RenderThread;
+
+		//Recording and the deferred render order queue the Render calls instead of drawing them
+		bool IsQueueingCommands();
 
+		//Between BeginRecording() and EndRecording() every scene is recorded into the snapshot instead of being drawn,
+		//and nothing touches the renderers or the graphics API. DrawSnapshot() draws it, on the render thread
+		void BeginRecording(FrameSnapshot& snapshot);
+		void EndRecording();
+		void DrawSnapshot(FrameSnapshot& snapshot);
+
+		//The renderers are only used by the thread that draws, the rest of the BatchRenderer by the thread that records
+		void BeginDrawing(const Matrix& viewProjection, const Viewport& viewport);
+		void EndDrawing();
+		void DrawCommands(RenderCommandBuffer& buffer, const Matrix& viewProjection, const Viewport& viewport, bool sort);
+		void DrawCommand(const RenderCommandBuffer::RenderCommand& command, const RenderCommandBuffer& buffer);
+		void UseRenderer(RendererType type);
 		void SwitchRenderer(RendererType type);
+		void WaitForRenderThread();
+
+		//NewFrame() starts a frame for both, the render thread starts the renderers' frames on its own
 		void NewFrame();
+		void NewRendererFrame();
+		void NewRecordingFrame();
 
+		Graphics& m_Graphics;
 		std::unique_ptr<SpriteRenderer> m_SpriteRenderer;
 		std::unique_ptr<LineRenderer> m_LineRenderer;
 		std::unique_ptr<PointRenderer> m_PointRenderer;
 		std::unique_ptr<CircleRenderer> m_CircleRenderer;
 		IRenderer* m_ActiveRenderer;
-		Camera* m_SceneCamera;
+		Matrix m_DrawViewProjection;
+		Viewport m_DrawViewport;
+		bool m_IsDrawing;
+		Matrix m_SceneViewProjection;
+		Viewport m_SceneViewport;
+		bool m_HasSceneView;
+		RenderCommandBuffer m_Commands;
+		FrameSnapshot* m_Snapshot;
+		RenderThread* m_RenderThread;
+		RenderOrder m_RenderOrder;
+		bool m_IsCullingEnabled;
+		unsigned long long m_FrameSubmittedItems;
+		unsigned long long m_FrameCulledItems;
+		unsigned long long m_LastFrameSubmittedItems;
+		unsigned long long m_LastFrameCulledItems;
+		std::unique_ptr<ThreadPool> m_RecordingThreadPool;
+		std::vector<RenderCommandBuffer> m_RecordingBuffers;
+		unsigned int m_MinParallelRecording;
 	};
+
+	template <typename Record>
+	void BatchRenderer::RecordItems(unsigned int count, const Record& record)
+	{
+		if (m_RecordingThreadPool == nullptr || count < m_MinParallelRecording)
+		{
+			for (unsigned int i = 0; i < count; i++)
+			{
+				record(*this, i);
+			}
+			return;
+		}
+
+		for (RenderCommandBuffer& buffer : m_RecordingBuffers)
+		{
+			PrepareCommandBuffer(buffer);
+		}
+
+		//Each chunk writes to its own buffer, so they don't need to be synchronized
+		const unsigned int numberOfChunks = (unsigned int)m_RecordingBuffers.size();
+		const unsigned int chunkSize = (count + numberOfChunks - 1) / numberOfChunks;
+		m_RecordingThreadPool->ParallelFor(numberOfChunks, [&](unsigned int chunk, unsigned int)
+		{
+			RenderCommandBuffer& buffer = m_RecordingBuffers[chunk];
+			const unsigned int end = std::min(count, (chunk + 1) * chunkSize);
+			for (unsigned int i = chunk * chunkSize; i < end; i++)
+			{
+				record(buffer, i);
+			}
+		});
+
+		for (RenderCommandBuffer& buffer : m_RecordingBuffers)
+		{
+			SubmitCommandBuffer(buffer);
+		}
+	}
 }
\ No newline at end of file
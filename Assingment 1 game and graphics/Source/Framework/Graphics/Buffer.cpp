@@ -1,6 +1,5 @@
 #include "Buffer.h"
 #include "Graphics.h"
-#include "../Application/Application.h"
 
 
 namespace GameDev2D
@@ -58,41 +57,50 @@ namespace GameDev2D
 		}
 	}
 
-	VertexBuffer::VertexBuffer(unsigned int size) :
+	VertexBuffer::VertexBuffer(Graphics& graphics, unsigned int size) :
+		m_Graphics(graphics),
 		m_ID(0)
 	{
-		Application::Get().GetGraphics().CreateBuffer(&m_ID);
-		Application::Get().GetGraphics().BindBuffer(BufferType::Vertex, m_ID);
-		Application::Get().GetGraphics().InitBuffer(BufferType::Vertex, size, nullptr, BufferUsage::DynamicDraw);
+		m_Graphics.CreateBuffer(&m_ID);
+		m_Graphics.BindBuffer(BufferType::Vertex, m_ID);
+		m_Graphics.InitBuffer(BufferType::Vertex, size, nullptr, BufferUsage::DynamicDraw);
 	}
 
-	VertexBuffer::VertexBuffer(float* vertices, unsigned int size) :
+	VertexBuffer::VertexBuffer(Graphics& graphics, float* vertices, unsigned int size) :
+		m_Graphics(graphics),
 		m_ID(0)
 	{
-		Application::Get().GetGraphics().CreateBuffer(&m_ID);
-		Application::Get().GetGraphics().BindBuffer(BufferType::Vertex, m_ID);
-		Application::Get().GetGraphics().InitBuffer(BufferType::Vertex, size, vertices, BufferUsage::StaticDraw);
+		m_Graphics.CreateBuffer(&m_ID);
+		m_Graphics.BindBuffer(BufferType::Vertex, m_ID);
+		m_Graphics.InitBuffer(BufferType::Vertex, size, vertices, BufferUsage::StaticDraw);
+	}
+
+	VertexBuffer::VertexBuffer(Graphics& graphics) :
+		m_Graphics(graphics),
+		m_ID(0)
+	{
+		m_Graphics.CreateBuffer(&m_ID);
 	}
 
 	VertexBuffer::~VertexBuffer()
 	{
-		Application::Get().GetGraphics().DeleteBuffer(&m_ID);
+		m_Graphics.DeleteBuffer(&m_ID);
 	}
 
 	void VertexBuffer::Bind() const
 	{
-		Application::Get().GetGraphics().BindBuffer(BufferType::Vertex, m_ID);
+		m_Graphics.BindBuffer(BufferType::Vertex, m_ID);
 	}
 
 	void VertexBuffer::Unbind() const
 	{
-		Application::Get().GetGraphics().BindBuffer(BufferType::Vertex, 0);
+		m_Graphics.BindBuffer(BufferType::Vertex, 0);
 	}
 
 	void VertexBuffer::SetData(const void* data, unsigned int size)
 	{
-		Application::Get().GetGraphics().BindBuffer(BufferType::Vertex, m_ID);
-		Application::Get().GetGraphics().UpdateBuffer(BufferType::Vertex, 0, size, data);
+		m_Graphics.BindBuffer(BufferType::Vertex, m_ID);
+		m_Graphics.UpdateBuffer(BufferType::Vertex, 0, size, data);
 	}
 
 	const BufferLayout& VertexBuffer::GetLayout() const
@@ -105,28 +113,102 @@ namespace GameDev2D
 		m_Layout = layout;
 	}
 
-	IndexBuffer::IndexBuffer(unsigned int* indices, unsigned int count) :
+	StreamingVertexBuffer::StreamingVertexBuffer(Graphics& graphics, unsigned int regionSize, unsigned int numberOfRegions) :
+		VertexBuffer(graphics),
+		m_MappedData(nullptr),
+		m_Fences(numberOfRegions, nullptr),
+		m_RegionSize(regionSize),
+		m_NumberOfRegions(numberOfRegions),
+		m_RegionIndex(0),
+		m_RegionOffset(0)
+	{
+		m_Graphics.BindBuffer(BufferType::Vertex, m_ID);
+		m_MappedData = (unsigned char*)m_Graphics.InitPersistentBuffer(BufferType::Vertex, regionSize * numberOfRegions);
+	}
+
+	StreamingVertexBuffer::~StreamingVertexBuffer()
+	{
+		for (void* fence : m_Fences)
+		{
+			if (fence != nullptr)
+			{
+				m_Graphics.DeleteFence(fence);
+			}
+		}
+	}
+
+	void* StreamingVertexBuffer::Begin(unsigned int minimumSize)
+	{
+		if (GetAvailableSize() < minimumSize)
+		{
+			NextRegion();
+		}
+
+		//The region's fence is only waited on the first time it's written to
+		void*& fence = m_Fences[m_RegionIndex];
+		if (fence != nullptr)
+		{
+			m_Graphics.WaitForFence(fence);
+			m_Graphics.DeleteFence(fence);
+			fence = nullptr;
+		}
+
+		return m_MappedData + GetWriteOffset();
+	}
+
+	void StreamingVertexBuffer::End(unsigned int size)
+	{
+		//The mapping is coherent, the flush lets the backend count (or record) the bytes that were written
+		m_Graphics.FlushMappedBuffer(m_ID, GetWriteOffset(), size);
+		m_RegionOffset += size;
+	}
+
+	void StreamingVertexBuffer::NextRegion()
+	{
+		//Nothing was written, the region can be used again
+		if (m_RegionOffset == 0)
+		{
+			return;
+		}
+
+		m_Fences[m_RegionIndex] = m_Graphics.CreateFence();
+		m_RegionIndex = (m_RegionIndex + 1) % m_NumberOfRegions;
+		m_RegionOffset = 0;
+	}
+
+	unsigned int StreamingVertexBuffer::GetAvailableSize() const
+	{
+		return m_RegionSize - m_RegionOffset;
+	}
+
+	unsigned int StreamingVertexBuffer::GetWriteOffset() const
+	{
+		return m_RegionIndex * m_RegionSize + m_RegionOffset;
+	}
+
+	IndexBuffer::IndexBuffer(Graphics& graphics, unsigned int* indices, unsigned int count) :
+		m_Graphics(graphics),
 		m_ID(0),
 		m_Count(count)
 	{
-		Application::Get().GetGraphics().CreateBuffer(&m_ID);
-		Application::Get().GetGraphics().BindBuffer(BufferType::Vertex, m_ID);
-		Application::Get().GetGraphics().InitBuffer(BufferType::Vertex, count * sizeof(unsigned int), indices, BufferUsage::StaticDraw);
+		m_Graphics.CreateBuffer(&m_ID);
+		m_Graphics.BindBuffer(BufferType::Vertex, m_ID);
+		m_Graphics.InitBuffer(BufferType::Vertex, count * sizeof(unsigned int), indices, BufferUsage::StaticDraw);
 	}
 
 	IndexBuffer::~IndexBuffer()
 	{
-		Application::Get().GetGraphics().DeleteBuffer(&m_ID);
+		m_Graphics.DeleteBuffer(&m_ID);
 	}
 
 	void IndexBuffer::Bind() const
 	{
-		Application::Get().GetGraphics().BindBuffer(BufferType::Index, m_ID);
+		m_Graphics.BindBuffer(BufferType::Index, m_ID);
 	}
 
 	void IndexBuffer::Unbind() const
 	{
-		Application::Get().GetGraphics().BindBuffer(BufferType::Index, 0);
+		m_Graphics.BindBuffer(BufferType::Index, 0);
 	}
 
 	unsigned int IndexBuffer::GetCount()
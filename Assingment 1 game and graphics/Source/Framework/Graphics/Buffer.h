@@ -7,6 +7,8 @@
 
 namespace GameDev2D
 {
+	class Graphics;
+
 	struct BufferElement
 	{
 		BufferElement() = default;
@@ -46,8 +48,8 @@ namespace GameDev2D
 	class VertexBuffer
 	{
 	public:
-		VertexBuffer(unsigned int size);
-		VertexBuffer(float* vertices, unsigned int size);
+		VertexBuffer(Graphics& graphics, unsigned int size);
+		VertexBuffer(Graphics& graphics, float* vertices, unsigned int size);
 
 		~VertexBuffer();
 
@@ -59,16 +61,54 @@ namespace GameDev2D
 		const BufferLayout& GetLayout() const;
 		void SetLayout(const BufferLayout& layout);
 
-	private:
+	protected:
+		//Only creates the buffer, the derived class sets up its storage
+		VertexBuffer(Graphics& graphics);
+
+		Graphics& m_Graphics;
 		unsigned int m_ID;
 		BufferLayout m_Layout;
 	};
 
+	//A vertex buffer that stays mapped so vertices can be written straight into GPU visible memory. The buffer is
+	//split into regions, every frame writes into the next region and a fence is placed after the draw calls that read
+	//it, so a region is only written to again once the GPU is done with it (instead of stalling in glBufferSubData)
+	class StreamingVertexBuffer : public VertexBuffer
+	{
+	public:
+		StreamingVertexBuffer(Graphics& graphics, unsigned int regionSize, unsigned int numberOfRegions = 3);
+		~StreamingVertexBuffer();
+
+		//Returns where the next vertices should be written. If fewer than minimumSize bytes are left in
+		//the current region, it moves on to the next region. Waits if the GPU is still reading the region
+		void* Begin(unsigned int minimumSize);
+
+		//Call after the draw call that reads the vertices written since Begin(), the next Begin() continues after them
+		void End(unsigned int size);
+
+		//Places a fence after the draw calls that read the current region and moves to the next one, called once a frame
+		void NextRegion();
+
+		//Number of bytes that can still be written in the current region
+		unsigned int GetAvailableSize() const;
+
+		//Offset in bytes from the start of the buffer to where the next vertices are written, divide by the stride to get the base vertex
+		unsigned int GetWriteOffset() const;
+
+	private:
+		unsigned char* m_MappedData;
+		std::vector<void*> m_Fences;
+		unsigned int m_RegionSize;
+		unsigned int m_NumberOfRegions;
+		unsigned int m_RegionIndex;
+		unsigned int m_RegionOffset;
+	};
+
 	// Currently only 32-bit index buffers supportted
 	class IndexBuffer
 	{
 	public:
-		IndexBuffer(unsigned int* indices, unsigned int count);
+		IndexBuffer(Graphics& graphics, unsigned int* indices, unsigned int count);
 		~IndexBuffer();
 
 		void Bind() const;
@@ -77,6 +117,7 @@ namespace GameDev2D
 		unsigned int GetCount();
 
 	private:
+		Graphics& m_Graphics;
 		unsigned int m_ID;
 		unsigned int m_Count;
 	};
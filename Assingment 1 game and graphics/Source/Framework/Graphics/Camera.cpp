@@ -1,10 +1,18 @@
 #include "Camera.h"
 #include "../Math/Math.h"
-#include "../Application/Application.h"
+#include <algorithm>
+#include <vector>
 
 
 namespace GameDev2D
 {
+    //Every Camera that currently exists, in the order they were created
+    static std::vector<Camera*>& GetCameras()
+    {
+        static std::vector<Camera*> s_Cameras;
+        return s_Cameras;
+    }
+
     Camera::Camera() : Transformable(),
         m_ProjectionMatrix(Matrix::Identity()),
         m_Viewport(0, 0),
@@ -17,8 +25,7 @@ namespace GameDev2D
         m_ShakeTimer(0.0f),
         m_ShakeOffset(Vector2(0.0f, 0.0f))
     {
-		Application::Get().WindowResizedSlot.connect<&Camera::OnResize>(this);
-        Application::Get().UpdateSlot.connect<&Camera::OnUpdate>(this);
+        GetCameras().push_back(this);
     }
 
 	Camera::Camera(const Camera& aCamera) : Transformable(aCamera),
@@ -33,8 +40,7 @@ namespace GameDev2D
 		m_ShakeTimer(aCamera.m_ShakeTimer),
 		m_ShakeOffset(aCamera.m_ShakeOffset)
 	{
-        Application::Get().WindowResizedSlot.connect<&Camera::OnResize>(this);
-        Application::Get().UpdateSlot.connect<&Camera::OnUpdate>(this);
+        GetCameras().push_back(this);
 	}
 
 	Camera::Camera(const Viewport& aViewport, bool aIsViewportResizeable) : Transformable(),
@@ -50,14 +56,13 @@ namespace GameDev2D
 		m_ShakeOffset(Vector2(0.0f, 0.0f))
 	{
 		SetViewport(aViewport);
-        Application::Get().WindowResizedSlot.connect<&Camera::OnResize>(this);
-        Application::Get().UpdateSlot.connect<&Camera::OnUpdate>(this);
+        GetCameras().push_back(this);
 	}
 
 	Camera::~Camera()
 	{
-        Application::Get().WindowResizedSlot.disconnect<&Camera::OnResize>(this);
-        Application::Get().UpdateSlot.disconnect<&Camera::OnUpdate>(this);
+        std::vector<Camera*>& cameras = GetCameras();
+        cameras.erase(std::find(cameras.begin(), cameras.end(), this));
 	}
 
     Matrix Camera::GetProjectionMatrix()
@@ -67,9 +72,9 @@ namespace GameDev2D
     
     Matrix Camera::GetViewMatrix()
     {
-        Matrix viewMatrix = GetWorldTransform().GetInverse();
-        viewMatrix.SetTranslation(viewMatrix.GetTranslation() + m_ShakeOffset);
-        return viewMatrix;
+        Affine2D view = GetWorldTransform().GetInverse();
+        view.SetTranslation(view.GetTranslation() + m_ShakeOffset);
+        return view.ToMatrix();
     }
 
     Matrix Camera::GetViewProjectionMatrix()
@@ -154,6 +159,22 @@ namespace GameDev2D
 		}
 	}
 
+    void Camera::UpdateCameras(float delta)
+    {
+        for (Camera* camera : GetCameras())
+        {
+            camera->OnUpdate(delta);
+        }
+    }
+
+    void Camera::ResizeCameras(unsigned int width, unsigned int height)
+    {
+        for (Camera* camera : GetCameras())
+        {
+            camera->OnResize(width, height);
+        }
+    }
+
     void Camera::ResetProjectionMatrix()
     {
         //Get the view's width and height
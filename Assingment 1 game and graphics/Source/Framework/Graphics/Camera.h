@@ -38,6 +38,11 @@ namespace GameDev2D
         //Shakes the camera for a magnitude over a certain duration
         void Shake(float magnitude, double duration);
 
+        //Updates the shake of every Camera and resizes the resizeable ones, the Application calls these every update
+        //and whenever the window is resized
+        static void UpdateCameras(float delta);
+        static void ResizeCameras(unsigned int width, unsigned int height);
+
     protected:
         void OnUpdate(float delta);
         void OnResize(unsigned int width, unsigned int height);
@@ -1,67 +1,49 @@
 #include "CircleRenderer.h"
-#include "../Application/Application.h"
+#include "Graphics.h"
+#include "../Resources/ResourceCache.h"
 
 
 namespace GameDev2D
 {
-	CircleRenderer::CircleRenderer() :
+	CircleRenderer::CircleRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache) :
+		m_Graphics(graphics),
 		m_CircleVertexArray(nullptr),
 		m_CircleVertexBuffer(nullptr),
+		m_CircleInstanceBuffer(nullptr),
 		m_CircleShader(nullptr),
-		m_CircleIndexCount(0),
-		m_CircleVertexBufferBase(nullptr),
-		m_CircleVertexBufferPtr(nullptr)
+		m_CircleInstanceCount(0),
+		m_CircleInstanceBufferBase(nullptr),
+		m_CircleInstanceBufferPtr(nullptr),
+		m_CircleInstanceBufferEnd(nullptr)
 	{
-		m_CircleVertexArray = std::make_shared<VertexArray>();
+		m_CircleVertexArray = std::make_shared<VertexArray>(m_Graphics);
 
-		m_CircleVertexBuffer = std::make_shared<VertexBuffer>(kMaxVertices * sizeof(CircleVertex));
+		//The corners of the unit quad, in triangle strip order
+		float circleVertices[] = {
+			-1.0f, -1.0f,
+			 1.0f, -1.0f,
+			-1.0f,  1.0f,
+			 1.0f,  1.0f
+		};
+
+		m_CircleVertexBuffer = std::make_shared<VertexBuffer>(m_Graphics, circleVertices, (unsigned int)sizeof(circleVertices));
 		m_CircleVertexBuffer->SetLayout({
-			{ ShaderDataType::Float2, "a_Vertices" },
+			{ ShaderDataType::Float2, "a_Vertices" }
+		});
+		m_CircleVertexArray->AddVertexBuffer(m_CircleVertexBuffer);
+
+		m_CircleInstanceBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxCircles * sizeof(CircleInstance));
+		m_CircleInstanceBuffer->SetLayout({
 			{ ShaderDataType::Float2, "a_Position" },
 			{ ShaderDataType::Float, "a_Radius" },
 			{ ShaderDataType::Float, "a_OutlineSize" },
 			{ ShaderDataType::Float4, "a_FillColor" },
 			{ ShaderDataType::Float4, "a_OutlineColor" }
 		});
+		m_CircleVertexArray->AddVertexBuffer(m_CircleInstanceBuffer, 1);
 
-		m_CircleVertexArray->AddVertexBuffer(m_CircleVertexBuffer);
-
-		m_CircleVertexBufferBase = new CircleVertex[kMaxVertices];
-		unsigned int* circleIndices = new unsigned int[kMaxIndices];
-
-		unsigned int offset = 0;
-		for (unsigned int i = 0; i < kMaxIndices; i += kCircleIndexCount)
-		{
-			circleIndices[i + 0] = offset + 0;
-			circleIndices[i + 1] = offset + 1;
-			circleIndices[i + 2] = offset + 2;
-
-			circleIndices[i + 3] = offset + 2;
-			circleIndices[i + 4] = offset + 3;
-			circleIndices[i + 5] = offset + 0;
-
-			offset += kCircleVertexCount;
-		}
-
-		std::shared_ptr<IndexBuffer> circleIndexBuffer = std::make_shared<IndexBuffer>(circleIndices, kMaxIndices);
-		m_CircleVertexArray->SetIndexBuffer(circleIndexBuffer);
-		delete[] circleIndices;
-
-		m_CircleShader = Application::Get().GetResourceManager().GetShaderCache().GetShared(CIRCLE_RENDERER_SHADER_KEY);
-	
-		m_CircleVertexPositions[0] = { 0.0f, 0.0f };
-		m_CircleVertexPositions[1] = { 1.0f, 0.0f };
-		m_CircleVertexPositions[2] = { 1.0f, 1.0f };
-		m_CircleVertexPositions[3] = { 0.0f, 1.0f };
-	}
-
-	CircleRenderer::~CircleRenderer()
-	{
-		if (m_CircleVertexBufferBase != nullptr)
-		{
-			delete[] m_CircleVertexBufferBase;
-			m_CircleVertexBufferBase = nullptr;
-		}
+		m_CircleShader = shaderCache.GetShared(CIRCLE_RENDERER_SHADER_KEY);
+		m_ViewProjectionUniform = m_CircleShader->GetUniform<Matrix>("u_ViewProjection");
 	}
 
 	RendererType CircleRenderer::GetType()
@@ -69,66 +51,74 @@ namespace GameDev2D
 		return RendererType::Circle;
 	}
 
-	void CircleRenderer::BeginScene(Camera* camera)
+	void CircleRenderer::BeginScene(const Matrix& viewProjection, const Viewport& /*viewport*/)
 	{
 		m_CircleShader->Bind();
-		m_CircleShader->SetMat4("u_ViewProjection", camera->GetViewProjectionMatrix());
+		m_CircleShader->Set(m_ViewProjectionUniform, viewProjection);
 
-		m_CircleIndexCount = 0;
-		m_CircleVertexBufferPtr = m_CircleVertexBufferBase;
+		m_CircleInstanceCount = 0;
+		m_CircleInstanceBufferBase = (CircleInstance*)m_CircleInstanceBuffer->Begin(0);
+		m_CircleInstanceBufferPtr = m_CircleInstanceBufferBase;
+		m_CircleInstanceBufferEnd = m_CircleInstanceBufferBase + m_CircleInstanceBuffer->GetAvailableSize() / sizeof(CircleInstance);
 	}
 
 	void CircleRenderer::EndScene()
 	{
-		unsigned int dataSize = (unsigned int)((unsigned char*)m_CircleVertexBufferPtr - (unsigned char*)m_CircleVertexBufferBase);
-		m_CircleVertexBuffer->SetData(m_CircleVertexBufferBase, dataSize);
-
+		//The instances were written straight into the mapped buffer, they only need to be drawn
 		Flush();
+
+		unsigned int dataSize = (unsigned int)((unsigned char*)m_CircleInstanceBufferPtr - (unsigned char*)m_CircleInstanceBufferBase);
+		m_CircleInstanceBuffer->End(dataSize);
+
+		m_CircleInstanceCount = 0;
+		m_CircleInstanceBufferBase = m_CircleInstanceBufferPtr;
 	}
 
 	void CircleRenderer::Flush()
 	{
-		if (m_CircleIndexCount == 0)
+		if (m_CircleInstanceCount == 0)
 			return;
 
 		m_CircleVertexArray->Bind();
 
-		Application::Get().GetGraphics().DrawElements(RenderMode::Triangles, m_CircleVertexArray, m_CircleIndexCount);
+		unsigned int baseInstance = m_CircleInstanceBuffer->GetWriteOffset() / sizeof(CircleInstance);
+		m_Graphics.DrawArraysInstanced(RenderMode::TriangleStrip, m_CircleVertexArray, 0, kCircleVertexCount, m_CircleInstanceCount, baseInstance);
 
 		m_TotalDrawCalls++;
 		m_FrameDrawCalls++;
 	}
 
+	void CircleRenderer::NewFrame()
+	{
+		IRenderer::NewFrame();
+		m_CircleInstanceBuffer->NextRegion();
+	}
+
 	void CircleRenderer::FlushAndReset()
 	{
 		EndScene();
 
-		m_CircleIndexCount = 0;
-		m_CircleVertexBufferPtr = m_CircleVertexBufferBase;
+		//The batch is full, so start the next one at the beginning of a region
+		m_CircleInstanceCount = 0;
+		m_CircleInstanceBufferBase = (CircleInstance*)m_CircleInstanceBuffer->Begin(kMaxCircles * sizeof(CircleInstance));
+		m_CircleInstanceBufferPtr = m_CircleInstanceBufferBase;
+		m_CircleInstanceBufferEnd = m_CircleInstanceBufferBase + m_CircleInstanceBuffer->GetAvailableSize() / sizeof(CircleInstance);
 	}
 
 	void CircleRenderer::RenderCircle(const Vector2& position, float radius, const Color& fillColor, const Color& outlineColor, float outlineSize)
 	{
-		if (m_CircleIndexCount + kCircleIndexCount >= kMaxIndices)
+		if (m_CircleInstanceCount >= kMaxCircles || m_CircleInstanceBufferPtr >= m_CircleInstanceBufferEnd)
 		{
 			FlushAndReset();
 		}
 
-		Matrix transform = Matrix::MakeTranslation(position);
-		Vector2 size((radius + outlineSize) * 2.0f, (radius + outlineSize) * 2.0f);
-		Vector2 offset(size.x * 0.5f, size.y * 0.5f);
-
-		for (unsigned int i = 0; i < kCircleVertexCount; i++)
-		{
-			m_CircleVertexBufferPtr->vertices = transform * ((m_CircleVertexPositions[i] * size) - offset);
-			m_CircleVertexBufferPtr->position = position;
-			m_CircleVertexBufferPtr->radius = radius;
-			m_CircleVertexBufferPtr->outlineSize = outlineSize;
-			m_CircleVertexBufferPtr->fillColor = fillColor;
-			m_CircleVertexBufferPtr->outlineColor = outlineColor;
-			m_CircleVertexBufferPtr++;
-		}
+		m_CircleInstanceBufferPtr->position = position;
+		m_CircleInstanceBufferPtr->radius = radius;
+		m_CircleInstanceBufferPtr->outlineSize = outlineSize;
+		m_CircleInstanceBufferPtr->fillColor = fillColor;
+		m_CircleInstanceBufferPtr->outlineColor = outlineColor;
+		m_CircleInstanceBufferPtr++;
 
-		m_CircleIndexCount += kCircleIndexCount;
+		m_CircleInstanceCount++;
 	}
 }
\ No newline at end of file
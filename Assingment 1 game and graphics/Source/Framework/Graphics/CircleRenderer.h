@@ -7,22 +7,21 @@
 #include "VertexArray.h"
 #include "../Math/Vector2.h"
 #include "../Math/Matrix.h"
-#include <array>
 
 
 namespace GameDev2D
 {
-	class Camera;
+	class Graphics;
+	template<typename T> class ResourceCache;
 
 	class CircleRenderer : public IRenderer
 	{
 	public:
-		CircleRenderer();
-		~CircleRenderer();
+		CircleRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache);
 
 		RendererType GetType() override;
 
-		void BeginScene(Camera* camera) override;
+		void BeginScene(const Matrix& viewProjection, const Viewport& viewport) override;
 		void EndScene() override;
 
 		void RenderCircle(const Vector2& position, float radius, const Color& fillColor, const Color& outlineColor, float outlineSize);
@@ -32,11 +31,12 @@ namespace GameDev2D
 
 		void Flush() override;
 		void FlushAndReset() override;
+		void NewFrame() override;
 
 	private:
-		struct CircleVertex
+		//Every circle is drawn as an instance of the same unit quad, the quad is scaled and moved in the vertex shader
+		struct CircleInstance
 		{
-			Vector2 vertices;
 			Vector2 position;
 			float radius;
 			float outlineSize;
@@ -44,18 +44,18 @@ namespace GameDev2D
 			Color outlineColor;
 		};
 
+		Graphics& m_Graphics;
 		std::shared_ptr<VertexArray> m_CircleVertexArray;
 		std::shared_ptr<VertexBuffer> m_CircleVertexBuffer;
+		std::shared_ptr<StreamingVertexBuffer> m_CircleInstanceBuffer;
 		std::shared_ptr<Shader> m_CircleShader;
-		unsigned int m_CircleIndexCount;
-		CircleVertex* m_CircleVertexBufferBase;
-		CircleVertex* m_CircleVertexBufferPtr;
-		Vector2 m_CircleVertexPositions[4];
+		ShaderUniform<Matrix> m_ViewProjectionUniform;
+		unsigned int m_CircleInstanceCount;
+		CircleInstance* m_CircleInstanceBufferBase;
+		CircleInstance* m_CircleInstanceBufferPtr;
+		CircleInstance* m_CircleInstanceBufferEnd;
 
 		const unsigned int kMaxCircles = 20000;
 		const unsigned int kCircleVertexCount = 4;
-		const unsigned int kMaxVertices = kMaxCircles * kCircleVertexCount;
-		const unsigned int kCircleIndexCount = 6;
-		const unsigned int kMaxIndices = kMaxCircles * kCircleIndexCount;
 	};
 }
\ No newline at end of file
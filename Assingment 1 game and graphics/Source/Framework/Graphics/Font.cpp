@@ -4,16 +4,24 @@
 
 namespace GameDev2D
 {
-    Font::Font(ImageData& imageData, FontData& fontData) :
+    Font::Font(Graphics& graphics, ImageData& imageData, FontData& fontData) :
         m_Texture(nullptr),
         m_GlyphData(fontData.glyphData),
         m_Name(fontData.name),
         m_CharacterSet(fontData.characterSet),
         m_LineHeight(fontData.lineHeight),
         m_Baseline(fontData.baseline),
-        m_Size(fontData.size)
+        m_Size(fontData.size),
+        m_DistanceRange(fontData.distanceRange),
+        m_IsDistanceField(fontData.distanceField)
     {
-        m_Texture = new Texture(imageData);
+        m_Texture = new Texture(graphics, imageData);
+
+        //The distance field has to be interpolated when it's scaled up, otherwise the edges are blocky
+        if (m_IsDistanceField)
+        {
+            m_Texture->SetFilter(TextureMinFilter::Linear, TextureMagFilter::Linear);
+        }
     }
 
     Font::~Font()
@@ -60,6 +68,16 @@ namespace GameDev2D
         return m_Size;
     }
 
+    bool Font::IsDistanceField()
+    {
+        return m_IsDistanceField;
+    }
+
+    unsigned int Font::GetDistanceRange()
+    {
+        return m_DistanceRange;
+    }
+
     GlyphData::GlyphData() :
         width(0),
         height(0),
@@ -73,7 +91,9 @@ namespace GameDev2D
     FontData::FontData() :
         lineHeight(0),
         baseline(0),
-        size(0)
+        size(0),
+        distanceRange(0),
+        distanceField(false)
     {
     }
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 namespace GameDev2D
 {
+    class Graphics;
     class Texture;
     struct FontData;
     struct GlyphData;
@@ -14,7 +15,7 @@ namespace GameDev2D
     class Font
     {
     public:
-        Font(ImageData& imageData, FontData& fontData);
+        Font(Graphics& graphics, ImageData& imageData, FontData& fontData);
         ~Font();
 
         Texture* GetTexture();
@@ -26,6 +27,11 @@ namespace GameDev2D
         unsigned int GetBaseline();
         unsigned int GetSize();
 
+        //Distance field fonts store the distance to each glyph's edge instead of its coverage, so they can be
+        //drawn at any size. GetDistanceRange() is the distance in pixels (at GetSize()) that the field covers
+        bool IsDistanceField();
+        unsigned int GetDistanceRange();
+
     private:
         Texture* m_Texture;
         std::unordered_map<char, GlyphData> m_GlyphData;
@@ -34,6 +40,8 @@ namespace GameDev2D
         unsigned int m_LineHeight;
         unsigned int m_Baseline;
         unsigned int m_Size;
+        unsigned int m_DistanceRange;
+        bool m_IsDistanceField;
     };
 
     struct GlyphData
@@ -58,5 +66,7 @@ namespace GameDev2D
         unsigned int lineHeight;
         unsigned int baseline;
         unsigned int size;
+        unsigned int distanceRange;
+        bool distanceField;
     };
 }
\ No newline at end of file
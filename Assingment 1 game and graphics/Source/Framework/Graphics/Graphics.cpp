@@ -1,40 +1,44 @@
 #include "Graphics.h"
-#include "../Application/Application.h"
-#include <glad/glad.h>
+#include "ColorList.h"
+#include <string.h>
 
 
 namespace GameDev2D
 {
-    Graphics::Graphics() :
-        m_MainCamera(Viewport(Application::Get().GetWindow().GetWidth(), Application::Get().GetWindow().GetHeight())),
-        m_ClearColor(ColorList::Black)
-    {
+    Graphics::Graphics(std::unique_ptr<IGraphicsBackend> backend, unsigned int width, unsigned int height) :
+        m_Backend(std::move(backend)),
+        m_MainCamera(Viewport(width, height)),
+        m_ClearColor(ColorList::Black),
+        m_TotalIssuedStateChanges(0),
+        m_TotalElidedStateChanges(0),
+        m_FrameIssuedStateChanges(0),
+        m_FrameElidedStateChanges(0),
+        m_LastFrameIssuedStateChanges(0),
+        m_LastFrameElidedStateChanges(0)
+    {
+        InvalidateState();
         EnableBlending(BlendingMode(BlendingFactor::SourceAlpha, BlendingFactor::OneMinusSourceAlpha));
     }
 
     unsigned int Graphics::GetApiVersion()
     {
-        float version;
-        sscanf((char *)glGetString(GL_VERSION), "%f", &version);
-        return (unsigned int)(100 * version);
+        return m_Backend->GetApiVersion();
     }
 
     unsigned int Graphics::GetShadingLanguageVersion()
     {
-        float version;
-        sscanf((char *)glGetString(GL_SHADING_LANGUAGE_VERSION), "%f", &version);
-        return (unsigned int)(100 * version);
+        return m_Backend->GetShadingLanguageVersion();
     }
     
     void Graphics::Clear()
     {
-        glClear(GL_COLOR_BUFFER_BIT);
+        m_Backend->Clear();
     }
 
     void Graphics::SetClearColor(Color aClearColor)
     {
         m_ClearColor = aClearColor;
-        glClearColor(m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a);
+        m_Backend->SetClearColor(m_ClearColor);
     }
 
     Color Graphics::GetClearColor()
@@ -70,27 +74,42 @@ namespace GameDev2D
     
     void Graphics::EnableBlending(BlendingMode aBlendingMode)
     {
-        GLenum source = GetOpenGLBlendingFactor(aBlendingMode.source);
-        GLenum destination = GetOpenGLBlendingFactor(aBlendingMode.destination);
-        glBlendFunc(source, destination);
-        glEnable(GL_BLEND);
+        unsigned int source = static_cast<unsigned int>(aBlendingMode.source);
+        unsigned int destination = static_cast<unsigned int>(aBlendingMode.destination);
+
+        //Both factors are set by the same call, so they only count as one state change
+        if (m_BlendingSource != source || m_BlendingDestination != destination)
+        {
+            m_BlendingSource = source;
+            m_BlendingDestination = destination;
+            m_FrameIssuedStateChanges++;
+            m_Backend->SetBlendingFunction(aBlendingMode.source, aBlendingMode.destination);
+        }
+        else
+        {
+            m_FrameElidedStateChanges++;
+        }
+
+        if (ChangeState(m_BlendingEnabled, 1))
+            m_Backend->SetBlendingEnabled(true);
     }
 
     void Graphics::DisableBlending()
     {
-        glDisable(GL_BLEND);
+        if (ChangeState(m_BlendingEnabled, 0))
+            m_Backend->SetBlendingEnabled(false);
     }
 
     void Graphics::SetViewport(const Viewport& viewport)
     {
-        glViewport((int)viewport.x, (int)viewport.y, (int)viewport.width, (int)viewport.height);
+        m_Backend->SetViewport((int)viewport.x, (int)viewport.y, (int)viewport.width, (int)viewport.height);
     }
 
     void Graphics::PushScissorClip(float aX, float aY, float aWidth, float aHeight)
     {
-        if (m_ScissorStack.size() == 0)
+        if (m_ScissorStack.size() == 0 && ChangeState(m_ScissorEnabled, 1))
         {
-            glEnable(GL_SCISSOR_TEST);
+            m_Backend->SetScissorEnabled(true);
         }
 
         m_ScissorStack.push_back(Rect(Vector2(aX, aY), Vector2(aWidth, aHeight)));
@@ -110,379 +129,441 @@ namespace GameDev2D
         {
             Vector2 position = m_ScissorStack.back().origin;
             Vector2 size = m_ScissorStack.back().size;
-            glScissor((int)position.x, (int)position.y, (int)size.x, (int)size.y);
+            int rect[] = { (int)position.x, (int)position.y, (int)size.x, (int)size.y };
+
+            //The rect is set by a single call, so it only counts as one state change
+            if (memcmp(m_ScissorRect, rect, sizeof(rect)) != 0)
+            {
+                memcpy(m_ScissorRect, rect, sizeof(rect));
+                m_FrameIssuedStateChanges++;
+                m_Backend->SetScissorRect(rect[0], rect[1], rect[2], rect[3]);
+            }
+            else
+            {
+                m_FrameElidedStateChanges++;
+            }
         }
-        else
+        else if (ChangeState(m_ScissorEnabled, 0))
         {
-            glDisable(GL_SCISSOR_TEST);
+            m_Backend->SetScissorEnabled(false);
         }
     }
 
+    void Graphics::InvalidateState()
+    {
+        m_BoundProgram = kUnknownState;
+        m_BoundVertexArray = kUnknownState;
+        m_BlendingEnabled = kUnknownState;
+        m_BlendingSource = kUnknownState;
+        m_BlendingDestination = kUnknownState;
+        m_ScissorEnabled = kUnknownState;
+
+        for (unsigned int i = 0; i < kNumberOfBufferTypes; i++)
+            m_BoundBuffers[i] = kUnknownState;
+
+        for (unsigned int i = 0; i < kMaxTextureUnits; i++)
+            m_BoundTextures[i] = kUnknownState;
+
+        //A negative width or height is never a valid scissor rect
+        for (unsigned int i = 0; i < 4; i++)
+            m_ScissorRect[i] = -1;
+    }
+
+    void Graphics::NewFrame()
+    {
+        m_TotalIssuedStateChanges += m_FrameIssuedStateChanges;
+        m_TotalElidedStateChanges += m_FrameElidedStateChanges;
+        m_LastFrameIssuedStateChanges = m_FrameIssuedStateChanges;
+        m_LastFrameElidedStateChanges = m_FrameElidedStateChanges;
+        m_FrameIssuedStateChanges = 0;
+        m_FrameElidedStateChanges = 0;
+
+        m_Backend->NewFrame();
+    }
+
+    IGraphicsBackend& Graphics::GetBackend()
+    {
+        return *m_Backend;
+    }
+
+    unsigned long long Graphics::GetTotalIssuedStateChanges()
+    {
+        return m_TotalIssuedStateChanges;
+    }
+
+    unsigned long long Graphics::GetTotalElidedStateChanges()
+    {
+        return m_TotalElidedStateChanges;
+    }
+
+    unsigned long long Graphics::GetLastFrameIssuedStateChanges()
+    {
+        return m_LastFrameIssuedStateChanges;
+    }
+
+    unsigned long long Graphics::GetLastFrameElidedStateChanges()
+    {
+        return m_LastFrameElidedStateChanges;
+    }
+
+    bool Graphics::ChangeState(unsigned int& aCachedValue, unsigned int aValue)
+    {
+        if (aCachedValue == aValue)
+        {
+            m_FrameElidedStateChanges++;
+            return false;
+        }
+
+        aCachedValue = aValue;
+        m_FrameIssuedStateChanges++;
+        return true;
+    }
+
     void Graphics::DrawElements(RenderMode renderMode, const std::shared_ptr<VertexArray>& vertexArray, unsigned int indexCount)
     {
-        unsigned int rm = GetOpenGLRenderMode(renderMode);
         unsigned int count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-        glDrawElements(rm, count, GL_UNSIGNED_INT, nullptr);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        m_Backend->DrawElements(renderMode, count, 0);
     }
     
+    void Graphics::DrawElements(RenderMode renderMode, const std::shared_ptr<VertexArray>& vertexArray, unsigned int indexCount, unsigned int baseVertex)
+    {
+        unsigned int count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+        m_Backend->DrawElements(renderMode, count, baseVertex);
+    }
+
+    void Graphics::DrawArraysInstanced(RenderMode renderMode, const std::shared_ptr<VertexArray>& /*vertexArray*/, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance)
+    {
+        m_Backend->DrawArraysInstanced(renderMode, firstVertex, vertexCount, instanceCount, baseInstance);
+    }
+
     void Graphics::CreateTexture(unsigned int* id, int count)
     {
-        glCreateTextures(GL_TEXTURE_2D, count, id);
+        m_Backend->CreateTexture(id, count);
     }
 
     void Graphics::DeleteTexture(unsigned int* id, int count)
     {
-        glDeleteTextures(count, id);
+        //Deleted textures are unbound from every texture unit
+        for (int i = 0; i < count; i++)
+        {
+            for (unsigned int slot = 0; slot < kMaxTextureUnits; slot++)
+            {
+                if (m_BoundTextures[slot] == id[i])
+                    m_BoundTextures[slot] = 0;
+            }
+        }
+
+        m_Backend->DeleteTexture(id, count);
     }
 
     void Graphics::BindTextureUnit(unsigned int id, unsigned int slot)
     {
-        glBindTextureUnit(slot, id);
+        if (slot >= kMaxTextureUnits || ChangeState(m_BoundTextures[slot], id))
+            m_Backend->BindTextureUnit(id, slot);
     }
 
     void Graphics::SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels)
     {
-        glTextureStorage2D(id, levels, GetOpenGLInternalPixelFormat(internalFormat), width, height);
+        m_Backend->SetTextureStorage(id, width, height, internalFormat, levels);
     }
 
     void Graphics::SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter)
     {
-        glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GetOpenGLTextureMinFilter(minFilter));
-        glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GetOpenGLTextureMagFilter(magFilter));
+        m_Backend->SetTextureFilter(id, minFilter, magFilter);
     }
 
     void Graphics::SetTextureData(unsigned int id, const ImageData& imageData)
     {
-        assert(imageData.width > 0 && imageData.height > 0);
-        unsigned int pixelLayout = GetOpenGLPixelLayout(imageData.format.layout);
-        unsigned int pixelSize = GetOpenGLPixelSize(imageData.format.size);
-        glTextureSubImage2D(id, 0, 0, 0, imageData.width, imageData.height, pixelLayout, pixelSize, &imageData.data[0]);
+        m_Backend->SetTextureData(id, imageData);
     }
 
     void Graphics::SetTextureWrap(unsigned int id, Wrap wrap)
     {
-        int wrapModeS = GetOpenGLWrapMode(wrap.s);
-        int wrapModeT = GetOpenGLWrapMode(wrap.t);
-        glTextureParameteri(id, GL_TEXTURE_WRAP_S, wrapModeS);
-        glTextureParameteri(id, GL_TEXTURE_WRAP_T, wrapModeT);
+        m_Backend->SetTextureWrap(id, wrap);
+    }
+
+    void Graphics::CreateTextureArray(unsigned int* id, int count)
+    {
+        m_Backend->CreateTextureArray(id, count);
+    }
+
+    void Graphics::SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat)
+    {
+        m_Backend->SetTextureArrayStorage(id, width, height, layers, internalFormat);
+    }
+
+    void Graphics::CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y)
+    {
+        m_Backend->CopyTextureToTextureArray(sourceId, sourceX, sourceY, width, height, arrayId, layer, x, y);
+    }
+
+    void Graphics::CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers)
+    {
+        m_Backend->CopyTextureArray(sourceId, destinationId, width, height, layers);
+    }
+
+    void Graphics::CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId)
+    {
+        m_Backend->CopyTextureArrayToTexture(arrayId, layer, width, height, textureId);
     }
 
     void Graphics::BindFrameBuffer(unsigned int frameBuffer)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+        m_Backend->BindFrameBuffer(frameBuffer);
     }
 
     void Graphics::GenerateFrameBuffer(unsigned int* frameBuffer)
     {
-        glGenFramebuffers(1, frameBuffer);
+        m_Backend->GenerateFrameBuffer(frameBuffer);
     }
 
     void Graphics::DeleteFrameBuffer(unsigned int* frameBuffer)
     {
-        glDeleteFramebuffers(1, frameBuffer);
+        m_Backend->DeleteFrameBuffer(frameBuffer);
     }
 
     void Graphics::SetFrameBufferStorage(unsigned int frameBuffer, unsigned int textureId)
     {
-        //TODO:
+        m_Backend->SetFrameBufferStorage(frameBuffer, textureId);
     }
 
     void Graphics::CopyFrameBufferContents(unsigned int aFrameBuffer, PixelFormat aFormat, unsigned int aWidth, unsigned int aHeight, unsigned char* aBuffer)
     {
-        //TODO:
+        m_Backend->CopyFrameBufferContents(aFrameBuffer, aFormat, aWidth, aHeight, aBuffer);
     }
     
     void Graphics::CreateBuffer(unsigned int* id, int count)
     {
-        glCreateBuffers(count, id);
+        m_Backend->CreateBuffer(id, count);
     }
 
     void Graphics::DeleteBuffer(unsigned int* id, int count)
     {
-        glDeleteBuffers(count, id);
+        //Deleted buffers are unbound, the index buffer binding belongs to the bound vertex array
+        for (int i = 0; i < count; i++)
+        {
+            for (unsigned int type = 0; type < kNumberOfBufferTypes; type++)
+            {
+                if (m_BoundBuffers[type] == id[i])
+                    m_BoundBuffers[type] = 0;
+            }
+        }
+
+        m_Backend->DeleteBuffer(id, count);
     }
 
     void Graphics::BindBuffer(BufferType bufferType, unsigned int id)
     {
-        glBindBuffer(GetOpenGLBufferType(bufferType), id);
+        if (ChangeState(m_BoundBuffers[static_cast<int>(bufferType)], id))
+            m_Backend->BindBuffer(bufferType, id);
     }
 
     void Graphics::InitBuffer(BufferType bufferType, unsigned int size, const void* data, BufferUsage usage)
     {
-        glBufferData(GetOpenGLBufferType(bufferType), (GLsizeiptr)size, data, GetOpenGLBufferUsage(usage));
+        m_Backend->InitBuffer(bufferType, size, data, usage);
     }
 
     void Graphics::UpdateBuffer(BufferType bufferType, unsigned int offset, unsigned int size, const void* data)
     {
-        glBufferSubData(GetOpenGLBufferType(bufferType), (GLintptr)offset, (GLsizeiptr)size, data);
+        m_Backend->UpdateBuffer(bufferType, offset, size, data);
+    }
+
+    void* Graphics::InitPersistentBuffer(BufferType bufferType, unsigned int size)
+    {
+        return m_Backend->InitPersistentBuffer(bufferType, size);
+    }
+
+    void Graphics::FlushMappedBuffer(unsigned int id, unsigned int offset, unsigned int size)
+    {
+        m_Backend->FlushMappedBuffer(id, offset, size);
+    }
+
+    void* Graphics::CreateFence()
+    {
+        return m_Backend->CreateFence();
+    }
+
+    void Graphics::WaitForFence(void* fence)
+    {
+        m_Backend->WaitForFence(fence);
+    }
+
+    void Graphics::DeleteFence(void* fence)
+    {
+        m_Backend->DeleteFence(fence);
     }
 
     void Graphics::CreateVertexArray(unsigned int* id, int count)
     {
-        glCreateVertexArrays(count, id);
+        m_Backend->CreateVertexArray(id, count);
     }
 
     void Graphics::DeleteVertexArray(unsigned int* id, int count)
     {
-        glDeleteVertexArrays(count, id);
+        for (int i = 0; i < count; i++)
+        {
+            if (m_BoundVertexArray == id[i])
+            {
+                m_BoundVertexArray = 0;
+                m_BoundBuffers[static_cast<int>(BufferType::Index)] = kUnknownState;
+            }
+        }
+
+        m_Backend->DeleteVertexArray(id, count);
     }
 
     void Graphics::BindVertexArray(unsigned int id)
     {
-        glBindVertexArray(id);
+        //The index buffer binding is part of the vertex array's state, it isn't known after switching vertex arrays
+        if (ChangeState(m_BoundVertexArray, id))
+        {
+            m_BoundBuffers[static_cast<int>(BufferType::Index)] = kUnknownState;
+            m_Backend->BindVertexArray(id);
+        }
     }
 
     void Graphics::EnableVertexAttributeArray(unsigned int vertexBuffer)
     {
-        glEnableVertexAttribArray(vertexBuffer);
+        m_Backend->EnableVertexAttributeArray(vertexBuffer);
     }
 
     void Graphics::SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset)
     {
-        GLenum type = GetShaderDataType(element.type);
-        GLboolean normalized = element.normalized ? GL_TRUE : GL_FALSE;
-        glVertexAttribPointer(vertexBuffer, element.GetComponentCount(), type, normalized, stride, offset);
+        m_Backend->SetVertexAttributePointer(vertexBuffer, element, stride, offset);
     }
 
     void Graphics::SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor)
     {
-        glVertexAttribDivisor(vertexBuffer, divisor);
+        m_Backend->SetVertexAttributeDivisor(vertexBuffer, divisor);
     }
 
     unsigned int Graphics::CreateShaderProgram()
     {
-        return glCreateProgram();
+        return m_Backend->CreateShaderProgram();
     }
 
     unsigned int Graphics::CreateShader(ShaderType shaderType)
     {
-        return glCreateShader(GetOpenGLShaderType(shaderType));
+        return m_Backend->CreateShader(shaderType);
     }
 
     void Graphics::SetShaderSource(unsigned int shader, const std::string& source)
     {
-        const GLchar* sourceCStr = source.c_str();
-        glShaderSource(shader, 1, &sourceCStr, 0);
+        m_Backend->SetShaderSource(shader, source);
     }
 
     void Graphics::CompileShader(unsigned int shader)
     {
-        glCompileShader(shader);
+        m_Backend->CompileShader(shader);
     }
 
     void Graphics::DeleteShader(unsigned int shader)
     {
-        glDeleteShader(shader);
+        m_Backend->DeleteShader(shader);
     }
 
     bool Graphics::IsShaderCompiled(unsigned int shader)
     {
-        GLint isCompiled = 0;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
-        return isCompiled == GL_TRUE;
+        return m_Backend->IsShaderCompiled(shader);
     }
 
     std::string Graphics::GetShaderInfoLog(unsigned int shader)
     {
-        GLint maxLength = 0;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
-
-        std::vector<GLchar> infoLog(maxLength);
-        glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
-
-        return std::string(infoLog.begin(), infoLog.end());
+        return m_Backend->GetShaderInfoLog(shader);
     }
 
     void Graphics::AttachShader(unsigned int program, unsigned int shader)
     {
-        glAttachShader(program, shader);
+        m_Backend->AttachShader(program, shader);
     }
 
     void Graphics::DetachShader(unsigned int program, unsigned int shader)
     {
-        glDetachShader(program, shader);
+        m_Backend->DetachShader(program, shader);
     }
 
     void Graphics::LinkShaderProgram(unsigned int program)
     {
-        glLinkProgram(program);
+        m_Backend->LinkShaderProgram(program);
     }
 
     bool Graphics::IsShaderProgramLinked(unsigned int program)
     {
-        GLint isLinked = 0;
-        glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
-        return isLinked == GL_TRUE;
+        return m_Backend->IsShaderProgramLinked(program);
     }
 
     void Graphics::DeleteShaderProgram(unsigned int program)
     {
-        glDeleteProgram(program);
+        //A deleted program stays in use until another one is used, and its id could be reused
+        if (m_BoundProgram == program)
+            m_BoundProgram = kUnknownState;
+
+        m_Backend->DeleteShaderProgram(program);
     }
 
     void Graphics::UseShaderProgram(unsigned int program)
     {
-        glUseProgram(program);
+        if (ChangeState(m_BoundProgram, program))
+            m_Backend->UseShaderProgram(program);
     }
 
     std::string Graphics::GetShaderProgramInfoLog(unsigned int program)
     {
-        GLint maxLength = 0;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
-
-        std::vector<GLchar> infoLog(maxLength);
-        glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
-
-        return std::string(infoLog.begin(), infoLog.end());
+        return m_Backend->GetShaderProgramInfoLog(program);
     }
 
     int Graphics::GetUniformLocation(unsigned int program, const std::string& uniform)
     {
-        return glGetUniformLocation(program, uniform.c_str());
+        return m_Backend->GetUniformLocation(program, uniform);
     }
 
     int Graphics::GetAttributeLocation(unsigned int program, const std::string& attribute)
     {
-        return glGetAttribLocation(program, attribute.c_str());
+        return m_Backend->GetAttributeLocation(program, attribute);
+    }
+
+    unsigned int Graphics::GetNumberOfActiveUniforms(unsigned int program)
+    {
+        return m_Backend->GetNumberOfActiveUniforms(program);
+    }
+
+    std::string Graphics::GetActiveUniformName(unsigned int program, unsigned int index)
+    {
+        return m_Backend->GetActiveUniformName(program, index);
     }
 
     void Graphics::SetUniformInt(int location, int value)
     {
-        glUniform1i(location, value);
+        m_Backend->SetUniformInt(location, value);
     }
 
     void Graphics::SetUniformIntArray(int location, int* values, unsigned int count)
     {
-        glUniform1iv(location, count, values);
+        m_Backend->SetUniformIntArray(location, values, count);
     }
 
     void Graphics::SetUniformFloat(int location, float value)
     {
-        glUniform1f(location, value);
+        m_Backend->SetUniformFloat(location, value);
     }
 
     void Graphics::SetUniformFloat2(int location, float value1, float value2)
     {
-        glUniform2f(location, value1, value2);
+        m_Backend->SetUniformFloat2(location, value1, value2);
     }
 
     void Graphics::SetUniformFloat3(int location, float value1, float value2, float value3)
     {
-        glUniform3f(location, value1, value2, value3);
+        m_Backend->SetUniformFloat3(location, value1, value2, value3);
     }
 
     void Graphics::SetUniformFloat4(int location, float value1, float value2, float value3, float value4)
     {
-        glUniform4f(location, value1, value2, value3, value4);
+        m_Backend->SetUniformFloat4(location, value1, value2, value3, value4);
     }
 
     void Graphics::SetUniformMatrix(int location, const Matrix& value)
     {
-        glUniformMatrix4fv(location, 1, GL_FALSE, &value.m[0][0]);
-    }
-
-    unsigned int Graphics::GetOpenGLGraphicType(GraphicType aType)
-    {
-        unsigned int types[] = { GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT, GL_INT, GL_UNSIGNED_INT, GL_FLOAT, GL_DOUBLE };
-        int index = static_cast<int>(aType);
-        return types[index];
-    }
-
-    unsigned int Graphics::GetOpenGLTextureMinFilter(TextureMinFilter minFilter)
-    {
-        unsigned int types[] = { GL_NEAREST, GL_LINEAR };
-        int index = static_cast<int>(minFilter);
-        return types[index];
-    }
-
-    unsigned int Graphics::GetOpenGLTextureMagFilter(TextureMagFilter magFilter)
-    {
-        unsigned int types[] = { GL_NEAREST, GL_LINEAR };
-        int index = static_cast<int>(magFilter);
-        return types[index];
-    }
-
-    unsigned int Graphics::GetOpenGLPixelLayout(PixelLayout aLayout)
-    {
-        unsigned int layouts[] = { GL_RGB, GL_RGBA };
-        int index = static_cast<int>(aLayout);
-        return layouts[index];
-    }
-
-    unsigned int Graphics::GetOpenGLPixelSize(PixelSize aSize)
-    {
-        unsigned int sizes[] = { GL_UNSIGNED_BYTE };
-        int index = static_cast<int>(aSize);
-        return sizes[index];
-    }
-
-    unsigned int Graphics::GetOpenGLInternalPixelFormat(PixelFormat pixeFormat)
-    {
-        unsigned int layouts[] = { GL_RGB8, GL_RGBA8 };
-        int index = static_cast<int>(pixeFormat.layout);
-        return layouts[index];
-    }
-
-    unsigned int Graphics::GetOpenGLBlendingFactor(BlendingFactor aBlendingFactor)
-    {
-        GLenum blendingFactors[] = { GL_ZERO, GL_ONE, GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_DST_COLOR, GL_ONE_MINUS_DST_COLOR, GL_SRC_ALPHA_SATURATE };
-        int index = static_cast<int>(aBlendingFactor);
-        return blendingFactors[index];
-    }
-
-    int Graphics::GetOpenGLWrapMode(WrapMode aWrapMode)
-    {
-        GLint wrapModes[] = { GL_CLAMP_TO_EDGE, GL_CLAMP_TO_BORDER, GL_REPEAT, GL_MIRRORED_REPEAT };
-        int index = static_cast<int>(aWrapMode);
-        return wrapModes[index];
-    }
-
-    unsigned int Graphics::GetOpenGLRenderMode(RenderMode aRenderMode)
-    {
-        unsigned int renderModes[] = { GL_POINTS, GL_LINES, GL_LINE_LOOP, GL_LINE_STRIP, GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS, GL_LINES_ADJACENCY, GL_LINE_STRIP_ADJACENCY };
-        int index = static_cast<int>(aRenderMode);
-        return renderModes[index];
-    }
-
-    unsigned int Graphics::GetOpenGLBufferUsage(BufferUsage aBufferUsage)
-    {
-        unsigned int bufferUsages[] = { GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY, GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY, GL_DYNAMIC_DRAW, GL_DYNAMIC_READ, GL_DYNAMIC_COPY };
-        int index = static_cast<int>(aBufferUsage);
-        return bufferUsages[index];
-    }
-
-    unsigned int Graphics::GetOpenGLBufferType(BufferType aBufferType)
-    {
-        unsigned int bufferTypes[] = { GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER };
-        int index = static_cast<int>(aBufferType);
-        return bufferTypes[index];
-    }
-
-    unsigned int Graphics::GetOpenGLShaderType(ShaderType aShaderType)
-    {
-        GLenum shaderTypes[] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
-        int index = static_cast<int>(aShaderType);
-        return shaderTypes[index];
-    }
-
-    unsigned int Graphics::GetShaderDataType(ShaderDataType type)
-    {
-        switch (type)
-        {
-        case ShaderDataType::Float:    return GL_FLOAT;
-        case ShaderDataType::Float2:   return GL_FLOAT;
-        case ShaderDataType::Float3:   return GL_FLOAT;
-        case ShaderDataType::Float4:   return GL_FLOAT;
-        case ShaderDataType::Mat3:     return GL_FLOAT;
-        case ShaderDataType::Mat4:     return GL_FLOAT;
-        case ShaderDataType::Int:      return GL_INT;
-        case ShaderDataType::Int2:     return GL_INT;
-        case ShaderDataType::Int3:     return GL_INT;
-        case ShaderDataType::Int4:     return GL_INT;
-        case ShaderDataType::Bool:     return GL_BOOL;
-        }
-
-        return 0;
+        m_Backend->SetUniformMatrix(location, value);
     }
 }
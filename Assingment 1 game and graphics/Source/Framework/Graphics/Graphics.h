@@ -5,6 +5,8 @@
 #include "Color.h"
 #include "Camera.h"
 #include "VertexArray.h"
+#include "IGraphicsBackend.h"
+#include <atomic>
 
 
 namespace GameDev2D
@@ -12,8 +14,12 @@ namespace GameDev2D
     class Graphics
     {
     public:
-        Graphics();
+        //Graphics keeps the cached state, cameras and counters, the backend makes the calls (OpenGL, recording, etc).
+        //The main camera's viewport is width by height, the size of the window
+        Graphics(std::unique_ptr<IGraphicsBackend> backend, unsigned int width, unsigned int height);
         ~Graphics() = default;
+
+        IGraphicsBackend& GetBackend();
         
         unsigned int GetApiVersion();
         unsigned int GetShadingLanguageVersion();
@@ -36,8 +42,29 @@ namespace GameDev2D
         void PopScissorClip();
         void ResetScissorClip();
 
+        //Graphics remembers the bound program, vertex array, buffers, texture units, blending and scissor state, calls
+        //that wouldn't change any of them aren't sent to the backend. Call InvalidateState() if OpenGL is used directly
+        void InvalidateState();
+
+        //Moves the state change counters to the last frame counters and starts a new frame on the backend, called
+        //once per frame by the Application
+        void NewFrame();
+
+        //Returns the number of state changes sent to the backend, and the number skipped because nothing would change.
+        //The totals are added up in NewFrame(), so they can be read while the render thread is drawing
+        unsigned long long GetTotalIssuedStateChanges();
+        unsigned long long GetTotalElidedStateChanges();
+        unsigned long long GetLastFrameIssuedStateChanges();
+        unsigned long long GetLastFrameElidedStateChanges();
+
         void DrawElements(RenderMode renderMode, const std::shared_ptr<VertexArray>& vertexArray, unsigned int indexCount);
 
+        //Same as DrawElements(), but baseVertex is added to every index, used to draw from a region of a StreamingVertexBuffer
+        void DrawElements(RenderMode renderMode, const std::shared_ptr<VertexArray>& vertexArray, unsigned int indexCount, unsigned int baseVertex);
+
+        //Draws vertexCount vertices starting at firstVertex once per instance, the per instance attributes start at baseInstance
+        void DrawArraysInstanced(RenderMode renderMode, const std::shared_ptr<VertexArray>& vertexArray, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance);
+
         void CreateTexture(unsigned int* id, int count = 1);
         void DeleteTexture(unsigned int* id, int count = 1);
         void BindTextureUnit(unsigned int id, unsigned int slot);
@@ -46,6 +73,16 @@ namespace GameDev2D
         void SetTextureData(unsigned int id, const ImageData& imageData);
         void SetTextureWrap(unsigned int id, Wrap wrap);
 
+        //Texture arrays hold layers textures of the same size and format, the filter and wrap functions above work on them too
+        void CreateTextureArray(unsigned int* id, int count = 1);
+        void SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat);
+
+        //Copies a rect of a texture into a layer of a texture array, the first layers of one texture array into another,
+        //or the bottom left of a layer back into a texture
+        void CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y);
+        void CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers);
+        void CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId);
+
         void BindFrameBuffer(unsigned int frameBuffer);
         void GenerateFrameBuffer(unsigned int* frameBuffer);
         void DeleteFrameBuffer(unsigned int* frameBuffer);
@@ -58,6 +95,18 @@ namespace GameDev2D
         void InitBuffer(BufferType bufferType, unsigned int size, const void* aData, BufferUsage usage);
         void UpdateBuffer(BufferType bufferType, unsigned int offset, unsigned int size, const void* data);
 
+        //Creates immutable storage for the bound buffer and maps all of it for writing, the mapping stays valid
+        //(and coherent) while the GPU reads from the buffer, it's released when the buffer is deleted
+        void* InitPersistentBuffer(BufferType bufferType, unsigned int size);
+
+        //Tells the backend which bytes of a persistent buffer were written since the last flush
+        void FlushMappedBuffer(unsigned int id, unsigned int offset, unsigned int size);
+
+        //Fences are used to know when the GPU has finished the commands issued before the fence was created
+        void* CreateFence();
+        void WaitForFence(void* fence);
+        void DeleteFence(void* fence);
+
         void CreateVertexArray(unsigned int* id, int count = 1);
         void DeleteVertexArray(unsigned int* id, int count = 1);
         void BindVertexArray(unsigned int id);
@@ -86,6 +135,9 @@ namespace GameDev2D
         int GetUniformLocation(unsigned int program, const std::string& uniform);
         int GetAttributeLocation(unsigned int program, const std::string& attribute);
 
+        unsigned int GetNumberOfActiveUniforms(unsigned int program);
+        std::string GetActiveUniformName(unsigned int program, unsigned int index);
+
         void SetUniformInt(int location, int value);
         void SetUniformIntArray(int location, int* values, unsigned int count);
         void SetUniformFloat(int location, float value);
@@ -94,47 +146,41 @@ namespace GameDev2D
         void SetUniformFloat4(int location, float value1, float value2, float value3, float value4);
         void SetUniformMatrix(int location, const Matrix& value);
 
-        //Converts the GraphicType data type into the OpenGL constant
-        unsigned int GetOpenGLGraphicType(GraphicType type);
-       
-        unsigned int GetOpenGLTextureMinFilter(TextureMinFilter minFilter);
-        unsigned int GetOpenGLTextureMagFilter(TextureMagFilter magFilter);
-
-        //Converts the PixelFormat::PixelLayout data type into the OpenGL constant
-        unsigned int GetOpenGLPixelLayout(PixelLayout layout);
-
-        //Converts the PixelFormat::PixelSize data type into the OpenGL constant
-        unsigned int GetOpenGLPixelSize(PixelSize size);
-
-        unsigned int GetOpenGLInternalPixelFormat(PixelFormat pixeFormat);
-
-        //Converts the BlendingFactor data type into the OpenGL constant
-        unsigned int GetOpenGLBlendingFactor(BlendingFactor blendingFactor);
-
-        //Converts the Wrap::WrapMode data type into the OpenGL constant
-        int GetOpenGLWrapMode(WrapMode wrapMode);
-
-        //Converts the RenderMode data type into the OpenGL constant
-        unsigned int GetOpenGLRenderMode(RenderMode renderMode);
-
-        //Converts the BufferUsage data type into the OpenGL constant
-        unsigned int GetOpenGLBufferUsage(BufferUsage dataBufferUsage);
-
-        //Converts the BufferType data type into the OpenGL constant
-        unsigned int GetOpenGLBufferType(BufferType dataBufferType);
+    private:
+        //Updates the cached state and returns true if the OpenGL call has to be made, counts it as issued or elided
+        bool ChangeState(unsigned int& cachedValue, unsigned int value);
 
-        //Converts the ShaderType data type into the OpenGL constant
-        unsigned int GetOpenGLShaderType(ShaderType shaderType);
-        
-        //Converts the ShaderDataType data type into the OpenGL constant
-        unsigned int GetShaderDataType(ShaderDataType type);
+        //Used for cached state that no longer matches OpenGL, the next call is always issued
+        static const unsigned int kUnknownState = 0xffffffff;
+        static const unsigned int kMaxTextureUnits = 32;
+        static const unsigned int kNumberOfBufferTypes = 2;
 
-    private:
         //Member variables
+        std::unique_ptr<IGraphicsBackend> m_Backend;
 		Camera m_MainCamera;
         Color m_ClearColor;
 		std::vector<Camera> m_CameraStack;
         std::vector<Rect> m_ScissorStack; 
+
+        //Cached backend state
+        unsigned int m_BoundProgram;
+        unsigned int m_BoundVertexArray;
+        unsigned int m_BoundBuffers[kNumberOfBufferTypes];
+        unsigned int m_BoundTextures[kMaxTextureUnits];
+        unsigned int m_BlendingEnabled;
+        unsigned int m_BlendingSource;
+        unsigned int m_BlendingDestination;
+        unsigned int m_ScissorEnabled;
+        int m_ScissorRect[4];
+
+        //The debug UI reads the totals and last frame counts from the main thread, the frame counts change with every
+        //state change so they're only used by the thread that draws
+        std::atomic<unsigned long long> m_TotalIssuedStateChanges;
+        std::atomic<unsigned long long> m_TotalElidedStateChanges;
+        unsigned long long m_FrameIssuedStateChanges;
+        unsigned long long m_FrameElidedStateChanges;
+        std::atomic<unsigned long long> m_LastFrameIssuedStateChanges;
+        std::atomic<unsigned long long> m_LastFrameElidedStateChanges;
     };
 }
 
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "GraphicTypes.h"
+#include "Buffer.h"
+#include "Color.h"
+#include "../Math/Matrix.h"
+#include <string>
+
+
+namespace GameDev2D
+{
+    //The calls Graphics makes to the GPU API. Graphics keeps the cameras, the scissor stack and the cached state, so
+    //a backend only has to do what it's told: every call it gets is one the renderers really needed to make
+    class IGraphicsBackend
+    {
+    public:
+        virtual ~IGraphicsBackend() = default;
+
+        virtual unsigned int GetApiVersion() = 0;
+        virtual unsigned int GetShadingLanguageVersion() = 0;
+
+        //Called once per frame by Graphics::NewFrame()
+        virtual void NewFrame() = 0;
+
+        virtual void Clear() = 0;
+        virtual void SetClearColor(const Color& clearColor) = 0;
+        virtual void SetViewport(int x, int y, int width, int height) = 0;
+
+        virtual void SetBlendingEnabled(bool enabled) = 0;
+        virtual void SetBlendingFunction(BlendingFactor source, BlendingFactor destination) = 0;
+        virtual void SetScissorEnabled(bool enabled) = 0;
+        virtual void SetScissorRect(int x, int y, int width, int height) = 0;
+
+        //The indices come from the bound vertex array's index buffer, baseVertex is added to each of them
+        virtual void DrawElements(RenderMode renderMode, unsigned int indexCount, unsigned int baseVertex) = 0;
+        virtual void DrawArraysInstanced(RenderMode renderMode, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance) = 0;
+
+        virtual void CreateTexture(unsigned int* id, int count) = 0;
+        virtual void DeleteTexture(unsigned int* id, int count) = 0;
+        virtual void BindTextureUnit(unsigned int id, unsigned int slot) = 0;
+        virtual void SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels) = 0;
+        virtual void SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter) = 0;
+        virtual void SetTextureData(unsigned int id, const ImageData& imageData) = 0;
+        virtual void SetTextureWrap(unsigned int id, Wrap wrap) = 0;
+
+        virtual void CreateTextureArray(unsigned int* id, int count) = 0;
+        virtual void SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat) = 0;
+        virtual void CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y) = 0;
+        virtual void CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers) = 0;
+        virtual void CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId) = 0;
+
+        virtual void BindFrameBuffer(unsigned int frameBuffer) = 0;
+        virtual void GenerateFrameBuffer(unsigned int* frameBuffer) = 0;
+        virtual void DeleteFrameBuffer(unsigned int* frameBuffer) = 0;
+        virtual void SetFrameBufferStorage(unsigned int frameBuffer, unsigned int textureId) = 0;
+        virtual void CopyFrameBufferContents(unsigned int frameBuffer, PixelFormat format, unsigned int width, unsigned int height, unsigned char* buffer) = 0;
+
+        //The buffer functions work on the buffer bound to bufferType
+        virtual void CreateBuffer(unsigned int* id, int count) = 0;
+        virtual void DeleteBuffer(unsigned int* id, int count) = 0;
+        virtual void BindBuffer(BufferType bufferType, unsigned int id) = 0;
+        virtual void InitBuffer(BufferType bufferType, unsigned int size, const void* data, BufferUsage usage) = 0;
+        virtual void UpdateBuffer(BufferType bufferType, unsigned int offset, unsigned int size, const void* data) = 0;
+        virtual void* InitPersistentBuffer(BufferType bufferType, unsigned int size) = 0;
+
+        //Tells the backend size bytes were written at offset in a persistently mapped buffer
+        virtual void FlushMappedBuffer(unsigned int id, unsigned int offset, unsigned int size) = 0;
+
+        virtual void* CreateFence() = 0;
+        virtual void WaitForFence(void* fence) = 0;
+        virtual void DeleteFence(void* fence) = 0;
+
+        virtual void CreateVertexArray(unsigned int* id, int count) = 0;
+        virtual void DeleteVertexArray(unsigned int* id, int count) = 0;
+        virtual void BindVertexArray(unsigned int id) = 0;
+
+        virtual void EnableVertexAttributeArray(unsigned int vertexBuffer) = 0;
+        virtual void SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset) = 0;
+        virtual void SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor) = 0;
+
+        virtual unsigned int CreateShaderProgram() = 0;
+        virtual unsigned int CreateShader(ShaderType shaderType) = 0;
+        virtual void SetShaderSource(unsigned int shader, const std::string& source) = 0;
+        virtual void CompileShader(unsigned int shader) = 0;
+        virtual void DeleteShader(unsigned int shader) = 0;
+        virtual bool IsShaderCompiled(unsigned int shader) = 0;
+        virtual std::string GetShaderInfoLog(unsigned int shader) = 0;
+
+        virtual void AttachShader(unsigned int program, unsigned int shader) = 0;
+        virtual void DetachShader(unsigned int program, unsigned int shader) = 0;
+
+        virtual void LinkShaderProgram(unsigned int program) = 0;
+        virtual bool IsShaderProgramLinked(unsigned int program) = 0;
+        virtual void DeleteShaderProgram(unsigned int program) = 0;
+        virtual void UseShaderProgram(unsigned int program) = 0;
+        virtual std::string GetShaderProgramInfoLog(unsigned int program) = 0;
+
+        virtual int GetUniformLocation(unsigned int program, const std::string& uniform) = 0;
+        virtual int GetAttributeLocation(unsigned int program, const std::string& attribute) = 0;
+
+        virtual unsigned int GetNumberOfActiveUniforms(unsigned int program) = 0;
+        virtual std::string GetActiveUniformName(unsigned int program, unsigned int index) = 0;
+
+        //The uniforms are set on the program in use
+        virtual void SetUniformInt(int location, int value) = 0;
+        virtual void SetUniformIntArray(int location, int* values, unsigned int count) = 0;
+        virtual void SetUniformFloat(int location, float value) = 0;
+        virtual void SetUniformFloat2(int location, float value1, float value2) = 0;
+        virtual void SetUniformFloat3(int location, float value1, float value2, float value3) = 0;
+        virtual void SetUniformFloat4(int location, float value1, float value2, float value3, float value4) = 0;
+        virtual void SetUniformMatrix(int location, const Matrix& value) = 0;
+    };
+}
\ No newline at end of file
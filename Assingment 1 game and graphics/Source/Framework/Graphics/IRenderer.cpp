@@ -10,7 +10,8 @@ namespace GameDev2D
 
     IRenderer::IRenderer() :
         m_TotalDrawCalls(0),
-        m_FrameDrawCalls(0)
+        m_FrameDrawCalls(0),
+        m_LastFrameDrawCalls(0)
     {
     }
 
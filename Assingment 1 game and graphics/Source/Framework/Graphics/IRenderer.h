@@ -1,5 +1,8 @@
 #pragma once
 
+#include "GraphicTypes.h"
+#include "../Math/Matrix.h"
+#include <atomic>
 
 namespace GameDev2D
 {
@@ -11,8 +14,6 @@ namespace GameDev2D
 		Circle
 	};
 
-	class Camera;
-
 	class IRenderer
 	{
 	public:
@@ -21,7 +22,8 @@ namespace GameDev2D
 
 		virtual RendererType GetType() = 0;
 
-		virtual void BeginScene(Camera* camera) = 0;
+		//Only uses the view projection and viewport, so a scene can be drawn without the camera that set it up
+		virtual void BeginScene(const Matrix& viewProjection, const Viewport& viewport) = 0;
 		virtual void EndScene() = 0;
 
 		unsigned long long GetTotalDrawCalls();
@@ -30,10 +32,11 @@ namespace GameDev2D
 	protected:
 		virtual void Flush() = 0;
 		virtual void FlushAndReset() = 0;
-		void NewFrame();
+		virtual void NewFrame();
 
-		unsigned long long m_TotalDrawCalls;
+		//The total and last frame counts are read by the debug UI while the render thread is drawing the next frame
+		std::atomic<unsigned long long> m_TotalDrawCalls;
 		unsigned long long m_FrameDrawCalls;
-		unsigned long long m_LastFrameDrawCalls;
+		std::atomic<unsigned long long> m_LastFrameDrawCalls;
 	};
 }
@@ -0,0 +1,149 @@
+#include "LineExpander.h"
+#include "../Math/BatchMath.h"
+
+
+namespace GameDev2D
+{
+	namespace
+	{
+		//The points before and after the segment points[index] to points[index + 1], a closed outline wraps around
+		//to its other end (skipping the repeated point), an open one continues in a straight line so its ends are square
+		void GetNeighbours(const Vector2* points, unsigned int count, unsigned int index, bool isClosed, Vector2& previous, Vector2& next)
+		{
+			const Vector2& start = points[index];
+			const Vector2& end = points[index + 1];
+
+			if (index > 0)
+				previous = points[index - 1];
+			else
+				previous = isClosed ? points[count - 2] : start + (start - end);
+
+			if (index + 2 < count)
+				next = points[index + 2];
+			else
+				next = isClosed ? points[1] : end + (end - start);
+		}
+
+		//The normal of a segment is its direction rotated counter clockwise. These are written out on floats, the
+		//Vector2 operators aren't inlined and they're most of the cost of expanding the lines on the CPU
+		Vector2 CalculateNormal(const Vector2& start, const Vector2& end)
+		{
+			float x = end.x - start.x;
+			float y = end.y - start.y;
+			float length = sqrtf(x * x + y * y);
+			float scale = length != 0.0f ? 1.0f / length : 0.0f;
+			return Vector2(-y * scale, x * scale);
+		}
+
+		//Returns the miter direction where the segments meet, scaled so the miter is lineWidth away from both segments
+		Vector2 CalculateMiter(const Vector2& normalA, const Vector2& normalB, float lineWidth)
+		{
+			Vector2 miter = CalculateNormal(Vector2::Zero, Vector2(normalA.y + normalB.y, -(normalA.x + normalB.x)));
+			float scale = lineWidth / (miter.x * normalB.x + miter.y * normalB.y);
+			return Vector2(miter.x * scale, miter.y * scale);
+		}
+
+		bool IsOutside(const Vector2& point, const Vector2& area)
+		{
+			return point.x < -area.x || point.x > area.x || point.y < -area.y || point.y > area.y;
+		}
+	}
+
+	bool LineExpander::IsClosed(const Vector2* points, unsigned int count)
+	{
+		return count > 2 && points[0] == points[count - 1];
+	}
+
+	unsigned int LineExpander::WriteStrip(const Vector2* points, unsigned int count, const Vector2& position, float radians, const Vector2& farAway, const Color& color, float lineWidth, LineVertex* out)
+	{
+		//Rotate and offset the points straight into the vertices, leaving room for the first adjacency vertex
+		LineVertex* first = out + 1;
+		BatchMath::RotateTranslate(points, count, radians, position, &first[0].vertices, sizeof(LineVertex));
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			first[i].color = color;
+			first[i].lineWidth = lineWidth;
+		}
+
+		LineVertex* last = first + count - 1;
+		out->vertices = first[0].vertices + (first[0].vertices - first[1].vertices).Normalized() * farAway;
+		out->color = color;
+		out->lineWidth = lineWidth;
+
+		LineVertex* end = last + 1;
+		end->vertices = last->vertices + (last->vertices - (last - 1)->vertices).Normalized() * farAway;
+		end->color = color;
+		end->lineWidth = lineWidth;
+
+		return count + 2;
+	}
+
+	unsigned int LineExpander::WriteSegments(const Vector2* points, unsigned int count, const Color& color, float lineWidth, LineSegmentInstance* out)
+	{
+		bool isClosed = IsClosed(points, count);
+
+		for (unsigned int i = 0; i + 1 < count; i++)
+		{
+			LineSegmentInstance& instance = out[i];
+			GetNeighbours(points, count, i, isClosed, instance.previous, instance.next);
+			instance.start = points[i];
+			instance.end = points[i + 1];
+			instance.color = color;
+			instance.lineWidth = lineWidth;
+		}
+
+		return count - 1;
+	}
+
+	unsigned int LineExpander::WriteQuads(const Vector2* points, unsigned int count, const Color& color, float lineWidth, const Vector2& viewport, LineQuadVertex* out)
+	{
+		bool isClosed = IsClosed(points, count);
+		const Vector2 area = viewport * 1.2f;
+		const Vector2 inverseViewport(1.0f / viewport.x, 1.0f / viewport.y);
+		unsigned int quads = 0;
+
+		//The same math as the geometry shader, except that the miter at a point is only calculated once and shared
+		//by the two segments meeting there, instead of each segment calculating the normals of its neighbours
+		Vector2 previous;
+		Vector2 next;
+		GetNeighbours(points, count, 0, isClosed, previous, next);
+
+		Vector2 normal = CalculateNormal(points[0], points[1]);
+		Vector2 miterStart = CalculateMiter(CalculateNormal(previous, points[0]), normal, lineWidth);
+
+		for (unsigned int i = 0; i + 1 < count; i++)
+		{
+			const Vector2& start = points[i];
+			const Vector2& end = points[i + 1];
+
+			GetNeighbours(points, count, i, isClosed, previous, next);
+			Vector2 normalNext = CalculateNormal(end, next);
+			Vector2 miterEnd = CalculateMiter(normalNext, normal, lineWidth);
+
+			if (IsOutside(start, area) || IsOutside(end, area))
+			{
+				normal = normalNext;
+				miterStart = miterEnd;
+				continue;
+			}
+
+			LineQuadVertex* quad = out + quads * 4;
+			quad[0].position = Vector2((start.x + miterStart.x) * inverseViewport.x, (start.y + miterStart.y) * inverseViewport.y);
+			quad[1].position = Vector2((start.x - miterStart.x) * inverseViewport.x, (start.y - miterStart.y) * inverseViewport.y);
+			quad[2].position = Vector2((end.x + miterEnd.x) * inverseViewport.x, (end.y + miterEnd.y) * inverseViewport.y);
+			quad[3].position = Vector2((end.x - miterEnd.x) * inverseViewport.x, (end.y - miterEnd.y) * inverseViewport.y);
+
+			quad[0].color = color;
+			quad[1].color = color;
+			quad[2].color = color;
+			quad[3].color = color;
+
+			normal = normalNext;
+			miterStart = miterEnd;
+			quads++;
+		}
+
+		return quads;
+	}
+}
\ No newline at end of file
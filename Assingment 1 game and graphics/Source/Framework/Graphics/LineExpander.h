@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Color.h"
+#include "../Math/Vector2.h"
+
+
+namespace GameDev2D
+{
+	//How line strips are turned into triangles. GeometryShader uploads each strip's points (plus an adjacency vertex
+	//at each end) and a lines_adjacency geometry shader builds the mitered quads. Instanced uploads one record per
+	//segment, holding the segment and its neighbouring points, and the vertex shader moves the 4 corners of a shared
+	//quad onto the miters. Cpu builds the mitered quads in screen space and uploads their 4 vertices
+	enum class LineExpansion
+	{
+		GeometryShader = 0,
+		Instanced,
+		Cpu
+	};
+
+	//A strip point for the GeometryShader expansion
+	struct LineVertex
+	{
+		LineVertex() :
+			vertices(Vector2::Zero),
+			color(1.0f, 1.0f, 1.0f, 1.0f),
+			lineWidth(1.0f)
+		{}
+
+		Vector2 vertices;
+		Color color;
+		float lineWidth;
+	};
+
+	//A segment from start to end for the Instanced expansion, previous and next are only used for the miter directions
+	struct LineSegmentInstance
+	{
+		Vector2 previous;
+		Vector2 start;
+		Vector2 end;
+		Vector2 next;
+		Color color;
+		float lineWidth;
+	};
+
+	//An instance of a registered shape for the GeometryShader expansion, the outline is rotated and positioned on the GPU
+	struct LineShapeInstance
+	{
+		Vector2 position;
+		float radians;
+		Color color;
+		float lineWidth;
+	};
+
+	//A corner of a mitered quad for the Cpu expansion, the position is already in normalized device coordinates
+	struct LineQuadVertex
+	{
+		Vector2 position;
+		Color color;
+	};
+
+	//Writes the vertices, instances or quads for a line strip. It doesn't use OpenGL, so the headless benchmarks can
+	//compare the cost of each LineExpansion. A strip whose first and last points are the same is a closed outline and
+	//every corner is mitered, the ends of an open strip are square
+	struct LineExpander
+	{
+		//Returns true if the strip is a closed outline
+		static bool IsClosed(const Vector2* points, unsigned int count);
+
+		//Rotates and offsets the points into out[1] to out[count], and adds the adjacency vertices at out[0] and out[count + 1].
+		//The adjacency vertices are pushed farAway, so the geometry shader culls the segments joining one strip to the next.
+		//Returns the number of vertices written, count + 2
+		static unsigned int WriteStrip(const Vector2* points, unsigned int count, const Vector2& position, float radians, const Vector2& farAway, const Color& color, float lineWidth, LineVertex* out);
+
+		//Writes an instance for each segment of the (already transformed) points, returns the number written, count - 1
+		static unsigned int WriteSegments(const Vector2* points, unsigned int count, const Color& color, float lineWidth, LineSegmentInstance* out);
+
+		//Writes 4 vertices for each segment of the points, which have to be in screen space (normalized device coordinates
+		//times the viewport). Segments outside of the viewport (with a 20% margin) are culled, the same as the geometry
+		//shader does. The corners are in triangle strip order, returns the number of quads written
+		static unsigned int WriteQuads(const Vector2* points, unsigned int count, const Color& color, float lineWidth, const Vector2& viewport, LineQuadVertex* out);
+	};
+}
\ No newline at end of file
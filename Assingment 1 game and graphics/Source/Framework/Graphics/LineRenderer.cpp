@@ -1,21 +1,53 @@
 #include "LineRenderer.h"
-#include "../Application/Application.h"
+#include "Graphics.h"
+#include "../Resources/ResourceCache.h"
+#include "../Math/BatchMath.h"
 #include "../Math/Math.h"
+#include "../Debug/Log.h"
+#include "../Memory/AllocationCounter.h"
+#include <algorithm>
 
 
 namespace GameDev2D
 {
-	LineRenderer::LineRenderer() :
+	LineRenderer::LineRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache) :
+		m_Graphics(graphics),
 		m_LineVertexArray(nullptr),
 		m_LineVertexBuffer(nullptr),
 		m_LineShader(nullptr),
 		m_LineIndexCount(0),
 		m_LineVertexBufferBase(nullptr),
-		m_LineVertexBufferPtr(nullptr)
+		m_LineVertexBufferPtr(nullptr),
+		m_LineVertexBufferEnd(nullptr),
+		m_SegmentVertexArray(nullptr),
+		m_SegmentCornerBuffer(nullptr),
+		m_SegmentInstanceBuffer(nullptr),
+		m_SegmentShader(nullptr),
+		m_SegmentCount(0),
+		m_SegmentInstanceBufferBase(nullptr),
+		m_SegmentInstanceBufferPtr(nullptr),
+		m_SegmentInstanceBufferEnd(nullptr),
+		m_QuadVertexArray(nullptr),
+		m_QuadVertexBuffer(nullptr),
+		m_QuadShader(nullptr),
+		m_QuadIndexCount(0),
+		m_QuadVertexBufferBase(nullptr),
+		m_QuadVertexBufferPtr(nullptr),
+		m_QuadVertexBufferEnd(nullptr),
+		m_ScreenTransform(),
+		m_Viewport(Vector2::Zero),
+		m_Expansion(LineExpansion::GeometryShader),
+		m_ShapeVertexArray(nullptr),
+		m_ShapeVertexBuffer(nullptr),
+		m_ShapeInstanceBuffer(nullptr),
+		m_ShapeShader(nullptr),
+		m_IsShapeBufferDirty(false),
+		m_FrameAllocations(0),
+		m_LastFrameAllocations(0)
 	{
-		m_LineVertexArray = std::make_shared<VertexArray>();
+		m_LineVertexArray = std::make_shared<VertexArray>(m_Graphics);
 
-		m_LineVertexBuffer = std::make_shared<VertexBuffer>(kMaxVertices * sizeof(LineVertex));
+		m_LineVertexBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxVertices * sizeof(LineVertex));
 		m_LineVertexBuffer->SetLayout({
 			{ ShaderDataType::Float2, "a_Vertices" },
 			{ ShaderDataType::Float4, "a_Color" },
@@ -24,27 +56,112 @@ namespace GameDev2D
 
 		m_LineVertexArray->AddVertexBuffer(m_LineVertexBuffer);
 
-		m_LineVertexBufferBase = new LineVertex[kMaxVertices];
 		unsigned int* lineIndices = new unsigned int[kMaxIndices];
 		for (unsigned int i = 0; i < kMaxIndices; i++)
 		{
 			lineIndices[i] = i;
 		}
 
-		std::shared_ptr<IndexBuffer> quadIB = std::make_shared<IndexBuffer>(lineIndices, kMaxIndices);
+		std::shared_ptr<IndexBuffer> quadIB = std::make_shared<IndexBuffer>(m_Graphics, lineIndices, kMaxIndices);
 		m_LineVertexArray->SetIndexBuffer(quadIB);
 		delete[] lineIndices;
 
-		m_LineShader = Application::Get().GetResourceManager().GetShaderCache().GetShared(LINE_RENDERER_SHADER_KEY);
-	}
+		m_LineShader = shaderCache.GetShared(LINE_RENDERER_SHADER_KEY);
+		m_LineViewProjectionUniform = m_LineShader->GetUniform<Matrix>("u_ViewProjection");
+		m_LineViewportUniform = m_LineShader->GetUniform<Vector2>("u_Viewport");
 
-	LineRenderer::~LineRenderer()
-	{
-		if (m_LineVertexBufferBase != nullptr)
+		//The Instanced expansion draws every segment from the same four corners, in triangle strip order. x picks
+		//the start or end of the segment and y the side of the line the corner is on
+		m_SegmentVertexArray = std::make_shared<VertexArray>(m_Graphics);
+
+		float segmentCorners[] = {
+			0.0f,  1.0f,
+			0.0f, -1.0f,
+			1.0f,  1.0f,
+			1.0f, -1.0f
+		};
+
+		m_SegmentCornerBuffer = std::make_shared<VertexBuffer>(m_Graphics, segmentCorners, (unsigned int)sizeof(segmentCorners));
+		m_SegmentCornerBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Corner" }
+		});
+		m_SegmentVertexArray->AddVertexBuffer(m_SegmentCornerBuffer);
+
+		m_SegmentInstanceBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxSegments * sizeof(LineSegmentInstance));
+		m_SegmentInstanceBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Previous" },
+			{ ShaderDataType::Float2, "a_Start" },
+			{ ShaderDataType::Float2, "a_End" },
+			{ ShaderDataType::Float2, "a_Next" },
+			{ ShaderDataType::Float4, "a_Color" },
+			{ ShaderDataType::Float, "a_LineWidth" }
+		});
+		m_SegmentVertexArray->AddVertexBuffer(m_SegmentInstanceBuffer, 1);
+
+		m_SegmentShader = shaderCache.GetShared(LINE_INSTANCE_RENDERER_SHADER_KEY);
+		m_SegmentViewProjectionUniform = m_SegmentShader->GetUniform<Matrix>("u_ViewProjection");
+		m_SegmentViewportUniform = m_SegmentShader->GetUniform<Vector2>("u_Viewport");
+
+		//The Cpu expansion uploads the four corners of each segment's quad, already in normalized device coordinates
+		m_QuadVertexArray = std::make_shared<VertexArray>(m_Graphics);
+
+		m_QuadVertexBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxQuadVertices * sizeof(LineQuadVertex));
+		m_QuadVertexBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Position" },
+			{ ShaderDataType::Float4, "a_Color" }
+		});
+		m_QuadVertexArray->AddVertexBuffer(m_QuadVertexBuffer);
+
+		unsigned int* quadIndices = new unsigned int[kMaxQuadIndices];
+
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < kMaxQuadIndices; i += kQuadIndexCount)
 		{
-			delete[] m_LineVertexBufferBase;
-			m_LineVertexBufferBase = nullptr;
+			quadIndices[i + 0] = offset + 0;
+			quadIndices[i + 1] = offset + 1;
+			quadIndices[i + 2] = offset + 2;
+
+			quadIndices[i + 3] = offset + 2;
+			quadIndices[i + 4] = offset + 1;
+			quadIndices[i + 5] = offset + 3;
+
+			offset += kQuadVertexCount;
 		}
+
+		std::shared_ptr<IndexBuffer> segmentIB = std::make_shared<IndexBuffer>(m_Graphics, quadIndices, kMaxQuadIndices);
+		m_QuadVertexArray->SetIndexBuffer(segmentIB);
+		delete[] quadIndices;
+
+		m_QuadShader = shaderCache.GetShared(LINE_QUAD_RENDERER_SHADER_KEY);
+
+		//A strip can have at most one point more than there are segments in a batch
+		m_StripPoints.resize(kMaxSegments + 1);
+
+		//The shape outlines are uploaded once, each instance only sends its position, rotation, color and width
+		m_ShapeVertexArray = std::make_shared<VertexArray>(m_Graphics);
+
+		m_ShapeVertexBuffer = std::make_shared<VertexBuffer>(m_Graphics, kMaxShapeVertices * sizeof(Vector2));
+		m_ShapeVertexBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Vertices" },
+		});
+		m_ShapeVertexArray->AddVertexBuffer(m_ShapeVertexBuffer);
+
+		m_ShapeInstanceBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxShapeInstances * sizeof(LineShapeInstance));
+		m_ShapeInstanceBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Position" },
+			{ ShaderDataType::Float, "a_Radians" },
+			{ ShaderDataType::Float4, "a_Color" },
+			{ ShaderDataType::Float, "a_LineWidth" },
+		});
+		m_ShapeVertexArray->AddVertexBuffer(m_ShapeInstanceBuffer, 1);
+
+		m_ShapeVertices.reserve(kMaxShapeVertices);
+		m_ShapeInstances.reserve(kMaxShapeInstances);
+		m_ShapeInstanceIds.reserve(kMaxShapeInstances);
+
+		m_ShapeShader = shaderCache.GetShared(LINE_SHAPE_RENDERER_SHADER_KEY);
+		m_ShapeViewProjectionUniform = m_ShapeShader->GetUniform<Matrix>("u_ViewProjection");
+		m_ShapeViewportUniform = m_ShapeShader->GetUniform<Vector2>("u_Viewport");
 	}
 
 	RendererType LineRenderer::GetType()
@@ -52,33 +169,128 @@ namespace GameDev2D
 		return RendererType::Line;
 	}
 
-	void LineRenderer::BeginScene(Camera* camera)
+	void LineRenderer::BeginScene(const Matrix& viewProjection, const Viewport& viewport)
 	{
+		Vector2 viewportSize((float)viewport.width, (float)viewport.height);
+
+		m_ShapeShader->Bind();
+		m_ShapeShader->Set(m_ShapeViewProjectionUniform, viewProjection);
+		m_ShapeShader->Set(m_ShapeViewportUniform, viewportSize);
+
+		m_SegmentShader->Bind();
+		m_SegmentShader->Set(m_SegmentViewProjectionUniform, viewProjection);
+		m_SegmentShader->Set(m_SegmentViewportUniform, viewportSize);
+
 		m_LineShader->Bind();
-		m_LineShader->SetMat4("u_ViewProjection", camera->GetViewProjectionMatrix());
-		m_LineShader->SetFloat2("u_Viewport", (float)camera->GetViewport().width, (float)camera->GetViewport().height);
-	
-		m_LineIndexCount = 0;
-		m_LineVertexBufferPtr = m_LineVertexBufferBase;
+		m_LineShader->Set(m_LineViewProjectionUniform, viewProjection);
+		m_LineShader->Set(m_LineViewportUniform, viewportSize);
+
+		//Takes a point from world space to the screen space the geometry shader works in
+		m_ScreenTransform = Affine2D::MakeScale(viewportSize) * Affine2D(viewProjection);
+		m_Viewport = viewportSize;
+
+		BeginLines(false);
 	}
 
 	void LineRenderer::EndScene()
 	{
-		unsigned int dataSize = (unsigned int)((unsigned char*)m_LineVertexBufferPtr - (unsigned char*)m_LineVertexBufferBase);
-		m_LineVertexBuffer->SetData(m_LineVertexBufferBase, dataSize);
+		EndLines();
+		FlushShapes();
+	}
 
+	void LineRenderer::BeginLines(bool fullRegion)
+	{
+		switch (m_Expansion)
+		{
+		case LineExpansion::Instanced:
+			m_SegmentCount = 0;
+			m_SegmentInstanceBufferBase = (LineSegmentInstance*)m_SegmentInstanceBuffer->Begin(fullRegion ? kMaxSegments * sizeof(LineSegmentInstance) : 0);
+			m_SegmentInstanceBufferPtr = m_SegmentInstanceBufferBase;
+			m_SegmentInstanceBufferEnd = m_SegmentInstanceBufferBase + m_SegmentInstanceBuffer->GetAvailableSize() / sizeof(LineSegmentInstance);
+			break;
+
+		case LineExpansion::Cpu:
+			m_QuadIndexCount = 0;
+			m_QuadVertexBufferBase = (LineQuadVertex*)m_QuadVertexBuffer->Begin(fullRegion ? kMaxQuadVertices * sizeof(LineQuadVertex) : 0);
+			m_QuadVertexBufferPtr = m_QuadVertexBufferBase;
+			m_QuadVertexBufferEnd = m_QuadVertexBufferBase + m_QuadVertexBuffer->GetAvailableSize() / sizeof(LineQuadVertex);
+			break;
+
+		default:
+			m_LineIndexCount = 0;
+			m_LineVertexBufferBase = (LineVertex*)m_LineVertexBuffer->Begin(fullRegion ? kMaxVertices * sizeof(LineVertex) : 0);
+			m_LineVertexBufferPtr = m_LineVertexBufferBase;
+			m_LineVertexBufferEnd = m_LineVertexBufferBase + m_LineVertexBuffer->GetAvailableSize() / sizeof(LineVertex);
+			break;
+		}
+	}
+
+	void LineRenderer::EndLines()
+	{
+		//The vertices were written straight into the mapped buffer, they only need to be drawn
 		Flush();
+
+		unsigned int dataSize = 0;
+		switch (m_Expansion)
+		{
+		case LineExpansion::Instanced:
+			dataSize = (unsigned int)((unsigned char*)m_SegmentInstanceBufferPtr - (unsigned char*)m_SegmentInstanceBufferBase);
+			m_SegmentInstanceBuffer->End(dataSize);
+			m_SegmentCount = 0;
+			m_SegmentInstanceBufferBase = m_SegmentInstanceBufferPtr;
+			break;
+
+		case LineExpansion::Cpu:
+			dataSize = (unsigned int)((unsigned char*)m_QuadVertexBufferPtr - (unsigned char*)m_QuadVertexBufferBase);
+			m_QuadVertexBuffer->End(dataSize);
+			m_QuadIndexCount = 0;
+			m_QuadVertexBufferBase = m_QuadVertexBufferPtr;
+			break;
+
+		default:
+			dataSize = (unsigned int)((unsigned char*)m_LineVertexBufferPtr - (unsigned char*)m_LineVertexBufferBase);
+			m_LineVertexBuffer->End(dataSize);
+			m_LineIndexCount = 0;
+			m_LineVertexBufferBase = m_LineVertexBufferPtr;
+			break;
+		}
 	}
 
 	void LineRenderer::Flush()
 	{
-		if (m_LineIndexCount == 0)
-			return;
+		switch (m_Expansion)
+		{
+		case LineExpansion::Instanced:
+			if (m_SegmentCount == 0)
+				return;
+
+			m_SegmentShader->Bind();
+			m_SegmentVertexArray->Bind();
+
+			m_Graphics.DrawArraysInstanced(RenderMode::TriangleStrip, m_SegmentVertexArray, 0, kQuadVertexCount, m_SegmentCount, m_SegmentInstanceBuffer->GetWriteOffset() / sizeof(LineSegmentInstance));
+			break;
+
+		case LineExpansion::Cpu:
+			if (m_QuadIndexCount == 0)
+				return;
+
+			m_QuadShader->Bind();
+			m_QuadVertexArray->Bind();
+
+			m_Graphics.DrawElements(RenderMode::Triangles, m_QuadVertexArray, m_QuadIndexCount, m_QuadVertexBuffer->GetWriteOffset() / sizeof(LineQuadVertex));
+			break;
+
+		default:
+			if (m_LineIndexCount == 0)
+				return;
+
+			m_LineShader->Bind();
+			m_LineVertexArray->Bind();
+
+			m_Graphics.DrawElements(RenderMode::LineStripAdjacent, m_LineVertexArray, m_LineIndexCount, m_LineVertexBuffer->GetWriteOffset() / sizeof(LineVertex));
+			break;
+		}
 
-		m_LineVertexArray->Bind();
-		
-		Application::Get().GetGraphics().DrawElements(RenderMode::LineStripAdjacent, m_LineVertexArray, m_LineIndexCount);
-		
 		m_TotalDrawCalls++;
 		m_FrameDrawCalls++;
 	}
@@ -90,66 +302,322 @@ namespace GameDev2D
 
 	void LineRenderer::RenderLine(const LineSegment& lineSegment, const Color& color, float lineWidth)
 	{
-		std::vector<Vector2> vertices;
-		vertices.push_back(lineSegment.start);
-		vertices.push_back(lineSegment.end);
-		RenderLineStrip(vertices, color, lineWidth);
+		Vector2 vertices[2] = { lineSegment.start, lineSegment.end };
+		RenderLineStrip(vertices, 2, color, lineWidth, Vector2::Zero, 0.0f);
 	}
 
 	void LineRenderer::RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth)
 	{
-		RenderLineStrip( points, color, lineWidth, Vector2(0,0), 0 );
+		RenderLineStrip(points.data(), (unsigned int)points.size(), color, lineWidth, Vector2::Zero, 0.0f);
 	}
 
 	void LineRenderer::RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth, const Vector2& position, float radians)
 	{
-		if (m_LineIndexCount >= kMaxIndices)
+		RenderLineStrip(points.data(), (unsigned int)points.size(), color, lineWidth, position, radians);
+	}
+
+	void LineRenderer::RenderLineStrip(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		if (numberOfPoints < 2)
+		{
+			return;
+		}
+
+		unsigned long long allocations = AllocationCounter::GetNumberOfThreadAllocations();
+
+		switch (m_Expansion)
+		{
+		case LineExpansion::Instanced:
+			RenderStripInstanced(points, numberOfPoints, color, lineWidth, position, radians);
+			break;
+
+		case LineExpansion::Cpu:
+			RenderStripQuads(points, numberOfPoints, color, lineWidth, position, radians);
+			break;
+
+		default:
+			RenderStripAdjacent(points, numberOfPoints, color, lineWidth, position, radians);
+			break;
+		}
+
+		m_FrameAllocations += AllocationCounter::GetNumberOfThreadAllocations() - allocations;
+	}
+
+	void LineRenderer::RenderStripAdjacent(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		//Every strip needs its points plus an adjacency vertex at each end
+		const unsigned int vertexCount = numberOfPoints + 2;
+		if (vertexCount > kMaxVertices)
+		{
+			Log::Error(false, LogVerbosity::Graphics, "[LineRenderer] A line strip with %u points doesn't fit in the vertex buffer", numberOfPoints);
+			return;
+		}
+
+		if (m_LineIndexCount + vertexCount > kMaxIndices || m_LineVertexBufferPtr + vertexCount > m_LineVertexBufferEnd)
+		{
+			FlushAndReset();
+		}
+
+		//The adjacency vertices are pushed far off screen, so the segments joining one strip to the next are culled
+		const Vector2 farAway = m_Viewport * 10.0f;
+
+		LineExpander::WriteStrip(points, numberOfPoints, position, radians, farAway, color, lineWidth, m_LineVertexBufferPtr);
+
+		m_LineVertexBufferPtr += vertexCount;
+		m_LineIndexCount += vertexCount;
+	}
+
+	void LineRenderer::RenderStripInstanced(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		//Each segment is its own instance, so nothing has to be added between strips
+		const unsigned int segmentCount = numberOfPoints - 1;
+		if (segmentCount > kMaxSegments)
+		{
+			Log::Error(false, LogVerbosity::Graphics, "[LineRenderer] A line strip with %u points doesn't fit in the instance buffer", numberOfPoints);
+			return;
+		}
+
+		if (m_SegmentCount + segmentCount > kMaxSegments || m_SegmentInstanceBufferPtr + segmentCount > m_SegmentInstanceBufferEnd)
+		{
+			FlushAndReset();
+		}
+
+		BatchMath::RotateTranslate(points, numberOfPoints, radians, position, m_StripPoints.data());
+		LineExpander::WriteSegments(m_StripPoints.data(), numberOfPoints, color, lineWidth, m_SegmentInstanceBufferPtr);
+
+		m_SegmentInstanceBufferPtr += segmentCount;
+		m_SegmentCount += segmentCount;
+	}
+
+	void LineRenderer::RenderStripQuads(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		const unsigned int segmentCount = numberOfPoints - 1;
+		if (segmentCount > kMaxSegments)
+		{
+			Log::Error(false, LogVerbosity::Graphics, "[LineRenderer] A line strip with %u points doesn't fit in the vertex buffer", numberOfPoints);
+			return;
+		}
+
+		if (m_QuadIndexCount + segmentCount * kQuadIndexCount > kMaxQuadIndices || m_QuadVertexBufferPtr + segmentCount * kQuadVertexCount > m_QuadVertexBufferEnd)
 		{
 			FlushAndReset();
 		}
 
-		if (points.size() > 1)
+		//Rotate, offset and project the points in one pass, then build the mitered quads of the segments that are on screen
+		BatchMath::Transform(m_ScreenTransform * Affine2D::Make(position, radians), points, numberOfPoints, m_StripPoints.data());
+		unsigned int quadCount = LineExpander::WriteQuads(m_StripPoints.data(), numberOfPoints, color, lineWidth, m_Viewport, m_QuadVertexBufferPtr);
+
+		m_QuadVertexBufferPtr += quadCount * kQuadVertexCount;
+		m_QuadIndexCount += quadCount * kQuadIndexCount;
+	}
+
+	void LineRenderer::FlushShapes()
+	{
+		if (m_ShapeInstances.empty())
+			return;
+
+		if (m_IsShapeBufferDirty)
+		{
+			m_ShapeVertexBuffer->SetData(m_ShapeVertices.data(), (unsigned int)(m_ShapeVertices.size() * sizeof(Vector2)));
+			m_IsShapeBufferDirty = false;
+		}
+
+		//Group the instances by shape (counting sort), so that each shape is drawn with one instanced draw call
+		for (Shape& shape : m_Shapes)
+		{
+			shape.instanceCount = 0;
+		}
+
+		for (unsigned int shapeId : m_ShapeInstanceIds)
 		{
-			// Rotate and offset the points.
-			std::vector<Vector2> transformedPoints;
-			for (unsigned int i = 0; i < points.size(); i++)
+			m_Shapes[shapeId].instanceCount++;
+		}
+
+		unsigned int baseInstance = 0;
+		for (Shape& shape : m_Shapes)
+		{
+			shape.baseInstance = baseInstance;
+			baseInstance += shape.instanceCount;
+			shape.instanceCount = 0;
+		}
+
+		//The sorted instances are written straight into the mapped instance buffer
+		const unsigned int dataSize = (unsigned int)(m_ShapeInstances.size() * sizeof(LineShapeInstance));
+		LineShapeInstance* sortedInstances = (LineShapeInstance*)m_ShapeInstanceBuffer->Begin(dataSize);
+		const unsigned int firstInstance = m_ShapeInstanceBuffer->GetWriteOffset() / sizeof(LineShapeInstance);
+
+		for (size_t i = 0; i < m_ShapeInstances.size(); i++)
+		{
+			Shape& shape = m_Shapes[m_ShapeInstanceIds[i]];
+			sortedInstances[shape.baseInstance + shape.instanceCount] = m_ShapeInstances[i];
+			shape.instanceCount++;
+		}
+
+		m_ShapeShader->Bind();
+		m_ShapeVertexArray->Bind();
+
+		for (const Shape& shape : m_Shapes)
+		{
+			if (shape.instanceCount > 0)
 			{
-				transformedPoints.push_back( position + Vector2( points[i].x * cosf(radians) - points[i].y * sinf(radians), points[i].x * sinf(radians) + points[i].y * cosf(radians) ) );
+				m_Graphics.DrawArraysInstanced(RenderMode::LineStripAdjacent, m_ShapeVertexArray, shape.firstVertex, shape.vertexCount, shape.instanceCount, firstInstance + shape.baseInstance);
+
+				m_TotalDrawCalls++;
+				m_FrameDrawCalls++;
 			}
+		}
+
+		m_ShapeInstanceBuffer->End(dataSize);
+
+		m_ShapeInstances.clear();
+		m_ShapeInstanceIds.clear();
+	}
+
+	unsigned int LineRenderer::RegisterShape(const Vector2* points, unsigned int numberOfPoints)
+	{
+		//A shape needs at least one segment, plus room for the two adjacency vertices
+		if (numberOfPoints < 2 || m_ShapeVertices.size() + numberOfPoints + 2 > kMaxShapeVertices)
+		{
+			Log::Error(false, LogVerbosity::Graphics, "[LineRenderer] Unable to register a line shape with %u points", numberOfPoints);
+			return 0;
+		}
+
+		Shape shape;
+		shape.firstVertex = (unsigned int)m_ShapeVertices.size();
+		shape.vertexCount = numberOfPoints + 2;
+		shape.instanceCount = 0;
+		shape.baseInstance = 0;
+		shape.radius = 0.0f;
+
+		//The adjacency vertices only give the geometry shader the direction of the neighbouring segments. A closed
+		//outline wraps around to its other end, an open one continues in a straight line so its ends are square
+		const Vector2& first = points[0];
+		const Vector2& last = points[numberOfPoints - 1];
+		bool isClosed = numberOfPoints > 2 && first == last;
+
+		m_ShapeVertices.push_back(isClosed ? points[numberOfPoints - 2] : first + (first - points[1]));
+		for (unsigned int i = 0; i < numberOfPoints; i++)
+		{
+			m_ShapeVertices.push_back(points[i]);
+			shape.radius = fmaxf(shape.radius, sqrtf(points[i].x * points[i].x + points[i].y * points[i].y));
+		}
+		m_ShapeVertices.push_back(isClosed ? points[1] : last + (last - points[numberOfPoints - 2]));
 
-			float windowWidth = static_cast<float>(Application::Get().GetWindow().GetWidth());
-			float windowHeight = static_cast<float>(Application::Get().GetWindow().GetHeight());
+		m_IsShapeBufferDirty = true;
 
-			//First, add an adjacency vertex at the beginning
-			m_LineVertexBufferPtr->vertices = transformedPoints[0] + (transformedPoints[0] - transformedPoints[1]).Normalized() * (Vector2(windowWidth, windowHeight) * 10.0f);
-			m_LineVertexBufferPtr->color = color;
-			m_LineVertexBufferPtr->lineWidth = lineWidth;
-			m_LineVertexBufferPtr++;
+		m_Shapes.push_back(shape);
+		return (unsigned int)m_Shapes.size() - 1;
+	}
+
+	void LineRenderer::RenderShape(unsigned int shapeId, const Vector2& position, float radians, const Color& color, float lineWidth)
+	{
+		if (shapeId >= m_Shapes.size())
+		{
+			return;
+		}
+
+		//Only the geometry shader draws the shapes as instances, the other expansions draw the outline as a line strip
+		if (m_Expansion != LineExpansion::GeometryShader)
+		{
+			const Shape& shape = m_Shapes[shapeId];
+			RenderLineStrip(&m_ShapeVertices[shape.firstVertex + 1], shape.vertexCount - 2, color, lineWidth, position, radians);
+			return;
+		}
+
+		if (m_ShapeInstances.size() >= kMaxShapeInstances)
+		{
+			FlushShapes();
+		}
+
+		unsigned long long allocations = AllocationCounter::GetNumberOfThreadAllocations();
+
+		LineShapeInstance instance;
+		instance.position = position;
+		instance.radians = radians;
+		instance.color = color;
+		instance.lineWidth = lineWidth;
+
+		m_ShapeInstances.push_back(instance);
+		m_ShapeInstanceIds.push_back(shapeId);
+
+		m_FrameAllocations += AllocationCounter::GetNumberOfThreadAllocations() - allocations;
+	}
 
-			for (unsigned int i = 0; i < transformedPoints.size(); i++)
+	void LineRenderer::RenderShapes(const LineShapeInstance* instances, const unsigned int* shapeIds, unsigned int count)
+	{
+		if (m_Expansion != LineExpansion::GeometryShader)
+		{
+			for (unsigned int i = 0; i < count; i++)
 			{
-				m_LineVertexBufferPtr->vertices = transformedPoints.at(i);
-				m_LineVertexBufferPtr->color = color;
-				m_LineVertexBufferPtr->lineWidth = lineWidth;
-				m_LineVertexBufferPtr++;
+				RenderShape(shapeIds[i], instances[i].position, instances[i].radians, instances[i].color, instances[i].lineWidth);
 			}
+			return;
+		}
 
-			//Next, add an adjacency vertex at the end
-			unsigned int n = transformedPoints.size();
-			m_LineVertexBufferPtr->vertices = transformedPoints[n - 1] + (transformedPoints[n - 1] - transformedPoints[n - 2]).Normalized() * ((windowWidth, windowHeight) * 10.0f);
-			m_LineVertexBufferPtr->color = color;
-			m_LineVertexBufferPtr->lineWidth = lineWidth;
-			m_LineVertexBufferPtr++;
+		unsigned long long allocations = AllocationCounter::GetNumberOfThreadAllocations();
 
-			m_LineIndexCount += transformedPoints.size() + 2;
+		//The instances are copied up to the size of the instance buffer at a time
+		while (count > 0)
+		{
+			if (m_ShapeInstances.size() >= kMaxShapeInstances)
+			{
+				FlushShapes();
+			}
+
+			unsigned int copyCount = std::min(count, kMaxShapeInstances - (unsigned int)m_ShapeInstances.size());
+			m_ShapeInstances.insert(m_ShapeInstances.end(), instances, instances + copyCount);
+			m_ShapeInstanceIds.insert(m_ShapeInstanceIds.end(), shapeIds, shapeIds + copyCount);
+
+			instances += copyCount;
+			shapeIds += copyCount;
+			count -= copyCount;
 		}
+
+		m_FrameAllocations += AllocationCounter::GetNumberOfThreadAllocations() - allocations;
+	}
+
+	unsigned long long LineRenderer::GetLastFrameAllocations()
+	{
+		return m_LastFrameAllocations;
+	}
+
+	void LineRenderer::NewFrame()
+	{
+		IRenderer::NewFrame();
+		m_LineVertexBuffer->NextRegion();
+		m_SegmentInstanceBuffer->NextRegion();
+		m_QuadVertexBuffer->NextRegion();
+		m_ShapeInstanceBuffer->NextRegion();
+
+		m_LastFrameAllocations = m_FrameAllocations;
+		m_FrameAllocations = 0;
+	}
+
+	unsigned int LineRenderer::GetNumberOfShapes() const
+	{
+		return (unsigned int)m_Shapes.size();
+	}
+
+	float LineRenderer::GetShapeRadius(unsigned int shapeId) const
+	{
+		return shapeId < m_Shapes.size() ? m_Shapes[shapeId].radius : 0.0f;
+	}
+
+	void LineRenderer::SetExpansion(LineExpansion expansion)
+	{
+		m_Expansion = expansion;
+	}
+
+	LineExpansion LineRenderer::GetExpansion()
+	{
+		return m_Expansion;
 	}
 
 	void LineRenderer::FlushAndReset()
 	{
 		EndScene();
 
-		m_LineIndexCount = 0;
-		m_LineVertexBufferPtr = m_LineVertexBufferBase;
+		//The batch is full, so start the next one at the beginning of a region
+		BeginLines(true);
 	}
 }
\ No newline at end of file
@@ -3,63 +3,148 @@
 #include "IRenderer.h"
 #include "Buffer.h"
 #include "Color.h"
+#include "LineExpander.h"
 #include "Shader.h"
 #include "VertexArray.h"
 #include "../Math/Vector2.h"
 #include "../Math/LineSegment.h"
 #include "../Math/Matrix.h"
+#include "../Math/Affine2D.h"
 #include <array>
+#include <atomic>
+#include <vector>
 
 
 namespace GameDev2D
 {
-	class Camera;
+	class Graphics;
+	template<typename T> class ResourceCache;
 
 	class LineRenderer : public IRenderer
 	{
 	public:
-		LineRenderer();
-		~LineRenderer();
+		LineRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache);
 
 		RendererType GetType() override;
 
-		void BeginScene(Camera* camera) override;
+		void BeginScene(const Matrix& viewProjection, const Viewport& viewport) override;
 		void EndScene() override;
 
 		void RenderLine(const Vector2& start, const Vector2& end, const Color& color, float lineWidth);
 		void RenderLine(const LineSegment& lineSegment, const Color& color, float lineWidth);
 		void RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth);
 		void RenderLineStrip(std::vector<Vector2>& points, const Color& color, float lineWidth, const Vector2& position, float radians);
+		void RenderLineStrip(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians);
+
+		//Stores a line strip outline once and returns the id to render it with. If the first and last
+		//points are the same the outline is closed and every corner is mitered, including the first one.
+		//The outline is uploaded the next time shapes are flushed, so this doesn't touch the graphics API
+		unsigned int RegisterShape(const Vector2* points, unsigned int numberOfPoints);
+
+		//Renders a registered shape, only the instance data is sent each frame and the outline is
+		//rotated and positioned on the GPU. Instances are grouped into one draw call per shape
+		void RenderShape(unsigned int shapeId, const Vector2& position, float radians, const Color& color, float lineWidth);
+
+		//Renders instances that were written somewhere else, the same as calling RenderShape() for each of them except
+		//that the records are copied in bulk. Every id has to be registered
+		void RenderShapes(const LineShapeInstance* instances, const unsigned int* shapeIds, unsigned int count);
+
+		unsigned int GetNumberOfShapes() const;
+
+		//Returns the distance of a registered shape's farthest point from its origin, 0 if the id isn't registered
+		float GetShapeRadius(unsigned int shapeId) const;
+
+		//Should be set outside of BeginScene() and EndScene(). Registered shapes are only drawn as instances by the
+		//GeometryShader expansion, the other expansions render them as line strips
+		void SetExpansion(LineExpansion expansion);
+		LineExpansion GetExpansion();
+
+		//Returns the number of heap allocations made while submitting lines last frame, this should be zero
+		unsigned long long GetLastFrameAllocations();
 
 	protected:
 		friend class BatchRenderer;
 		void Flush() override;
 		void FlushAndReset() override;
+		void FlushShapes();
+		void NewFrame() override;
 
 	private:
-		struct LineVertex
+		void BeginLines(bool fullRegion);
+		void EndLines();
+		void RenderStripAdjacent(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians);
+		void RenderStripInstanced(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians);
+		void RenderStripQuads(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians);
+
+		struct Shape
 		{
-			LineVertex() :
-				vertices(Vector2::Zero),
-				color(1.0f, 1.0f, 1.0f, 1.0f),
-				lineWidth(1.0f)
-			{}
-
-			Vector2 vertices;
-			Color color;
-			float lineWidth;
+			unsigned int firstVertex;
+			unsigned int vertexCount;
+			unsigned int instanceCount;
+			unsigned int baseInstance;
+			float radius;
 		};
 
 
+		Graphics& m_Graphics;
 		std::shared_ptr<VertexArray> m_LineVertexArray;
-		std::shared_ptr<VertexBuffer> m_LineVertexBuffer;
+		std::shared_ptr<StreamingVertexBuffer> m_LineVertexBuffer;
 		std::shared_ptr<Shader> m_LineShader;
+		ShaderUniform<Matrix> m_LineViewProjectionUniform;
+		ShaderUniform<Vector2> m_LineViewportUniform;
 		unsigned int m_LineIndexCount;
 		LineVertex* m_LineVertexBufferBase;
 		LineVertex* m_LineVertexBufferPtr;
+		LineVertex* m_LineVertexBufferEnd;
+
+		std::shared_ptr<VertexArray> m_SegmentVertexArray;
+		std::shared_ptr<VertexBuffer> m_SegmentCornerBuffer;
+		std::shared_ptr<StreamingVertexBuffer> m_SegmentInstanceBuffer;
+		std::shared_ptr<Shader> m_SegmentShader;
+		ShaderUniform<Matrix> m_SegmentViewProjectionUniform;
+		ShaderUniform<Vector2> m_SegmentViewportUniform;
+		unsigned int m_SegmentCount;
+		LineSegmentInstance* m_SegmentInstanceBufferBase;
+		LineSegmentInstance* m_SegmentInstanceBufferPtr;
+		LineSegmentInstance* m_SegmentInstanceBufferEnd;
+
+		std::shared_ptr<VertexArray> m_QuadVertexArray;
+		std::shared_ptr<StreamingVertexBuffer> m_QuadVertexBuffer;
+		std::shared_ptr<Shader> m_QuadShader;
+		unsigned int m_QuadIndexCount;
+		LineQuadVertex* m_QuadVertexBufferBase;
+		LineQuadVertex* m_QuadVertexBufferPtr;
+		LineQuadVertex* m_QuadVertexBufferEnd;
+
+		//The Cpu expansion works in screen space, the strip's points are transformed into m_StripPoints first
+		Affine2D m_ScreenTransform;
+		Vector2 m_Viewport;
+		std::vector<Vector2> m_StripPoints;
+		LineExpansion m_Expansion;
+
+		std::shared_ptr<VertexArray> m_ShapeVertexArray;
+		std::shared_ptr<VertexBuffer> m_ShapeVertexBuffer;
+		std::shared_ptr<StreamingVertexBuffer> m_ShapeInstanceBuffer;
+		std::shared_ptr<Shader> m_ShapeShader;
+		ShaderUniform<Matrix> m_ShapeViewProjectionUniform;
+		ShaderUniform<Vector2> m_ShapeViewportUniform;
+		std::vector<Vector2> m_ShapeVertices;
+		std::vector<Shape> m_Shapes;
+		std::vector<LineShapeInstance> m_ShapeInstances;
+		std::vector<unsigned int> m_ShapeInstanceIds;
+		bool m_IsShapeBufferDirty;
+		unsigned long long m_FrameAllocations;
+		std::atomic<unsigned long long> m_LastFrameAllocations;
 
 		const unsigned int kMaxLines = 20000;
 		const unsigned int kMaxVertices = kMaxLines * 2;
 		const unsigned int kMaxIndices = kMaxLines * 2;
+		const unsigned int kMaxSegments = kMaxLines;
+		const unsigned int kQuadVertexCount = 4;
+		const unsigned int kQuadIndexCount = 6;
+		const unsigned int kMaxQuadVertices = kMaxSegments * kQuadVertexCount;
+		const unsigned int kMaxQuadIndices = kMaxSegments * kQuadIndexCount;
+		const unsigned int kMaxShapeVertices = 8192;
+		const unsigned int kMaxShapeInstances = 20000;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,529 @@
+#include "OpenGLBackend.h"
+#include <glad/glad.h>
+
+
+namespace GameDev2D
+{
+    OpenGLBackend::OpenGLBackend()
+    {
+    }
+
+    unsigned int OpenGLBackend::GetApiVersion()
+    {
+        float version;
+        sscanf((char *)glGetString(GL_VERSION), "%f", &version);
+        return (unsigned int)(100 * version);
+    }
+
+    unsigned int OpenGLBackend::GetShadingLanguageVersion()
+    {
+        float version;
+        sscanf((char *)glGetString(GL_SHADING_LANGUAGE_VERSION), "%f", &version);
+        return (unsigned int)(100 * version);
+    }
+
+    void OpenGLBackend::NewFrame()
+    {
+    }
+
+    void OpenGLBackend::Clear()
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+
+    void OpenGLBackend::SetClearColor(const Color& clearColor)
+    {
+        glClearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+    }
+
+    void OpenGLBackend::SetViewport(int x, int y, int width, int height)
+    {
+        glViewport(x, y, width, height);
+    }
+
+    void OpenGLBackend::SetBlendingEnabled(bool enabled)
+    {
+        if (enabled)
+            glEnable(GL_BLEND);
+        else
+            glDisable(GL_BLEND);
+    }
+
+    void OpenGLBackend::SetBlendingFunction(BlendingFactor source, BlendingFactor destination)
+    {
+        glBlendFunc(GetOpenGLBlendingFactor(source), GetOpenGLBlendingFactor(destination));
+    }
+
+    void OpenGLBackend::SetScissorEnabled(bool enabled)
+    {
+        if (enabled)
+            glEnable(GL_SCISSOR_TEST);
+        else
+            glDisable(GL_SCISSOR_TEST);
+    }
+
+    void OpenGLBackend::SetScissorRect(int x, int y, int width, int height)
+    {
+        glScissor(x, y, width, height);
+    }
+
+    void OpenGLBackend::DrawElements(RenderMode renderMode, unsigned int indexCount, unsigned int baseVertex)
+    {
+        unsigned int rm = GetOpenGLRenderMode(renderMode);
+        if (baseVertex == 0)
+            glDrawElements(rm, indexCount, GL_UNSIGNED_INT, nullptr);
+        else
+            glDrawElementsBaseVertex(rm, indexCount, GL_UNSIGNED_INT, nullptr, baseVertex);
+    }
+
+    void OpenGLBackend::DrawArraysInstanced(RenderMode renderMode, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance)
+    {
+        unsigned int rm = GetOpenGLRenderMode(renderMode);
+        glDrawArraysInstancedBaseInstance(rm, firstVertex, vertexCount, instanceCount, baseInstance);
+    }
+
+    void OpenGLBackend::CreateTexture(unsigned int* id, int count)
+    {
+        glCreateTextures(GL_TEXTURE_2D, count, id);
+    }
+
+    void OpenGLBackend::DeleteTexture(unsigned int* id, int count)
+    {
+        glDeleteTextures(count, id);
+    }
+
+    void OpenGLBackend::BindTextureUnit(unsigned int id, unsigned int slot)
+    {
+        glBindTextureUnit(slot, id);
+    }
+
+    void OpenGLBackend::SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels)
+    {
+        glTextureStorage2D(id, levels, GetOpenGLInternalPixelFormat(internalFormat), width, height);
+    }
+
+    void OpenGLBackend::SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter)
+    {
+        glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GetOpenGLTextureMinFilter(minFilter));
+        glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GetOpenGLTextureMagFilter(magFilter));
+    }
+
+    void OpenGLBackend::SetTextureData(unsigned int id, const ImageData& imageData)
+    {
+        assert(imageData.width > 0 && imageData.height > 0);
+        unsigned int pixelLayout = GetOpenGLPixelLayout(imageData.format.layout);
+        unsigned int pixelSize = GetOpenGLPixelSize(imageData.format.size);
+        glTextureSubImage2D(id, 0, 0, 0, imageData.width, imageData.height, pixelLayout, pixelSize, &imageData.data[0]);
+    }
+
+    void OpenGLBackend::SetTextureWrap(unsigned int id, Wrap wrap)
+    {
+        int wrapModeS = GetOpenGLWrapMode(wrap.s);
+        int wrapModeT = GetOpenGLWrapMode(wrap.t);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_S, wrapModeS);
+        glTextureParameteri(id, GL_TEXTURE_WRAP_T, wrapModeT);
+    }
+
+    void OpenGLBackend::CreateTextureArray(unsigned int* id, int count)
+    {
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, count, id);
+    }
+
+    void OpenGLBackend::SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat)
+    {
+        glTextureStorage3D(id, 1, GetOpenGLInternalPixelFormat(internalFormat), width, height, layers);
+    }
+
+    void OpenGLBackend::CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y)
+    {
+        glCopyImageSubData(sourceId, GL_TEXTURE_2D, 0, sourceX, sourceY, 0, arrayId, GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1);
+    }
+
+    void OpenGLBackend::CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers)
+    {
+        glCopyImageSubData(sourceId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, destinationId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, width, height, layers);
+    }
+
+    void OpenGLBackend::CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId)
+    {
+        glCopyImageSubData(arrayId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, textureId, GL_TEXTURE_2D, 0, 0, 0, 0, width, height, 1);
+    }
+
+    void OpenGLBackend::BindFrameBuffer(unsigned int frameBuffer)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+    }
+
+    void OpenGLBackend::GenerateFrameBuffer(unsigned int* frameBuffer)
+    {
+        glGenFramebuffers(1, frameBuffer);
+    }
+
+    void OpenGLBackend::DeleteFrameBuffer(unsigned int* frameBuffer)
+    {
+        glDeleteFramebuffers(1, frameBuffer);
+    }
+
+    void OpenGLBackend::SetFrameBufferStorage(unsigned int /*frameBuffer*/, unsigned int /*textureId*/)
+    {
+        //TODO:
+    }
+
+    void OpenGLBackend::CopyFrameBufferContents(unsigned int /*aFrameBuffer*/, PixelFormat /*aFormat*/, unsigned int /*aWidth*/, unsigned int /*aHeight*/, unsigned char* /*aBuffer*/)
+    {
+        //TODO:
+    }
+
+    void OpenGLBackend::CreateBuffer(unsigned int* id, int count)
+    {
+        glCreateBuffers(count, id);
+    }
+
+    void OpenGLBackend::DeleteBuffer(unsigned int* id, int count)
+    {
+        glDeleteBuffers(count, id);
+    }
+
+    void OpenGLBackend::BindBuffer(BufferType bufferType, unsigned int id)
+    {
+        glBindBuffer(GetOpenGLBufferType(bufferType), id);
+    }
+
+    void OpenGLBackend::InitBuffer(BufferType bufferType, unsigned int size, const void* data, BufferUsage usage)
+    {
+        glBufferData(GetOpenGLBufferType(bufferType), (GLsizeiptr)size, data, GetOpenGLBufferUsage(usage));
+    }
+
+    void OpenGLBackend::UpdateBuffer(BufferType bufferType, unsigned int offset, unsigned int size, const void* data)
+    {
+        glBufferSubData(GetOpenGLBufferType(bufferType), (GLintptr)offset, (GLsizeiptr)size, data);
+    }
+
+    void* OpenGLBackend::InitPersistentBuffer(BufferType bufferType, unsigned int size)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GetOpenGLBufferType(bufferType), (GLsizeiptr)size, nullptr, flags);
+        return glMapBufferRange(GetOpenGLBufferType(bufferType), 0, (GLsizeiptr)size, flags);
+    }
+
+    void OpenGLBackend::FlushMappedBuffer(unsigned int /*id*/, unsigned int /*offset*/, unsigned int /*size*/)
+    {
+        //The persistent buffers are mapped coherent, the writes are already visible to the GPU
+    }
+
+    void* OpenGLBackend::CreateFence()
+    {
+        return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    void OpenGLBackend::WaitForFence(void* fence)
+    {
+        if (fence == nullptr)
+            return;
+
+        //The first wait flushes the commands so the fence is guaranteed to be signaled eventually
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (true)
+        {
+            GLenum result = glClientWaitSync((GLsync)fence, flags, 1000000);
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+                break;
+
+            flags = 0;
+        }
+    }
+
+    void OpenGLBackend::DeleteFence(void* fence)
+    {
+        glDeleteSync((GLsync)fence);
+    }
+
+    void OpenGLBackend::CreateVertexArray(unsigned int* id, int count)
+    {
+        glCreateVertexArrays(count, id);
+    }
+
+    void OpenGLBackend::DeleteVertexArray(unsigned int* id, int count)
+    {
+        glDeleteVertexArrays(count, id);
+    }
+
+    void OpenGLBackend::BindVertexArray(unsigned int id)
+    {
+        glBindVertexArray(id);
+    }
+
+    void OpenGLBackend::EnableVertexAttributeArray(unsigned int vertexBuffer)
+    {
+        glEnableVertexAttribArray(vertexBuffer);
+    }
+
+    void OpenGLBackend::SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset)
+    {
+        GLenum type = GetShaderDataType(element.type);
+        GLboolean normalized = element.normalized ? GL_TRUE : GL_FALSE;
+        glVertexAttribPointer(vertexBuffer, element.GetComponentCount(), type, normalized, stride, offset);
+    }
+
+    void OpenGLBackend::SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor)
+    {
+        glVertexAttribDivisor(vertexBuffer, divisor);
+    }
+
+    unsigned int OpenGLBackend::CreateShaderProgram()
+    {
+        return glCreateProgram();
+    }
+
+    unsigned int OpenGLBackend::CreateShader(ShaderType shaderType)
+    {
+        return glCreateShader(GetOpenGLShaderType(shaderType));
+    }
+
+    void OpenGLBackend::SetShaderSource(unsigned int shader, const std::string& source)
+    {
+        const GLchar* sourceCStr = source.c_str();
+        glShaderSource(shader, 1, &sourceCStr, 0);
+    }
+
+    void OpenGLBackend::CompileShader(unsigned int shader)
+    {
+        glCompileShader(shader);
+    }
+
+    void OpenGLBackend::DeleteShader(unsigned int shader)
+    {
+        glDeleteShader(shader);
+    }
+
+    bool OpenGLBackend::IsShaderCompiled(unsigned int shader)
+    {
+        GLint isCompiled = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+        return isCompiled == GL_TRUE;
+    }
+
+    std::string OpenGLBackend::GetShaderInfoLog(unsigned int shader)
+    {
+        GLint maxLength = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+
+        std::vector<GLchar> infoLog(maxLength);
+        glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
+
+        return std::string(infoLog.begin(), infoLog.end());
+    }
+
+    void OpenGLBackend::AttachShader(unsigned int program, unsigned int shader)
+    {
+        glAttachShader(program, shader);
+    }
+
+    void OpenGLBackend::DetachShader(unsigned int program, unsigned int shader)
+    {
+        glDetachShader(program, shader);
+    }
+
+    void OpenGLBackend::LinkShaderProgram(unsigned int program)
+    {
+        glLinkProgram(program);
+    }
+
+    bool OpenGLBackend::IsShaderProgramLinked(unsigned int program)
+    {
+        GLint isLinked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
+        return isLinked == GL_TRUE;
+    }
+
+    void OpenGLBackend::DeleteShaderProgram(unsigned int program)
+    {
+        glDeleteProgram(program);
+    }
+
+    void OpenGLBackend::UseShaderProgram(unsigned int program)
+    {
+        glUseProgram(program);
+    }
+
+    std::string OpenGLBackend::GetShaderProgramInfoLog(unsigned int program)
+    {
+        GLint maxLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+
+        std::vector<GLchar> infoLog(maxLength);
+        glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
+
+        return std::string(infoLog.begin(), infoLog.end());
+    }
+
+    int OpenGLBackend::GetUniformLocation(unsigned int program, const std::string& uniform)
+    {
+        return glGetUniformLocation(program, uniform.c_str());
+    }
+
+    int OpenGLBackend::GetAttributeLocation(unsigned int program, const std::string& attribute)
+    {
+        return glGetAttribLocation(program, attribute.c_str());
+    }
+
+    unsigned int OpenGLBackend::GetNumberOfActiveUniforms(unsigned int program)
+    {
+        int count = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+        return (unsigned int)count;
+    }
+
+    std::string OpenGLBackend::GetActiveUniformName(unsigned int program, unsigned int index)
+    {
+        int maxLength = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+        std::string name(maxLength, '\0');
+        int length = 0;
+        int size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, index, maxLength, &length, &size, &type, &name[0]);
+        name.resize(length);
+        return name;
+    }
+
+    void OpenGLBackend::SetUniformInt(int location, int value)
+    {
+        glUniform1i(location, value);
+    }
+
+    void OpenGLBackend::SetUniformIntArray(int location, int* values, unsigned int count)
+    {
+        glUniform1iv(location, count, values);
+    }
+
+    void OpenGLBackend::SetUniformFloat(int location, float value)
+    {
+        glUniform1f(location, value);
+    }
+
+    void OpenGLBackend::SetUniformFloat2(int location, float value1, float value2)
+    {
+        glUniform2f(location, value1, value2);
+    }
+
+    void OpenGLBackend::SetUniformFloat3(int location, float value1, float value2, float value3)
+    {
+        glUniform3f(location, value1, value2, value3);
+    }
+
+    void OpenGLBackend::SetUniformFloat4(int location, float value1, float value2, float value3, float value4)
+    {
+        glUniform4f(location, value1, value2, value3, value4);
+    }
+
+    void OpenGLBackend::SetUniformMatrix(int location, const Matrix& value)
+    {
+        glUniformMatrix4fv(location, 1, GL_FALSE, &value.m[0][0]);
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLGraphicType(GraphicType aType)
+    {
+        unsigned int types[] = { GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT, GL_INT, GL_UNSIGNED_INT, GL_FLOAT, GL_DOUBLE };
+        int index = static_cast<int>(aType);
+        return types[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLTextureMinFilter(TextureMinFilter minFilter)
+    {
+        unsigned int types[] = { GL_NEAREST, GL_LINEAR };
+        int index = static_cast<int>(minFilter);
+        return types[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLTextureMagFilter(TextureMagFilter magFilter)
+    {
+        unsigned int types[] = { GL_NEAREST, GL_LINEAR };
+        int index = static_cast<int>(magFilter);
+        return types[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLPixelLayout(PixelLayout aLayout)
+    {
+        unsigned int layouts[] = { GL_RGB, GL_RGBA };
+        int index = static_cast<int>(aLayout);
+        return layouts[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLPixelSize(PixelSize aSize)
+    {
+        unsigned int sizes[] = { GL_UNSIGNED_BYTE };
+        int index = static_cast<int>(aSize);
+        return sizes[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLInternalPixelFormat(PixelFormat pixeFormat)
+    {
+        unsigned int layouts[] = { GL_RGB8, GL_RGBA8 };
+        int index = static_cast<int>(pixeFormat.layout);
+        return layouts[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLBlendingFactor(BlendingFactor aBlendingFactor)
+    {
+        GLenum blendingFactors[] = { GL_ZERO, GL_ONE, GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_DST_COLOR, GL_ONE_MINUS_DST_COLOR, GL_SRC_ALPHA_SATURATE };
+        int index = static_cast<int>(aBlendingFactor);
+        return blendingFactors[index];
+    }
+
+    int OpenGLBackend::GetOpenGLWrapMode(WrapMode aWrapMode)
+    {
+        GLint wrapModes[] = { GL_CLAMP_TO_EDGE, GL_CLAMP_TO_BORDER, GL_REPEAT, GL_MIRRORED_REPEAT };
+        int index = static_cast<int>(aWrapMode);
+        return wrapModes[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLRenderMode(RenderMode aRenderMode)
+    {
+        unsigned int renderModes[] = { GL_POINTS, GL_LINES, GL_LINE_LOOP, GL_LINE_STRIP, GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS, GL_LINES_ADJACENCY, GL_LINE_STRIP_ADJACENCY };
+        int index = static_cast<int>(aRenderMode);
+        return renderModes[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLBufferUsage(BufferUsage aBufferUsage)
+    {
+        unsigned int bufferUsages[] = { GL_STREAM_DRAW, GL_STREAM_READ, GL_STREAM_COPY, GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY, GL_DYNAMIC_DRAW, GL_DYNAMIC_READ, GL_DYNAMIC_COPY };
+        int index = static_cast<int>(aBufferUsage);
+        return bufferUsages[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLBufferType(BufferType aBufferType)
+    {
+        unsigned int bufferTypes[] = { GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER };
+        int index = static_cast<int>(aBufferType);
+        return bufferTypes[index];
+    }
+
+    unsigned int OpenGLBackend::GetOpenGLShaderType(ShaderType aShaderType)
+    {
+        GLenum shaderTypes[] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+        int index = static_cast<int>(aShaderType);
+        return shaderTypes[index];
+    }
+
+    unsigned int OpenGLBackend::GetShaderDataType(ShaderDataType type)
+    {
+        switch (type)
+        {
+        case ShaderDataType::Float:    return GL_FLOAT;
+        case ShaderDataType::Float2:   return GL_FLOAT;
+        case ShaderDataType::Float3:   return GL_FLOAT;
+        case ShaderDataType::Float4:   return GL_FLOAT;
+        case ShaderDataType::Mat3:     return GL_FLOAT;
+        case ShaderDataType::Mat4:     return GL_FLOAT;
+        case ShaderDataType::Int:      return GL_INT;
+        case ShaderDataType::Int2:     return GL_INT;
+        case ShaderDataType::Int3:     return GL_INT;
+        case ShaderDataType::Int4:     return GL_INT;
+        case ShaderDataType::Bool:     return GL_BOOL;
+        }
+
+        return 0;
+    }
+}
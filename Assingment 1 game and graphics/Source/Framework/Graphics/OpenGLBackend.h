@@ -0,0 +1,139 @@
+#pragma once
+
+#include "IGraphicsBackend.h"
+
+
+namespace GameDev2D
+{
+    //Sends the Graphics calls to OpenGL 4.5, this is the backend the game normally runs with
+    class OpenGLBackend : public IGraphicsBackend
+    {
+    public:
+        OpenGLBackend();
+
+        unsigned int GetApiVersion() override;
+        unsigned int GetShadingLanguageVersion() override;
+
+        void NewFrame() override;
+
+        void Clear() override;
+        void SetClearColor(const Color& clearColor) override;
+        void SetViewport(int x, int y, int width, int height) override;
+
+        void SetBlendingEnabled(bool enabled) override;
+        void SetBlendingFunction(BlendingFactor source, BlendingFactor destination) override;
+        void SetScissorEnabled(bool enabled) override;
+        void SetScissorRect(int x, int y, int width, int height) override;
+
+        void DrawElements(RenderMode renderMode, unsigned int indexCount, unsigned int baseVertex) override;
+        void DrawArraysInstanced(RenderMode renderMode, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance) override;
+
+        void CreateTexture(unsigned int* id, int count) override;
+        void DeleteTexture(unsigned int* id, int count) override;
+        void BindTextureUnit(unsigned int id, unsigned int slot) override;
+        void SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels) override;
+        void SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter) override;
+        void SetTextureData(unsigned int id, const ImageData& imageData) override;
+        void SetTextureWrap(unsigned int id, Wrap wrap) override;
+
+        void CreateTextureArray(unsigned int* id, int count) override;
+        void SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat) override;
+        void CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y) override;
+        void CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers) override;
+        void CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId) override;
+
+        void BindFrameBuffer(unsigned int frameBuffer) override;
+        void GenerateFrameBuffer(unsigned int* frameBuffer) override;
+        void DeleteFrameBuffer(unsigned int* frameBuffer) override;
+        void SetFrameBufferStorage(unsigned int frameBuffer, unsigned int textureId) override;
+        void CopyFrameBufferContents(unsigned int frameBuffer, PixelFormat format, unsigned int width, unsigned int height, unsigned char* buffer) override;
+
+        void CreateBuffer(unsigned int* id, int count) override;
+        void DeleteBuffer(unsigned int* id, int count) override;
+        void BindBuffer(BufferType bufferType, unsigned int id) override;
+        void InitBuffer(BufferType bufferType, unsigned int size, const void* data, BufferUsage usage) override;
+        void UpdateBuffer(BufferType bufferType, unsigned int offset, unsigned int size, const void* data) override;
+        void* InitPersistentBuffer(BufferType bufferType, unsigned int size) override;
+
+        void FlushMappedBuffer(unsigned int id, unsigned int offset, unsigned int size) override;
+
+        void* CreateFence() override;
+        void WaitForFence(void* fence) override;
+        void DeleteFence(void* fence) override;
+
+        void CreateVertexArray(unsigned int* id, int count) override;
+        void DeleteVertexArray(unsigned int* id, int count) override;
+        void BindVertexArray(unsigned int id) override;
+
+        void EnableVertexAttributeArray(unsigned int vertexBuffer) override;
+        void SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset) override;
+        void SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor) override;
+
+        unsigned int CreateShaderProgram() override;
+        unsigned int CreateShader(ShaderType shaderType) override;
+        void SetShaderSource(unsigned int shader, const std::string& source) override;
+        void CompileShader(unsigned int shader) override;
+        void DeleteShader(unsigned int shader) override;
+        bool IsShaderCompiled(unsigned int shader) override;
+        std::string GetShaderInfoLog(unsigned int shader) override;
+
+        void AttachShader(unsigned int program, unsigned int shader) override;
+        void DetachShader(unsigned int program, unsigned int shader) override;
+
+        void LinkShaderProgram(unsigned int program) override;
+        bool IsShaderProgramLinked(unsigned int program) override;
+        void DeleteShaderProgram(unsigned int program) override;
+        void UseShaderProgram(unsigned int program) override;
+        std::string GetShaderProgramInfoLog(unsigned int program) override;
+
+        int GetUniformLocation(unsigned int program, const std::string& uniform) override;
+        int GetAttributeLocation(unsigned int program, const std::string& attribute) override;
+
+        unsigned int GetNumberOfActiveUniforms(unsigned int program) override;
+        std::string GetActiveUniformName(unsigned int program, unsigned int index) override;
+
+        void SetUniformInt(int location, int value) override;
+        void SetUniformIntArray(int location, int* values, unsigned int count) override;
+        void SetUniformFloat(int location, float value) override;
+        void SetUniformFloat2(int location, float value1, float value2) override;
+        void SetUniformFloat3(int location, float value1, float value2, float value3) override;
+        void SetUniformFloat4(int location, float value1, float value2, float value3, float value4) override;
+        void SetUniformMatrix(int location, const Matrix& value) override;
+
+    private:
+        //Converts the GraphicType data type into the OpenGL constant
+        unsigned int GetOpenGLGraphicType(GraphicType type);
+       
+        unsigned int GetOpenGLTextureMinFilter(TextureMinFilter minFilter);
+        unsigned int GetOpenGLTextureMagFilter(TextureMagFilter magFilter);
+
+        //Converts the PixelFormat::PixelLayout data type into the OpenGL constant
+        unsigned int GetOpenGLPixelLayout(PixelLayout layout);
+
+        //Converts the PixelFormat::PixelSize data type into the OpenGL constant
+        unsigned int GetOpenGLPixelSize(PixelSize size);
+
+        unsigned int GetOpenGLInternalPixelFormat(PixelFormat pixeFormat);
+
+        //Converts the BlendingFactor data type into the OpenGL constant
+        unsigned int GetOpenGLBlendingFactor(BlendingFactor blendingFactor);
+
+        //Converts the Wrap::WrapMode data type into the OpenGL constant
+        int GetOpenGLWrapMode(WrapMode wrapMode);
+
+        //Converts the RenderMode data type into the OpenGL constant
+        unsigned int GetOpenGLRenderMode(RenderMode renderMode);
+
+        //Converts the BufferUsage data type into the OpenGL constant
+        unsigned int GetOpenGLBufferUsage(BufferUsage dataBufferUsage);
+
+        //Converts the BufferType data type into the OpenGL constant
+        unsigned int GetOpenGLBufferType(BufferType dataBufferType);
+
+        //Converts the ShaderType data type into the OpenGL constant
+        unsigned int GetOpenGLShaderType(ShaderType shaderType);
+        
+        //Converts the ShaderDataType data type into the OpenGL constant
+        unsigned int GetShaderDataType(ShaderDataType type);
+    };
+}
\ No newline at end of file
@@ -1,20 +1,23 @@
 #include "PointRenderer.h"
-#include "../Application/Application.h"
+#include "Graphics.h"
+#include "../Resources/ResourceCache.h"
 
 
 namespace GameDev2D
 {
-	PointRenderer::PointRenderer() :
+	PointRenderer::PointRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache) :
+		m_Graphics(graphics),
 		m_PointVertexArray(nullptr),
 		m_PointVertexBuffer(nullptr),
 		m_PointShader(nullptr),
 		m_PointIndexCount(0),
 		m_PointVertexBufferBase(nullptr),
-		m_PointVertexBufferPtr(nullptr)
+		m_PointVertexBufferPtr(nullptr),
+		m_PointVertexBufferEnd(nullptr)
 	{
-		m_PointVertexArray = std::make_shared<VertexArray>();
+		m_PointVertexArray = std::make_shared<VertexArray>(m_Graphics);
 
-		m_PointVertexBuffer = std::make_shared<VertexBuffer>(kMaxVertices * sizeof(PointVertex));
+		m_PointVertexBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxVertices * sizeof(PointVertex));
 		m_PointVertexBuffer->SetLayout({
 			{ ShaderDataType::Float2, "a_Position" },
 			{ ShaderDataType::Float4, "a_Color" }
@@ -22,27 +25,19 @@ namespace GameDev2D
 
 		m_PointVertexArray->AddVertexBuffer(m_PointVertexBuffer);
 
-		m_PointVertexBufferBase = new PointVertex[kMaxVertices];
 		unsigned int* pointIndices = new unsigned int[kMaxIndices];
 		for (unsigned int i = 0; i < kMaxIndices; i++)
 		{
 			pointIndices[i] = i;
 		}
 
-		std::shared_ptr<IndexBuffer> pointIndexBuffer = std::make_shared<IndexBuffer>(pointIndices, kMaxIndices);
+		std::shared_ptr<IndexBuffer> pointIndexBuffer = std::make_shared<IndexBuffer>(m_Graphics, pointIndices, kMaxIndices);
 		m_PointVertexArray->SetIndexBuffer(pointIndexBuffer);
 		delete[] pointIndices;
 
-		m_PointShader = Application::Get().GetResourceManager().GetShaderCache().GetShared(POINT_RENDERER_SHADER_KEY);
-	}
-
-	PointRenderer::~PointRenderer()
-	{
-		if (m_PointVertexBufferBase != nullptr)
-		{
-			delete[] m_PointVertexBufferBase;
-			m_PointVertexBufferBase = nullptr;
-		}
+		m_PointShader = shaderCache.GetShared(POINT_RENDERER_SHADER_KEY);
+		m_ViewProjectionUniform = m_PointShader->GetUniform<Matrix>("u_ViewProjection");
+		m_ViewportUniform = m_PointShader->GetUniform<Vector2>("u_Viewport");
 	}
 
 	RendererType PointRenderer::GetType()
@@ -50,22 +45,28 @@ namespace GameDev2D
 		return RendererType::Point;
 	}
 
-	void PointRenderer::BeginScene(Camera* camera)
+	void PointRenderer::BeginScene(const Matrix& viewProjection, const Viewport& viewport)
 	{
 		m_PointShader->Bind();
-		m_PointShader->SetMat4("u_ViewProjection", camera->GetViewProjectionMatrix());
-		m_PointShader->SetFloat2("u_Viewport", (float)camera->GetViewport().width, (float)camera->GetViewport().height);
+		m_PointShader->Set(m_ViewProjectionUniform, viewProjection);
+		m_PointShader->Set(m_ViewportUniform, Vector2((float)viewport.width, (float)viewport.height));
 
 		m_PointIndexCount = 0;
+		m_PointVertexBufferBase = (PointVertex*)m_PointVertexBuffer->Begin(0);
 		m_PointVertexBufferPtr = m_PointVertexBufferBase;
+		m_PointVertexBufferEnd = m_PointVertexBufferBase + m_PointVertexBuffer->GetAvailableSize() / sizeof(PointVertex);
 	}
 
 	void PointRenderer::EndScene()
 	{
+		//The vertices were written straight into the mapped buffer, they only need to be drawn
+		Flush();
+
 		unsigned int dataSize = (unsigned int)((unsigned char*)m_PointVertexBufferPtr - (unsigned char*)m_PointVertexBufferBase);
-		m_PointVertexBuffer->SetData(m_PointVertexBufferBase, dataSize);
+		m_PointVertexBuffer->End(dataSize);
 
-		Flush();
+		m_PointIndexCount = 0;
+		m_PointVertexBufferBase = m_PointVertexBufferPtr;
 	}
 
 	void PointRenderer::Flush()
@@ -74,22 +75,31 @@ namespace GameDev2D
 			return;
 
 		m_PointVertexArray->Bind();
-		Application::Get().GetGraphics().DrawElements(RenderMode::Points, m_PointVertexArray, m_PointIndexCount);
+		m_Graphics.DrawElements(RenderMode::Points, m_PointVertexArray, m_PointIndexCount, m_PointVertexBuffer->GetWriteOffset() / sizeof(PointVertex));
 		m_TotalDrawCalls++;
 		m_FrameDrawCalls++;
 	}
 
+	void PointRenderer::NewFrame()
+	{
+		IRenderer::NewFrame();
+		m_PointVertexBuffer->NextRegion();
+	}
+
 	void PointRenderer::FlushAndReset()
 	{
 		EndScene();
 
+		//The batch is full, so start the next one at the beginning of a region
 		m_PointIndexCount = 0;
+		m_PointVertexBufferBase = (PointVertex*)m_PointVertexBuffer->Begin(kMaxVertices * sizeof(PointVertex));
 		m_PointVertexBufferPtr = m_PointVertexBufferBase;
+		m_PointVertexBufferEnd = m_PointVertexBufferBase + m_PointVertexBuffer->GetAvailableSize() / sizeof(PointVertex);
 	}
 
 	void PointRenderer::RenderPoint(const Vector2& position, const Color& color)
 	{
-		if (m_PointIndexCount >= kMaxIndices)
+		if (m_PointIndexCount >= kMaxIndices || m_PointVertexBufferPtr >= m_PointVertexBufferEnd)
 		{
 			FlushAndReset();
 		}
@@ -12,17 +12,17 @@
 
 namespace GameDev2D
 {
-	class Camera;
+	class Graphics;
+	template<typename T> class ResourceCache;
 
 	class PointRenderer : public IRenderer
 	{
 	public:
-		PointRenderer();
-		~PointRenderer();
+		PointRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache);
 
 		RendererType GetType() override;
 
-		void BeginScene(Camera* camera) override;
+		void BeginScene(const Matrix& viewProjection, const Viewport& viewport) override;
 		void EndScene() override;
 
 		void RenderPoint(const Vector2& position, const Color& color);
@@ -31,6 +31,7 @@ namespace GameDev2D
 		friend class BatchRenderer;
 		void Flush() override;
 		void FlushAndReset() override;
+		void NewFrame() override;
 
 	private:
 		struct PointVertex
@@ -39,12 +40,16 @@ namespace GameDev2D
 			Color color;
 		};
 
+		Graphics& m_Graphics;
 		std::shared_ptr<VertexArray> m_PointVertexArray;
-		std::shared_ptr<VertexBuffer> m_PointVertexBuffer;
+		std::shared_ptr<StreamingVertexBuffer> m_PointVertexBuffer;
 		std::shared_ptr<Shader> m_PointShader;
+		ShaderUniform<Matrix> m_ViewProjectionUniform;
+		ShaderUniform<Vector2> m_ViewportUniform;
 		unsigned int m_PointIndexCount;
 		PointVertex* m_PointVertexBufferBase;
 		PointVertex* m_PointVertexBufferPtr;
+		PointVertex* m_PointVertexBufferEnd;
 
 		const unsigned int kMaxPoints = 10000;
 		const unsigned int kMaxVertices = kMaxPoints;
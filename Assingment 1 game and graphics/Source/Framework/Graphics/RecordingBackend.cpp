@@ -0,0 +1,722 @@
+#include "RecordingBackend.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    namespace
+    {
+        const char* kCommandNames[] =
+        {
+            "Clear", "SetClearColor", "SetViewport", "SetBlendingEnabled", "SetBlendingFunction", "SetScissorEnabled", "SetScissorRect",
+            "DrawElements", "DrawArraysInstanced",
+            "CreateTexture", "DeleteTexture", "BindTextureUnit", "SetTextureStorage", "SetTextureFilter", "SetTextureData", "SetTextureWrap",
+            "CreateTextureArray", "SetTextureArrayStorage", "CopyTextureToTextureArray", "CopyTextureArray", "CopyTextureArrayToTexture",
+            "BindFrameBuffer", "GenerateFrameBuffer", "DeleteFrameBuffer", "SetFrameBufferStorage", "CopyFrameBufferContents",
+            "CreateBuffer", "DeleteBuffer", "BindBuffer", "InitBuffer", "UpdateBuffer", "InitPersistentBuffer", "FlushMappedBuffer",
+            "CreateFence", "WaitForFence", "DeleteFence",
+            "CreateVertexArray", "DeleteVertexArray", "BindVertexArray", "EnableVertexAttributeArray", "SetVertexAttributePointer", "SetVertexAttributeDivisor",
+            "CreateShaderProgram", "CreateShader", "SetShaderSource", "CompileShader", "DeleteShader", "AttachShader", "DetachShader",
+            "LinkShaderProgram", "DeleteShaderProgram", "UseShaderProgram",
+            "SetUniformInt", "SetUniformIntArray", "SetUniformFloat", "SetUniformFloat2", "SetUniformFloat3", "SetUniformFloat4", "SetUniformMatrix"
+        };
+
+        static_assert(sizeof(kCommandNames) / sizeof(kCommandNames[0]) == static_cast<int>(GraphicsCommandType::Count), "Every GraphicsCommandType needs a name");
+
+        //FNV-1a, only used to tell uploads apart in the dumps
+        unsigned int Checksum(const void* data, unsigned int size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            unsigned int hash = 2166136261u;
+            for (unsigned int i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        unsigned int GetBytesPerPixel(PixelFormat format)
+        {
+            return format.layout == PixelLayout::RGB ? 3 : 4;
+        }
+    }
+
+    GraphicsCounters::GraphicsCounters()
+    {
+        Reset();
+    }
+
+    void GraphicsCounters::Reset()
+    {
+        calls = 0;
+        drawCalls = 0;
+        vertices = 0;
+        bufferBytes = 0;
+        textureBytes = 0;
+        uniformBytes = 0;
+        memset(callsByType, 0, sizeof(callsByType));
+    }
+
+    void GraphicsCounters::Add(const GraphicsCounters& aCounters)
+    {
+        calls += aCounters.calls;
+        drawCalls += aCounters.drawCalls;
+        vertices += aCounters.vertices;
+        bufferBytes += aCounters.bufferBytes;
+        textureBytes += aCounters.textureBytes;
+        uniformBytes += aCounters.uniformBytes;
+
+        for (int i = 0; i < static_cast<int>(GraphicsCommandType::Count); i++)
+            callsByType[i] += aCounters.callsByType[i];
+    }
+
+    RecordingBackend::RecordingBackend() :
+        m_BoundProgram(0),
+        m_NextId(1)
+    {
+        for (unsigned int i = 0; i < kNumberOfBufferTypes; i++)
+            m_BoundBuffers[i] = 0;
+    }
+
+    unsigned int RecordingBackend::GetApiVersion()
+    {
+        return 450;
+    }
+
+    unsigned int RecordingBackend::GetShadingLanguageVersion()
+    {
+        return 450;
+    }
+
+    void RecordingBackend::NewFrame()
+    {
+        m_TotalCounters.Add(m_FrameCounters);
+        m_LastFrameCounters = m_FrameCounters;
+        m_FrameCounters.Reset();
+
+        //Swapping keeps both vectors' capacity, recording a frame doesn't allocate once the log is big enough
+        m_LastFrameCommands.swap(m_FrameCommands);
+        m_FrameCommands.clear();
+    }
+
+    void RecordingBackend::Clear()
+    {
+        Record(GraphicsCommandType::Clear, {});
+    }
+
+    void RecordingBackend::SetClearColor(const Color& aClearColor)
+    {
+        GraphicsCommand& command = Record(GraphicsCommandType::SetClearColor, {});
+        RecordFloats(command, { aClearColor.r, aClearColor.g, aClearColor.b, aClearColor.a });
+    }
+
+    void RecordingBackend::SetViewport(int x, int y, int width, int height)
+    {
+        Record(GraphicsCommandType::SetViewport, { x, y, width, height });
+    }
+
+    void RecordingBackend::SetBlendingEnabled(bool enabled)
+    {
+        Record(GraphicsCommandType::SetBlendingEnabled, { enabled ? 1 : 0 });
+    }
+
+    void RecordingBackend::SetBlendingFunction(BlendingFactor source, BlendingFactor destination)
+    {
+        Record(GraphicsCommandType::SetBlendingFunction, { static_cast<int>(source), static_cast<int>(destination) });
+    }
+
+    void RecordingBackend::SetScissorEnabled(bool enabled)
+    {
+        Record(GraphicsCommandType::SetScissorEnabled, { enabled ? 1 : 0 });
+    }
+
+    void RecordingBackend::SetScissorRect(int x, int y, int width, int height)
+    {
+        Record(GraphicsCommandType::SetScissorRect, { x, y, width, height });
+    }
+
+    void RecordingBackend::DrawElements(RenderMode renderMode, unsigned int indexCount, unsigned int baseVertex)
+    {
+        Record(GraphicsCommandType::DrawElements, { static_cast<int>(renderMode), (int)indexCount, (int)baseVertex });
+        m_FrameCounters.drawCalls++;
+        m_FrameCounters.vertices += indexCount;
+    }
+
+    void RecordingBackend::DrawArraysInstanced(RenderMode renderMode, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance)
+    {
+        Record(GraphicsCommandType::DrawArraysInstanced, { static_cast<int>(renderMode), (int)firstVertex, (int)vertexCount, (int)instanceCount, (int)baseInstance });
+        m_FrameCounters.drawCalls++;
+        m_FrameCounters.vertices += (unsigned long long)vertexCount * instanceCount;
+    }
+
+    void RecordingBackend::CreateTexture(unsigned int* id, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            id[i] = m_NextId++;
+            Record(GraphicsCommandType::CreateTexture, { (int)id[i] });
+        }
+    }
+
+    void RecordingBackend::DeleteTexture(unsigned int* id, int count)
+    {
+        for (int i = 0; i < count; i++)
+            Record(GraphicsCommandType::DeleteTexture, { (int)id[i] });
+    }
+
+    void RecordingBackend::BindTextureUnit(unsigned int id, unsigned int slot)
+    {
+        Record(GraphicsCommandType::BindTextureUnit, { (int)id, (int)slot });
+    }
+
+    void RecordingBackend::SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels)
+    {
+        Record(GraphicsCommandType::SetTextureStorage, { (int)id, (int)width, (int)height, static_cast<int>(internalFormat.layout), (int)levels });
+    }
+
+    void RecordingBackend::SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter)
+    {
+        Record(GraphicsCommandType::SetTextureFilter, { (int)id, static_cast<int>(minFilter), static_cast<int>(magFilter) });
+    }
+
+    void RecordingBackend::SetTextureData(unsigned int id, const ImageData& imageData)
+    {
+        unsigned int size = (unsigned int)imageData.data.size();
+        Record(GraphicsCommandType::SetTextureData, { (int)id, (int)imageData.width, (int)imageData.height }, size, imageData.data.data());
+        m_FrameCounters.textureBytes += size;
+    }
+
+    void RecordingBackend::SetTextureWrap(unsigned int id, Wrap wrap)
+    {
+        Record(GraphicsCommandType::SetTextureWrap, { (int)id, static_cast<int>(wrap.s), static_cast<int>(wrap.t) });
+    }
+
+    void RecordingBackend::CreateTextureArray(unsigned int* id, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            id[i] = m_NextId++;
+            Record(GraphicsCommandType::CreateTextureArray, { (int)id[i] });
+        }
+    }
+
+    void RecordingBackend::SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat)
+    {
+        Record(GraphicsCommandType::SetTextureArrayStorage, { (int)id, (int)width, (int)height, (int)layers, static_cast<int>(internalFormat.layout) });
+    }
+
+    void RecordingBackend::CopyTextureToTextureArray(unsigned int sourceId, unsigned int /*sourceX*/, unsigned int /*sourceY*/, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y)
+    {
+        //The source rect's position is left out of the dump, the copy's size and destination identify it
+        Record(GraphicsCommandType::CopyTextureToTextureArray, { (int)sourceId, (int)arrayId, (int)layer, (int)x, (int)y, (int)(width * height) });
+    }
+
+    void RecordingBackend::CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers)
+    {
+        Record(GraphicsCommandType::CopyTextureArray, { (int)sourceId, (int)destinationId, (int)width, (int)height, (int)layers });
+    }
+
+    void RecordingBackend::CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId)
+    {
+        Record(GraphicsCommandType::CopyTextureArrayToTexture, { (int)arrayId, (int)layer, (int)textureId, (int)width, (int)height });
+    }
+
+    void RecordingBackend::BindFrameBuffer(unsigned int frameBuffer)
+    {
+        Record(GraphicsCommandType::BindFrameBuffer, { (int)frameBuffer });
+    }
+
+    void RecordingBackend::GenerateFrameBuffer(unsigned int* frameBuffer)
+    {
+        *frameBuffer = m_NextId++;
+        Record(GraphicsCommandType::GenerateFrameBuffer, { (int)*frameBuffer });
+    }
+
+    void RecordingBackend::DeleteFrameBuffer(unsigned int* frameBuffer)
+    {
+        Record(GraphicsCommandType::DeleteFrameBuffer, { (int)*frameBuffer });
+    }
+
+    void RecordingBackend::SetFrameBufferStorage(unsigned int frameBuffer, unsigned int textureId)
+    {
+        Record(GraphicsCommandType::SetFrameBufferStorage, { (int)frameBuffer, (int)textureId });
+    }
+
+    void RecordingBackend::CopyFrameBufferContents(unsigned int frameBuffer, PixelFormat format, unsigned int width, unsigned int height, unsigned char* buffer)
+    {
+        //Nothing is drawn, so there are no pixels to read back
+        Record(GraphicsCommandType::CopyFrameBufferContents, { (int)frameBuffer, (int)width, (int)height });
+        memset(buffer, 0, width * height * GetBytesPerPixel(format));
+    }
+
+    void RecordingBackend::CreateBuffer(unsigned int* id, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            id[i] = m_NextId++;
+            m_Buffers[id[i]].isPersistent = false;
+            Record(GraphicsCommandType::CreateBuffer, { (int)id[i] });
+        }
+    }
+
+    void RecordingBackend::DeleteBuffer(unsigned int* id, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            for (unsigned int type = 0; type < kNumberOfBufferTypes; type++)
+            {
+                if (m_BoundBuffers[type] == id[i])
+                    m_BoundBuffers[type] = 0;
+            }
+
+            m_Buffers.erase(id[i]);
+            Record(GraphicsCommandType::DeleteBuffer, { (int)id[i] });
+        }
+    }
+
+    void RecordingBackend::BindBuffer(BufferType bufferType, unsigned int id)
+    {
+        m_BoundBuffers[static_cast<int>(bufferType)] = id;
+        Record(GraphicsCommandType::BindBuffer, { static_cast<int>(bufferType), (int)id });
+    }
+
+    void RecordingBackend::InitBuffer(BufferType bufferType, unsigned int size, const void* data, BufferUsage usage)
+    {
+        BufferRecord* buffer = GetBoundBuffer(bufferType);
+        if (buffer != nullptr)
+        {
+            buffer->data.assign(size, 0);
+            if (data != nullptr)
+                memcpy(buffer->data.data(), data, size);
+        }
+
+        //A buffer created without data is only allocated, nothing is uploaded
+        unsigned int uploaded = data != nullptr ? size : 0;
+        Record(GraphicsCommandType::InitBuffer, { static_cast<int>(bufferType), (int)size, static_cast<int>(usage) }, uploaded, data);
+        m_FrameCounters.bufferBytes += uploaded;
+    }
+
+    void RecordingBackend::UpdateBuffer(BufferType bufferType, unsigned int offset, unsigned int size, const void* data)
+    {
+        BufferRecord* buffer = GetBoundBuffer(bufferType);
+        if (buffer != nullptr && offset + size <= buffer->data.size())
+            memcpy(buffer->data.data() + offset, data, size);
+
+        Record(GraphicsCommandType::UpdateBuffer, { static_cast<int>(bufferType), (int)offset }, size, data);
+        m_FrameCounters.bufferBytes += size;
+    }
+
+    void* RecordingBackend::InitPersistentBuffer(BufferType bufferType, unsigned int size)
+    {
+        Record(GraphicsCommandType::InitPersistentBuffer, { static_cast<int>(bufferType), (int)size });
+
+        //The storage is immutable, so the vector is never resized and the pointer stays valid until the buffer is deleted
+        BufferRecord* buffer = GetBoundBuffer(bufferType);
+        if (buffer == nullptr)
+            return nullptr;
+
+        buffer->data.assign(size, 0);
+        buffer->isPersistent = true;
+        return buffer->data.data();
+    }
+
+    void RecordingBackend::FlushMappedBuffer(unsigned int id, unsigned int offset, unsigned int size)
+    {
+        auto buffer = m_Buffers.find(id);
+        const void* data = buffer != m_Buffers.end() && offset + size <= buffer->second.data.size() ? buffer->second.data.data() + offset : nullptr;
+
+        Record(GraphicsCommandType::FlushMappedBuffer, { (int)id, (int)offset }, size, data);
+        m_FrameCounters.bufferBytes += size;
+    }
+
+    void* RecordingBackend::CreateFence()
+    {
+        //Nothing runs asynchronously, any non null value will do
+        unsigned int id = m_NextId++;
+        Record(GraphicsCommandType::CreateFence, { (int)id });
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+    }
+
+    void RecordingBackend::WaitForFence(void* fence)
+    {
+        Record(GraphicsCommandType::WaitForFence, { (int)reinterpret_cast<uintptr_t>(fence) });
+    }
+
+    void RecordingBackend::DeleteFence(void* fence)
+    {
+        Record(GraphicsCommandType::DeleteFence, { (int)reinterpret_cast<uintptr_t>(fence) });
+    }
+
+    void RecordingBackend::CreateVertexArray(unsigned int* id, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            id[i] = m_NextId++;
+            Record(GraphicsCommandType::CreateVertexArray, { (int)id[i] });
+        }
+    }
+
+    void RecordingBackend::DeleteVertexArray(unsigned int* id, int count)
+    {
+        for (int i = 0; i < count; i++)
+            Record(GraphicsCommandType::DeleteVertexArray, { (int)id[i] });
+    }
+
+    void RecordingBackend::BindVertexArray(unsigned int id)
+    {
+        Record(GraphicsCommandType::BindVertexArray, { (int)id });
+    }
+
+    void RecordingBackend::EnableVertexAttributeArray(unsigned int vertexBuffer)
+    {
+        Record(GraphicsCommandType::EnableVertexAttributeArray, { (int)vertexBuffer });
+    }
+
+    void RecordingBackend::SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset)
+    {
+        Record(GraphicsCommandType::SetVertexAttributePointer, { (int)vertexBuffer, static_cast<int>(element.type), element.normalized ? 1 : 0, stride, (int)reinterpret_cast<uintptr_t>(offset) });
+    }
+
+    void RecordingBackend::SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor)
+    {
+        Record(GraphicsCommandType::SetVertexAttributeDivisor, { (int)vertexBuffer, (int)divisor });
+    }
+
+    unsigned int RecordingBackend::CreateShaderProgram()
+    {
+        unsigned int id = m_NextId++;
+        m_Programs[id] = ProgramRecord();
+        Record(GraphicsCommandType::CreateShaderProgram, { (int)id });
+        return id;
+    }
+
+    unsigned int RecordingBackend::CreateShader(ShaderType shaderType)
+    {
+        unsigned int id = m_NextId++;
+        m_Shaders[id] = ShaderRecord();
+        m_Shaders[id].type = shaderType;
+        Record(GraphicsCommandType::CreateShader, { (int)id, static_cast<int>(shaderType) });
+        return id;
+    }
+
+    void RecordingBackend::SetShaderSource(unsigned int shader, const std::string& source)
+    {
+        m_Shaders[shader].source = source;
+        Record(GraphicsCommandType::SetShaderSource, { (int)shader }, (unsigned int)source.length(), source.c_str());
+    }
+
+    void RecordingBackend::CompileShader(unsigned int shader)
+    {
+        Record(GraphicsCommandType::CompileShader, { (int)shader });
+    }
+
+    void RecordingBackend::DeleteShader(unsigned int shader)
+    {
+        m_Shaders.erase(shader);
+        Record(GraphicsCommandType::DeleteShader, { (int)shader });
+    }
+
+    bool RecordingBackend::IsShaderCompiled(unsigned int /*shader*/)
+    {
+        return true;
+    }
+
+    std::string RecordingBackend::GetShaderInfoLog(unsigned int /*shader*/)
+    {
+        return "";
+    }
+
+    void RecordingBackend::AttachShader(unsigned int program, unsigned int shader)
+    {
+        m_Programs[program].shaders.push_back(shader);
+        Record(GraphicsCommandType::AttachShader, { (int)program, (int)shader });
+    }
+
+    void RecordingBackend::DetachShader(unsigned int program, unsigned int shader)
+    {
+        std::vector<unsigned int>& shaders = m_Programs[program].shaders;
+        for (size_t i = 0; i < shaders.size(); i++)
+        {
+            if (shaders[i] == shader)
+            {
+                shaders.erase(shaders.begin() + i);
+                break;
+            }
+        }
+
+        Record(GraphicsCommandType::DetachShader, { (int)program, (int)shader });
+    }
+
+    void RecordingBackend::LinkShaderProgram(unsigned int program)
+    {
+        //The shaders are detached and deleted after linking, so the uniforms have to be found now
+        ReflectUniforms(m_Programs[program]);
+        Record(GraphicsCommandType::LinkShaderProgram, { (int)program });
+    }
+
+    bool RecordingBackend::IsShaderProgramLinked(unsigned int /*program*/)
+    {
+        return true;
+    }
+
+    void RecordingBackend::DeleteShaderProgram(unsigned int program)
+    {
+        if (m_BoundProgram == program)
+            m_BoundProgram = 0;
+
+        m_Programs.erase(program);
+        Record(GraphicsCommandType::DeleteShaderProgram, { (int)program });
+    }
+
+    void RecordingBackend::UseShaderProgram(unsigned int program)
+    {
+        m_BoundProgram = program;
+        Record(GraphicsCommandType::UseShaderProgram, { (int)program });
+    }
+
+    std::string RecordingBackend::GetShaderProgramInfoLog(unsigned int /*program*/)
+    {
+        return "";
+    }
+
+    int RecordingBackend::GetUniformLocation(unsigned int program, const std::string& uniform)
+    {
+        auto iterator = m_Programs.find(program);
+        if (iterator != m_Programs.end())
+        {
+            for (const UniformRecord& record : iterator->second.uniforms)
+            {
+                if (record.name == uniform)
+                    return record.location;
+            }
+        }
+        return -1;
+    }
+
+    int RecordingBackend::GetAttributeLocation(unsigned int /*program*/, const std::string& /*attribute*/)
+    {
+        //The shaders all use explicit attribute locations
+        return -1;
+    }
+
+    unsigned int RecordingBackend::GetNumberOfActiveUniforms(unsigned int program)
+    {
+        auto iterator = m_Programs.find(program);
+        return iterator != m_Programs.end() ? (unsigned int)iterator->second.uniforms.size() : 0;
+    }
+
+    std::string RecordingBackend::GetActiveUniformName(unsigned int program, unsigned int index)
+    {
+        auto iterator = m_Programs.find(program);
+        if (iterator == m_Programs.end() || index >= iterator->second.uniforms.size())
+            return "";
+
+        //Arrays are reported the same way OpenGL reports them
+        const UniformRecord& record = iterator->second.uniforms[index];
+        return record.count > 1 ? record.name + "[0]" : record.name;
+    }
+
+    void RecordingBackend::SetUniformInt(int location, int value)
+    {
+        Record(GraphicsCommandType::SetUniformInt, { (int)m_BoundProgram, location, value }, sizeof(int));
+        m_FrameCounters.uniformBytes += sizeof(int);
+    }
+
+    void RecordingBackend::SetUniformIntArray(int location, int* values, unsigned int count)
+    {
+        unsigned int size = count * sizeof(int);
+        Record(GraphicsCommandType::SetUniformIntArray, { (int)m_BoundProgram, location, (int)count }, size, values);
+        m_FrameCounters.uniformBytes += size;
+    }
+
+    void RecordingBackend::SetUniformFloat(int location, float value)
+    {
+        GraphicsCommand& command = Record(GraphicsCommandType::SetUniformFloat, { (int)m_BoundProgram, location }, sizeof(float));
+        RecordFloats(command, { value });
+        m_FrameCounters.uniformBytes += sizeof(float);
+    }
+
+    void RecordingBackend::SetUniformFloat2(int location, float value1, float value2)
+    {
+        GraphicsCommand& command = Record(GraphicsCommandType::SetUniformFloat2, { (int)m_BoundProgram, location }, 2 * sizeof(float));
+        RecordFloats(command, { value1, value2 });
+        m_FrameCounters.uniformBytes += 2 * sizeof(float);
+    }
+
+    void RecordingBackend::SetUniformFloat3(int location, float value1, float value2, float value3)
+    {
+        GraphicsCommand& command = Record(GraphicsCommandType::SetUniformFloat3, { (int)m_BoundProgram, location }, 3 * sizeof(float));
+        RecordFloats(command, { value1, value2, value3 });
+        m_FrameCounters.uniformBytes += 3 * sizeof(float);
+    }
+
+    void RecordingBackend::SetUniformFloat4(int location, float value1, float value2, float value3, float value4)
+    {
+        GraphicsCommand& command = Record(GraphicsCommandType::SetUniformFloat4, { (int)m_BoundProgram, location }, 4 * sizeof(float));
+        RecordFloats(command, { value1, value2, value3, value4 });
+        m_FrameCounters.uniformBytes += 4 * sizeof(float);
+    }
+
+    void RecordingBackend::SetUniformMatrix(int location, const Matrix& value)
+    {
+        Record(GraphicsCommandType::SetUniformMatrix, { (int)m_BoundProgram, location }, sizeof(value.m), &value.m[0][0]);
+        m_FrameCounters.uniformBytes += sizeof(value.m);
+    }
+
+    const std::vector<GraphicsCommand>& RecordingBackend::GetFrameCommands() const
+    {
+        return m_FrameCommands;
+    }
+
+    const std::vector<GraphicsCommand>& RecordingBackend::GetLastFrameCommands() const
+    {
+        return m_LastFrameCommands;
+    }
+
+    std::string RecordingBackend::GetLastFrameDump() const
+    {
+        std::string dump;
+        for (const GraphicsCommand& command : m_LastFrameCommands)
+        {
+            dump += GetCommandString(command);
+            dump += '\n';
+        }
+        return dump;
+    }
+
+    const GraphicsCounters& RecordingBackend::GetTotalCounters() const
+    {
+        return m_TotalCounters;
+    }
+
+    const GraphicsCounters& RecordingBackend::GetLastFrameCounters() const
+    {
+        return m_LastFrameCounters;
+    }
+
+    const char* RecordingBackend::GetCommandName(GraphicsCommandType aType)
+    {
+        int index = static_cast<int>(aType);
+        return index >= 0 && index < static_cast<int>(GraphicsCommandType::Count) ? kCommandNames[index] : "Unknown";
+    }
+
+    std::string RecordingBackend::GetCommandString(const GraphicsCommand& aCommand)
+    {
+        std::string line = GetCommandName(aCommand.type);
+        char buffer[32];
+
+        for (unsigned int i = 0; i < aCommand.numberOfValues; i++)
+        {
+            snprintf(buffer, sizeof(buffer), " %i", aCommand.values[i]);
+            line += buffer;
+        }
+
+        for (unsigned int i = 0; i < aCommand.numberOfFloats; i++)
+        {
+            snprintf(buffer, sizeof(buffer), " %g", aCommand.floats[i]);
+            line += buffer;
+        }
+
+        //The values of small uploads are already in the line, only uploaded data has a checksum
+        if (aCommand.size > 0 && aCommand.checksum != 0)
+            snprintf(buffer, sizeof(buffer), " (%u bytes, %08x)", aCommand.size, aCommand.checksum);
+        else if (aCommand.size > 0)
+            snprintf(buffer, sizeof(buffer), " (%u bytes)", aCommand.size);
+
+        if (aCommand.size > 0)
+            line += buffer;
+
+        return line;
+    }
+
+    GraphicsCommand& RecordingBackend::Record(GraphicsCommandType aType, std::initializer_list<int> aValues, unsigned int aSize, const void* aData)
+    {
+        m_FrameCommands.emplace_back();
+        GraphicsCommand& command = m_FrameCommands.back();
+        command.type = aType;
+        command.numberOfValues = 0;
+        command.numberOfFloats = 0;
+        command.size = aSize;
+        command.checksum = aData != nullptr ? Checksum(aData, aSize) : 0;
+
+        for (int value : aValues)
+        {
+            if (command.numberOfValues < GraphicsCommand::kMaxValues)
+                command.values[command.numberOfValues++] = value;
+        }
+
+        m_FrameCounters.calls++;
+        m_FrameCounters.callsByType[static_cast<int>(aType)]++;
+        return command;
+    }
+
+    void RecordingBackend::RecordFloats(GraphicsCommand& aCommand, std::initializer_list<float> aFloats)
+    {
+        for (float value : aFloats)
+        {
+            if (aCommand.numberOfFloats < GraphicsCommand::kMaxFloats)
+                aCommand.floats[aCommand.numberOfFloats++] = value;
+        }
+    }
+
+    RecordingBackend::BufferRecord* RecordingBackend::GetBoundBuffer(BufferType aBufferType)
+    {
+        auto iterator = m_Buffers.find(m_BoundBuffers[static_cast<int>(aBufferType)]);
+        return iterator != m_Buffers.end() ? &iterator->second : nullptr;
+    }
+
+    void RecordingBackend::ReflectUniforms(ProgramRecord& aProgram)
+    {
+        aProgram.uniforms.clear();
+        int nextLocation = 0;
+
+        for (unsigned int shader : aProgram.shaders)
+        {
+            auto iterator = m_Shaders.find(shader);
+            if (iterator == m_Shaders.end())
+                continue;
+
+            //Finds every 'uniform <type> <name>;' and 'uniform <type> <name>[<count>];' declaration
+            const std::string& source = iterator->second.source;
+            size_t position = source.find("uniform ");
+            while (position != std::string::npos)
+            {
+                size_t end = source.find(';', position);
+                if (end == std::string::npos)
+                    break;
+
+                char type[64] = {};
+                char name[64] = {};
+                std::string declaration = source.substr(position, end - position);
+                if (sscanf(declaration.c_str(), "uniform %63s %63[A-Za-z0-9_]", type, name) == 2)
+                {
+                    unsigned int count = 1;
+                    size_t bracket = declaration.find('[');
+                    if (bracket != std::string::npos)
+                        count = (unsigned int)strtoul(declaration.c_str() + bracket + 1, nullptr, 10);
+
+                    //The geometry and fragment shaders can declare the same uniform as the vertex shader
+                    bool isDeclared = false;
+                    for (const UniformRecord& record : aProgram.uniforms)
+                        isDeclared |= record.name == name;
+
+                    if (isDeclared == false)
+                    {
+                        UniformRecord record;
+                        record.name = name;
+                        record.location = nextLocation;
+                        record.count = count > 0 ? count : 1;
+                        aProgram.uniforms.push_back(record);
+                        nextLocation += record.count;
+                    }
+                }
+
+                position = source.find("uniform ", end);
+            }
+        }
+    }
+}
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "IGraphicsBackend.h"
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Every call the RecordingBackend gets is one of these, GetCommandName() returns the name used in the dumps
+    enum class GraphicsCommandType
+    {
+        Clear = 0,
+        SetClearColor,
+        SetViewport,
+        SetBlendingEnabled,
+        SetBlendingFunction,
+        SetScissorEnabled,
+        SetScissorRect,
+        DrawElements,
+        DrawArraysInstanced,
+        CreateTexture,
+        DeleteTexture,
+        BindTextureUnit,
+        SetTextureStorage,
+        SetTextureFilter,
+        SetTextureData,
+        SetTextureWrap,
+        CreateTextureArray,
+        SetTextureArrayStorage,
+        CopyTextureToTextureArray,
+        CopyTextureArray,
+        CopyTextureArrayToTexture,
+        BindFrameBuffer,
+        GenerateFrameBuffer,
+        DeleteFrameBuffer,
+        SetFrameBufferStorage,
+        CopyFrameBufferContents,
+        CreateBuffer,
+        DeleteBuffer,
+        BindBuffer,
+        InitBuffer,
+        UpdateBuffer,
+        InitPersistentBuffer,
+        FlushMappedBuffer,
+        CreateFence,
+        WaitForFence,
+        DeleteFence,
+        CreateVertexArray,
+        DeleteVertexArray,
+        BindVertexArray,
+        EnableVertexAttributeArray,
+        SetVertexAttributePointer,
+        SetVertexAttributeDivisor,
+        CreateShaderProgram,
+        CreateShader,
+        SetShaderSource,
+        CompileShader,
+        DeleteShader,
+        AttachShader,
+        DetachShader,
+        LinkShaderProgram,
+        DeleteShaderProgram,
+        UseShaderProgram,
+        SetUniformInt,
+        SetUniformIntArray,
+        SetUniformFloat,
+        SetUniformFloat2,
+        SetUniformFloat3,
+        SetUniformFloat4,
+        SetUniformMatrix,
+        Count
+    };
+
+    //One recorded call, values holds the call's integer arguments and floats its float arguments. Calls that upload
+    //data store the number of bytes in size and a hash of the bytes in checksum, so two dumps can be diffed
+    struct GraphicsCommand
+    {
+        static const unsigned int kMaxValues = 6;
+        static const unsigned int kMaxFloats = 4;
+
+        GraphicsCommandType type;
+        int values[kMaxValues];
+        float floats[kMaxFloats];
+        unsigned char numberOfValues;
+        unsigned char numberOfFloats;
+        unsigned int size;
+        unsigned int checksum;
+    };
+
+    struct GraphicsCounters
+    {
+        GraphicsCounters();
+
+        void Reset();
+        void Add(const GraphicsCounters& counters);
+
+        unsigned long long calls;
+        unsigned long long drawCalls;
+        unsigned long long vertices;
+        unsigned long long bufferBytes;
+        unsigned long long textureBytes;
+        unsigned long long uniformBytes;
+        unsigned long long callsByType[static_cast<int>(GraphicsCommandType::Count)];
+    };
+
+    //Records the calls Graphics makes into a command log instead of sending them to a GPU. Buffers are kept in
+    //memory (persistent buffers are mapped to it), ids and fences are made up and shaders always compile, their
+    //uniforms are found by reading the uniform declarations in the sources. Used to count what a frame costs in
+    //calls and bytes without a GPU, and to diff the draw streams of two frames or two builds
+    class RecordingBackend : public IGraphicsBackend
+    {
+    public:
+        RecordingBackend();
+
+        unsigned int GetApiVersion() override;
+        unsigned int GetShadingLanguageVersion() override;
+
+        void NewFrame() override;
+
+        void Clear() override;
+        void SetClearColor(const Color& clearColor) override;
+        void SetViewport(int x, int y, int width, int height) override;
+
+        void SetBlendingEnabled(bool enabled) override;
+        void SetBlendingFunction(BlendingFactor source, BlendingFactor destination) override;
+        void SetScissorEnabled(bool enabled) override;
+        void SetScissorRect(int x, int y, int width, int height) override;
+
+        void DrawElements(RenderMode renderMode, unsigned int indexCount, unsigned int baseVertex) override;
+        void DrawArraysInstanced(RenderMode renderMode, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance) override;
+
+        void CreateTexture(unsigned int* id, int count) override;
+        void DeleteTexture(unsigned int* id, int count) override;
+        void BindTextureUnit(unsigned int id, unsigned int slot) override;
+        void SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels) override;
+        void SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter) override;
+        void SetTextureData(unsigned int id, const ImageData& imageData) override;
+        void SetTextureWrap(unsigned int id, Wrap wrap) override;
+
+        void CreateTextureArray(unsigned int* id, int count) override;
+        void SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat) override;
+        void CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y) override;
+        void CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers) override;
+        void CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId) override;
+
+        void BindFrameBuffer(unsigned int frameBuffer) override;
+        void GenerateFrameBuffer(unsigned int* frameBuffer) override;
+        void DeleteFrameBuffer(unsigned int* frameBuffer) override;
+        void SetFrameBufferStorage(unsigned int frameBuffer, unsigned int textureId) override;
+        void CopyFrameBufferContents(unsigned int frameBuffer, PixelFormat format, unsigned int width, unsigned int height, unsigned char* buffer) override;
+
+        void CreateBuffer(unsigned int* id, int count) override;
+        void DeleteBuffer(unsigned int* id, int count) override;
+        void BindBuffer(BufferType bufferType, unsigned int id) override;
+        void InitBuffer(BufferType bufferType, unsigned int size, const void* data, BufferUsage usage) override;
+        void UpdateBuffer(BufferType bufferType, unsigned int offset, unsigned int size, const void* data) override;
+        void* InitPersistentBuffer(BufferType bufferType, unsigned int size) override;
+
+        void FlushMappedBuffer(unsigned int id, unsigned int offset, unsigned int size) override;
+
+        void* CreateFence() override;
+        void WaitForFence(void* fence) override;
+        void DeleteFence(void* fence) override;
+
+        void CreateVertexArray(unsigned int* id, int count) override;
+        void DeleteVertexArray(unsigned int* id, int count) override;
+        void BindVertexArray(unsigned int id) override;
+
+        void EnableVertexAttributeArray(unsigned int vertexBuffer) override;
+        void SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset) override;
+        void SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor) override;
+
+        unsigned int CreateShaderProgram() override;
+        unsigned int CreateShader(ShaderType shaderType) override;
+        void SetShaderSource(unsigned int shader, const std::string& source) override;
+        void CompileShader(unsigned int shader) override;
+        void DeleteShader(unsigned int shader) override;
+        bool IsShaderCompiled(unsigned int shader) override;
+        std::string GetShaderInfoLog(unsigned int shader) override;
+
+        void AttachShader(unsigned int program, unsigned int shader) override;
+        void DetachShader(unsigned int program, unsigned int shader) override;
+
+        void LinkShaderProgram(unsigned int program) override;
+        bool IsShaderProgramLinked(unsigned int program) override;
+        void DeleteShaderProgram(unsigned int program) override;
+        void UseShaderProgram(unsigned int program) override;
+        std::string GetShaderProgramInfoLog(unsigned int program) override;
+
+        int GetUniformLocation(unsigned int program, const std::string& uniform) override;
+        int GetAttributeLocation(unsigned int program, const std::string& attribute) override;
+
+        unsigned int GetNumberOfActiveUniforms(unsigned int program) override;
+        std::string GetActiveUniformName(unsigned int program, unsigned int index) override;
+
+        void SetUniformInt(int location, int value) override;
+        void SetUniformIntArray(int location, int* values, unsigned int count) override;
+        void SetUniformFloat(int location, float value) override;
+        void SetUniformFloat2(int location, float value1, float value2) override;
+        void SetUniformFloat3(int location, float value1, float value2, float value3) override;
+        void SetUniformFloat4(int location, float value1, float value2, float value3, float value4) override;
+        void SetUniformMatrix(int location, const Matrix& value) override;
+
+        //The commands recorded since the last NewFrame(), and the commands of the frame before it
+        const std::vector<GraphicsCommand>& GetFrameCommands() const;
+        const std::vector<GraphicsCommand>& GetLastFrameCommands() const;
+
+        //Returns the last frame's commands as text, one command per line
+        std::string GetLastFrameDump() const;
+
+        const GraphicsCounters& GetTotalCounters() const;
+        const GraphicsCounters& GetLastFrameCounters() const;
+
+        static const char* GetCommandName(GraphicsCommandType type);
+        static std::string GetCommandString(const GraphicsCommand& command);
+
+    protected:
+        struct BufferRecord
+        {
+            std::vector<unsigned char> data;
+            bool isPersistent;
+        };
+
+        struct UniformRecord
+        {
+            std::string name;
+            int location;
+            unsigned int count;
+        };
+
+        struct ShaderRecord
+        {
+            ShaderType type;
+            std::string source;
+        };
+
+        struct ProgramRecord
+        {
+            std::vector<unsigned int> shaders;
+            std::vector<UniformRecord> uniforms;
+        };
+
+        //Adds a command to the log and counts it, the values and floats are copied into it
+        GraphicsCommand& Record(GraphicsCommandType type, std::initializer_list<int> values, unsigned int size = 0, const void* data = nullptr);
+        void RecordFloats(GraphicsCommand& command, std::initializer_list<float> floats);
+
+        //Returns the bound buffer for bufferType, nullptr if none is bound
+        BufferRecord* GetBoundBuffer(BufferType bufferType);
+
+        //Fills in the program's uniforms from the uniform declarations in its shaders' sources
+        void ReflectUniforms(ProgramRecord& program);
+
+        static const unsigned int kNumberOfBufferTypes = 2;
+
+        //Member variables
+        std::vector<GraphicsCommand> m_FrameCommands;
+        std::vector<GraphicsCommand> m_LastFrameCommands;
+        GraphicsCounters m_FrameCounters;
+        GraphicsCounters m_LastFrameCounters;
+        GraphicsCounters m_TotalCounters;
+
+        std::unordered_map<unsigned int, BufferRecord> m_Buffers;
+        std::unordered_map<unsigned int, ShaderRecord> m_Shaders;
+        std::unordered_map<unsigned int, ProgramRecord> m_Programs;
+        unsigned int m_BoundBuffers[kNumberOfBufferTypes];
+        unsigned int m_BoundProgram;
+        unsigned int m_NextId;
+    };
+}
\ No newline at end of file
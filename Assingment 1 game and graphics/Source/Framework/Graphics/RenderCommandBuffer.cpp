@@ -0,0 +1,532 @@
+#include "RenderCommandBuffer.h"
+#include "LineRenderer.h"
+#include "Sprite.h"
+#include "SpriteFont.h"
+#include "Texture.h"
+
+
+namespace
+{
+	//Sharp corners miter out past the line width, registered shapes and line strips are given this many line
+	//widths of room so that their corners aren't culled while they're still on screen
+	const float kLineCullMargin = 4.0f;
+
+	//m_OpenShapeBatch when the last command can't be extended by another line shape
+	const unsigned int kNoShapeBatch = 0xffffffff;
+}
+
+namespace GameDev2D
+{
+	RenderCommandBuffer::RenderCommandBuffer() :
+		m_Commands{},
+		m_CommandKeys{},
+		m_CommandPoints{},
+		m_ShapeInstances{},
+		m_ShapeInstanceIds{},
+		m_OpenShapeBatch(kNoShapeBatch),
+		m_LineRenderer(nullptr),
+		m_CullMin(Vector2::Zero),
+		m_CullMax(Vector2::Zero),
+		m_HasCullRect(false),
+		m_CopiesSprites(false),
+		m_CopiesSpriteOutlines(false),
+		m_Layer(0),
+		m_SubmittedItems(0),
+		m_CulledItems(0)
+	{
+	}
+
+	void RenderCommandBuffer::RenderSprite(Sprite& sprite)
+	{
+		if (IsSpriteCulled(sprite))
+		{
+			return;
+		}
+
+		if (m_CopiesSprites)
+		{
+			//Only the anchored corner goes through the transform, the edges are its scaled x and y axes
+			const Affine2D& transform = sprite.GetWorldTransform();
+			Vector2 size = sprite.GetSize();
+			Vector2 anchor = sprite.GetAnchor();
+			Vector2 origin = transform * Vector2(-size.x * anchor.x, -size.y * anchor.y);
+			Vector2 axisX(transform.m[0][0] * size.x, transform.m[0][1] * size.x);
+			Vector2 axisY(transform.m[1][0] * size.y, transform.m[1][1] * size.y);
+
+			Vector2 uvs[4];
+			sprite.GetUVs(uvs);
+			QueueTexturedQuad(sprite.GetTexture(), origin, axisX, axisY, uvs[0], uvs[2] - uvs[0], sprite.GetColor(), false);
+
+#if DEBUG
+			//The sprite renderer outlines the sprites it's given, a copied sprite's outline is queued right after it
+			if (m_CopiesSpriteOutlines)
+			{
+				RenderCommand outline;
+				outline.type = RenderCommandType::SpriteOutline;
+				outline.transform = transform;
+				outline.size = size * sprite.GetWorldScale();
+				outline.anchor = anchor;
+				QueueCommand(RendererType::Sprite, 0, outline);
+			}
+#endif
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::Sprite;
+		command.sprite = &sprite;
+		QueueCommand(RendererType::Sprite, sprite.GetTexture() != nullptr ? sprite.GetTexture()->GetBatchId() : 0, command);
+	}
+
+	void RenderCommandBuffer::RenderSpriteFont(SpriteFont& spriteFont)
+	{
+		if (IsSpriteFontCulled(spriteFont))
+		{
+			return;
+		}
+
+		if (m_CopiesSprites)
+		{
+			const Affine2D& parent = spriteFont.GetWorldTransform();
+			bool distanceField = spriteFont.GetFont()->IsDistanceField();
+
+			for (const SpriteFont::GlyphQuad& quad : spriteFont.GetGlyphQuads())
+			{
+				QueueTexturedQuad(spriteFont.GetTexture(), parent * quad.origin, parent.TransformVector(quad.axisX), parent.TransformVector(quad.axisY), quad.uvOrigin, quad.uvSize, quad.color, distanceField);
+			}
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::SpriteFont;
+		command.sprite = &spriteFont;
+		QueueCommand(RendererType::Sprite, spriteFont.GetTexture() != nullptr ? spriteFont.GetTexture()->GetBatchId() : 0, command);
+	}
+
+	void RenderCommandBuffer::RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor)
+	{
+		if (IsQuadCulled(position, size, 0.0f, anchor, 0.0f))
+		{
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::Quad;
+		command.position = position;
+		command.size = size;
+		command.anchor = anchor;
+		command.fillColor = fillColor;
+		command.hasOutline = false;
+		QueueCommand(RendererType::Sprite, 0, command);
+	}
+
+	void RenderCommandBuffer::RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize)
+	{
+		if (IsQuadCulled(position, size, 0.0f, anchor, outlineSize))
+		{
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::Quad;
+		command.position = position;
+		command.size = size;
+		command.anchor = anchor;
+		command.fillColor = fillColor;
+		command.outlineColor = outlineColor;
+		command.outlineSize = outlineSize;
+		command.hasOutline = true;
+		QueueCommand(RendererType::Sprite, 0, command);
+	}
+
+	void RenderCommandBuffer::RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor)
+	{
+		if (IsQuadCulled(position, size, radians, anchor, 0.0f))
+		{
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::RotatedQuad;
+		command.position = position;
+		command.size = size;
+		command.anchor = anchor;
+		command.fillColor = fillColor;
+		command.radians = radians;
+		command.hasOutline = false;
+		QueueCommand(RendererType::Sprite, 0, command);
+	}
+
+	void RenderCommandBuffer::RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize)
+	{
+		if (IsQuadCulled(position, size, radians, anchor, outlineSize))
+		{
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::RotatedQuad;
+		command.position = position;
+		command.size = size;
+		command.anchor = anchor;
+		command.fillColor = fillColor;
+		command.radians = radians;
+		command.outlineColor = outlineColor;
+		command.outlineSize = outlineSize;
+		command.hasOutline = true;
+		QueueCommand(RendererType::Sprite, 0, command);
+	}
+
+	void RenderCommandBuffer::RenderLineStrip(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		if (IsLineStripCulled(points, numberOfPoints, lineWidth, position, radians))
+		{
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::LineStrip;
+		command.position = position;
+		command.radians = radians;
+		command.fillColor = color;
+		command.lineWidth = lineWidth;
+		command.firstPoint = (unsigned int)m_CommandPoints.size();
+		command.numberOfPoints = numberOfPoints;
+		m_CommandPoints.insert(m_CommandPoints.end(), points, points + numberOfPoints);
+		QueueCommand(RendererType::Line, 0, command);
+	}
+
+	void RenderCommandBuffer::RenderLineShape(unsigned int shapeId, const Color& color, float lineWidth, const Vector2& position, float radians)
+	{
+		if (m_LineRenderer != nullptr && shapeId >= m_LineRenderer->GetNumberOfShapes())
+		{
+			return;
+		}
+
+		if (IsLineShapeCulled(shapeId, lineWidth, position))
+		{
+			return;
+		}
+
+		//The record is the one the line renderer uploads, replaying the command only copies the range
+		LineShapeInstance instance;
+		instance.position = position;
+		instance.radians = radians;
+		instance.color = color;
+		instance.lineWidth = lineWidth;
+		m_ShapeInstances.push_back(instance);
+		m_ShapeInstanceIds.push_back(shapeId);
+
+		if (m_OpenShapeBatch != kNoShapeBatch)
+		{
+			m_Commands[m_OpenShapeBatch].numberOfInstances++;
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::LineShapes;
+		command.firstInstance = (unsigned int)m_ShapeInstances.size() - 1;
+		command.numberOfInstances = 1;
+		QueueCommand(RendererType::Line, 0, command);
+		m_OpenShapeBatch = (unsigned int)m_Commands.size() - 1;
+	}
+
+	void RenderCommandBuffer::RenderPoint(const Vector2& position, const Color& color)
+	{
+		if (IsCulled(position, position))
+		{
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::Point;
+		command.position = position;
+		command.fillColor = color;
+		QueueCommand(RendererType::Point, 0, command);
+	}
+
+	void RenderCommandBuffer::RenderCircle(const Vector2& position, float radius, const Color& fillColor, const Color& outlineColor, float outlineSize)
+	{
+		if (IsCircleCulled(position, radius, outlineSize))
+		{
+			return;
+		}
+
+		RenderCommand command;
+		command.type = RenderCommandType::Circle;
+		command.position = position;
+		command.size = Vector2(radius, radius);
+		command.fillColor = fillColor;
+		command.outlineColor = outlineColor;
+		command.outlineSize = outlineSize;
+		QueueCommand(RendererType::Circle, 0, command);
+	}
+
+	void RenderCommandBuffer::SetLayer(unsigned char layer)
+	{
+		if (layer != m_Layer)
+		{
+			m_Layer = layer;
+			m_OpenShapeBatch = kNoShapeBatch;
+		}
+	}
+
+	unsigned char RenderCommandBuffer::GetLayer() const
+	{
+		return m_Layer;
+	}
+
+	void RenderCommandBuffer::Clear()
+	{
+		m_Commands.clear();
+		m_CommandKeys.clear();
+		m_CommandPoints.clear();
+		m_ShapeInstances.clear();
+		m_ShapeInstanceIds.clear();
+		m_OpenShapeBatch = kNoShapeBatch;
+		m_SubmittedItems = 0;
+		m_CulledItems = 0;
+	}
+
+	unsigned int RenderCommandBuffer::GetNumberOfCommands() const
+	{
+		return (unsigned int)m_Commands.size();
+	}
+
+	unsigned long long RenderCommandBuffer::GetSubmittedItems() const
+	{
+		return m_SubmittedItems;
+	}
+
+	unsigned long long RenderCommandBuffer::GetCulledItems() const
+	{
+		return m_CulledItems;
+	}
+
+	void RenderCommandBuffer::QueueCommand(RendererType rendererType, unsigned int textureId, const RenderCommand& command)
+	{
+		unsigned long long key = (unsigned long long)m_Layer << 56;
+		key |= (unsigned long long)rendererType << 52;
+		key |= (unsigned long long)(textureId & 0xfffff) << 32;
+		key |= (unsigned long long)m_Commands.size();
+
+		m_OpenShapeBatch = kNoShapeBatch;
+		m_CommandKeys.push_back(key);
+		m_Commands.push_back(command);
+	}
+
+	void RenderCommandBuffer::QueueTexturedQuad(Texture* texture, const Vector2& origin, const Vector2& axisX, const Vector2& axisY, const Vector2& uvOrigin, const Vector2& uvSize, const Color& color, bool distanceField)
+	{
+		RenderCommand command;
+		command.type = RenderCommandType::TexturedQuad;
+		command.texture = texture;
+		command.position = origin;
+		command.axisX = axisX;
+		command.axisY = axisY;
+		command.uvOrigin = uvOrigin;
+		command.uvSize = uvSize;
+		command.fillColor = color;
+		command.distanceField = distanceField;
+		QueueCommand(RendererType::Sprite, texture != nullptr ? texture->GetBatchId() : 0, command);
+	}
+
+	void RenderCommandBuffer::Append(const RenderCommandBuffer& buffer)
+	{
+		//The appended commands are numbered after this buffer's, and their points and instances are moved past this buffer's
+		unsigned int firstCommand = (unsigned int)m_Commands.size();
+		unsigned int firstPoint = (unsigned int)m_CommandPoints.size();
+		unsigned int firstInstance = (unsigned int)m_ShapeInstances.size();
+
+		for (unsigned long long key : buffer.m_CommandKeys)
+		{
+			m_CommandKeys.push_back((key & 0xffffffff00000000ull) | (unsigned long long)(firstCommand + (unsigned int)(key & 0xffffffff)));
+		}
+
+		for (const RenderCommand& command : buffer.m_Commands)
+		{
+			m_Commands.push_back(command);
+			if (command.type == RenderCommandType::LineStrip)
+			{
+				m_Commands.back().firstPoint += firstPoint;
+			}
+			else if (command.type == RenderCommandType::LineShapes)
+			{
+				m_Commands.back().firstInstance += firstInstance;
+			}
+		}
+
+		m_CommandPoints.insert(m_CommandPoints.end(), buffer.m_CommandPoints.begin(), buffer.m_CommandPoints.end());
+		m_ShapeInstances.insert(m_ShapeInstances.end(), buffer.m_ShapeInstances.begin(), buffer.m_ShapeInstances.end());
+		m_ShapeInstanceIds.insert(m_ShapeInstanceIds.end(), buffer.m_ShapeInstanceIds.begin(), buffer.m_ShapeInstanceIds.end());
+		m_OpenShapeBatch = kNoShapeBatch;
+		m_SubmittedItems += buffer.m_SubmittedItems;
+		m_CulledItems += buffer.m_CulledItems;
+	}
+
+	void RenderCommandBuffer::SetLineRenderer(const LineRenderer* lineRenderer)
+	{
+		m_LineRenderer = lineRenderer;
+	}
+
+	void RenderCommandBuffer::SetCullRect(const Vector2& min, const Vector2& max)
+	{
+		m_CullMin = min;
+		m_CullMax = max;
+		m_HasCullRect = true;
+	}
+
+	void RenderCommandBuffer::ClearCullRect()
+	{
+		m_HasCullRect = false;
+	}
+
+	void RenderCommandBuffer::CopySceneState(const RenderCommandBuffer& buffer)
+	{
+		m_CullMin = buffer.m_CullMin;
+		m_CullMax = buffer.m_CullMax;
+		m_LineRenderer = buffer.m_LineRenderer;
+		m_HasCullRect = buffer.m_HasCullRect;
+		m_CopiesSprites = buffer.m_CopiesSprites;
+		m_CopiesSpriteOutlines = buffer.m_CopiesSpriteOutlines;
+		m_Layer = buffer.m_Layer;
+	}
+
+	void RenderCommandBuffer::SwapCommands(RenderCommandBuffer& buffer)
+	{
+		std::swap(m_Commands, buffer.m_Commands);
+		std::swap(m_CommandKeys, buffer.m_CommandKeys);
+		std::swap(m_CommandPoints, buffer.m_CommandPoints);
+		std::swap(m_ShapeInstances, buffer.m_ShapeInstances);
+		std::swap(m_ShapeInstanceIds, buffer.m_ShapeInstanceIds);
+		std::swap(m_OpenShapeBatch, buffer.m_OpenShapeBatch);
+		std::swap(m_SubmittedItems, buffer.m_SubmittedItems);
+		std::swap(m_CulledItems, buffer.m_CulledItems);
+	}
+
+	bool RenderCommandBuffer::IsCulled(const Vector2& min, const Vector2& max)
+	{
+		if (m_HasCullRect == false)
+		{
+			return false;
+		}
+
+		m_SubmittedItems++;
+
+		if (max.x < m_CullMin.x || min.x > m_CullMax.x || max.y < m_CullMin.y || min.y > m_CullMax.y)
+		{
+			m_CulledItems++;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool RenderCommandBuffer::IsCulled(const Affine2D& transform, const Vector2& min, const Vector2& max, float margin)
+	{
+		if (m_HasCullRect == false)
+		{
+			return false;
+		}
+
+		//The transformed rect's bounds are its transformed center, plus half of its size along each axis
+		Vector2 center = transform * Vector2((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f);
+		float halfWidth = (max.x - min.x) * 0.5f + margin;
+		float halfHeight = (max.y - min.y) * 0.5f + margin;
+		float extentX = fabsf(transform.m[0][0]) * halfWidth + fabsf(transform.m[1][0]) * halfHeight;
+		float extentY = fabsf(transform.m[0][1]) * halfWidth + fabsf(transform.m[1][1]) * halfHeight;
+		Vector2 extent(extentX, extentY);
+
+		return IsCulled(center - extent, center + extent);
+	}
+
+	bool RenderCommandBuffer::IsSpriteCulled(Sprite& sprite)
+	{
+		if (m_HasCullRect == false)
+		{
+			return false;
+		}
+
+		Vector2 size = sprite.GetSize();
+		Vector2 anchor = sprite.GetAnchor();
+		Vector2 min(-size.x * anchor.x, -size.y * anchor.y);
+		return IsCulled(sprite.GetWorldTransform(), min, min + size, 0.0f);
+	}
+
+	bool RenderCommandBuffer::IsSpriteFontCulled(SpriteFont& spriteFont)
+	{
+		if (m_HasCullRect == false)
+		{
+			return false;
+		}
+
+		//Each character can be scaled and rotated, so the bounds are found from the laid out quads
+		const std::vector<SpriteFont::GlyphQuad>& glyphQuads = spriteFont.GetGlyphQuads();
+		if (glyphQuads.empty())
+		{
+			return false;
+		}
+
+		Vector2 min = glyphQuads[0].origin;
+		Vector2 max = glyphQuads[0].origin;
+		for (const SpriteFont::GlyphQuad& quad : glyphQuads)
+		{
+			const Vector2 corners[] = { quad.origin, quad.origin + quad.axisX, quad.origin + quad.axisY, quad.origin + quad.axisX + quad.axisY };
+			for (const Vector2& corner : corners)
+			{
+				min = Vector2(fminf(min.x, corner.x), fminf(min.y, corner.y));
+				max = Vector2(fmaxf(max.x, corner.x), fmaxf(max.y, corner.y));
+			}
+		}
+
+		return IsCulled(spriteFont.GetWorldTransform(), min, max, 0.0f);
+	}
+
+	bool RenderCommandBuffer::IsQuadCulled(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, float outlineSize)
+	{
+		if (m_HasCullRect == false)
+		{
+			return false;
+		}
+
+		Affine2D transform = radians == 0.0f ? Affine2D::MakeTranslation(position) : Affine2D::Make(position, radians);
+		Vector2 min(-size.x * anchor.x, -size.y * anchor.y);
+		return IsCulled(transform, min, min + size, outlineSize);
+	}
+
+	bool RenderCommandBuffer::IsLineStripCulled(const Vector2* points, unsigned int numberOfPoints, float lineWidth, const Vector2& position, float radians)
+	{
+		if (m_HasCullRect == false || numberOfPoints == 0)
+		{
+			return false;
+		}
+
+		Vector2 min = points[0];
+		Vector2 max = points[0];
+		for (unsigned int i = 1; i < numberOfPoints; i++)
+		{
+			min = Vector2(fminf(min.x, points[i].x), fminf(min.y, points[i].y));
+			max = Vector2(fmaxf(max.x, points[i].x), fmaxf(max.y, points[i].y));
+		}
+
+		return IsCulled(Affine2D::Make(position, radians), min, max, lineWidth * kLineCullMargin);
+	}
+
+	bool RenderCommandBuffer::IsLineShapeCulled(unsigned int shapeId, float lineWidth, const Vector2& position)
+	{
+		if (m_HasCullRect == false || m_LineRenderer == nullptr)
+		{
+			return false;
+		}
+
+		//The shape's radius covers it at any rotation
+		float radius = m_LineRenderer->GetShapeRadius(shapeId) + lineWidth * kLineCullMargin;
+		return IsCulled(position - Vector2(radius, radius), position + Vector2(radius, radius));
+	}
+
+	bool RenderCommandBuffer::IsCircleCulled(const Vector2& position, float radius, float outlineSize)
+	{
+		//The circle's quad is sized to the radius plus the outline
+		float extent = radius + outlineSize;
+		return IsCulled(position - Vector2(extent, extent), position + Vector2(extent, extent));
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "IRenderer.h"
+#include "Color.h"
+#include "LineExpander.h"
+#include "../Math/Affine2D.h"
+#include "../Math/Vector2.h"
+#include <vector>
+
+
+namespace GameDev2D
+{
+	class LineRenderer;
+	class Sprite;
+	class SpriteFont;
+	class Texture;
+
+	//Records Render calls so that a BatchRenderer can replay them later, culling them against the scene camera's
+	//view as they're recorded. The deferred render order and the render thread's frame snapshots queue into one, and
+	//worker threads can each fill their own in parallel: BatchRenderer::PrepareCommandBuffer() readies a buffer, the
+	//worker records into it, then BatchRenderer::SubmitCommandBuffer() replays or queues it, both on the thread that
+	//uses the BatchRenderer. A buffer doesn't touch the graphics API or the renderers while recording, but it must
+	//only be filled by one thread at a time
+	class RenderCommandBuffer
+	{
+	public:
+		RenderCommandBuffer();
+
+		//Sprites and sprite fonts are kept by pointer so they have to stay alive until the buffer is submitted. When the
+		//frame is recorded for the render thread their quads are copied instead, so they can change straight away
+		void RenderSprite(Sprite& sprite);
+		void RenderSpriteFont(SpriteFont& spriteFont);
+
+		void RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor);
+		void RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize);
+
+		void RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor);
+		void RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize);
+
+		//The points are copied into the buffer
+		void RenderLineStrip(const Vector2* points, unsigned int numberOfPoints, const Color& color, float lineWidth, const Vector2& position, float radians);
+
+		//The shape has to be registered before the buffer is prepared, see BatchRenderer::RegisterLineShape(). The instance
+		//record is written here, shapes rendered one after another on the same layer share one command
+		void RenderLineShape(unsigned int shapeId, const Color& color, float lineWidth, const Vector2& position, float radians);
+
+		void RenderPoint(const Vector2& position, const Color& color);
+
+		void RenderCircle(const Vector2& position, float radius, const Color& fillColor, const Color& outlineColor, float outlineSize);
+
+		//Primitives on a higher layer are drawn on top of lower layers, only used by the deferred render order
+		void SetLayer(unsigned char layer);
+		unsigned char GetLayer() const;
+
+		//Removes the recorded commands and resets the counters, the layer and the cull rect are kept
+		void Clear();
+
+		unsigned int GetNumberOfCommands() const;
+
+		//The number of Render calls made since the last Clear(), and how many of them were culled
+		unsigned long long GetSubmittedItems() const;
+		unsigned long long GetCulledItems() const;
+
+	private:
+		friend class BatchRenderer;
+
+		enum class RenderCommandType
+		{
+			Sprite = 0,
+			SpriteFont,
+			Quad,
+			RotatedQuad,
+			LineStrip,
+			LineShapes,
+			Point,
+			Circle,
+			TexturedQuad,
+			SpriteOutline
+		};
+
+		//Everything needed to replay one Render call, the fields that are used depend on the type
+		struct RenderCommand
+		{
+			RenderCommandType type;
+			Sprite* sprite;
+			Vector2 position;
+			Vector2 size;
+			Vector2 anchor;
+			float radians;
+			Color fillColor;
+			Color outlineColor;
+			float outlineSize;
+			bool hasOutline;
+			float lineWidth;
+			unsigned int firstPoint;
+			unsigned int numberOfPoints;
+			unsigned int firstInstance;
+			unsigned int numberOfInstances;
+			Texture* texture;
+			Vector2 axisX;
+			Vector2 axisY;
+			Vector2 uvOrigin;
+			Vector2 uvSize;
+			bool distanceField;
+			Affine2D transform;
+		};
+
+		//The sort key is the layer, renderer type and texture, followed by the command's index so that
+		//primitives with the same key stay in the order they were submitted. The shader is set by the renderer type
+		void QueueCommand(RendererType rendererType, unsigned int textureId, const RenderCommand& command);
+
+		//Queues a world space quad, the origin is stored in the command's position and the color in its fill color
+		void QueueTexturedQuad(Texture* texture, const Vector2& origin, const Vector2& axisX, const Vector2& axisY, const Vector2& uvOrigin, const Vector2& uvSize, const Color& color, bool distanceField);
+
+		//Appends another buffer's commands and counters, as if its Render calls had been made on this buffer
+		void Append(const RenderCommandBuffer& buffer);
+
+		//The line renderer is used to check the ids of line shapes and look up their size
+		void SetLineRenderer(const LineRenderer* lineRenderer);
+
+		//Sets the world space rect that's visible
+		void SetCullRect(const Vector2& min, const Vector2& max);
+		void ClearCullRect();
+
+		//Copies the line renderer, cull rect, layer and whether sprites (and their debug outlines) are copied from another buffer
+		void CopySceneState(const RenderCommandBuffer& buffer);
+
+		//Trades commands and counters with another buffer, without copying them. The scene state isn't traded
+		void SwapCommands(RenderCommandBuffer& buffer);
+
+		//Counts a submitted item and returns true if its world space bounds don't overlap the cull rect, always
+		//false when there's no cull rect. The transform version finds the bounds of a local space rect without
+		//transforming its corners, the margin grows the rect before it's transformed
+		bool IsCulled(const Vector2& min, const Vector2& max);
+		bool IsCulled(const Affine2D& transform, const Vector2& min, const Vector2& max, float margin);
+		bool IsSpriteCulled(Sprite& sprite);
+		bool IsSpriteFontCulled(SpriteFont& spriteFont);
+		bool IsQuadCulled(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, float outlineSize);
+		bool IsLineStripCulled(const Vector2* points, unsigned int numberOfPoints, float lineWidth, const Vector2& position, float radians);
+		bool IsLineShapeCulled(unsigned int shapeId, float lineWidth, const Vector2& position);
+		bool IsCircleCulled(const Vector2& position, float radius, float outlineSize);
+
+		std::vector<RenderCommand> m_Commands;
+		std::vector<unsigned long long> m_CommandKeys;
+		std::vector<Vector2> m_CommandPoints;
+		std::vector<LineShapeInstance> m_ShapeInstances;
+		std::vector<unsigned int> m_ShapeInstanceIds;
+		unsigned int m_OpenShapeBatch;
+		const LineRenderer* m_LineRenderer;
+		Vector2 m_CullMin;
+		Vector2 m_CullMax;
+		bool m_HasCullRect;
+		bool m_CopiesSprites;
+		bool m_CopiesSpriteOutlines;
+		unsigned char m_Layer;
+		unsigned long long m_SubmittedItems;
+		unsigned long long m_CulledItems;
+	};
+}
\ No newline at end of file
@@ -1,13 +1,19 @@
 #include "Shader.h"
 #include "Graphics.h"
-#include "../Application/Application.h"
+#include "../Debug/Log.h"
 
 
 namespace GameDev2D
 {
-	Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource)
+	Shader::Shader(Graphics& graphics, const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource) :
+		m_Graphics(graphics),
+		m_ID(0),
+		m_UniformLocations{}
 	{
-		Compile(vertexSource, fragmentSource, geometrySource);
+		if (Compile(vertexSource, fragmentSource, geometrySource))
+		{
+			ReflectUniforms();
+		}
 	}
 
 	Shader::~Shader()
@@ -16,54 +22,80 @@ namespace GameDev2D
 
 	void Shader::Bind() const
 	{
-		Application::Get().GetGraphics().UseShaderProgram(m_ID);
+		m_Graphics.UseShaderProgram(m_ID);
 	}
 
 	void Shader::Unbind() const
 	{
-		Application::Get().GetGraphics().UseShaderProgram(0);
+		m_Graphics.UseShaderProgram(0);
 	}
 
 	void Shader::SetInt(const std::string& name, int value)
 	{
-		int location = Application::Get().GetGraphics().GetUniformLocation(m_ID, name);
-		Application::Get().GetGraphics().SetUniformInt(location, value);
+		int location = GetUniformLocation(HashUniformName(name.c_str()));
+		m_Graphics.SetUniformInt(location, value);
 	}
 
 	void Shader::SetIntArray(const std::string& name, int* values, unsigned int count)
 	{
-		int location = Application::Get().GetGraphics().GetUniformLocation(m_ID, name);
-		Application::Get().GetGraphics().SetUniformIntArray(location, values, count);
+		int location = GetUniformLocation(HashUniformName(name.c_str()));
+		m_Graphics.SetUniformIntArray(location, values, count);
 	}
 
 	void Shader::SetFloat(const std::string& name, float value)
 	{
-		int location = Application::Get().GetGraphics().GetUniformLocation(m_ID, name);
-		Application::Get().GetGraphics().SetUniformFloat(location, value);
+		int location = GetUniformLocation(HashUniformName(name.c_str()));
+		m_Graphics.SetUniformFloat(location, value);
 	}
 
 	void Shader::SetFloat2(const std::string& name, float value1, float value2)
 	{
-		int location = Application::Get().GetGraphics().GetUniformLocation(m_ID, name);
-		Application::Get().GetGraphics().SetUniformFloat2(location, value1, value2);
+		int location = GetUniformLocation(HashUniformName(name.c_str()));
+		m_Graphics.SetUniformFloat2(location, value1, value2);
 	}
 
 	void Shader::SetFloat3(const std::string& name, float value1, float value2, float value3)
 	{
-		int location = Application::Get().GetGraphics().GetUniformLocation(m_ID, name);
-		Application::Get().GetGraphics().SetUniformFloat3(location, value1, value2, value3);
+		int location = GetUniformLocation(HashUniformName(name.c_str()));
+		m_Graphics.SetUniformFloat3(location, value1, value2, value3);
 	}
 
 	void Shader::SetFloat4(const std::string& name, float value1, float value2, float value3, float value4)
 	{
-		int location = Application::Get().GetGraphics().GetUniformLocation(m_ID, name);
-		Application::Get().GetGraphics().SetUniformFloat4(location, value1, value2, value3, value4);
+		int location = GetUniformLocation(HashUniformName(name.c_str()));
+		m_Graphics.SetUniformFloat4(location, value1, value2, value3, value4);
 	}
 
 	void Shader::SetMat4(const std::string& name, const Matrix& value)
 	{
-		int location = Application::Get().GetGraphics().GetUniformLocation(m_ID, name);
-		Application::Get().GetGraphics().SetUniformMatrix(location, value);
+		int location = GetUniformLocation(HashUniformName(name.c_str()));
+		m_Graphics.SetUniformMatrix(location, value);
+	}
+
+	void Shader::Set(ShaderUniform<int> uniform, int value)
+	{
+		m_Graphics.SetUniformInt(uniform.location, value);
+	}
+
+	void Shader::Set(ShaderUniform<float> uniform, float value)
+	{
+		m_Graphics.SetUniformFloat(uniform.location, value);
+	}
+
+	void Shader::Set(ShaderUniform<Vector2> uniform, const Vector2& value)
+	{
+		m_Graphics.SetUniformFloat2(uniform.location, value.x, value.y);
+	}
+
+	void Shader::Set(ShaderUniform<Matrix> uniform, const Matrix& value)
+	{
+		m_Graphics.SetUniformMatrix(uniform.location, value);
+	}
+
+	int Shader::GetUniformLocation(unsigned int nameHash) const
+	{
+		std::unordered_map<unsigned int, int>::const_iterator it = m_UniformLocations.find(nameHash);
+		return it != m_UniformLocations.end() ? it->second : -1;
 	}
 
 	ShaderType Shader::GetShaderType(const std::string& type)
@@ -80,7 +112,7 @@ namespace GameDev2D
 
 	bool Shader::Compile(const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource)
 	{
-		Graphics& graphics = Application::Get().GetGraphics();
+		Graphics& graphics = m_Graphics;
 
 		assert(vertexSource.length() > 0);
 		assert(fragmentSource.length() > 0);
@@ -153,4 +185,30 @@ namespace GameDev2D
 
 		return true;
 	}
+
+	void Shader::ReflectUniforms()
+	{
+		Graphics& graphics = m_Graphics;
+
+		unsigned int numberOfUniforms = graphics.GetNumberOfActiveUniforms(m_ID);
+		for (unsigned int i = 0; i < numberOfUniforms; i++)
+		{
+			//Arrays are reported as name[0], they're looked up without the brackets
+			std::string name = graphics.GetActiveUniformName(m_ID, i);
+			size_t bracket = name.find('[');
+			if (bracket != std::string::npos)
+			{
+				name = name.substr(0, bracket);
+			}
+
+			unsigned int hash = HashUniformName(name.c_str());
+			if (m_UniformLocations.find(hash) != m_UniformLocations.end())
+			{
+				Log::Error(false, LogVerbosity::Shaders, "Shader uniform %s has the same hash as another uniform", name.c_str());
+				continue;
+			}
+
+			m_UniformLocations[hash] = graphics.GetUniformLocation(m_ID, name);
+		}
+	}
 }
\ No newline at end of file
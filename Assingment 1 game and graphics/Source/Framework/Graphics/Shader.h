@@ -7,12 +7,43 @@
 #include <unordered_map>
 
 
+//Shader constants
+const std::string SPRITE_RENDERER_SHADER_KEY = "SpriteRenderer";
+const std::string SPRITE_INSTANCE_RENDERER_SHADER_KEY = "SpriteInstanceRenderer";
+const std::string LINE_RENDERER_SHADER_KEY = "LineRenderer";
+const std::string LINE_SHAPE_RENDERER_SHADER_KEY = "LineShapeRenderer";
+const std::string LINE_INSTANCE_RENDERER_SHADER_KEY = "LineInstanceRenderer";
+const std::string LINE_QUAD_RENDERER_SHADER_KEY = "LineQuadRenderer";
+const std::string POINT_RENDERER_SHADER_KEY = "PointRenderer";
+const std::string CIRCLE_RENDERER_SHADER_KEY = "CircleRenderer";
+
 namespace GameDev2D
 {
+	class Graphics;
+
+	//FNV-1a hash of a uniform's name, it's constexpr so names written in the code are hashed when compiling
+	constexpr unsigned int HashUniformName(const char* name, unsigned int hash = 2166136261u)
+	{
+		return *name == '\0' ? hash : HashUniformName(name + 1, (hash ^ (unsigned char)*name) * 16777619u);
+	}
+
+	//The location of a uniform in a shader, looked up once and kept by the caller. The type
+	//makes sure the uniform can only be set with the kind of value it was declared with
+	template<typename T>
+	struct ShaderUniform
+	{
+		ShaderUniform() : location(-1) {}
+		explicit ShaderUniform(int location) : location(location) {}
+
+		bool IsValid() const { return location != -1; }
+
+		int location;
+	};
+
 	class Shader
 	{
 	public:
-		Shader(const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource = "");
+		Shader(Graphics& graphics, const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource = "");
 		~Shader();
 
 		void Bind() const;
@@ -26,11 +57,35 @@ namespace GameDev2D
 		void SetFloat4(const std::string& name, float value1, float value2, float value3, float value4);
 		void SetMat4(const std::string& name, const Matrix& value);
 
+		//Returns a handle to a uniform, it's invalid if the uniform isn't used by the shader
+		template<typename T>
+		ShaderUniform<T> GetUniform(const char* name) const;
+
+		//Sets a uniform without looking up its location, the shader has to be bound
+		void Set(ShaderUniform<int> uniform, int value);
+		void Set(ShaderUniform<float> uniform, float value);
+		void Set(ShaderUniform<Vector2> uniform, const Vector2& value);
+		void Set(ShaderUniform<Matrix> uniform, const Matrix& value);
+
+		//Returns -1 if the shader doesn't use a uniform with that name
+		int GetUniformLocation(unsigned int nameHash) const;
+
 		static ShaderType GetShaderType(const std::string& type);
 
 	private:
 		bool Compile(const std::string& vertexSource, const std::string& fragmentSource, const std::string& geometrySource);
 
+		//Stores the location of every active uniform, keyed by the hash of its name
+		void ReflectUniforms();
+
+		Graphics& m_Graphics;
 		unsigned int m_ID;
+		std::unordered_map<unsigned int, int> m_UniformLocations;
 	};
+
+	template<typename T>
+	ShaderUniform<T> Shader::GetUniform(const char* name) const
+	{
+		return ShaderUniform<T>(GetUniformLocation(HashUniformName(name)));
+	}
 }
\ No newline at end of file
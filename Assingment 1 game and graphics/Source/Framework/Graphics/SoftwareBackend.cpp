@@ -0,0 +1,907 @@
+#include "SoftwareBackend.h"
+#include "Buffer.h"
+#include <math.h>
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    namespace
+    {
+        //Same as BufferElement::GetComponentCount(), matrices are split into one attribute per column
+        unsigned int GetComponentCount(ShaderDataType type)
+        {
+            switch (type)
+            {
+            case ShaderDataType::Float:   return 1;
+            case ShaderDataType::Float2:  return 2;
+            case ShaderDataType::Float3:  return 3;
+            case ShaderDataType::Float4:  return 4;
+            case ShaderDataType::Mat3:    return 3;
+            case ShaderDataType::Mat4:    return 4;
+            case ShaderDataType::Int:     return 1;
+            case ShaderDataType::Int2:    return 2;
+            case ShaderDataType::Int3:    return 3;
+            case ShaderDataType::Int4:    return 4;
+            case ShaderDataType::Bool:    return 1;
+            default:                      return 0;
+            }
+        }
+
+        bool IsIntegerType(ShaderDataType type)
+        {
+            return type == ShaderDataType::Int || type == ShaderDataType::Int2 || type == ShaderDataType::Int3 || type == ShaderDataType::Int4;
+        }
+
+        //u_ViewProjection * vec4(x, y, 0.0, 1.0), the matrix is column major
+        inline void Transform(const float* matrix, float x, float y, float* position)
+        {
+            for (int row = 0; row < 4; row++)
+                position[row] = matrix[row] * x + matrix[4 + row] * y + matrix[12 + row];
+        }
+
+        //Same as GLSL's normalize(), a zero vector becomes NaN and so does the triangle using it
+        inline void Normalize(float x, float y, float* result)
+        {
+            float length = sqrtf(x * x + y * y);
+            result[0] = x / length;
+            result[1] = y / length;
+        }
+
+        inline void SetPosition(float* position, float x, float y, float z, float w)
+        {
+            position[0] = x;
+            position[1] = y;
+            position[2] = z;
+            position[3] = w;
+        }
+    }
+
+    SoftwareBackend::SoftwareProgram::SoftwareProgram() :
+        kind(ProgramKind::Unsupported),
+        viewProjectionLocation(-1),
+        viewportLocation(-1),
+        texturesLocation(-1),
+        textureArraysLocation(-1),
+        viewProjection{},
+        viewport{}
+    {
+        //Every texture index samples the unit with the same number until the samplers are set
+        for (unsigned int i = 0; i < SoftwareDrawState::kMaxTextures; i++)
+            samplers[i] = i;
+    }
+
+    SoftwareBackend::SoftwareVertexArray::SoftwareVertexArray() :
+        attributes{},
+        indexBuffer(0)
+    {
+    }
+
+    SoftwareBackend::SoftwareBackend(unsigned int aWidth, unsigned int aHeight, unsigned int aNumberOfThreads) :
+        m_Rasterizer(aWidth, aHeight, aNumberOfThreads),
+        m_AttributeSources{},
+        m_BaseInstance(0),
+        m_TextureUnits{},
+        m_BoundVertexArray(0),
+        m_ClearColor(),
+        m_Viewport{ 0, 0, (int)aWidth, (int)aHeight },
+        m_ScissorRect{ 0, 0, (int)aWidth, (int)aHeight },
+        m_IsScissorEnabled(false),
+        m_IsBlendingEnabled(false),
+        m_BlendingSource(BlendingFactor::One),
+        m_BlendingDestination(BlendingFactor::Zero),
+        m_SkippedDrawCalls(0)
+    {
+        //Vertex array 0 is always there, same as a compatibility profile context
+        m_VertexArrays[0] = SoftwareVertexArray();
+    }
+
+    void SoftwareBackend::NewFrame()
+    {
+        RecordingBackend::NewFrame();
+        Flush();
+    }
+
+    void SoftwareBackend::Clear()
+    {
+        RecordingBackend::Clear();
+
+        //Clearing ignores the viewport but not the scissor rect
+        int clip[4] = { 0, 0, (int)m_Rasterizer.GetWidth(), (int)m_Rasterizer.GetHeight() };
+        if (m_IsScissorEnabled)
+        {
+            clip[0] = m_ScissorRect[0];
+            clip[1] = m_ScissorRect[1];
+            clip[2] = m_ScissorRect[0] + m_ScissorRect[2];
+            clip[3] = m_ScissorRect[1] + m_ScissorRect[3];
+        }
+
+        m_Rasterizer.Clear(m_ClearColor, clip);
+    }
+
+    void SoftwareBackend::SetClearColor(const Color& aClearColor)
+    {
+        RecordingBackend::SetClearColor(aClearColor);
+        m_ClearColor = aClearColor;
+    }
+
+    void SoftwareBackend::SetViewport(int x, int y, int width, int height)
+    {
+        RecordingBackend::SetViewport(x, y, width, height);
+        m_Viewport[0] = x;
+        m_Viewport[1] = y;
+        m_Viewport[2] = width;
+        m_Viewport[3] = height;
+    }
+
+    void SoftwareBackend::SetBlendingEnabled(bool enabled)
+    {
+        RecordingBackend::SetBlendingEnabled(enabled);
+        m_IsBlendingEnabled = enabled;
+    }
+
+    void SoftwareBackend::SetBlendingFunction(BlendingFactor source, BlendingFactor destination)
+    {
+        RecordingBackend::SetBlendingFunction(source, destination);
+        m_BlendingSource = source;
+        m_BlendingDestination = destination;
+    }
+
+    void SoftwareBackend::SetScissorEnabled(bool enabled)
+    {
+        RecordingBackend::SetScissorEnabled(enabled);
+        m_IsScissorEnabled = enabled;
+    }
+
+    void SoftwareBackend::SetScissorRect(int x, int y, int width, int height)
+    {
+        RecordingBackend::SetScissorRect(x, y, width, height);
+        m_ScissorRect[0] = x;
+        m_ScissorRect[1] = y;
+        m_ScissorRect[2] = width;
+        m_ScissorRect[3] = height;
+    }
+
+    void SoftwareBackend::DrawElements(RenderMode renderMode, unsigned int indexCount, unsigned int baseVertex)
+    {
+        RecordingBackend::DrawElements(renderMode, indexCount, baseVertex);
+
+        SoftwareProgram* program = BeginDraw(renderMode, 0);
+        if (program == nullptr)
+            return;
+
+        //The indices are 32 bit and start at the beginning of the vertex array's index buffer
+        auto buffer = m_Buffers.find(m_VertexArrays[m_BoundVertexArray].indexBuffer);
+        if (buffer == m_Buffers.end() || (size_t)indexCount * sizeof(unsigned int) > buffer->second.data.size())
+        {
+            m_SkippedDrawCalls++;
+            return;
+        }
+
+        const unsigned char* indices = buffer->second.data.data();
+        m_ShadedVertices.resize(indexCount);
+        for (unsigned int i = 0; i < indexCount; i++)
+        {
+            unsigned int index;
+            memcpy(&index, indices + i * sizeof(unsigned int), sizeof(unsigned int));
+            ShadeVertex(*program, index + baseVertex, 0, m_ShadedVertices[i]);
+        }
+
+        AddPrimitives(renderMode, m_ShadedVertices);
+    }
+
+    void SoftwareBackend::DrawArraysInstanced(RenderMode renderMode, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance)
+    {
+        RecordingBackend::DrawArraysInstanced(renderMode, firstVertex, vertexCount, instanceCount, baseInstance);
+
+        SoftwareProgram* program = BeginDraw(renderMode, baseInstance);
+        if (program == nullptr)
+            return;
+
+        //Each instance is its own primitive, a strip doesn't continue from one instance into the next
+        m_ShadedVertices.resize(vertexCount);
+        for (unsigned int instance = 0; instance < instanceCount; instance++)
+        {
+            for (unsigned int i = 0; i < vertexCount; i++)
+                ShadeVertex(*program, firstVertex + i, instance, m_ShadedVertices[i]);
+
+            AddPrimitives(renderMode, m_ShadedVertices);
+        }
+    }
+
+    void SoftwareBackend::CreateTexture(unsigned int* id, int count)
+    {
+        RecordingBackend::CreateTexture(id, count);
+        for (int i = 0; i < count; i++)
+            m_Textures[id[i]] = SoftwareTexture();
+    }
+
+    void SoftwareBackend::DeleteTexture(unsigned int* id, int count)
+    {
+        //The binned triangles can still be sampling the texture
+        Flush();
+
+        RecordingBackend::DeleteTexture(id, count);
+        for (int i = 0; i < count; i++)
+        {
+            for (unsigned int slot = 0; slot < SoftwareDrawState::kMaxTextures; slot++)
+            {
+                if (m_TextureUnits[slot] == id[i])
+                    m_TextureUnits[slot] = 0;
+            }
+
+            m_Textures.erase(id[i]);
+        }
+    }
+
+    void SoftwareBackend::BindTextureUnit(unsigned int id, unsigned int slot)
+    {
+        RecordingBackend::BindTextureUnit(id, slot);
+        if (slot < SoftwareDrawState::kMaxTextures)
+            m_TextureUnits[slot] = id;
+    }
+
+    void SoftwareBackend::SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels)
+    {
+        RecordingBackend::SetTextureStorage(id, width, height, internalFormat, levels);
+
+        //The binned triangles sample the textures when they're rasterized, so they're drawn before a texture changes
+        Flush();
+
+        SoftwareTexture* texture = GetTexture(id);
+        if (texture != nullptr)
+            texture->SetStorage(width, height, 1);
+    }
+
+    void SoftwareBackend::SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter)
+    {
+        RecordingBackend::SetTextureFilter(id, minFilter, magFilter);
+        Flush();
+
+        SoftwareTexture* texture = GetTexture(id);
+        if (texture != nullptr)
+        {
+            texture->minFilter = minFilter;
+            texture->magFilter = magFilter;
+        }
+    }
+
+    void SoftwareBackend::SetTextureData(unsigned int id, const ImageData& imageData)
+    {
+        RecordingBackend::SetTextureData(id, imageData);
+        Flush();
+
+        SoftwareTexture* texture = GetTexture(id);
+        if (texture == nullptr)
+            return;
+
+        if (texture->width != imageData.width || texture->height != imageData.height || texture->layers != 1)
+            texture->SetStorage(imageData.width, imageData.height, 1);
+
+        //RGB images are expanded to RGBA with an opaque alpha
+        unsigned int bytesPerPixel = imageData.format.layout == PixelLayout::RGB ? 3 : 4;
+        size_t numberOfTexels = (size_t)imageData.width * imageData.height;
+        if (imageData.data.size() < numberOfTexels * bytesPerPixel)
+            return;
+
+        const unsigned char* data = imageData.data.data();
+        for (size_t i = 0; i < numberOfTexels; i++, data += bytesPerPixel)
+        {
+            uint32_t alpha = bytesPerPixel == 4 ? data[3] : 255;
+            texture->texels[i] = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | (alpha << 24);
+        }
+    }
+
+    void SoftwareBackend::SetTextureWrap(unsigned int id, Wrap wrap)
+    {
+        RecordingBackend::SetTextureWrap(id, wrap);
+        Flush();
+
+        SoftwareTexture* texture = GetTexture(id);
+        if (texture != nullptr)
+            texture->wrap = wrap;
+    }
+
+    void SoftwareBackend::CreateTextureArray(unsigned int* id, int count)
+    {
+        RecordingBackend::CreateTextureArray(id, count);
+        for (int i = 0; i < count; i++)
+            m_Textures[id[i]] = SoftwareTexture();
+    }
+
+    void SoftwareBackend::SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat)
+    {
+        RecordingBackend::SetTextureArrayStorage(id, width, height, layers, internalFormat);
+        Flush();
+
+        SoftwareTexture* texture = GetTexture(id);
+        if (texture != nullptr)
+            texture->SetStorage(width, height, layers);
+    }
+
+    void SoftwareBackend::CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y)
+    {
+        RecordingBackend::CopyTextureToTextureArray(sourceId, sourceX, sourceY, width, height, arrayId, layer, x, y);
+        Flush();
+
+        SoftwareTexture* source = GetTexture(sourceId);
+        SoftwareTexture* destination = GetTexture(arrayId);
+        if (source == nullptr || destination == nullptr || layer >= destination->layers)
+            return;
+
+        if (sourceX + width > source->width || sourceY + height > source->height || x + width > destination->width || y + height > destination->height)
+            return;
+
+        for (unsigned int row = 0; row < height; row++)
+        {
+            const uint32_t* from = &source->texels[(size_t)(sourceY + row) * source->width + sourceX];
+            uint32_t* to = &destination->texels[((size_t)layer * destination->height + y + row) * destination->width + x];
+            memcpy(to, from, width * sizeof(uint32_t));
+        }
+    }
+
+    void SoftwareBackend::CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers)
+    {
+        RecordingBackend::CopyTextureArray(sourceId, destinationId, width, height, layers);
+        Flush();
+
+        SoftwareTexture* source = GetTexture(sourceId);
+        SoftwareTexture* destination = GetTexture(destinationId);
+        if (source == nullptr || destination == nullptr)
+            return;
+
+        if (width > source->width || height > source->height || layers > source->layers || width > destination->width || height > destination->height || layers > destination->layers)
+            return;
+
+        for (unsigned int layer = 0; layer < layers; layer++)
+        {
+            for (unsigned int row = 0; row < height; row++)
+            {
+                const uint32_t* from = &source->texels[((size_t)layer * source->height + row) * source->width];
+                uint32_t* to = &destination->texels[((size_t)layer * destination->height + row) * destination->width];
+                memcpy(to, from, width * sizeof(uint32_t));
+            }
+        }
+    }
+
+    void SoftwareBackend::CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId)
+    {
+        RecordingBackend::CopyTextureArrayToTexture(arrayId, layer, width, height, textureId);
+        Flush();
+
+        SoftwareTexture* source = GetTexture(arrayId);
+        SoftwareTexture* destination = GetTexture(textureId);
+        if (source == nullptr || destination == nullptr || layer >= source->layers)
+            return;
+
+        if (width > source->width || height > source->height || width > destination->width || height > destination->height)
+            return;
+
+        for (unsigned int row = 0; row < height; row++)
+        {
+            const uint32_t* from = &source->texels[((size_t)layer * source->height + row) * source->width];
+            uint32_t* to = &destination->texels[(size_t)row * destination->width];
+            memcpy(to, from, width * sizeof(uint32_t));
+        }
+    }
+
+    void SoftwareBackend::CopyFrameBufferContents(unsigned int frameBuffer, PixelFormat format, unsigned int width, unsigned int height, unsigned char* buffer)
+    {
+        //The base class records the call and clears the buffer
+        RecordingBackend::CopyFrameBufferContents(frameBuffer, format, width, height, buffer);
+        m_Rasterizer.ReadPixels(format, width, height, buffer);
+    }
+
+    void SoftwareBackend::BindBuffer(BufferType bufferType, unsigned int id)
+    {
+        RecordingBackend::BindBuffer(bufferType, id);
+
+        //The index buffer binding is part of the vertex array's state
+        if (bufferType == BufferType::Index)
+            m_VertexArrays[m_BoundVertexArray].indexBuffer = id;
+    }
+
+    void SoftwareBackend::CreateVertexArray(unsigned int* id, int count)
+    {
+        RecordingBackend::CreateVertexArray(id, count);
+        for (int i = 0; i < count; i++)
+            m_VertexArrays[id[i]] = SoftwareVertexArray();
+    }
+
+    void SoftwareBackend::DeleteVertexArray(unsigned int* id, int count)
+    {
+        RecordingBackend::DeleteVertexArray(id, count);
+        for (int i = 0; i < count; i++)
+        {
+            if (id[i] == 0)
+                continue;
+
+            if (m_BoundVertexArray == id[i])
+                m_BoundVertexArray = 0;
+
+            m_VertexArrays.erase(id[i]);
+        }
+    }
+
+    void SoftwareBackend::BindVertexArray(unsigned int id)
+    {
+        RecordingBackend::BindVertexArray(id);
+        m_BoundVertexArray = m_VertexArrays.find(id) != m_VertexArrays.end() ? id : 0;
+    }
+
+    void SoftwareBackend::EnableVertexAttributeArray(unsigned int vertexBuffer)
+    {
+        RecordingBackend::EnableVertexAttributeArray(vertexBuffer);
+        if (vertexBuffer < kMaxAttributes)
+            m_VertexArrays[m_BoundVertexArray].attributes[vertexBuffer].enabled = true;
+    }
+
+    void SoftwareBackend::SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset)
+    {
+        RecordingBackend::SetVertexAttributePointer(vertexBuffer, element, stride, offset);
+        if (vertexBuffer >= kMaxAttributes)
+            return;
+
+        //The attribute reads from the buffer bound when the pointer is set, same as OpenGL
+        VertexAttribute& attribute = m_VertexArrays[m_BoundVertexArray].attributes[vertexBuffer];
+        attribute.buffer = m_BoundBuffers[static_cast<int>(BufferType::Vertex)];
+        attribute.components = GetComponentCount(element.type);
+        attribute.isInteger = IsIntegerType(element.type);
+        attribute.stride = stride > 0 ? stride : (int)(attribute.components * sizeof(float));
+        attribute.offset = (unsigned int)reinterpret_cast<uintptr_t>(offset);
+    }
+
+    void SoftwareBackend::SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor)
+    {
+        RecordingBackend::SetVertexAttributeDivisor(vertexBuffer, divisor);
+        if (vertexBuffer < kMaxAttributes)
+            m_VertexArrays[m_BoundVertexArray].attributes[vertexBuffer].divisor = divisor;
+    }
+
+    void SoftwareBackend::LinkShaderProgram(unsigned int program)
+    {
+        RecordingBackend::LinkShaderProgram(program);
+
+        std::string vertexSource;
+        bool hasGeometryShader = false;
+        for (unsigned int shader : m_Programs[program].shaders)
+        {
+            auto iterator = m_Shaders.find(shader);
+            if (iterator == m_Shaders.end())
+                continue;
+
+            if (iterator->second.type == ShaderType::Geometry)
+                hasGeometryShader = true;
+            else if (iterator->second.type == ShaderType::Vertex)
+                vertexSource = iterator->second.source;
+        }
+
+        //Each of the framework's vertex shaders has an attribute none of the others have
+        SoftwareProgram softwareProgram;
+        if (hasGeometryShader == false)
+        {
+            if (vertexSource.find("a_AxisX") != std::string::npos)
+                softwareProgram.kind = ProgramKind::SpriteInstance;
+            else if (vertexSource.find("a_TextureUV") != std::string::npos)
+                softwareProgram.kind = ProgramKind::Sprite;
+            else if (vertexSource.find("a_Radius") != std::string::npos)
+                softwareProgram.kind = ProgramKind::Circle;
+            else if (vertexSource.find("a_Start") != std::string::npos)
+                softwareProgram.kind = ProgramKind::LineInstance;
+            else if (vertexSource.find("a_Position") != std::string::npos)
+                softwareProgram.kind = vertexSource.find("u_ViewProjection") != std::string::npos ? ProgramKind::Point : ProgramKind::LineQuad;
+        }
+
+        softwareProgram.viewProjectionLocation = GetUniformLocation(program, "u_ViewProjection");
+        softwareProgram.viewportLocation = GetUniformLocation(program, "u_Viewport");
+        softwareProgram.texturesLocation = GetUniformLocation(program, "u_Textures");
+        softwareProgram.textureArraysLocation = GetUniformLocation(program, "u_TextureArrays");
+        m_SoftwarePrograms[program] = softwareProgram;
+    }
+
+    void SoftwareBackend::DeleteShaderProgram(unsigned int program)
+    {
+        RecordingBackend::DeleteShaderProgram(program);
+        m_SoftwarePrograms.erase(program);
+    }
+
+    void SoftwareBackend::SetUniformIntArray(int location, int* values, unsigned int count)
+    {
+        RecordingBackend::SetUniformIntArray(location, values, count);
+
+        auto iterator = m_SoftwarePrograms.find(m_BoundProgram);
+        if (iterator == m_SoftwarePrograms.end() || location < 0)
+            return;
+
+        //Texture indices 0-23 are the u_Textures samplers and 24-31 the u_TextureArrays samplers
+        SoftwareProgram& program = iterator->second;
+        unsigned int first = SoftwareDrawState::kMaxTextures;
+        if (location == program.texturesLocation)
+            first = 0;
+        else if (location == program.textureArraysLocation)
+            first = 24;
+
+        for (unsigned int i = 0; i < count && first + i < SoftwareDrawState::kMaxTextures; i++)
+            program.samplers[first + i] = (unsigned int)values[i];
+    }
+
+    void SoftwareBackend::SetUniformFloat2(int location, float value1, float value2)
+    {
+        RecordingBackend::SetUniformFloat2(location, value1, value2);
+
+        auto iterator = m_SoftwarePrograms.find(m_BoundProgram);
+        if (iterator != m_SoftwarePrograms.end() && location >= 0 && location == iterator->second.viewportLocation)
+        {
+            iterator->second.viewport[0] = value1;
+            iterator->second.viewport[1] = value2;
+        }
+    }
+
+    void SoftwareBackend::SetUniformMatrix(int location, const Matrix& value)
+    {
+        RecordingBackend::SetUniformMatrix(location, value);
+
+        auto iterator = m_SoftwarePrograms.find(m_BoundProgram);
+        if (iterator != m_SoftwarePrograms.end() && location >= 0 && location == iterator->second.viewProjectionLocation)
+            memcpy(iterator->second.viewProjection, value.m, sizeof(iterator->second.viewProjection));
+    }
+
+    void SoftwareBackend::Flush()
+    {
+        m_Rasterizer.Flush();
+    }
+
+    SoftwareRasterizer& SoftwareBackend::GetRasterizer()
+    {
+        return m_Rasterizer;
+    }
+
+    unsigned long long SoftwareBackend::GetSkippedDrawCalls() const
+    {
+        return m_SkippedDrawCalls;
+    }
+
+    SoftwareBackend::SoftwareProgram* SoftwareBackend::BeginDraw(RenderMode aRenderMode, unsigned int aBaseInstance)
+    {
+        auto program = m_SoftwarePrograms.find(m_BoundProgram);
+        bool isModeSupported = aRenderMode == RenderMode::Triangles || aRenderMode == RenderMode::TriangleStrip || aRenderMode == RenderMode::TriangleFan || aRenderMode == RenderMode::Points;
+        if (program == m_SoftwarePrograms.end() || program->second.kind == ProgramKind::Unsupported || isModeSupported == false)
+        {
+            m_SkippedDrawCalls++;
+            return nullptr;
+        }
+
+        //Look up the attributes' buffers once instead of once per vertex
+        const SoftwareVertexArray& vertexArray = m_VertexArrays[m_BoundVertexArray];
+        for (unsigned int i = 0; i < kMaxAttributes; i++)
+        {
+            m_AttributeSources[i].attribute = nullptr;
+            m_AttributeSources[i].data = nullptr;
+            m_AttributeSources[i].size = 0;
+
+            const VertexAttribute& attribute = vertexArray.attributes[i];
+            auto buffer = m_Buffers.find(attribute.buffer);
+            if (attribute.enabled && buffer != m_Buffers.end())
+            {
+                m_AttributeSources[i].attribute = &attribute;
+                m_AttributeSources[i].data = buffer->second.data.data();
+                m_AttributeSources[i].size = buffer->second.data.size();
+            }
+        }
+        m_BaseInstance = aBaseInstance;
+
+        SoftwareDrawState state;
+        switch (program->second.kind)
+        {
+        case ProgramKind::Sprite:
+        case ProgramKind::SpriteInstance:
+            state.shading = SoftwareShading::Texture;
+            break;
+        case ProgramKind::Circle:
+            state.shading = SoftwareShading::Circle;
+            break;
+        default:
+            state.shading = SoftwareShading::Color;
+            break;
+        }
+
+        state.blending = m_IsBlendingEnabled;
+        state.source = m_BlendingSource;
+        state.destination = m_BlendingDestination;
+
+        //The viewport clipped by the scissor rect and the frame buffer
+        state.clip[0] = m_Viewport[0] > 0 ? m_Viewport[0] : 0;
+        state.clip[1] = m_Viewport[1] > 0 ? m_Viewport[1] : 0;
+        state.clip[2] = m_Viewport[0] + m_Viewport[2] < (int)m_Rasterizer.GetWidth() ? m_Viewport[0] + m_Viewport[2] : (int)m_Rasterizer.GetWidth();
+        state.clip[3] = m_Viewport[1] + m_Viewport[3] < (int)m_Rasterizer.GetHeight() ? m_Viewport[1] + m_Viewport[3] : (int)m_Rasterizer.GetHeight();
+        if (m_IsScissorEnabled)
+        {
+            state.clip[0] = state.clip[0] > m_ScissorRect[0] ? state.clip[0] : m_ScissorRect[0];
+            state.clip[1] = state.clip[1] > m_ScissorRect[1] ? state.clip[1] : m_ScissorRect[1];
+            state.clip[2] = state.clip[2] < m_ScissorRect[0] + m_ScissorRect[2] ? state.clip[2] : m_ScissorRect[0] + m_ScissorRect[2];
+            state.clip[3] = state.clip[3] < m_ScissorRect[1] + m_ScissorRect[3] ? state.clip[3] : m_ScissorRect[1] + m_ScissorRect[3];
+        }
+
+        for (unsigned int i = 0; i < SoftwareDrawState::kMaxTextures; i++)
+        {
+            unsigned int unit = program->second.samplers[i];
+            state.textures[i] = unit < SoftwareDrawState::kMaxTextures ? GetTexture(m_TextureUnits[unit]) : nullptr;
+        }
+
+        m_Rasterizer.SetDrawState(state);
+        return &program->second;
+    }
+
+    void SoftwareBackend::ShadeVertex(const SoftwareProgram& aProgram, unsigned int aVertex, unsigned int aInstance, ShadedVertex& aShaded) const
+    {
+        float a0[4], a1[4], a2[4], a3[4], a4[4], a5[4], a6[4];
+        SoftwareVertex& vertex = aShaded.vertex;
+        float* flat = aShaded.flat;
+
+        vertex.uv[0] = vertex.uv[1] = 0.0f;
+
+        switch (aProgram.kind)
+        {
+        case ProgramKind::Sprite:
+        {
+            //SpriteRenderer.glsl
+            FetchAttribute(0, aVertex, aInstance, a0);
+            FetchAttribute(1, aVertex, aInstance, a1);
+            FetchAttribute(2, aVertex, aInstance, a2);
+            FetchAttribute(3, aVertex, aInstance, a3);
+            FetchAttribute(4, aVertex, aInstance, a4);
+            FetchAttribute(5, aVertex, aInstance, a5);
+            FetchAttribute(6, aVertex, aInstance, a6);
+
+            Transform(aProgram.viewProjection, a0[0], a0[1], aShaded.position);
+            memcpy(vertex.color, a2, sizeof(vertex.color));
+            vertex.uv[0] = a1[0];
+            vertex.uv[1] = a1[1];
+            flat[0] = a3[0];
+            flat[1] = a4[0];
+            flat[2] = a5[0];
+            flat[3] = a6[0];
+            break;
+        }
+
+        case ProgramKind::SpriteInstance:
+        {
+            //SpriteInstanceRenderer.glsl, the quad's uvs and its four per quad values come from the instance
+            float corner[4], origin[4], axisX[4], axisY[4];
+            FetchAttribute(0, aVertex, aInstance, corner);
+            FetchAttribute(1, aVertex, aInstance, origin);
+            FetchAttribute(2, aVertex, aInstance, axisX);
+            FetchAttribute(3, aVertex, aInstance, axisY);
+            FetchAttribute(4, aVertex, aInstance, a0);
+            FetchAttribute(5, aVertex, aInstance, a1);
+            FetchAttribute(6, aVertex, aInstance, a2);
+            FetchAttribute(7, aVertex, aInstance, a3);
+            FetchAttribute(8, aVertex, aInstance, a4);
+            FetchAttribute(9, aVertex, aInstance, a5);
+            FetchAttribute(10, aVertex, aInstance, a6);
+
+            float x = origin[0] + axisX[0] * corner[0] + axisY[0] * corner[1];
+            float y = origin[1] + axisX[1] * corner[0] + axisY[1] * corner[1];
+            Transform(aProgram.viewProjection, x, y, aShaded.position);
+            memcpy(vertex.color, a2, sizeof(vertex.color));
+            vertex.uv[0] = a0[0] + corner[0] * a1[0];
+            vertex.uv[1] = a0[1] + corner[1] * a1[1];
+            flat[0] = a3[0];
+            flat[1] = a4[0];
+            flat[2] = a5[0];
+            flat[3] = a6[0];
+            break;
+        }
+
+        case ProgramKind::Circle:
+        {
+            //CircleRenderer.glsl, the fragments compare their window position with the circle's position
+            FetchAttribute(0, aVertex, aInstance, a0);
+            FetchAttribute(1, aVertex, aInstance, a1);
+            FetchAttribute(2, aVertex, aInstance, a2);
+            FetchAttribute(3, aVertex, aInstance, a3);
+            FetchAttribute(4, aVertex, aInstance, a4);
+            FetchAttribute(5, aVertex, aInstance, a5);
+
+            float size = a2[0] + a3[0];
+            Transform(aProgram.viewProjection, a1[0] + a0[0] * size, a1[1] + a0[1] * size, aShaded.position);
+            memcpy(vertex.color, a4, sizeof(vertex.color));
+            flat[0] = a1[0];
+            flat[1] = a1[1];
+            flat[2] = a2[0];
+            flat[3] = a3[0];
+            memcpy(&flat[4], a4, 4 * sizeof(float));
+            memcpy(&flat[8], a5, 4 * sizeof(float));
+            break;
+        }
+
+        case ProgramKind::LineInstance:
+        {
+            //LineInstanceRenderer.glsl, builds the mitered corner of the segment's quad in screen space
+            float corner[4];
+            FetchAttribute(0, aVertex, aInstance, corner);
+            FetchAttribute(1, aVertex, aInstance, a0);
+            FetchAttribute(2, aVertex, aInstance, a1);
+            FetchAttribute(3, aVertex, aInstance, a2);
+            FetchAttribute(4, aVertex, aInstance, a3);
+            FetchAttribute(5, aVertex, aInstance, a4);
+            FetchAttribute(6, aVertex, aInstance, a5);
+            memcpy(vertex.color, a4, sizeof(vertex.color));
+
+            const float* viewport = aProgram.viewport;
+            float p[4][2];
+            const float* points[4] = { a0, a1, a2, a3 };
+            for (int i = 0; i < 4; i++)
+            {
+                float position[4];
+                Transform(aProgram.viewProjection, points[i][0], points[i][1], position);
+                p[i][0] = position[0] / position[3] * viewport[0];
+                p[i][1] = position[1] / position[3] * viewport[1];
+            }
+
+            //Culled segments put every corner on the same point outside of the clip volume
+            float areaX = viewport[0] * 1.2f;
+            float areaY = viewport[1] * 1.2f;
+            if (fabsf(p[1][0]) > areaX || fabsf(p[1][1]) > areaY || fabsf(p[2][0]) > areaX || fabsf(p[2][1]) > areaY)
+            {
+                SetPosition(aShaded.position, 2.0f, 2.0f, 2.0f, 1.0f);
+                break;
+            }
+
+            float v[3][2];
+            float n[3][2];
+            for (int i = 0; i < 3; i++)
+            {
+                Normalize(p[i + 1][0] - p[i][0], p[i + 1][1] - p[i][1], v[i]);
+                n[i][0] = -v[i][1];
+                n[i][1] = v[i][0];
+            }
+
+            bool isStart = corner[0] < 0.5f;
+            const float* point = isStart ? p[1] : p[2];
+            float miter[2];
+            if (isStart)
+                Normalize(n[0][0] + n[1][0], n[0][1] + n[1][1], miter);
+            else
+                Normalize(n[1][0] + n[2][0], n[1][1] + n[2][1], miter);
+
+            float miterLength = a5[0] / (miter[0] * n[1][0] + miter[1] * n[1][1]);
+            SetPosition(aShaded.position, (point[0] + corner[1] * miterLength * miter[0]) / viewport[0], (point[1] + corner[1] * miterLength * miter[1]) / viewport[1], 0.0f, 1.0f);
+            break;
+        }
+
+        case ProgramKind::LineQuad:
+        {
+            //LineQuadRenderer.glsl, the positions are already in normalized device coordinates
+            FetchAttribute(0, aVertex, aInstance, a0);
+            FetchAttribute(1, aVertex, aInstance, a1);
+            SetPosition(aShaded.position, a0[0], a0[1], 0.0f, 1.0f);
+            memcpy(vertex.color, a1, sizeof(vertex.color));
+            break;
+        }
+
+        case ProgramKind::Point:
+        default:
+        {
+            //PointRenderer.glsl
+            FetchAttribute(0, aVertex, aInstance, a0);
+            FetchAttribute(1, aVertex, aInstance, a1);
+            Transform(aProgram.viewProjection, a0[0], a0[1], aShaded.position);
+            memcpy(vertex.color, a1, sizeof(vertex.color));
+            break;
+        }
+        }
+    }
+
+    void SoftwareBackend::FetchAttribute(unsigned int aLocation, unsigned int aVertex, unsigned int aInstance, float* aValue) const
+    {
+        aValue[0] = aValue[1] = aValue[2] = 0.0f;
+        aValue[3] = 1.0f;
+
+        const AttributeSource& source = m_AttributeSources[aLocation];
+        if (source.attribute == nullptr)
+            return;
+
+        //Instanced attributes advance once every divisor instances, starting at the base instance
+        const VertexAttribute& attribute = *source.attribute;
+        size_t index = attribute.divisor == 0 ? aVertex : m_BaseInstance + aInstance / attribute.divisor;
+        size_t offset = attribute.offset + index * attribute.stride;
+        if (offset + attribute.components * sizeof(float) > source.size)
+            return;
+
+        const unsigned char* data = source.data + offset;
+        for (unsigned int i = 0; i < attribute.components; i++)
+        {
+            if (attribute.isInteger)
+            {
+                int value;
+                memcpy(&value, data + i * sizeof(int), sizeof(int));
+                aValue[i] = (float)value;
+            }
+            else
+            {
+                memcpy(&aValue[i], data + i * sizeof(float), sizeof(float));
+            }
+        }
+    }
+
+    void SoftwareBackend::AddPrimitives(RenderMode aRenderMode, const std::vector<ShadedVertex>& aVertices)
+    {
+        size_t count = aVertices.size();
+
+        switch (aRenderMode)
+        {
+        case RenderMode::Triangles:
+            for (size_t i = 2; i < count; i += 3)
+                AddTriangle(aVertices[i - 2], aVertices[i - 1], aVertices[i], aVertices[i]);
+            break;
+
+        case RenderMode::TriangleStrip:
+            for (size_t i = 2; i < count; i++)
+                AddTriangle(aVertices[i - 2], aVertices[i - 1], aVertices[i], aVertices[i]);
+            break;
+
+        case RenderMode::TriangleFan:
+            for (size_t i = 2; i < count; i++)
+                AddTriangle(aVertices[0], aVertices[i - 1], aVertices[i], aVertices[i]);
+            break;
+
+        case RenderMode::Points:
+            for (size_t i = 0; i < count; i++)
+            {
+                //A 1 pixel point is a 1 by 1 square around its window position
+                const ShadedVertex& point = aVertices[i];
+                const float* position = point.position;
+                if (!(position[3] > 0.0f) || fabsf(position[2]) > position[3])
+                    continue;
+
+                ShadedVertex corners[4];
+                float width = (float)m_Viewport[2] / position[3];
+                float height = (float)m_Viewport[3] / position[3];
+                for (int c = 0; c < 4; c++)
+                {
+                    corners[c] = point;
+                    corners[c].position[0] += ((c & 1) ? 1.0f : -1.0f) / width;
+                    corners[c].position[1] += ((c & 2) ? 1.0f : -1.0f) / height;
+                }
+
+                AddTriangle(corners[0], corners[1], corners[2], point);
+                AddTriangle(corners[2], corners[1], corners[3], point);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void SoftwareBackend::AddTriangle(const ShadedVertex& a, const ShadedVertex& b, const ShadedVertex& c, const ShadedVertex& aProvoking)
+    {
+        //There's no clipping, triangles crossing the near or far plane (or behind the camera) are dropped. The 2D
+        //cameras never make one, apart from the culled line segments which are dropped on purpose
+        const ShadedVertex* vertices[3] = { &a, &b, &c };
+        SoftwareTriangle triangle;
+        for (int i = 0; i < 3; i++)
+        {
+            const float* position = vertices[i]->position;
+            if (!(position[3] > 0.0f) || fabsf(position[2]) > position[3])
+                return;
+
+            //Normalized device coordinates to window coordinates
+            triangle.vertices[i] = vertices[i]->vertex;
+            triangle.vertices[i].x = (float)m_Viewport[0] + (position[0] / position[3] + 1.0f) * 0.5f * (float)m_Viewport[2];
+            triangle.vertices[i].y = (float)m_Viewport[1] + (position[1] / position[3] + 1.0f) * 0.5f * (float)m_Viewport[3];
+        }
+
+        //The values that are the same for the whole primitive come from its last vertex, same as OpenGL's flat outputs
+        memcpy(triangle.flat, aProvoking.flat, sizeof(triangle.flat));
+        triangle.state = 0;
+        m_Rasterizer.AddTriangle(triangle);
+    }
+
+    SoftwareTexture* SoftwareBackend::GetTexture(unsigned int aId)
+    {
+        auto iterator = m_Textures.find(aId);
+        return iterator != m_Textures.end() ? &iterator->second : nullptr;
+    }
+}
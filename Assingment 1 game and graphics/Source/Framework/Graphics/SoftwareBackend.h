@@ -0,0 +1,177 @@
+#pragma once
+
+#include "RecordingBackend.h"
+#include "SoftwareRasterizer.h"
+
+
+namespace GameDev2D
+{
+    //Draws the frames on the CPU with a SoftwareRasterizer, every call is also recorded the same way RecordingBackend
+    //records it. The shaders aren't compiled, the programs are matched to C++ versions of the framework's shaders
+    //by their vertex attributes when they're linked. Programs with a geometry shader (the geometry shader line
+    //expansion) can't be run and their draw calls are skipped. Only the default frame buffer is drawn to, the
+    //frame is read back with CopyFrameBufferContents(). It's meant for testing and headless runs, a busy frame takes
+    //hundreds of milliseconds on one thread, RasterBenchmark reports the setup and rasterization time separately
+    class SoftwareBackend : public RecordingBackend
+    {
+    public:
+        //0 threads uses one thread per hardware thread
+        SoftwareBackend(unsigned int width, unsigned int height, unsigned int numberOfThreads = 0);
+
+        void NewFrame() override;
+
+        void Clear() override;
+        void SetClearColor(const Color& clearColor) override;
+        void SetViewport(int x, int y, int width, int height) override;
+
+        void SetBlendingEnabled(bool enabled) override;
+        void SetBlendingFunction(BlendingFactor source, BlendingFactor destination) override;
+        void SetScissorEnabled(bool enabled) override;
+        void SetScissorRect(int x, int y, int width, int height) override;
+
+        void DrawElements(RenderMode renderMode, unsigned int indexCount, unsigned int baseVertex) override;
+        void DrawArraysInstanced(RenderMode renderMode, unsigned int firstVertex, unsigned int vertexCount, unsigned int instanceCount, unsigned int baseInstance) override;
+
+        void CreateTexture(unsigned int* id, int count) override;
+        void DeleteTexture(unsigned int* id, int count) override;
+        void BindTextureUnit(unsigned int id, unsigned int slot) override;
+        void SetTextureStorage(unsigned int id, unsigned int width, unsigned int height, PixelFormat internalFormat, unsigned int levels) override;
+        void SetTextureFilter(unsigned int id, TextureMinFilter minFilter, TextureMagFilter magFilter) override;
+        void SetTextureData(unsigned int id, const ImageData& imageData) override;
+        void SetTextureWrap(unsigned int id, Wrap wrap) override;
+
+        void CreateTextureArray(unsigned int* id, int count) override;
+        void SetTextureArrayStorage(unsigned int id, unsigned int width, unsigned int height, unsigned int layers, PixelFormat internalFormat) override;
+        void CopyTextureToTextureArray(unsigned int sourceId, unsigned int sourceX, unsigned int sourceY, unsigned int width, unsigned int height, unsigned int arrayId, unsigned int layer, unsigned int x, unsigned int y) override;
+        void CopyTextureArray(unsigned int sourceId, unsigned int destinationId, unsigned int width, unsigned int height, unsigned int layers) override;
+        void CopyTextureArrayToTexture(unsigned int arrayId, unsigned int layer, unsigned int width, unsigned int height, unsigned int textureId) override;
+
+        void CopyFrameBufferContents(unsigned int frameBuffer, PixelFormat format, unsigned int width, unsigned int height, unsigned char* buffer) override;
+
+        void BindBuffer(BufferType bufferType, unsigned int id) override;
+
+        void CreateVertexArray(unsigned int* id, int count) override;
+        void DeleteVertexArray(unsigned int* id, int count) override;
+        void BindVertexArray(unsigned int id) override;
+
+        void EnableVertexAttributeArray(unsigned int vertexBuffer) override;
+        void SetVertexAttributePointer(unsigned int vertexBuffer, const BufferElement& element, int stride, const void* offset) override;
+        void SetVertexAttributeDivisor(unsigned int vertexBuffer, unsigned int divisor) override;
+
+        void LinkShaderProgram(unsigned int program) override;
+        void DeleteShaderProgram(unsigned int program) override;
+
+        void SetUniformIntArray(int location, int* values, unsigned int count) override;
+        void SetUniformFloat2(int location, float value1, float value2) override;
+        void SetUniformMatrix(int location, const Matrix& value) override;
+
+        //Rasterizes the triangles drawn so far, the draw calls only bin their triangles
+        void Flush();
+
+        SoftwareRasterizer& GetRasterizer();
+
+        //Returns the number of draw calls that weren't drawn because their program or render mode isn't supported
+        unsigned long long GetSkippedDrawCalls() const;
+
+    private:
+        //The framework shader a program runs, found from the vertex shader's attributes
+        enum class ProgramKind
+        {
+            Unsupported = 0,
+            Sprite,
+            SpriteInstance,
+            Circle,
+            LineInstance,
+            LineQuad,
+            Point
+        };
+
+        struct SoftwareProgram
+        {
+            SoftwareProgram();
+
+            ProgramKind kind;
+            int viewProjectionLocation;
+            int viewportLocation;
+            int texturesLocation;
+            int textureArraysLocation;
+            float viewProjection[16];
+            float viewport[2];
+
+            //The texture unit each texture index samples, set through the sampler uniforms
+            unsigned int samplers[SoftwareDrawState::kMaxTextures];
+        };
+
+        static const unsigned int kMaxAttributes = 16;
+
+        struct VertexAttribute
+        {
+            bool enabled;
+            unsigned int buffer;
+            unsigned int components;
+            bool isInteger;
+            int stride;
+            unsigned int offset;
+            unsigned int divisor;
+        };
+
+        //An enabled attribute and its buffer's data, looked up once per draw call
+        struct AttributeSource
+        {
+            const VertexAttribute* attribute;
+            const unsigned char* data;
+            size_t size;
+        };
+
+        struct SoftwareVertexArray
+        {
+            SoftwareVertexArray();
+
+            VertexAttribute attributes[kMaxAttributes];
+            unsigned int indexBuffer;
+        };
+
+        //A vertex after the vertex shader, before the perspective divide
+        struct ShadedVertex
+        {
+            float position[4];
+            SoftwareVertex vertex;
+            float flat[SoftwareTriangle::kMaxFlat];
+        };
+
+        //Returns the current program if it can be drawn with the render mode, otherwise counts a skipped draw call.
+        //Sets the rasterizer's draw state and looks up the bound vertex array's attributes
+        SoftwareProgram* BeginDraw(RenderMode renderMode, unsigned int baseInstance);
+
+        //Runs the program's vertex shader for one vertex
+        void ShadeVertex(const SoftwareProgram& program, unsigned int vertex, unsigned int instance, ShadedVertex& shaded) const;
+
+        //Reads an attribute of the bound vertex array, missing components are filled in with 0, 0, 0, 1
+        void FetchAttribute(unsigned int location, unsigned int vertex, unsigned int instance, float* value) const;
+
+        //Assembles the shaded vertices into triangles and adds them to the rasterizer
+        void AddPrimitives(RenderMode renderMode, const std::vector<ShadedVertex>& vertices);
+        void AddTriangle(const ShadedVertex& a, const ShadedVertex& b, const ShadedVertex& c, const ShadedVertex& provoking);
+
+        SoftwareTexture* GetTexture(unsigned int id);
+
+        //Member variables
+        SoftwareRasterizer m_Rasterizer;
+        std::unordered_map<unsigned int, SoftwareTexture> m_Textures;
+        std::unordered_map<unsigned int, SoftwareProgram> m_SoftwarePrograms;
+        std::unordered_map<unsigned int, SoftwareVertexArray> m_VertexArrays;
+        std::vector<ShadedVertex> m_ShadedVertices;
+        AttributeSource m_AttributeSources[kMaxAttributes];
+        unsigned int m_BaseInstance;
+        unsigned int m_TextureUnits[SoftwareDrawState::kMaxTextures];
+        unsigned int m_BoundVertexArray;
+        Color m_ClearColor;
+        int m_Viewport[4];
+        int m_ScissorRect[4];
+        bool m_IsScissorEnabled;
+        bool m_IsBlendingEnabled;
+        BlendingFactor m_BlendingSource;
+        BlendingFactor m_BlendingDestination;
+        unsigned long long m_SkippedDrawCalls;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,666 @@
+#include "SoftwareRasterizer.h"
+#include <math.h>
+#include <string.h>
+
+//The per pixel color math works on all four channels at once where SSE2 is always there (x64, and x86 built with
+//SSE2), each channel goes through the same operations in the same order as the scalar code so the frames match
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RASTERIZER_SSE2 1
+#include <emmintrin.h>
+#else
+#define SOFTWARE_RASTERIZER_SSE2 0
+#endif
+
+
+namespace GameDev2D
+{
+    namespace
+    {
+        inline float Clamp01(float value)
+        {
+            return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        }
+
+#if SOFTWARE_RASTERIZER_SSE2
+        inline __m128 Clamp01(__m128 value)
+        {
+            return _mm_max_ps(_mm_min_ps(value, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+        }
+
+        //The four channels of a pixel as 0 to 255 ints
+        inline __m128i UnpackBytes(uint32_t pixel)
+        {
+            __m128i zero = _mm_setzero_si128();
+            return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)pixel), zero), zero);
+        }
+#endif
+
+        inline uint32_t PackColor(const float* color)
+        {
+#if SOFTWARE_RASTERIZER_SSE2
+            __m128 scaled = _mm_add_ps(_mm_mul_ps(Clamp01(_mm_loadu_ps(color)), _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+            __m128i channels = _mm_cvttps_epi32(scaled);
+            channels = _mm_packs_epi32(channels, channels);
+            return (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(channels, channels));
+#else
+            uint32_t r = (uint32_t)(Clamp01(color[0]) * 255.0f + 0.5f);
+            uint32_t g = (uint32_t)(Clamp01(color[1]) * 255.0f + 0.5f);
+            uint32_t b = (uint32_t)(Clamp01(color[2]) * 255.0f + 0.5f);
+            uint32_t a = (uint32_t)(Clamp01(color[3]) * 255.0f + 0.5f);
+            return r | (g << 8) | (b << 16) | (a << 24);
+#endif
+        }
+
+        inline void UnpackColor(uint32_t pixel, float* color)
+        {
+            const float scale = 1.0f / 255.0f;
+#if SOFTWARE_RASTERIZER_SSE2
+            _mm_storeu_ps(color, _mm_mul_ps(_mm_cvtepi32_ps(UnpackBytes(pixel)), _mm_set1_ps(scale)));
+#else
+            color[0] = (float)(pixel & 0xff) * scale;
+            color[1] = (float)((pixel >> 8) & 0xff) * scale;
+            color[2] = (float)((pixel >> 16) & 0xff) * scale;
+            color[3] = (float)(pixel >> 24) * scale;
+#endif
+        }
+
+        //result = a * weightA + b * weightB + c * weightC, channel by channel
+        inline void InterpolateColor(const float* a, const float* b, const float* c, float weightA, float weightB, float weightC, float* result)
+        {
+#if SOFTWARE_RASTERIZER_SSE2
+            __m128 sum = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(weightA)), _mm_mul_ps(_mm_loadu_ps(b), _mm_set1_ps(weightB)));
+            _mm_storeu_ps(result, _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(c), _mm_set1_ps(weightC))));
+#else
+            for (int i = 0; i < 4; i++)
+                result[i] = a[i] * weightA + b[i] * weightB + c[i] * weightC;
+#endif
+        }
+
+        //color *= factor, channel by channel
+        inline void MultiplyColor(float* color, const float* factor)
+        {
+#if SOFTWARE_RASTERIZER_SSE2
+            _mm_storeu_ps(color, _mm_mul_ps(_mm_loadu_ps(color), _mm_loadu_ps(factor)));
+#else
+            for (int i = 0; i < 4; i++)
+                color[i] *= factor[i];
+#endif
+        }
+
+        //The source over the destination with the source's alpha, both already clamped to 0 to 1
+        inline void BlendAlpha(const float* source, const float* destination, float* result)
+        {
+#if SOFTWARE_RASTERIZER_SSE2
+            __m128 alpha = _mm_set1_ps(source[3]);
+            __m128 inverseAlpha = _mm_set1_ps(1.0f - source[3]);
+            _mm_storeu_ps(result, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(source), alpha), _mm_mul_ps(_mm_loadu_ps(destination), inverseAlpha)));
+#else
+            for (int i = 0; i < 4; i++)
+                result[i] = source[i] * source[3] + destination[i] * (1.0f - source[3]);
+#endif
+        }
+
+        //floorf() is a library call without SSE4.1, the sample coordinates are already limited to a range ints can hold
+        inline int FloorToInt(float value)
+        {
+            int result = (int)value;
+            return value < (float)result ? result - 1 : result;
+        }
+
+        //Returns the texel to use for index, -1 means the border color
+        inline int WrapTexel(int index, int size, WrapMode wrapMode)
+        {
+            switch (wrapMode)
+            {
+            case WrapMode::Repeat:
+                index %= size;
+                return index < 0 ? index + size : index;
+
+            case WrapMode::MirroredRepeat:
+            {
+                int period = size * 2;
+                index %= period;
+                if (index < 0)
+                    index += period;
+                return index < size ? index : period - 1 - index;
+            }
+
+            case WrapMode::ClampToBorder:
+                return index < 0 || index >= size ? -1 : index;
+
+            default:
+                return index < 0 ? 0 : (index >= size ? size - 1 : index);
+            }
+        }
+
+        //Same as GLSL's smoothstep(), a zero width edge is a step at edge0
+        inline float SmoothStep(float edge0, float edge1, float x)
+        {
+            if (edge1 <= edge0)
+                return x < edge0 ? 0.0f : 1.0f;
+
+            float t = Clamp01((x - edge0) / (edge1 - edge0));
+            return t * t * (3.0f - 2.0f * t);
+        }
+
+        void GetBlendingFactor(BlendingFactor factor, const float* source, const float* destination, float* result)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                switch (factor)
+                {
+                case BlendingFactor::Zero:                      result[i] = 0.0f; break;
+                case BlendingFactor::One:                       result[i] = 1.0f; break;
+                case BlendingFactor::SourceColor:               result[i] = source[i]; break;
+                case BlendingFactor::OneMinusSourceColor:       result[i] = 1.0f - source[i]; break;
+                case BlendingFactor::SourceAlpha:               result[i] = source[3]; break;
+                case BlendingFactor::OneMinusSourceAlpha:       result[i] = 1.0f - source[3]; break;
+                case BlendingFactor::DestinationAlpha:          result[i] = destination[3]; break;
+                case BlendingFactor::OneMinusDestinationAlpha:  result[i] = 1.0f - destination[3]; break;
+                case BlendingFactor::DestinationColor:          result[i] = destination[i]; break;
+                case BlendingFactor::OneMinusDestinationColor:  result[i] = 1.0f - destination[i]; break;
+                case BlendingFactor::SourceAlphaSaturate:       result[i] = i < 3 ? fminf(source[3], 1.0f - destination[3]) : 1.0f; break;
+                }
+            }
+        }
+
+        //The edge is a top or left edge of a counter clockwise triangle (y goes up), pixel centers exactly on those
+        //edges belong to the triangle so pixels on an edge shared by two triangles are only drawn once
+        inline bool IsTopLeft(const SoftwareVertex& a, const SoftwareVertex& b)
+        {
+            return (a.y == b.y && b.x < a.x) || b.y < a.y;
+        }
+
+        inline bool IsInside(float weight, bool isTopLeft)
+        {
+            return weight > 0.0f || (weight == 0.0f && isTopLeft);
+        }
+    }
+
+    SoftwareTexture::SoftwareTexture() :
+        width(0),
+        height(0),
+        layers(0),
+        minFilter(TextureMinFilter::Linear),
+        magFilter(TextureMagFilter::Linear),
+        wrap()
+    {
+    }
+
+    void SoftwareTexture::SetStorage(unsigned int aWidth, unsigned int aHeight, unsigned int aLayers)
+    {
+        width = aWidth;
+        height = aHeight;
+        layers = aLayers;
+        texels.assign((size_t)width * height * layers, 0);
+    }
+
+    void SoftwareTexture::Sample(float u, float v, unsigned int layer, float footprint, float* color) const
+    {
+        //OpenGL samples a texture without storage as opaque black
+        if (texels.empty())
+        {
+            color[0] = color[1] = color[2] = 0.0f;
+            color[3] = 1.0f;
+            return;
+        }
+
+        float x = u * (float)width;
+        float y = v * (float)height;
+        if (!(fabsf(x) < 1.0e6f && fabsf(y) < 1.0e6f))
+        {
+            x = 0.0f;
+            y = 0.0f;
+        }
+
+        const uint32_t* texture = &texels[(size_t)(layer < layers ? layer : layers - 1) * width * height];
+        bool isLinear = footprint > 1.0f ? minFilter == TextureMinFilter::Linear : magFilter == TextureMagFilter::Linear;
+
+        if (isLinear == false)
+        {
+            int s = WrapTexel(FloorToInt(x), (int)width, wrap.s);
+            int t = WrapTexel(FloorToInt(y), (int)height, wrap.t);
+            if (s < 0 || t < 0)
+                color[0] = color[1] = color[2] = color[3] = 0.0f;
+            else
+                UnpackColor(texture[t * width + s], color);
+            return;
+        }
+
+        //Bilinear filtering between the four texels around the sample point, the texels are blended as 0 to 255 and
+        //scaled once at the end
+        x -= 0.5f;
+        y -= 0.5f;
+        int floorX = FloorToInt(x);
+        int floorY = FloorToInt(y);
+        float blendX = x - (float)floorX;
+        float blendY = y - (float)floorY;
+
+        int s[2] = { WrapTexel(floorX, (int)width, wrap.s), WrapTexel(floorX + 1, (int)width, wrap.s) };
+        int t[2] = { WrapTexel(floorY, (int)height, wrap.t), WrapTexel(floorY + 1, (int)height, wrap.t) };
+
+        uint32_t texels[2][2];
+        for (int j = 0; j < 2; j++)
+        {
+            for (int i = 0; i < 2; i++)
+                texels[j][i] = s[i] < 0 || t[j] < 0 ? 0 : texture[t[j] * width + s[i]];
+        }
+
+        const float scale = 1.0f / 255.0f;
+#if SOFTWARE_RASTERIZER_SSE2
+        __m128 bottomLeft = _mm_cvtepi32_ps(UnpackBytes(texels[0][0]));
+        __m128 bottomRight = _mm_cvtepi32_ps(UnpackBytes(texels[0][1]));
+        __m128 topLeft = _mm_cvtepi32_ps(UnpackBytes(texels[1][0]));
+        __m128 topRight = _mm_cvtepi32_ps(UnpackBytes(texels[1][1]));
+
+        __m128 bottom = _mm_add_ps(bottomLeft, _mm_mul_ps(_mm_sub_ps(bottomRight, bottomLeft), _mm_set1_ps(blendX)));
+        __m128 top = _mm_add_ps(topLeft, _mm_mul_ps(_mm_sub_ps(topRight, topLeft), _mm_set1_ps(blendX)));
+        __m128 blended = _mm_add_ps(bottom, _mm_mul_ps(_mm_sub_ps(top, bottom), _mm_set1_ps(blendY)));
+        _mm_storeu_ps(color, _mm_mul_ps(blended, _mm_set1_ps(scale)));
+#else
+        for (int c = 0; c < 4; c++)
+        {
+            int shift = c * 8;
+            float bottomLeft = (float)((texels[0][0] >> shift) & 0xff);
+            float bottomRight = (float)((texels[0][1] >> shift) & 0xff);
+            float topLeft = (float)((texels[1][0] >> shift) & 0xff);
+            float topRight = (float)((texels[1][1] >> shift) & 0xff);
+
+            float bottom = bottomLeft + (bottomRight - bottomLeft) * blendX;
+            float top = topLeft + (topRight - topLeft) * blendX;
+            color[c] = (bottom + (top - bottom) * blendY) * scale;
+        }
+#endif
+    }
+
+    SoftwareRasterizer::SoftwareRasterizer(unsigned int aWidth, unsigned int aHeight, unsigned int aNumberOfThreads) :
+        m_ThreadPool(aNumberOfThreads),
+        m_Width(0),
+        m_Height(0),
+        m_TilesX(0),
+        m_TilesY(0),
+        m_TotalTriangles(0),
+        m_TotalBinnedTriangles(0)
+    {
+        Resize(aWidth, aHeight);
+    }
+
+    void SoftwareRasterizer::Resize(unsigned int aWidth, unsigned int aHeight)
+    {
+        Flush();
+
+        m_Width = aWidth;
+        m_Height = aHeight;
+        m_TilesX = (aWidth + kTileSize - 1) / kTileSize;
+        m_TilesY = (aHeight + kTileSize - 1) / kTileSize;
+        m_Pixels.assign((size_t)aWidth * aHeight, 0);
+        m_Bins.resize(m_TilesX * m_TilesY);
+    }
+
+    unsigned int SoftwareRasterizer::GetWidth() const
+    {
+        return m_Width;
+    }
+
+    unsigned int SoftwareRasterizer::GetHeight() const
+    {
+        return m_Height;
+    }
+
+    void SoftwareRasterizer::SetDrawState(const SoftwareDrawState& aState)
+    {
+        m_States.push_back(aState);
+    }
+
+    void SoftwareRasterizer::AddTriangle(const SoftwareTriangle& aTriangle)
+    {
+        assert(m_States.size() > 0);
+        m_TotalTriangles++;
+
+        const SoftwareDrawState& state = m_States.back();
+        const SoftwareVertex* vertices = aTriangle.vertices;
+
+        //Zero area (and NaN) triangles don't cover any pixels
+        float area = (vertices[1].x - vertices[0].x) * (vertices[2].y - vertices[0].y) - (vertices[1].y - vertices[0].y) * (vertices[2].x - vertices[0].x);
+        if (!(fabsf(area) > 0.0f))
+            return;
+
+        //The pixels whose centers could be inside the triangle, clamped before converting so huge triangles don't overflow
+        float minX = fmaxf(fminf(fminf(vertices[0].x, vertices[1].x), vertices[2].x) - 0.5f, (float)state.clip[0]);
+        float minY = fmaxf(fminf(fminf(vertices[0].y, vertices[1].y), vertices[2].y) - 0.5f, (float)state.clip[1]);
+        float maxX = fminf(fmaxf(fmaxf(vertices[0].x, vertices[1].x), vertices[2].x) - 0.5f, (float)(state.clip[2] - 1));
+        float maxY = fminf(fmaxf(fmaxf(vertices[0].y, vertices[1].y), vertices[2].y) - 0.5f, (float)(state.clip[3] - 1));
+        if (minX > maxX || minY > maxY)
+            return;
+
+        int firstX = (int)ceilf(minX);
+        int firstY = (int)ceilf(minY);
+        int lastX = (int)floorf(maxX);
+        int lastY = (int)floorf(maxY);
+        if (firstX > lastX || firstY > lastY)
+            return;
+
+        unsigned int index = (unsigned int)m_Triangles.size();
+        m_Triangles.push_back(aTriangle);
+        m_Triangles.back().state = (unsigned int)m_States.size() - 1;
+        m_TotalBinnedTriangles++;
+
+        for (unsigned int tileY = firstY / kTileSize; tileY <= lastY / kTileSize; tileY++)
+        {
+            for (unsigned int tileX = firstX / kTileSize; tileX <= lastX / kTileSize; tileX++)
+            {
+                m_Bins[tileY * m_TilesX + tileX].push_back(index);
+            }
+        }
+    }
+
+    void SoftwareRasterizer::Flush()
+    {
+        if (m_Triangles.size() > 0)
+        {
+            m_ThreadPool.ParallelFor(m_TilesX * m_TilesY, [this](unsigned int tile, unsigned int)
+                {
+                    RasterizeTile(tile);
+                });
+
+            for (std::vector<unsigned int>& bin : m_Bins)
+                bin.clear();
+
+            m_Triangles.clear();
+        }
+
+        //The last state is kept, it's still the current draw call's state
+        if (m_States.size() > 1)
+        {
+            m_States.front() = m_States.back();
+            m_States.resize(1);
+        }
+    }
+
+    void SoftwareRasterizer::Clear(const Color& aColor, const int aClip[4])
+    {
+        Flush();
+
+        float color[] = { aColor.r, aColor.g, aColor.b, aColor.a };
+        uint32_t pixel = PackColor(color);
+
+        int minX = aClip[0] > 0 ? aClip[0] : 0;
+        int minY = aClip[1] > 0 ? aClip[1] : 0;
+        int maxX = aClip[2] < (int)m_Width ? aClip[2] : (int)m_Width;
+        int maxY = aClip[3] < (int)m_Height ? aClip[3] : (int)m_Height;
+
+        for (int y = minY; y < maxY; y++)
+        {
+            uint32_t* row = &m_Pixels[(size_t)y * m_Width];
+            for (int x = minX; x < maxX; x++)
+                row[x] = pixel;
+        }
+    }
+
+    void SoftwareRasterizer::ReadPixels(PixelFormat aFormat, unsigned int aWidth, unsigned int aHeight, unsigned char* aBuffer)
+    {
+        Flush();
+
+        unsigned int bytesPerPixel = aFormat.layout == PixelLayout::RGB ? 3 : 4;
+        memset(aBuffer, 0, (size_t)aWidth * aHeight * bytesPerPixel);
+
+        unsigned int width = aWidth < m_Width ? aWidth : m_Width;
+        unsigned int height = aHeight < m_Height ? aHeight : m_Height;
+
+        for (unsigned int y = 0; y < height; y++)
+        {
+            const uint32_t* row = &m_Pixels[(size_t)y * m_Width];
+            unsigned char* destination = aBuffer + (size_t)y * aWidth * bytesPerPixel;
+
+            for (unsigned int x = 0; x < width; x++)
+            {
+                uint32_t pixel = row[x];
+                for (unsigned int c = 0; c < bytesPerPixel; c++)
+                    destination[x * bytesPerPixel + c] = (unsigned char)((pixel >> (c * 8)) & 0xff);
+            }
+        }
+    }
+
+    unsigned int SoftwareRasterizer::GetNumberOfThreads() const
+    {
+        return m_ThreadPool.GetNumberOfThreads();
+    }
+
+    unsigned long long SoftwareRasterizer::GetTotalTriangles() const
+    {
+        return m_TotalTriangles;
+    }
+
+    unsigned long long SoftwareRasterizer::GetTotalBinnedTriangles() const
+    {
+        return m_TotalBinnedTriangles;
+    }
+
+    void SoftwareRasterizer::RasterizeTile(unsigned int aTile)
+    {
+        const std::vector<unsigned int>& bin = m_Bins[aTile];
+        if (bin.empty())
+            return;
+
+        int tileMinX = (int)((aTile % m_TilesX) * kTileSize);
+        int tileMinY = (int)((aTile / m_TilesX) * kTileSize);
+        int tileMaxX = tileMinX + (int)kTileSize < (int)m_Width ? tileMinX + (int)kTileSize : (int)m_Width;
+        int tileMaxY = tileMinY + (int)kTileSize < (int)m_Height ? tileMinY + (int)kTileSize : (int)m_Height;
+
+        for (unsigned int index : bin)
+        {
+            const SoftwareTriangle& triangle = m_Triangles[index];
+            const SoftwareDrawState& state = m_States[triangle.state];
+
+            int minX = tileMinX > state.clip[0] ? tileMinX : state.clip[0];
+            int minY = tileMinY > state.clip[1] ? tileMinY : state.clip[1];
+            int maxX = tileMaxX < state.clip[2] ? tileMaxX : state.clip[2];
+            int maxY = tileMaxY < state.clip[3] ? tileMaxY : state.clip[3];
+
+            if (minX < maxX && minY < maxY)
+                RasterizeTriangle(triangle, state, minX, minY, maxX, maxY);
+        }
+    }
+
+    void SoftwareRasterizer::RasterizeTriangle(const SoftwareTriangle& aTriangle, const SoftwareDrawState& aState, int aMinX, int aMinY, int aMaxX, int aMaxY)
+    {
+        const SoftwareVertex* a = &aTriangle.vertices[0];
+        const SoftwareVertex* b = &aTriangle.vertices[1];
+        const SoftwareVertex* c = &aTriangle.vertices[2];
+
+        //The edge functions below expect counter clockwise triangles, OpenGL doesn't cull either winding by default
+        float area = (b->x - a->x) * (c->y - a->y) - (b->y - a->y) * (c->x - a->x);
+        if (area < 0.0f)
+        {
+            const SoftwareVertex* swap = b;
+            b = c;
+            c = swap;
+            area = -area;
+        }
+
+        float minX = fmaxf(fminf(fminf(a->x, b->x), c->x) - 0.5f, (float)aMinX);
+        float minY = fmaxf(fminf(fminf(a->y, b->y), c->y) - 0.5f, (float)aMinY);
+        float maxX = fminf(fmaxf(fmaxf(a->x, b->x), c->x) - 0.5f, (float)(aMaxX - 1));
+        float maxY = fminf(fmaxf(fmaxf(a->y, b->y), c->y) - 0.5f, (float)(aMaxY - 1));
+        if (minX > maxX || minY > maxY)
+            return;
+
+        int firstX = (int)ceilf(minX);
+        int firstY = (int)ceilf(minY);
+        int lastX = (int)floorf(maxX);
+        int lastY = (int)floorf(maxY);
+
+        //Each edge function is the weight of the vertex opposite the edge, scaled by the area
+        float stepX0 = b->y - c->y, stepY0 = c->x - b->x;
+        float stepX1 = c->y - a->y, stepY1 = a->x - c->x;
+        float stepX2 = a->y - b->y, stepY2 = b->x - a->x;
+        bool isTopLeft0 = IsTopLeft(*b, *c);
+        bool isTopLeft1 = IsTopLeft(*c, *a);
+        bool isTopLeft2 = IsTopLeft(*a, *b);
+        float inverseArea = 1.0f / area;
+
+        //Per triangle texture values, the uv derivatives are the same for every pixel of a triangle
+        const SoftwareTexture* texture = nullptr;
+        unsigned int layer = 0;
+        float tiling = 1.0f;
+        float footprint = 0.0f;
+        float distanceField = 0.0f;
+        float uvStepX[2] = { 0.0f, 0.0f };
+        float uvStepY[2] = { 0.0f, 0.0f };
+        bool isTextured = false;
+
+        if (aState.shading == SoftwareShading::Texture)
+        {
+            //Units 0-23 hold textures and units 24-31 hold texture arrays, any other index isn't textured
+            int textureIndex = (int)aTriangle.flat[0];
+            isTextured = textureIndex >= 0 && textureIndex < (int)SoftwareDrawState::kMaxTextures;
+            if (isTextured)
+            {
+                texture = aState.textures[textureIndex];
+                if (textureIndex >= 24)
+                    layer = aTriangle.flat[1] > 0.0f ? (unsigned int)(aTriangle.flat[1] + 0.5f) : 0;
+                else
+                    tiling = aTriangle.flat[2];
+                distanceField = aTriangle.flat[3];
+
+                for (int i = 0; i < 2; i++)
+                {
+                    uvStepX[i] = (a->uv[i] * stepX0 + b->uv[i] * stepX1 + c->uv[i] * stepX2) * inverseArea * tiling;
+                    uvStepY[i] = (a->uv[i] * stepY0 + b->uv[i] * stepY1 + c->uv[i] * stepY2) * inverseArea * tiling;
+                }
+
+                if (texture != nullptr)
+                {
+                    float footprintX = sqrtf(uvStepX[0] * uvStepX[0] * texture->width * texture->width + uvStepX[1] * uvStepX[1] * texture->height * texture->height);
+                    float footprintY = sqrtf(uvStepY[0] * uvStepY[0] * texture->width * texture->width + uvStepY[1] * uvStepY[1] * texture->height * texture->height);
+                    footprint = fmaxf(footprintX, footprintY);
+                }
+            }
+        }
+
+        for (int y = firstY; y <= lastY; y++)
+        {
+            float pixelX = (float)firstX + 0.5f;
+            float pixelY = (float)y + 0.5f;
+            float weight0 = (pixelX - b->x) * stepX0 + (pixelY - b->y) * stepY0;
+            float weight1 = (pixelX - c->x) * stepX1 + (pixelY - c->y) * stepY1;
+            float weight2 = (pixelX - a->x) * stepX2 + (pixelY - a->y) * stepY2;
+            uint32_t* row = &m_Pixels[(size_t)y * m_Width];
+
+            for (int x = firstX; x <= lastX; x++, weight0 += stepX0, weight1 += stepX1, weight2 += stepX2)
+            {
+                if (!(IsInside(weight0, isTopLeft0) && IsInside(weight1, isTopLeft1) && IsInside(weight2, isTopLeft2)))
+                    continue;
+
+                float l1 = weight1 * inverseArea;
+                float l2 = weight2 * inverseArea;
+                float l0 = 1.0f - l1 - l2;
+                float color[4];
+
+                if (aState.shading == SoftwareShading::Circle)
+                {
+                    //Same as the circle shader, gl_FragCoord (the pixel's center) is compared with the circle's position
+                    const float* flat = aTriangle.flat;
+                    float dx = flat[0] - ((float)x + 0.5f);
+                    float dy = flat[1] - ((float)y + 0.5f);
+                    float distanceSquared = dx * dx + dy * dy;
+                    float outline = flat[2] + flat[3];
+
+                    if (distanceSquared <= flat[2] * flat[2])
+                        memcpy(color, &flat[4], sizeof(color));
+                    else if (distanceSquared <= outline * outline)
+                        memcpy(color, &flat[8], sizeof(color));
+                    else
+                        continue;
+                }
+                else
+                {
+                    InterpolateColor(a->color, b->color, c->color, l0, l1, l2, color);
+
+                    if (isTextured)
+                    {
+                        float u = (a->uv[0] * l0 + b->uv[0] * l1 + c->uv[0] * l2) * tiling;
+                        float v = (a->uv[1] * l0 + b->uv[1] * l1 + c->uv[1] * l2) * tiling;
+                        float texColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                        if (texture != nullptr)
+                            texture->Sample(u, v, layer, footprint, texColor);
+
+                        //Distance field fonts, fwidth() is the alpha's change to the next pixel right and up
+                        if (distanceField > 0.0f && texture != nullptr)
+                        {
+                            float right[4];
+                            float up[4];
+                            texture->Sample(u + uvStepX[0], v + uvStepX[1], layer, footprint, right);
+                            texture->Sample(u + uvStepY[0], v + uvStepY[1], layer, footprint, up);
+
+                            float edgeWidth = (fabsf(right[3] - texColor[3]) + fabsf(up[3] - texColor[3])) * 0.5f;
+                            float coverage = SmoothStep(0.5f - edgeWidth, 0.5f + edgeWidth, texColor[3]);
+                            for (int i = 0; i < 3; i++)
+                                texColor[i] += (1.0f - texColor[i]) * distanceField;
+                            texColor[3] += (coverage - texColor[3]) * distanceField;
+                        }
+
+                        MultiplyColor(color, texColor);
+                    }
+                }
+
+                WritePixel(row[x], color, aState);
+            }
+        }
+    }
+
+    void SoftwareRasterizer::WritePixel(uint32_t& aPixel, const float* aColor, const SoftwareDrawState& aState)
+    {
+        if (aState.blending == false)
+        {
+            aPixel = PackColor(aColor);
+            return;
+        }
+
+        float source[4];
+#if SOFTWARE_RASTERIZER_SSE2
+        _mm_storeu_ps(source, Clamp01(_mm_loadu_ps(aColor)));
+#else
+        for (int i = 0; i < 4; i++)
+            source[i] = Clamp01(aColor[i]);
+#endif
+
+        //Alpha blending is what the renderers use, it skips the factor lookups and leaves the pixel alone when the
+        //fragment is fully transparent
+        if (aState.source == BlendingFactor::SourceAlpha && aState.destination == BlendingFactor::OneMinusSourceAlpha)
+        {
+            if (source[3] <= 0.0f)
+                return;
+
+            //An opaque fragment replaces the pixel, source * 1 + destination * 0 is exactly the source
+            if (source[3] >= 1.0f)
+            {
+                aPixel = PackColor(source);
+                return;
+            }
+
+            float destination[4];
+            UnpackColor(aPixel, destination);
+
+            float result[4];
+            BlendAlpha(source, destination, result);
+
+            aPixel = PackColor(result);
+            return;
+        }
+
+        float destination[4];
+        float sourceFactor[4];
+        float destinationFactor[4];
+        UnpackColor(aPixel, destination);
+
+        GetBlendingFactor(aState.source, source, destination, sourceFactor);
+        GetBlendingFactor(aState.destination, source, destination, destinationFactor);
+
+        float result[4];
+        for (int i = 0; i < 4; i++)
+            result[i] = source[i] * sourceFactor[i] + destination[i] * destinationFactor[i];
+
+        aPixel = PackColor(result);
+    }
+}
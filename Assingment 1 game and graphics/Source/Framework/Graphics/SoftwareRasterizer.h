@@ -0,0 +1,132 @@
+#pragma once
+
+#include "GraphicTypes.h"
+#include "Color.h"
+#include "../Utils/ThreadPool/ThreadPool.h"
+#include <stdint.h>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //A texture or texture array kept in memory as RGBA8, layer by layer, the first row is the first row of the image data
+    struct SoftwareTexture
+    {
+        SoftwareTexture();
+
+        //Discards the texels, they're all transparent black after this
+        void SetStorage(unsigned int width, unsigned int height, unsigned int layers);
+
+        //Writes the texture's color at uv into color (rgba 0 to 1). footprint is how many texels one pixel covers,
+        //it picks between the min and mag filter since there are no mipmaps
+        void Sample(float u, float v, unsigned int layer, float footprint, float* color) const;
+
+        unsigned int width;
+        unsigned int height;
+        unsigned int layers;
+        std::vector<uint32_t> texels;
+        TextureMinFilter minFilter;
+        TextureMagFilter magFilter;
+        Wrap wrap;
+    };
+
+    //How a triangle's fragments are colored, these match the fragment shaders of the programs SoftwareBackend runs
+    enum class SoftwareShading
+    {
+        Color = 0,
+        Texture,
+        Circle
+    };
+
+    //The part of a draw call's state the fragments need, shared by all of the draw call's triangles
+    struct SoftwareDrawState
+    {
+        static const unsigned int kMaxTextures = 32;
+
+        SoftwareShading shading;
+        bool blending;
+        BlendingFactor source;
+        BlendingFactor destination;
+
+        //The pixels that can be written to: the viewport clipped by the scissor rect, the max corner is exclusive
+        int clip[4];
+
+        //The texture used by each texture index, nullptr if nothing is bound
+        const SoftwareTexture* textures[kMaxTextures];
+    };
+
+    //A vertex after the vertex shader, in window coordinates (the bottom left of the frame buffer is 0,0)
+    struct SoftwareVertex
+    {
+        float x;
+        float y;
+        float color[4];
+        float uv[2];
+    };
+
+    //flat holds the values that are the same across the triangle. Textured triangles use texture index, layer,
+    //tiling factor and distance field. Circles use center x and y, radius, outline size, fill and outline color
+    struct SoftwareTriangle
+    {
+        static const unsigned int kMaxFlat = 12;
+
+        SoftwareVertex vertices[3];
+        float flat[kMaxFlat];
+        unsigned int state;
+    };
+
+    //Draws triangles into an RGBA8 frame buffer. The triangles are binned into tiles as they're added and Flush()
+    //rasterizes the tiles in parallel, a tile is only touched by one thread and draws its triangles in the order
+    //they were added, so blending gives the same result as drawing them one after another
+    class SoftwareRasterizer
+    {
+    public:
+        static const unsigned int kTileSize = 64;
+
+        //0 uses one thread per hardware thread
+        SoftwareRasterizer(unsigned int width, unsigned int height, unsigned int numberOfThreads = 0);
+
+        void Resize(unsigned int width, unsigned int height);
+        unsigned int GetWidth() const;
+        unsigned int GetHeight() const;
+
+        //The triangles added after this use the state
+        void SetDrawState(const SoftwareDrawState& state);
+
+        //Bins the triangle into the tiles it overlaps, it's rasterized by the next Flush()
+        void AddTriangle(const SoftwareTriangle& triangle);
+
+        //Rasterizes the triangles added since the last Flush()
+        void Flush();
+
+        //Flushes, then fills the clip rect (min x, min y, max x, max y) with the color
+        void Clear(const Color& color, const int clip[4]);
+
+        //Flushes, then copies the frame buffer bottom row first (like glReadPixels) as RGBA or RGB
+        void ReadPixels(PixelFormat format, unsigned int width, unsigned int height, unsigned char* buffer);
+
+        unsigned int GetNumberOfThreads() const;
+
+        //Returns the number of triangles added and the number that covered at least one tile
+        unsigned long long GetTotalTriangles() const;
+        unsigned long long GetTotalBinnedTriangles() const;
+
+    private:
+        void RasterizeTile(unsigned int tile);
+        void RasterizeTriangle(const SoftwareTriangle& triangle, const SoftwareDrawState& state, int minX, int minY, int maxX, int maxY);
+        void WritePixel(uint32_t& pixel, const float* color, const SoftwareDrawState& state);
+
+        //Member variables
+        ThreadPool m_ThreadPool;
+        std::vector<uint32_t> m_Pixels;
+        unsigned int m_Width;
+        unsigned int m_Height;
+        unsigned int m_TilesX;
+        unsigned int m_TilesY;
+        std::vector<SoftwareDrawState> m_States;
+        std::vector<SoftwareTriangle> m_Triangles;
+        std::vector<std::vector<unsigned int>> m_Bins;
+        unsigned long long m_TotalTriangles;
+        unsigned long long m_TotalBinnedTriangles;
+    };
+}
\ No newline at end of file
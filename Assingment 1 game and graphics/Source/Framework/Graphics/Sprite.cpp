@@ -1,5 +1,4 @@
 #include "Sprite.h"
-#include "../Application/Application.h"
 #include <GameDev2D.h>
 #include <vector>
 
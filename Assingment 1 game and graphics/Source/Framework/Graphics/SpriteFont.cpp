@@ -1,6 +1,6 @@
 #include "SpriteFont.h"
 #include "GraphicTypes.h"
-#include "../Application/Application.h"
+#include <GameDev2D.h>
 #include "../Utils/Text/Text.h"
 #include <fstream>
 
@@ -13,7 +13,9 @@ namespace GameDev2D
 		m_Size(Vector2(0.0f, 0.0f)),
 		m_Justification(Justification::Left),
 		m_CharacterSpacing(0.0f),
-		m_LineCount(0)
+		m_FontSize(0.0f),
+		m_LineCount(0),
+		m_IsLayoutDirty(true)
 	{
 		SetTexture(m_Font->GetTexture());
 	}
@@ -24,7 +26,9 @@ namespace GameDev2D
 		m_Size(Vector2(0.0f, 0.0f)),
 		m_Justification(Justification::Left),
 		m_CharacterSpacing(0.0f),
-		m_LineCount(0)
+		m_FontSize(0.0f),
+		m_LineCount(0),
+		m_IsLayoutDirty(true)
 	{
 		SetTexture(m_Font->GetTexture());
 	}
@@ -36,12 +40,12 @@ namespace GameDev2D
 
 	float SpriteFont::GetWidth()
 	{
-		return m_Size.x;
+		return m_Size.x * GetFontScale();
 	}
 
 	float SpriteFont::GetHeight()
 	{
-		return m_Size.y;
+		return m_Size.y * GetFontScale();
 	}
 
 	void SpriteFont::SetColor(Color aColor)
@@ -52,12 +56,17 @@ namespace GameDev2D
 		{
 			m_CharacterData.at(i).color = aColor;
 		}
+
+		m_IsLayoutDirty = true;
 	}
 
 	void SpriteFont::SetFont(const std::string& fontFile)
 	{
 		m_Font = Application::Get().GetResourceManager().GetFontCache().Get(fontFile);
 		SetTexture(m_Font->GetTexture());
+
+		//Re-calculate the size
+		CalculateSize();
 	}
 
 	Font* SpriteFont::GetFont()
@@ -65,6 +74,29 @@ namespace GameDev2D
 		return m_Font;
 	}
 
+	void SpriteFont::SetFontSize(float aFontSize)
+	{
+		if (m_FontSize != aFontSize)
+		{
+			m_FontSize = aFontSize;
+			m_IsLayoutDirty = true;
+		}
+	}
+
+	float SpriteFont::GetFontSize()
+	{
+		return m_FontSize > 0.0f ? m_FontSize : (float)m_Font->GetSize();
+	}
+
+	float SpriteFont::GetFontScale()
+	{
+		if (m_FontSize <= 0.0f || m_Font == nullptr || m_Font->GetSize() == 0)
+		{
+			return 1.0f;
+		}
+		return m_FontSize / (float)m_Font->GetSize();
+	}
+
 	void SpriteFont::SetText(const std::string& aText)
 	{
 		//Is the text the exact same, if so return
@@ -116,7 +148,7 @@ namespace GameDev2D
 
 	float SpriteFont::GetLineWidth(unsigned int lineIndex)
 	{
-		return m_LineWidth.at(lineIndex);
+		return m_LineWidth.at(lineIndex) * GetFontScale();
 	}
 
 	void SpriteFont::SetJustification(SpriteFont::Justification aJustification)
@@ -126,6 +158,7 @@ namespace GameDev2D
 		{
 			//Set the justification
 			m_Justification = aJustification;
+			m_IsLayoutDirty = true;
 		}
 	}
 
@@ -182,10 +215,107 @@ namespace GameDev2D
 
 		//Set the size
 		m_Size = maxSize;
+
+		//The size is used to lay out the characters
+		m_IsLayoutDirty = true;
 	}
 
 	std::vector<SpriteFont::CharacterData>& SpriteFont::GetCharacterData()
 	{
+		//The character data can be changed through the reference
+		m_IsLayoutDirty = true;
 		return m_CharacterData;
 	}
+
+	const std::vector<SpriteFont::GlyphQuad>& SpriteFont::GetGlyphQuads()
+	{
+		if (m_IsLayoutDirty || m_LayoutAnchor != GetAnchor())
+		{
+			LayoutGlyphs();
+		}
+		return m_GlyphQuads;
+	}
+
+	void SpriteFont::LayoutGlyphs()
+	{
+		m_GlyphQuads.clear();
+		m_LayoutAnchor = GetAnchor();
+		m_IsLayoutDirty = false;
+
+		//Safety check that the font pointer is null
+		if (m_Font == nullptr || m_Text.length() == 0)
+		{
+			return;
+		}
+
+		//calculate the baseline and origin for the label
+		unsigned int baseline = m_Font->GetLineHeight() - m_Font->GetBaseline();
+		Vector2 position = Vector2(GetLineOrigin(0), 0.0f);
+		position.y += baseline + (m_Font->GetLineHeight() * (m_LineCount - 1));
+		Vector2 anchorOffset = Vector2(-m_Size.x * m_LayoutAnchor.x, -m_Size.y * m_LayoutAnchor.y);
+		unsigned int lineIndex = 0;
+
+		float textureWidth = (float)m_Font->GetTexture()->GetWidth();
+		float textureHeight = (float)m_Font->GetTexture()->GetHeight();
+		float fontScale = GetFontScale();
+
+		//Cycle through the characters in the text label
+		for (unsigned int i = 0; i < m_Text.length(); i++)
+		{
+			//Did we reach a new line?
+			if (m_Text.at(i) == '\n')
+			{
+				//Calculate the line's origin based on the justification, and the y line origin based on the line height of the font
+				lineIndex++;
+				position.x = GetLineOrigin(lineIndex);
+				position.y -= m_Font->GetLineHeight();
+				continue;
+			}
+
+			GlyphData glyph = m_Font->GetGlyph(m_Text.at(i));
+			const Rect& characterRect = glyph.frame;
+			const CharacterData& characterData = m_CharacterData.at(i);
+
+			Vector2 charPosition = position + anchorOffset;
+			charPosition.x += glyph.bearingX;
+			charPosition.y += glyph.bearingY - characterRect.size.y;
+
+			//Only the anchored corner goes through the transform, the edges are its scaled x and y axes
+			Affine2D local = Affine2D::Make(charPosition, characterData.angle, characterData.scale);
+			Vector2 size = characterRect.size;
+
+			GlyphQuad quad;
+			quad.origin = local * Vector2(-size.x * characterData.anchor.x, -size.y * characterData.anchor.y);
+			quad.axisX = Vector2(local.m[0][0] * size.x, local.m[0][1] * size.x);
+			quad.axisY = Vector2(local.m[1][0] * size.y, local.m[1][1] * size.y);
+
+			//Same uvs as Sprite::GetUVs() for the character's frame
+			quad.uvOrigin = Vector2(characterRect.origin.x / textureWidth, 1.0f - ((characterRect.origin.y + size.y) / textureHeight));
+			quad.uvSize = Vector2(size.x / textureWidth, size.y / textureHeight);
+			quad.color = characterData.color;
+
+			//The characters are laid out at the Font's size, then scaled to the font size
+			quad.origin *= fontScale;
+			quad.axisX *= fontScale;
+			quad.axisY *= fontScale;
+			m_GlyphQuads.push_back(quad);
+
+			//Increment the position
+			position.x += glyph.advanceX + GetCharacterSpacing();
+		}
+	}
+
+	float SpriteFont::GetLineOrigin(unsigned int lineIndex)
+	{
+		//In the Font's size, before the font scale is applied
+		if (m_Justification == Justification::Center)
+		{
+			return (m_Size.x - m_LineWidth.at(lineIndex)) * 0.5f;
+		}
+		else if (m_Justification == Justification::Right)
+		{
+			return m_Size.x - m_LineWidth.at(lineIndex);
+		}
+		return 0.0f;
+	}
 }
\ No newline at end of file
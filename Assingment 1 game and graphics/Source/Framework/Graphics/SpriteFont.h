@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Sprite.h"
+#include "ColorList.h"
 #include "Font.h"
 
 
@@ -25,6 +26,11 @@ namespace GameDev2D
 		void SetFont(const std::string& fontFile);
 		Font* GetFont();
 
+		//Sets the size the text is drawn at, zero draws it at the Font's size. Distance field fonts stay sharp
+		//at any size, other fonts are scaled from their texture
+		void SetFontSize(float fontSize);
+		float GetFontSize();
+
 		//Sets the text that the Label will display
 		void SetText(const std::string& text);
 
@@ -90,18 +96,45 @@ namespace GameDev2D
 		//Returns a reference to the CharacterData so that you can modify each character's data individually
 		std::vector<CharacterData>& GetCharacterData();
 
+		//A character's quad in the SpriteFont's local space, its corners are origin, origin + axisX,
+		//origin + axisY and origin + axisX + axisY
+		struct GlyphQuad
+		{
+			Vector2 origin;
+			Vector2 axisX;
+			Vector2 axisY;
+			Vector2 uvOrigin;
+			Vector2 uvSize;
+			Color color;
+		};
+
+		//Returns the laid out character quads, they are only laid out again after the text, font, spacing,
+		//justification, anchor or character data changes
+		const std::vector<GlyphQuad>& GetGlyphQuads();
+
 	private:
 		//Conveniance method to calculate the size of the SpriteFont, based on the text
 		void CalculateSize();
 
+		//Lays out the character quads in local space
+		void LayoutGlyphs();
+		float GetLineOrigin(unsigned int lineIndex);
+
+		//Returns the scale from the Font's size to the font size the text is drawn at
+		float GetFontScale();
+
 		//Member variables
 		Font* m_Font;
 		std::string m_Text;
 		std::vector<float> m_LineWidth;
 		std::vector<CharacterData> m_CharacterData;
+		std::vector<GlyphQuad> m_GlyphQuads;
+		Vector2 m_LayoutAnchor;
+		bool m_IsLayoutDirty;
 		Vector2 m_Size;
 		Justification m_Justification;
 		float m_CharacterSpacing;
+		float m_FontSize;
 		unsigned int m_LineCount;
 	};
 }
\ No newline at end of file
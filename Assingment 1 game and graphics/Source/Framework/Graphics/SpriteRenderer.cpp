@@ -1,37 +1,51 @@
 #include "SpriteRenderer.h"
-#include "Camera.h"
 #include "Sprite.h"
 #include "SpriteFont.h"
 #include "Texture.h"
-#include "../Application/Application.h"
-#include "../Resources/ResourceManager.h"
-#include "../Utils/Text/Text.h"
+#include "TextureArray.h"
+#include "Graphics.h"
+#include "../Math/LineSegment.h"
+#include "../Math/Math.h"
+#include "../Resources/ResourceCache.h"
 
 
 namespace GameDev2D
 {
-	SpriteRenderer::SpriteRenderer() :
+	//Shared by every SpriteRenderer, so a Texture's batch slot stamp can never match another renderer's batch
+	static unsigned int s_LastBatchGeneration = 0;
+
+	SpriteRenderer::SpriteRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache) :
+		m_Graphics(graphics),
+		m_Submission(SpriteSubmission::PerVertex),
+		m_QuadInstanceCount(0),
+		m_QuadInstanceBufferBase(nullptr),
+		m_QuadInstanceBufferPtr(nullptr),
+		m_QuadInstanceBufferEnd(nullptr),
 		m_TextureSlotIndex(1), // 0 = white texture
+		m_TextureArraySlotIndex(0),
+		m_BatchGeneration(0),
 		m_QuadIndexCount(0),
 		m_QuadVertexBufferBase(nullptr),
 		m_QuadVertexBufferPtr(nullptr),
+		m_QuadVertexBufferEnd(nullptr),
 		m_QuadVertexPositions{},
 		m_RenderSpriteOutline(false)
 	{
-		m_QuadVertexArray = std::make_shared<VertexArray>();
+		m_QuadVertexArray = std::make_shared<VertexArray>(m_Graphics);
 
-		m_QuadVertexBuffer = std::make_shared<VertexBuffer>(kMaxVertices * sizeof(QuadVertex));
+		m_QuadVertexBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxVertices * sizeof(QuadVertex));
 		m_QuadVertexBuffer->SetLayout({
 			{ ShaderDataType::Float2, "a_Vertices" },
 			{ ShaderDataType::Float2, "a_TextureUV" },
 			{ ShaderDataType::Float4, "a_Color" },
 			{ ShaderDataType::Float, "a_TexureIndex" },
-			{ ShaderDataType::Float, "a_TilingFactor" }
+			{ ShaderDataType::Float, "a_TextureLayer" },
+			{ ShaderDataType::Float, "a_TilingFactor" },
+			{ ShaderDataType::Float, "a_DistanceField" }
 			});
 
 		m_QuadVertexArray->AddVertexBuffer(m_QuadVertexBuffer);
 
-		m_QuadVertexBufferBase = new QuadVertex[kMaxVertices];
 		unsigned int* quadIndices = new unsigned int[kMaxIndices];
 
 		unsigned int offset = 0;
@@ -48,16 +62,47 @@ namespace GameDev2D
 			offset += kQuadVertexCount;
 		}
 
-		std::shared_ptr<IndexBuffer> quadIB = std::make_shared<IndexBuffer>(quadIndices, kMaxIndices);
+		std::shared_ptr<IndexBuffer> quadIB = std::make_shared<IndexBuffer>(m_Graphics, quadIndices, kMaxIndices);
 		m_QuadVertexArray->SetIndexBuffer(quadIB);
 		delete[] quadIndices;
 
+		//The instanced path draws every quad from the same four corners, in triangle strip order
+		m_InstanceVertexArray = std::make_shared<VertexArray>(m_Graphics);
+
+		float quadCorners[] = {
+			0.0f, 0.0f,
+			1.0f, 0.0f,
+			0.0f, 1.0f,
+			1.0f, 1.0f
+		};
+
+		m_InstanceCornerBuffer = std::make_shared<VertexBuffer>(m_Graphics, quadCorners, (unsigned int)sizeof(quadCorners));
+		m_InstanceCornerBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Corner" }
+			});
+		m_InstanceVertexArray->AddVertexBuffer(m_InstanceCornerBuffer);
+
+		m_QuadInstanceBuffer = std::make_shared<StreamingVertexBuffer>(m_Graphics, kMaxQuads * sizeof(QuadInstance));
+		m_QuadInstanceBuffer->SetLayout({
+			{ ShaderDataType::Float2, "a_Origin" },
+			{ ShaderDataType::Float2, "a_AxisX" },
+			{ ShaderDataType::Float2, "a_AxisY" },
+			{ ShaderDataType::Float2, "a_TextureUVOrigin" },
+			{ ShaderDataType::Float2, "a_TextureUVSize" },
+			{ ShaderDataType::Float4, "a_Color" },
+			{ ShaderDataType::Float, "a_TexureIndex" },
+			{ ShaderDataType::Float, "a_TextureLayer" },
+			{ ShaderDataType::Float, "a_TilingFactor" },
+			{ ShaderDataType::Float, "a_DistanceField" }
+			});
+		m_InstanceVertexArray->AddVertexBuffer(m_QuadInstanceBuffer, 1);
+
 		ImageData imageData(PixelFormat(PixelLayout::RGBA, PixelSize::UnsignedByte), 1, 1);
 		imageData.data.push_back(0xff);
 		imageData.data.push_back(0xff);
 		imageData.data.push_back(0xff);
 		imageData.data.push_back(0xff);
-		m_WhiteTexture = std::make_shared<Texture>(imageData);
+		m_WhiteTexture = std::make_shared<Texture>(m_Graphics, imageData);
 
 		int samplers[MAX_TEXTURE_SLOTS];
 		for (unsigned int i = 0; i < MAX_TEXTURE_SLOTS; i++)
@@ -65,9 +110,23 @@ namespace GameDev2D
 			samplers[i] = i;
 		}
 
-		m_TextureShader = Application::Get().GetResourceManager().GetShaderCache().GetShared(SPRITE_RENDERER_SHADER_KEY);
+		int arraySamplers[MAX_TEXTURE_ARRAY_SLOTS];
+		for (unsigned int i = 0; i < MAX_TEXTURE_ARRAY_SLOTS; i++)
+		{
+			arraySamplers[i] = MAX_TEXTURE_SLOTS + i;
+		}
+
+		m_TextureShader = shaderCache.GetShared(SPRITE_RENDERER_SHADER_KEY);
 		m_TextureShader->Bind();
 		m_TextureShader->SetIntArray("u_Textures", samplers, MAX_TEXTURE_SLOTS);
+		m_TextureShader->SetIntArray("u_TextureArrays", arraySamplers, MAX_TEXTURE_ARRAY_SLOTS);
+		m_ViewProjectionUniform = m_TextureShader->GetUniform<Matrix>("u_ViewProjection");
+
+		m_InstanceShader = shaderCache.GetShared(SPRITE_INSTANCE_RENDERER_SHADER_KEY);
+		m_InstanceShader->Bind();
+		m_InstanceShader->SetIntArray("u_Textures", samplers, MAX_TEXTURE_SLOTS);
+		m_InstanceShader->SetIntArray("u_TextureArrays", arraySamplers, MAX_TEXTURE_ARRAY_SLOTS);
+		m_InstanceViewProjectionUniform = m_InstanceShader->GetUniform<Matrix>("u_ViewProjection");
 
 		//Set first texture slot to 0
 		m_TextureSlots[0] = m_WhiteTexture.get();
@@ -78,42 +137,54 @@ namespace GameDev2D
 		m_QuadVertexPositions[3] = { 0.0f, 1.0f };
 	}
 
-	SpriteRenderer::~SpriteRenderer()
-	{
-		if (m_QuadVertexBufferBase != nullptr)
-		{
-			delete[] m_QuadVertexBufferBase;
-			m_QuadVertexBufferBase = nullptr;
-		}
-	}
-
 	RendererType SpriteRenderer::GetType()
 	{
 		return RendererType::Sprite;
 	}
 
-	void SpriteRenderer::BeginScene(Camera* camera)
+	void SpriteRenderer::BeginScene(const Matrix& viewProjection, const Viewport& /*viewport*/)
 	{
-		m_TextureShader->Bind();
-		m_TextureShader->SetMat4("u_ViewProjection", camera->GetViewProjectionMatrix());
-
-		m_QuadIndexCount = 0;
-		m_QuadVertexBufferPtr = m_QuadVertexBufferBase;
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			m_InstanceShader->Bind();
+			m_InstanceShader->Set(m_InstanceViewProjectionUniform, viewProjection);
+		}
+		else
+		{
+			m_TextureShader->Bind();
+			m_TextureShader->Set(m_ViewProjectionUniform, viewProjection);
+		}
 
-		m_TextureSlotIndex = 1;
+		BeginBatch(0);
+		ResetTextureSlots();
 	}
 
 	void SpriteRenderer::EndScene()
 	{
-		unsigned int dataSize = (unsigned int)((unsigned char*)m_QuadVertexBufferPtr - (unsigned char*)m_QuadVertexBufferBase);
-		m_QuadVertexBuffer->SetData(m_QuadVertexBufferBase, dataSize);
-
+		//The vertices were written straight into the mapped buffer, they only need to be drawn
 		Flush();
+
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			unsigned int dataSize = (unsigned int)((unsigned char*)m_QuadInstanceBufferPtr - (unsigned char*)m_QuadInstanceBufferBase);
+			m_QuadInstanceBuffer->End(dataSize);
+
+			m_QuadInstanceCount = 0;
+			m_QuadInstanceBufferBase = m_QuadInstanceBufferPtr;
+		}
+		else
+		{
+			unsigned int dataSize = (unsigned int)((unsigned char*)m_QuadVertexBufferPtr - (unsigned char*)m_QuadVertexBufferBase);
+			m_QuadVertexBuffer->End(dataSize);
+
+			m_QuadIndexCount = 0;
+			m_QuadVertexBufferBase = m_QuadVertexBufferPtr;
+		}
 	}
 
 	void SpriteRenderer::Flush()
 	{
-		if (m_QuadIndexCount == 0)
+		if (m_QuadIndexCount == 0 && m_QuadInstanceCount == 0)
 			return;
 
 		for (unsigned int i = 0; i < m_TextureSlotIndex; i++)
@@ -121,38 +192,49 @@ namespace GameDev2D
 			m_TextureSlots[i]->Bind(i);
 		}
 
-		m_QuadVertexArray->Bind();
-		Application::Get().GetGraphics().DrawElements(RenderMode::Triangles, m_QuadVertexArray, m_QuadIndexCount);
+		for (unsigned int i = 0; i < m_TextureArraySlotIndex; i++)
+		{
+			m_TextureArraySlots[i]->Bind(MAX_TEXTURE_SLOTS + i);
+		}
+
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			m_InstanceVertexArray->Bind();
+			unsigned int baseInstance = m_QuadInstanceBuffer->GetWriteOffset() / sizeof(QuadInstance);
+			m_Graphics.DrawArraysInstanced(RenderMode::TriangleStrip, m_InstanceVertexArray, 0, kQuadVertexCount, m_QuadInstanceCount, baseInstance);
+		}
+		else
+		{
+			m_QuadVertexArray->Bind();
+			m_Graphics.DrawElements(RenderMode::Triangles, m_QuadVertexArray, m_QuadIndexCount, m_QuadVertexBuffer->GetWriteOffset() / sizeof(QuadVertex));
+		}
+
 		m_TotalDrawCalls++;
 		m_FrameDrawCalls++;
 	}
 
 	void SpriteRenderer::RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor)
 	{
-		Matrix transform = Matrix::MakeTranslation(position);
+		Affine2D transform = Affine2D::MakeTranslation(position);
 		RenderQuad(transform, size, anchor, fillColor);
 	}
 
 	void SpriteRenderer::RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize)
 	{
-		Matrix transform = Matrix::MakeTranslation(position);
+		Affine2D transform = Affine2D::MakeTranslation(position);
 		RenderQuad(transform, size, anchor, fillColor);
 		RenderOutline(transform, size, anchor, outlineColor, outlineSize);
 	}
 
 	void SpriteRenderer::RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor)
 	{
-		Matrix translationMatrix = Matrix::MakeTranslation(position);
-		Matrix rotationMatrix = Matrix::MakeRotation(radians);
-		Matrix transform = translationMatrix * rotationMatrix;
+		Affine2D transform = Affine2D::Make(position, radians);
 		RenderQuad(transform, size, anchor, fillColor);
 	}
 
 	void SpriteRenderer::RenderRotatedQuad(const Vector2& position, const Vector2& size, float radians, const Vector2& anchor, const Color& fillColor, const Color& outlineColor, float outlineSize)
 	{
-		Matrix translationMatrix = Matrix::MakeTranslation(position);
-		Matrix rotationMatrix = Matrix::MakeRotation(radians);
-		Matrix transform = translationMatrix * rotationMatrix;
+		Affine2D transform = Affine2D::Make(position, radians);
 		RenderQuad(transform, size, anchor, fillColor);
 		RenderOutline(transform, size, anchor, outlineColor, outlineSize);
 	}
@@ -171,8 +253,7 @@ namespace GameDev2D
 #if DEBUG
 		if (m_RenderSpriteOutline)
 		{
-			RenderOutline(sprite.GetWorldTransform(), sprite.GetSize() * sprite.GetWorldScale(), sprite.GetAnchor(), kSpriteOutlineColor, kSpriteOutlineSize);
-			RenderAnchor(sprite.GetWorldTransform());
+			RenderDebugSpriteOutline(sprite.GetWorldTransform(), sprite.GetSize() * sprite.GetWorldScale(), sprite.GetAnchor());
 		}
 #endif
 	}
@@ -184,84 +265,45 @@ namespace GameDev2D
 
 	void SpriteRenderer::RenderSpriteFont(SpriteFont& spriteFont)
 	{
+		//The characters are laid out in local space by the SpriteFont, they only have to be moved into world space
+		const std::vector<SpriteFont::GlyphQuad>& glyphQuads = spriteFont.GetGlyphQuads();
+
 		//Is there any text to render?
-		if (spriteFont.GetText().length() == 0)
+		if (glyphQuads.empty())
 		{
 			return;
 		}
 
-		//calculate the baseline and origin for the label
-		unsigned int baseline = spriteFont.GetFont()->GetLineHeight() - spriteFont.GetFont()->GetBaseline();
-		unsigned int numberOfLines = Text::NumberOfLines(spriteFont.GetText());
-		Vector2 origin = Vector2(0.0f, 0.0f);
-		Vector2 position = Vector2(0.0f, 0.0f);
-		position.y += baseline + (spriteFont.GetFont()->GetLineHeight() * (numberOfLines - 1));
-		int lineIndex = 0;
+		const Affine2D& parent = spriteFont.GetWorldTransform();
 
-		//What justification are we dealing with
-		if (spriteFont.GetJustification() == SpriteFont::Justification::Left)
-		{
-			position.x = 0.0f;
-		}
-		else if (spriteFont.GetJustification() == SpriteFont::Justification::Center)
-		{
-			position.x = (spriteFont.GetWidth() - spriteFont.GetLineWidth(lineIndex)) * 0.5f;
-		}
-		else if (spriteFont.GetJustification() == SpriteFont::Justification::Right)
-		{
-			position.x = spriteFont.GetWidth() - spriteFont.GetLineWidth(lineIndex);
-		}
+		//Distance field fonts are drawn at any size from the same texture, the shader rebuilds the glyph's edges
+		float distanceField = spriteFont.GetFont()->IsDistanceField() ? 1.0f : 0.0f;
 
-		//Cycle through the characters in the text label
-		for (unsigned int i = 0; i < spriteFont.GetText().length(); i++)
+		for (const SpriteFont::GlyphQuad& quad : glyphQuads)
 		{
-			//Did we reach a new line?
-			if (spriteFont.GetText().at(i) == '\n')
+			if (IsBatchFull())
 			{
-				//Increment the line index
-				lineIndex++;
-
-				//Calculate the line's origin based on the justification
-				if (spriteFont.GetJustification() == SpriteFont::Justification::Left)
-				{
-					position.x = 0.0f;
-				}
-				else if (spriteFont.GetJustification() == SpriteFont::Justification::Center)
-				{
-					position.x = (spriteFont.GetWidth() - spriteFont.GetLineWidth(lineIndex)) * 0.5f;
-				}
-				else if (spriteFont.GetJustification() == SpriteFont::Justification::Right)
-				{
-					position.x = spriteFont.GetWidth() - spriteFont.GetLineWidth(lineIndex);
-				}
-
-				//Set the y line origin based on the line height of the font
-				position.y -= spriteFont.GetFont()->GetLineHeight();
-				continue;
+				FlushAndReset();
 			}
 
-			//Set the frame
-			GlyphData glyph = spriteFont.GetFont()->GetGlyph(spriteFont.GetText().at(i));
-			Rect characterRect = glyph.frame;
-			spriteFont.SetFrame(characterRect);
-			Vector2 uvs[4];
-			spriteFont.GetUVs(uvs);
+			Vector2 origin = parent * quad.origin;
+			Vector2 axisX = parent.TransformVector(quad.axisX);
+			Vector2 axisY = parent.TransformVector(quad.axisY);
 
-			//Rect characterRect = m_Font->GetTextureRectForCharacter();
-			Vector2 anchorOffset = Vector2(-spriteFont.GetWidth() * spriteFont.GetAnchor().x, -spriteFont.GetHeight() * spriteFont.GetAnchor().y);
-			Vector2 charPosition = position + anchorOffset;
-			charPosition.x += glyph.bearingX;
-			charPosition.y += glyph.bearingY - characterRect.size.y;
-
-			//Calculate the Matrix
-			Matrix parent = spriteFont.GetWorldTransform();
-			Matrix local = Matrix::Make(charPosition, spriteFont.GetCharacterData().at(i).angle, spriteFont.GetCharacterData().at(i).scale);
-
-			RenderTexture(spriteFont.GetTexture(), parent * local, uvs, characterRect.size, 1.0f, spriteFont.GetCharacterData().at(i).anchor, spriteFont.GetCharacterData().at(i).color);
+			TextureSlot textureSlot = GetTextureSlot(spriteFont.GetTexture());
+			WriteQuad(origin, axisX, axisY, quad.uvOrigin, quad.uvSize, quad.color, textureSlot, 1.0f, distanceField);
+		}
+	}
 
-			//Increment the position
-			position.x += glyph.advanceX + spriteFont.GetCharacterSpacing();
+	void SpriteRenderer::RenderTexturedQuad(Texture* texture, const Vector2& origin, const Vector2& axisX, const Vector2& axisY, const Vector2& uvOrigin, const Vector2& uvSize, const Color& color, bool distanceField)
+	{
+		if (IsBatchFull())
+		{
+			FlushAndReset();
 		}
+
+		TextureSlot textureSlot = GetTextureSlot(texture);
+		WriteQuad(origin, axisX, axisY, uvOrigin, uvSize, color, textureSlot, 1.0f, distanceField ? 1.0f : 0.0f);
 	}
 
 	void SpriteRenderer::EnableDebugSpriteOutline(bool enable)
@@ -274,59 +316,105 @@ namespace GameDev2D
 		return m_RenderSpriteOutline;
 	}
 
-	void SpriteRenderer::RenderQuad(const Matrix& transform, const Vector2& size, const Vector2& anchor, const Color& fillColor)
+	void SpriteRenderer::RenderDebugSpriteOutline(const Affine2D& transform, const Vector2& size, const Vector2& anchor)
+	{
+		RenderOutline(transform, size, anchor, kSpriteOutlineColor, kSpriteOutlineSize);
+		RenderAnchor(transform);
+	}
+
+	void SpriteRenderer::SetSubmission(SpriteSubmission submission)
+	{
+		m_Submission = submission;
+	}
+
+	SpriteSubmission SpriteRenderer::GetSubmission()
+	{
+		return m_Submission;
+	}
+
+	void SpriteRenderer::RenderQuad(const Affine2D& transform, const Vector2& size, const Vector2& anchor, const Color& fillColor)
 	{
-		if (m_QuadIndexCount + kQuadIndexCount >= kMaxIndices)
+		if (IsBatchFull())
 		{
 			FlushAndReset();
 		}
 
 		const Vector2 uvs[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-		const float textureIndex = 0.0f; // White Texture
+		const TextureSlot textureSlot; // White Texture
 		const float tilingFactor = 1.0f;
 
-		Vector2 offset;
-		for (unsigned int i = 0; i < kQuadVertexCount; i++)
-		{
-			offset = (m_QuadVertexPositions[i] * size) - Vector2(size.x * anchor.x, size.y * anchor.y);
-			m_QuadVertexBufferPtr->vertices = transform * offset;
-			m_QuadVertexBufferPtr->uv = uvs[i];
-			m_QuadVertexBufferPtr->color = fillColor;
-			m_QuadVertexBufferPtr->texureIndex = textureIndex;
-			m_QuadVertexBufferPtr->tilingFactor = tilingFactor;
-			m_QuadVertexBufferPtr++;
-		}
-
-		m_QuadIndexCount += kQuadIndexCount;
+		WriteQuad(transform, uvs, size, anchor, fillColor, textureSlot, tilingFactor);
 	}
 
-	void SpriteRenderer::RenderTexture(Texture* texture, const Matrix& transform, Vector2 uvs[4], const Vector2& size, float tilingFactor, const Vector2 anchor, const Color& tintColor)
+	void SpriteRenderer::RenderTexture(Texture* texture, const Affine2D& transform, Vector2 uvs[4], const Vector2& size, float tilingFactor, const Vector2 anchor, const Color& tintColor)
 	{
-		if (m_QuadIndexCount + kQuadIndexCount >= kMaxIndices)
+		if (IsBatchFull())
 		{
 			FlushAndReset();
 		}
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < m_TextureSlotIndex; i++)
+		TextureSlot textureSlot = GetTextureSlot(texture);
+		WriteQuad(transform, uvs, size, anchor, tintColor, textureSlot, tilingFactor);
+	}
+
+	SpriteRenderer::TextureSlot SpriteRenderer::GetTextureSlot(Texture* texture)
+	{
+		TextureSlot textureSlot;
+		unsigned int slot = 0;
+
+		//Every Texture in an array shares the array's slot, only the layer changes
+		TextureArray* textureArray = texture->GetArray();
+		if (textureArray != nullptr)
 		{
-			if (*m_TextureSlots[i] == *texture)
+			if (textureArray->GetBatchSlot(m_BatchGeneration, slot) == false)
 			{
-				textureIndex = (float)i;
-				break;
+				if (m_TextureArraySlotIndex >= MAX_TEXTURE_ARRAY_SLOTS)
+				{
+					FlushAndReset();
+				}
+
+				slot = m_TextureArraySlotIndex;
+				m_TextureArraySlots[m_TextureArraySlotIndex] = textureArray;
+				m_TextureArraySlotIndex++;
+				textureArray->SetBatchSlot(m_BatchGeneration, slot);
 			}
+
+			textureSlot.index = (float)(MAX_TEXTURE_SLOTS + slot);
+			textureSlot.layer = (float)texture->GetArrayLayer();
+			textureSlot.uvScale = texture->GetArrayUVScale();
+			return textureSlot;
 		}
 
-		if (textureIndex == 0.0f)
+		//The Texture remembers which slot it was given in this batch
+		if (texture->GetBatchSlot(m_BatchGeneration, slot) == false)
 		{
+			//All the slots are used, in the deferred render order the sprites are sorted by texture so this
+			//only happens once every MAX_TEXTURE_SLOTS - 1 textures
 			if (m_TextureSlotIndex >= MAX_TEXTURE_SLOTS)
 			{
 				FlushAndReset();
 			}
 
-			textureIndex = (float)m_TextureSlotIndex;
+			slot = m_TextureSlotIndex;
 			m_TextureSlots[m_TextureSlotIndex] = texture;
 			m_TextureSlotIndex++;
+			texture->SetBatchSlot(m_BatchGeneration, slot);
+		}
+
+		textureSlot.index = (float)slot;
+		return textureSlot;
+	}
+
+	void SpriteRenderer::WriteQuad(const Affine2D& transform, const Vector2* uvs, const Vector2& size, const Vector2& anchor, const Color& color, const TextureSlot& textureSlot, float tilingFactor)
+	{
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			//Only the anchored corner goes through the transform, the edges are its scaled x and y axes
+			Vector2 origin = transform * Vector2(-size.x * anchor.x, -size.y * anchor.y);
+			Vector2 axisX(transform.m[0][0] * size.x, transform.m[0][1] * size.x);
+			Vector2 axisY(transform.m[1][0] * size.y, transform.m[1][1] * size.y);
+			WriteQuad(origin, axisX, axisY, uvs[0], uvs[2] - uvs[0], color, textureSlot, tilingFactor, 0.0f);
+			return;
 		}
 
 		Vector2 offset;
@@ -334,17 +422,84 @@ namespace GameDev2D
 		{
 			offset = (m_QuadVertexPositions[i] * size) - Vector2(size.x * anchor.x, size.y * anchor.y);
 			m_QuadVertexBufferPtr->vertices = transform * offset;
-			m_QuadVertexBufferPtr->uv = uvs[i];
-			m_QuadVertexBufferPtr->color = tintColor;
-			m_QuadVertexBufferPtr->texureIndex = textureIndex;
+			m_QuadVertexBufferPtr->uv = uvs[i] * textureSlot.uvScale;
+			m_QuadVertexBufferPtr->color = color;
+			m_QuadVertexBufferPtr->texureIndex = textureSlot.index;
+			m_QuadVertexBufferPtr->textureLayer = textureSlot.layer;
 			m_QuadVertexBufferPtr->tilingFactor = tilingFactor;
+			m_QuadVertexBufferPtr->distanceField = 0.0f;
 			m_QuadVertexBufferPtr++;
 		}
 
 		m_QuadIndexCount += kQuadIndexCount;
 	}
 
-	void SpriteRenderer::RenderOutline(const Matrix& transform, const Vector2& size, const Vector2& anchor, const Color& outlineColor, float outlineSize)
+	void SpriteRenderer::WriteQuad(const Vector2& origin, const Vector2& axisX, const Vector2& axisY, const Vector2& uvOrigin, const Vector2& uvSize, const Color& color, const TextureSlot& textureSlot, float tilingFactor, float distanceField)
+	{
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			m_QuadInstanceBufferPtr->origin = origin;
+			m_QuadInstanceBufferPtr->axisX = axisX;
+			m_QuadInstanceBufferPtr->axisY = axisY;
+			m_QuadInstanceBufferPtr->uvOrigin = uvOrigin * textureSlot.uvScale;
+			m_QuadInstanceBufferPtr->uvSize = uvSize * textureSlot.uvScale;
+			m_QuadInstanceBufferPtr->color = color;
+			m_QuadInstanceBufferPtr->texureIndex = textureSlot.index;
+			m_QuadInstanceBufferPtr->textureLayer = textureSlot.layer;
+			m_QuadInstanceBufferPtr->tilingFactor = tilingFactor;
+			m_QuadInstanceBufferPtr->distanceField = distanceField;
+			m_QuadInstanceBufferPtr++;
+
+			m_QuadInstanceCount++;
+			return;
+		}
+
+		//Same corner order as m_QuadVertexPositions
+		const Vector2 vertices[] = { origin, origin + axisX, origin + axisX + axisY, origin + axisY };
+		for (unsigned int i = 0; i < kQuadVertexCount; i++)
+		{
+			m_QuadVertexBufferPtr->vertices = vertices[i];
+			m_QuadVertexBufferPtr->uv = (uvOrigin + m_QuadVertexPositions[i] * uvSize) * textureSlot.uvScale;
+			m_QuadVertexBufferPtr->color = color;
+			m_QuadVertexBufferPtr->texureIndex = textureSlot.index;
+			m_QuadVertexBufferPtr->textureLayer = textureSlot.layer;
+			m_QuadVertexBufferPtr->tilingFactor = tilingFactor;
+			m_QuadVertexBufferPtr->distanceField = distanceField;
+			m_QuadVertexBufferPtr++;
+		}
+
+		m_QuadIndexCount += kQuadIndexCount;
+	}
+
+	bool SpriteRenderer::IsBatchFull()
+	{
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			return m_QuadInstanceCount >= kMaxQuads || m_QuadInstanceBufferPtr >= m_QuadInstanceBufferEnd;
+		}
+
+		return m_QuadIndexCount + kQuadIndexCount >= kMaxIndices || m_QuadVertexBufferPtr + kQuadVertexCount > m_QuadVertexBufferEnd;
+	}
+
+	void SpriteRenderer::BeginBatch(unsigned int minimumSize)
+	{
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			m_QuadInstanceCount = 0;
+			m_QuadInstanceBufferBase = (QuadInstance*)m_QuadInstanceBuffer->Begin(minimumSize);
+			m_QuadInstanceBufferPtr = m_QuadInstanceBufferBase;
+			m_QuadInstanceBufferEnd = m_QuadInstanceBufferBase + m_QuadInstanceBuffer->GetAvailableSize() / sizeof(QuadInstance);
+		}
+		else
+		{
+			m_QuadIndexCount = 0;
+			m_QuadVertexBufferBase = (QuadVertex*)m_QuadVertexBuffer->Begin(minimumSize);
+			m_QuadVertexBufferPtr = m_QuadVertexBufferBase;
+			m_QuadVertexBufferEnd = m_QuadVertexBufferBase + m_QuadVertexBuffer->GetAvailableSize() / sizeof(QuadVertex);
+		}
+	}
+
+	void SpriteRenderer::RenderOutline(const Affine2D& transform, const Vector2& size, const Vector2& anchor, const Color& outlineColor, float outlineSize)
 	{
 		Vector2 quadCorners[4];
 		Math::CalculateCorners(transform, anchor, size, quadCorners);
@@ -360,9 +515,7 @@ namespace GameDev2D
 			Vector2 leftEdgeMidpoint = LineSegment(quadCorners[Math::BottomLeftCorner], quadCorners[Math::TopLeftCorner]).Midpoint();
 			Vector2 direction = Vector2(quadMidpoint - leftEdgeMidpoint).Normalized();
 			Vector2 leftOutlinePosition = leftEdgeMidpoint - direction * (outlineSize * 0.5f);
-			Matrix translationMatrix = Matrix::MakeTranslation(leftOutlinePosition);
-			Matrix rotationMatrix = Matrix::MakeRotation(quadRadians);
-			Matrix transform = translationMatrix * rotationMatrix;
+			Affine2D transform = Affine2D::Make(leftOutlinePosition, quadRadians);
 			RenderQuad(transform, verticalSize, outlineAnchor, outlineColor);
 		}
 
@@ -371,9 +524,7 @@ namespace GameDev2D
 			Vector2 rightEdgeMidpoint = LineSegment(quadCorners[Math::BottomRightCorner], quadCorners[Math::TopRightCorner]).Midpoint();
 			Vector2 direction = Vector2(quadMidpoint - rightEdgeMidpoint).Normalized();
 			Vector2 rightOutlinePosition = rightEdgeMidpoint - direction * (outlineSize * 0.5f);
-			Matrix translationMatrix = Matrix::MakeTranslation(rightOutlinePosition);
-			Matrix rotationMatrix = Matrix::MakeRotation(quadRadians);
-			Matrix transform = translationMatrix * rotationMatrix;
+			Affine2D transform = Affine2D::Make(rightOutlinePosition, quadRadians);
 			RenderQuad(transform, verticalSize, outlineAnchor, outlineColor);
 		}
 
@@ -382,9 +533,7 @@ namespace GameDev2D
 			Vector2 topEdgeMidpoint = LineSegment(quadCorners[Math::TopLeftCorner], quadCorners[Math::TopRightCorner]).Midpoint();
 			Vector2 direction = Vector2(quadMidpoint - topEdgeMidpoint).Normalized();
 			Vector2 topOutlinePosition = topEdgeMidpoint - direction * (outlineSize * 0.5f);
-			Matrix translationMatrix = Matrix::MakeTranslation(topOutlinePosition);
-			Matrix rotationMatrix = Matrix::MakeRotation(quadRadians);
-			Matrix transform = translationMatrix * rotationMatrix;
+			Affine2D transform = Affine2D::Make(topOutlinePosition, quadRadians);
 			RenderQuad(transform, horizontalSize, outlineAnchor, outlineColor);
 		}
 
@@ -393,26 +542,46 @@ namespace GameDev2D
 			Vector2 bottomEdgeMidpoint = LineSegment(quadCorners[Math::BottomLeftCorner], quadCorners[Math::BottomRightCorner]).Midpoint();
 			Vector2 direction = Vector2(quadMidpoint - bottomEdgeMidpoint).Normalized();
 			Vector2 bottomOutlinePosition = bottomEdgeMidpoint - direction * (outlineSize * 0.5f);
-			Matrix translationMatrix = Matrix::MakeTranslation(bottomOutlinePosition);
-			Matrix rotationMatrix = Matrix::MakeRotation(quadRadians);
-			Matrix transform = translationMatrix * rotationMatrix;
+			Affine2D transform = Affine2D::Make(bottomOutlinePosition, quadRadians);
 			RenderQuad(transform, horizontalSize, outlineAnchor, outlineColor);
 		}
 
 	}
 
-	void SpriteRenderer::RenderAnchor(const Matrix& transform)
+	void SpriteRenderer::RenderAnchor(const Affine2D& transform)
 	{
 		RenderQuad(transform, Vector2(kAnchorSize.x, kAnchorSize.y), Vector2(0.0f, 0.0f), kAnchorColor);
 		RenderQuad(transform, Vector2(kAnchorSize.y, kAnchorSize.x), Vector2(0.0f, 0.0f), kAnchorColor);
 	}
 
+	void SpriteRenderer::NewFrame()
+	{
+		IRenderer::NewFrame();
+		m_QuadVertexBuffer->NextRegion();
+		m_QuadInstanceBuffer->NextRegion();
+	}
+
 	void SpriteRenderer::FlushAndReset()
 	{
 		EndScene();
 
-		m_QuadIndexCount = 0;
-		m_QuadVertexBufferPtr = m_QuadVertexBufferBase;
+		//The batch is full, so start the next one at the beginning of a region
+		if (m_Submission == SpriteSubmission::Instanced)
+		{
+			BeginBatch(kMaxQuads * sizeof(QuadInstance));
+		}
+		else
+		{
+			BeginBatch(kMaxVertices * sizeof(QuadVertex));
+		}
+		ResetTextureSlots();
+	}
+
+	void SpriteRenderer::ResetTextureSlots()
+	{
+		//A new generation invalidates every Texture's slot stamp at once
 		m_TextureSlotIndex = 1;
+		m_TextureArraySlotIndex = 0;
+		m_BatchGeneration = ++s_LastBatchGeneration;
 	}
 }
\ No newline at end of file
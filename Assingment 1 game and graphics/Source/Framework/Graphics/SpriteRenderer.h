@@ -8,27 +8,39 @@
 #include "VertexArray.h"
 #include "../Math/Vector2.h"
 #include "../Math/Matrix.h"
+#include "../Math/Affine2D.h"
 #include <array>
 
 
 namespace GameDev2D
 {
-	class Camera;
+	class Graphics;
+	template<typename T> class ResourceCache;
 	class Sprite;
 	class SpriteFont;
 	class Texture;
+	class TextureArray;
 
-	const unsigned int MAX_TEXTURE_SLOTS = 32;
+	//The 32 texture units are split between textures and texture arrays, the arrays use the units after the textures
+	const unsigned int MAX_TEXTURE_SLOTS = 24;
+	const unsigned int MAX_TEXTURE_ARRAY_SLOTS = 8;
+
+	//PerVertex transforms the four corners of every quad on the CPU and uploads four vertices. Instanced uploads a
+	//single record per quad (its 2x3 transform, uv rect, color, texture index and tiling) that the vertex shader expands
+	enum class SpriteSubmission
+	{
+		PerVertex = 0,
+		Instanced
+	};
 
 	class SpriteRenderer : public IRenderer
 	{
 	public:
-		SpriteRenderer();
-		~SpriteRenderer();
+		SpriteRenderer(Graphics& graphics, ResourceCache<Shader>& shaderCache);
 
 		RendererType GetType() override;
 
-		void BeginScene(Camera* camera) override;
+		void BeginScene(const Matrix& viewProjection, const Viewport& viewport) override;
 		void EndScene() override;
 
 		void RenderQuad(const Vector2& position, const Vector2& size, const Vector2& anchor, const Color& fillColor);
@@ -43,19 +55,49 @@ namespace GameDev2D
 		void RenderSpriteFont(SpriteFont* spriteFont);
 		void RenderSpriteFont(SpriteFont& spriteFont);
 
+		//Renders a textured quad that's already in world space, its corners are origin, origin + axisX, origin + axisY
+		//and origin + axisX + axisY. Sprites and sprite fonts are recorded this way when they're drawn on the render thread
+		void RenderTexturedQuad(Texture* texture, const Vector2& origin, const Vector2& axisX, const Vector2& axisY, const Vector2& uvOrigin, const Vector2& uvSize, const Color& color, bool distanceField);
+
 		void EnableDebugSpriteOutline(bool enable);
 		bool IsDebugSpriteOutlineEnabled();
 
+		//Renders the outline and anchor RenderSprite() adds to a sprite when the debug outline is enabled, the size is
+		//the sprite's size times its world scale. Sprites copied into a frame snapshot have theirs recorded separately
+		void RenderDebugSpriteOutline(const Affine2D& transform, const Vector2& size, const Vector2& anchor);
+
+		//Should be set outside of BeginScene() and EndScene()
+		void SetSubmission(SpriteSubmission submission);
+		SpriteSubmission GetSubmission();
+
 	protected:
 		friend class BatchRenderer;
 		void Flush() override;
 		void FlushAndReset() override;
+		void NewFrame() override;
 
 	private:
-		void RenderQuad(const Matrix& transform, const Vector2& size, const Vector2& anchor, const Color& fillColor);
-		void RenderTexture(Texture* texture, const Matrix& transform, Vector2 uvs[4], const Vector2& size, float tilingFactor, const Vector2 anchor, const Color& tintColor);
-		void RenderOutline(const Matrix& transform, const Vector2& size, const Vector2& anchor, const Color& outlineColor, float outlineSize);
-		void RenderAnchor(const Matrix& transform);
+		void RenderQuad(const Affine2D& transform, const Vector2& size, const Vector2& anchor, const Color& fillColor);
+		void RenderTexture(Texture* texture, const Affine2D& transform, Vector2 uvs[4], const Vector2& size, float tilingFactor, const Vector2 anchor, const Color& tintColor);
+		void RenderOutline(const Affine2D& transform, const Vector2& size, const Vector2& anchor, const Color& outlineColor, float outlineSize);
+		void RenderAnchor(const Affine2D& transform);
+
+		//The texture unit a quad samples from, the layer if the unit holds a texture array, and the part of the layer the texture covers
+		struct TextureSlot
+		{
+			TextureSlot() : index(0.0f), layer(0.0f), uvScale(1.0f, 1.0f) {}
+
+			float index;
+			float layer;
+			Vector2 uvScale;
+		};
+
+		void WriteQuad(const Affine2D& transform, const Vector2* uvs, const Vector2& size, const Vector2& anchor, const Color& color, const TextureSlot& textureSlot, float tilingFactor);
+		void WriteQuad(const Vector2& origin, const Vector2& axisX, const Vector2& axisY, const Vector2& uvOrigin, const Vector2& uvSize, const Color& color, const TextureSlot& textureSlot, float tilingFactor, float distanceField);
+		TextureSlot GetTextureSlot(Texture* texture);
+		bool IsBatchFull();
+		void BeginBatch(unsigned int minimumSize);
+		void ResetTextureSlots();
 
 		struct QuadVertex
 		{
@@ -63,18 +105,51 @@ namespace GameDev2D
 			Vector2 uv;
 			Color color;
 			float texureIndex;
+			float textureLayer;
+			float tilingFactor;
+			float distanceField;
+		};
+
+		//The quad's corners are origin, origin + axisX, origin + axisY and origin + axisX + axisY
+		struct QuadInstance
+		{
+			Vector2 origin;
+			Vector2 axisX;
+			Vector2 axisY;
+			Vector2 uvOrigin;
+			Vector2 uvSize;
+			Color color;
+			float texureIndex;
+			float textureLayer;
 			float tilingFactor;
+			float distanceField;
 		};
 
+		Graphics& m_Graphics;
 		std::shared_ptr<VertexArray> m_QuadVertexArray;
-		std::shared_ptr<VertexBuffer> m_QuadVertexBuffer;
+		std::shared_ptr<StreamingVertexBuffer> m_QuadVertexBuffer;
+		std::shared_ptr<VertexArray> m_InstanceVertexArray;
+		std::shared_ptr<VertexBuffer> m_InstanceCornerBuffer;
+		std::shared_ptr<StreamingVertexBuffer> m_QuadInstanceBuffer;
+		std::shared_ptr<Shader> m_InstanceShader;
+		ShaderUniform<Matrix> m_InstanceViewProjectionUniform;
+		SpriteSubmission m_Submission;
+		unsigned int m_QuadInstanceCount;
+		QuadInstance* m_QuadInstanceBufferBase;
+		QuadInstance* m_QuadInstanceBufferPtr;
+		QuadInstance* m_QuadInstanceBufferEnd;
 		std::shared_ptr<Shader> m_TextureShader;
+		ShaderUniform<Matrix> m_ViewProjectionUniform;
 		std::shared_ptr<Texture> m_WhiteTexture;
 		std::array<Texture*, MAX_TEXTURE_SLOTS> m_TextureSlots;
 		unsigned int m_TextureSlotIndex;
+		std::array<TextureArray*, MAX_TEXTURE_ARRAY_SLOTS> m_TextureArraySlots;
+		unsigned int m_TextureArraySlotIndex;
+		unsigned int m_BatchGeneration;
 		unsigned int m_QuadIndexCount;
 		QuadVertex* m_QuadVertexBufferBase;
 		QuadVertex* m_QuadVertexBufferPtr;
+		QuadVertex* m_QuadVertexBufferEnd;
 		Vector2 m_QuadVertexPositions[4];
 		bool m_RenderSpriteOutline;
 
@@ -1,30 +1,43 @@
 #include "Texture.h"
-#include "../Application/Application.h"
+#include "TextureArray.h"
+#include "Graphics.h"
 
 
 namespace GameDev2D
 {
-    Texture::Texture(const ImageData& imageData) :
+    Texture::Texture(Graphics& graphics, const ImageData& imageData) :
+        m_Graphics(graphics),
         m_Format(imageData.format),
         m_Wrap(WrapMode::ClampToEdge, WrapMode::ClampToEdge),
+        m_MinFilter(TextureMinFilter::Linear),
+        m_MagFilter(TextureMagFilter::Nearest),
         m_Width(imageData.width),
         m_Height(imageData.height),
-        m_ID(0)
+        m_ID(0),
+        m_BatchGeneration(0),
+        m_BatchSlot(0),
+        m_Array(nullptr),
+        m_ArrayLayer(0)
     {
-        Application::Get().GetGraphics().CreateTexture(&m_ID);
-        Application::Get().GetGraphics().SetTextureStorage(m_ID, m_Width, m_Height, m_Format);
-        Application::Get().GetGraphics().SetTextureFilter(m_ID, TextureMinFilter::Linear, TextureMagFilter::Nearest);
-        Application::Get().GetGraphics().SetTextureWrap(m_ID, m_Wrap);
+        m_Graphics.CreateTexture(&m_ID);
+        m_Graphics.SetTextureStorage(m_ID, m_Width, m_Height, m_Format);
+        m_Graphics.SetTextureFilter(m_ID, m_MinFilter, m_MagFilter);
+        m_Graphics.SetTextureWrap(m_ID, m_Wrap);
 
         if (imageData.data.size() > 0)
         {
-            Application::Get().GetGraphics().SetTextureData(m_ID, imageData);
+            m_Graphics.SetTextureData(m_ID, imageData);
         }
     }
 
     Texture::~Texture()
     {
-        Application::Get().GetGraphics().DeleteTexture(&m_ID);
+        RemoveFromArray(false);
+
+        if (m_ID != 0)
+        {
+            m_Graphics.DeleteTexture(&m_ID);
+        }
     }
 
     unsigned int Texture::GetWidth()
@@ -51,7 +64,18 @@ namespace GameDev2D
     {
         m_Wrap.s = wrapModeS;
         m_Wrap.t = wrapModeT;
-        Application::Get().GetGraphics().SetTextureWrap(m_ID, m_Wrap);
+
+        //Texture arrays always clamp to the edge
+        if (m_Wrap.s != WrapMode::ClampToEdge || m_Wrap.t != WrapMode::ClampToEdge)
+        {
+            RemoveFromArray(true);
+        }
+
+        //A Texture in an array has no texture of its own, it gets the wrap when it leaves the array
+        if (m_ID != 0)
+        {
+            m_Graphics.SetTextureWrap(m_ID, m_Wrap);
+        }
     }
 
     void Texture::SetWrap(Wrap wrap)
@@ -64,27 +88,131 @@ namespace GameDev2D
         return m_Wrap;
     }
 
+    void Texture::SetFilter(TextureMinFilter minFilter, TextureMagFilter magFilter)
+    {
+        if (minFilter != m_MinFilter || magFilter != m_MagFilter)
+        {
+            RemoveFromArray(true);
+        }
+
+        m_MinFilter = minFilter;
+        m_MagFilter = magFilter;
+        if (m_ID != 0)
+        {
+            m_Graphics.SetTextureFilter(m_ID, m_MinFilter, m_MagFilter);
+        }
+    }
+
     void Texture::SetData(const ImageData& imageData)
     {
-        //The Texture id can't be zero
-        assert(m_ID != 0);
+        //The array's copy would be out of date, the Texture gets a texture of its own again without copying it back
+        RemoveFromArray(false);
+        if (m_ID == 0)
+        {
+            m_Graphics.CreateTexture(&m_ID);
+            m_Graphics.SetTextureWrap(m_ID, m_Wrap);
+        }
 
         m_Width = imageData.width;
         m_Height = imageData.height;
         m_Format = imageData.format;
 
-        Application::Get().GetGraphics().SetTextureStorage(m_ID, m_Width, m_Height, m_Format);
-        Application::Get().GetGraphics().SetTextureFilter(m_ID, TextureMinFilter::Linear, TextureMagFilter::Nearest);
-        Application::Get().GetGraphics().SetTextureData(m_ID, imageData);
+        m_Graphics.SetTextureStorage(m_ID, m_Width, m_Height, m_Format);
+        m_Graphics.SetTextureFilter(m_ID, m_MinFilter, m_MagFilter);
+        m_Graphics.SetTextureData(m_ID, imageData);
     }
 
     void Texture::Bind(unsigned int slot)
     {
-        Application::Get().GetGraphics().BindTextureUnit(m_ID, slot);
+        m_Graphics.BindTextureUnit(m_ID, slot);
     }
 
     bool Texture::operator==(const Texture& texture) const
     {
-        return m_ID == texture.m_ID;
+        //Every Texture in an array has an id of zero, but no two Textures share a texture
+        return this == &texture;
+    }
+
+    bool Texture::GetBatchSlot(unsigned int generation, unsigned int& slot) const
+    {
+        if (m_BatchGeneration != generation)
+        {
+            return false;
+        }
+
+        slot = m_BatchSlot;
+        return true;
+    }
+
+    void Texture::SetBatchSlot(unsigned int generation, unsigned int slot)
+    {
+        m_BatchGeneration = generation;
+        m_BatchSlot = slot;
+    }
+
+    void Texture::SetArrayLayer(TextureArray* textureArray, unsigned int layer)
+    {
+        if (textureArray == nullptr)
+        {
+            RemoveFromArray(true);
+            return;
+        }
+
+        m_Array = textureArray;
+        m_ArrayLayer = layer;
+
+        //The layer holds the only copy, keeping the Texture's own texture as well would double its memory
+        if (m_ID != 0)
+        {
+            m_Graphics.DeleteTexture(&m_ID);
+            m_ID = 0;
+        }
+    }
+
+    TextureArray* Texture::GetArray()
+    {
+        return m_Array;
+    }
+
+    unsigned int Texture::GetArrayLayer()
+    {
+        return m_ArrayLayer;
+    }
+
+    Vector2 Texture::GetArrayUVScale()
+    {
+        if (m_Array == nullptr)
+        {
+            return Vector2(1.0f, 1.0f);
+        }
+
+        return Vector2((float)m_Width / (float)m_Array->GetWidth(), (float)m_Height / (float)m_Array->GetHeight());
+    }
+
+    unsigned int Texture::GetBatchId()
+    {
+        return m_Array != nullptr ? m_Array->GetId() : m_ID;
+    }
+
+    void Texture::RemoveFromArray(bool copyContents)
+    {
+        if (m_Array == nullptr)
+        {
+            return;
+        }
+
+        if (copyContents)
+        {
+            Graphics& graphics = m_Graphics;
+            graphics.CreateTexture(&m_ID);
+            graphics.SetTextureStorage(m_ID, m_Width, m_Height, m_Format);
+            graphics.SetTextureFilter(m_ID, m_MinFilter, m_MagFilter);
+            graphics.SetTextureWrap(m_ID, m_Wrap);
+            graphics.CopyTextureArrayToTexture(m_Array->GetId(), m_ArrayLayer, m_Width, m_Height, m_ID);
+        }
+
+        m_Array->RemoveTexture(m_ArrayLayer);
+        m_Array = nullptr;
+        m_ArrayLayer = 0;
     }
 }
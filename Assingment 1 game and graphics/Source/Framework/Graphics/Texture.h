@@ -1,15 +1,19 @@
 #pragma once
 
 #include "GraphicTypes.h"
+#include "../Math/Vector2.h"
 
 
 namespace GameDev2D
 {
+    class Graphics;
+    class TextureArray;
+
     class Texture
     {
     public:
         //Creates a Texture object using the image data
-        Texture(const ImageData& imageData);
+        Texture(Graphics& graphics, const ImageData& imageData);
         Texture() = delete;
 
         //Prevent Texture from being copied
@@ -22,7 +26,7 @@ namespace GameDev2D
         unsigned int GetWidth();
         unsigned int GetHeight();
         
-        //Returns the id of the texture
+        //Returns the id of the texture, zero while the Texture is in a TextureArray
         unsigned int GetId();
 
         //Returns the Texture's PixelFormat
@@ -35,6 +39,9 @@ namespace GameDev2D
         //Returns the wrap mode of the Sprite
         Wrap GetWrap();
 
+        //Sets the filters used when the Texture is scaled down and up
+        void SetFilter(TextureMinFilter minFilter, TextureMagFilter magFilter);
+
         //Set (or update) the contents of the Texture
         void SetData(const ImageData& imageData);
 
@@ -43,12 +50,40 @@ namespace GameDev2D
 
         bool operator==(const Texture& texture) const;
 
+        //Used by SpriteRenderer to find the Texture's slot in the current batch without searching, the slot is
+        //only valid while the batch generation matches. Returns false if the Texture isn't in that batch
+        bool GetBatchSlot(unsigned int generation, unsigned int& slot) const;
+        void SetBatchSlot(unsigned int generation, unsigned int slot);
+
+        //Set once the Texture is copied into a TextureArray, its own texture is deleted since the layer holds the only
+        //copy it needs. Changing its data, or a wrap or filter the array doesn't share, takes it back out of the array
+        //and gives it a texture of its own again. Setting a null array copies the layer back out before it's freed
+        void SetArrayLayer(TextureArray* textureArray, unsigned int layer);
+
+        //Returns the TextureArray the Texture is in (or nullptr), its layer and the part of the layer the Texture covers
+        TextureArray* GetArray();
+        unsigned int GetArrayLayer();
+        Vector2 GetArrayUVScale();
+
+        //Returns the id of the texture sprites using this Texture are drawn from, the array's id if it is in one
+        unsigned int GetBatchId();
+
     private:
+        //Frees the Texture's layer, copyContents copies the layer into a new texture of its own first
+        void RemoveFromArray(bool copyContents);
+
         //Member variables
+        Graphics& m_Graphics;
         PixelFormat m_Format;
         Wrap m_Wrap;
+        TextureMinFilter m_MinFilter;
+        TextureMagFilter m_MagFilter;
         unsigned int m_Width;
         unsigned int m_Height;
         unsigned int m_ID;
+        unsigned int m_BatchGeneration;
+        unsigned int m_BatchSlot;
+        TextureArray* m_Array;
+        unsigned int m_ArrayLayer;
     };
 }
@@ -0,0 +1,203 @@
+#include "TextureArray.h"
+#include "Texture.h"
+#include "Graphics.h"
+
+
+namespace GameDev2D
+{
+    TextureArray::TextureArray(Graphics& graphics, unsigned int width, unsigned int height, PixelFormat format) :
+        m_Graphics(graphics),
+        m_Layers(),
+        m_Format(format),
+        m_Width(width),
+        m_Height(height),
+        m_Capacity(0),
+        m_Count(0),
+        m_ID(0),
+        m_BatchGeneration(0),
+        m_BatchSlot(0)
+    {
+    }
+
+    TextureArray::~TextureArray()
+    {
+        //The Textures still in the array are copied back out, to be drawn on their own
+        for (size_t i = 0; i < m_Layers.size(); i++)
+        {
+            if (m_Layers[i] != nullptr)
+            {
+                m_Layers[i]->SetArrayLayer(nullptr, 0);
+            }
+        }
+
+        if (m_ID != 0)
+        {
+            m_Graphics.DeleteTexture(&m_ID);
+        }
+    }
+
+    bool TextureArray::AddTexture(Texture* texture, unsigned int& layer)
+    {
+        unsigned int width = texture->GetWidth();
+        unsigned int height = texture->GetHeight();
+        PixelFormat format = texture->GetPixelFormat();
+        if (width > m_Width || height > m_Height || format.layout != m_Format.layout || format.size != m_Format.size)
+        {
+            return false;
+        }
+
+        //Reuse a layer that was freed before adding a new one
+        layer = 0;
+        while (layer < m_Layers.size() && m_Layers[layer] != nullptr)
+        {
+            layer++;
+        }
+
+        if (layer == m_Layers.size())
+        {
+            if (layer == m_Capacity)
+            {
+                if (m_Capacity == kMaxLayers)
+                {
+                    return false;
+                }
+
+                Grow();
+            }
+
+            m_Layers.push_back(nullptr);
+        }
+
+        Graphics& graphics = m_Graphics;
+        graphics.CopyTextureToTextureArray(texture->GetId(), 0, 0, width, height, m_ID, layer, 0, 0);
+
+        //Linear filtering at the Texture's right and top edges samples the texels past them, repeating the
+        //edge texels there keeps them from blending with whatever was left in the layer
+        if (width < m_Width)
+        {
+            graphics.CopyTextureToTextureArray(texture->GetId(), width - 1, 0, 1, height, m_ID, layer, width, 0);
+        }
+
+        if (height < m_Height)
+        {
+            graphics.CopyTextureToTextureArray(texture->GetId(), 0, height - 1, width, 1, m_ID, layer, 0, height);
+        }
+
+        if (width < m_Width && height < m_Height)
+        {
+            graphics.CopyTextureToTextureArray(texture->GetId(), width - 1, height - 1, 1, 1, m_ID, layer, width, height);
+        }
+
+        m_Layers[layer] = texture;
+        m_Count++;
+        return true;
+    }
+
+    void TextureArray::RemoveTexture(unsigned int layer)
+    {
+        if (layer < m_Layers.size() && m_Layers[layer] != nullptr)
+        {
+            m_Layers[layer] = nullptr;
+            m_Count--;
+        }
+    }
+
+    unsigned int TextureArray::GetWidth()
+    {
+        return m_Width;
+    }
+
+    unsigned int TextureArray::GetHeight()
+    {
+        return m_Height;
+    }
+
+    unsigned int TextureArray::GetId()
+    {
+        return m_ID;
+    }
+
+    PixelFormat TextureArray::GetPixelFormat()
+    {
+        return m_Format;
+    }
+
+    unsigned int TextureArray::GetLayerCount()
+    {
+        return m_Count;
+    }
+
+    unsigned int TextureArray::GetLayerCapacity()
+    {
+        return m_Capacity;
+    }
+
+    unsigned long long TextureArray::GetMemoryUsage()
+    {
+        unsigned long long bytesPerPixel = m_Format.layout == PixelLayout::RGBA ? 4 : 3;
+        return (unsigned long long)m_Width * m_Height * m_Capacity * bytesPerPixel;
+    }
+
+    unsigned long long TextureArray::GetUsedMemory()
+    {
+        unsigned long long bytesPerPixel = m_Format.layout == PixelLayout::RGBA ? 4 : 3;
+        unsigned long long pixels = 0;
+        for (size_t i = 0; i < m_Layers.size(); i++)
+        {
+            if (m_Layers[i] != nullptr)
+            {
+                pixels += (unsigned long long)m_Layers[i]->GetWidth() * m_Layers[i]->GetHeight();
+            }
+        }
+        return pixels * bytesPerPixel;
+    }
+
+    void TextureArray::Bind(unsigned int slot)
+    {
+        m_Graphics.BindTextureUnit(m_ID, slot);
+    }
+
+    bool TextureArray::GetBatchSlot(unsigned int generation, unsigned int& slot) const
+    {
+        if (m_BatchGeneration != generation)
+        {
+            return false;
+        }
+
+        slot = m_BatchSlot;
+        return true;
+    }
+
+    void TextureArray::SetBatchSlot(unsigned int generation, unsigned int slot)
+    {
+        m_BatchGeneration = generation;
+        m_BatchSlot = slot;
+    }
+
+    void TextureArray::Grow()
+    {
+        //Texture storage can't be resized, so the layers are copied into a new array twice the size
+        unsigned int capacity = m_Capacity == 0 ? kInitialLayers : m_Capacity * 2;
+        if (capacity > kMaxLayers)
+        {
+            capacity = kMaxLayers;
+        }
+
+        Graphics& graphics = m_Graphics;
+
+        unsigned int id = 0;
+        graphics.CreateTextureArray(&id);
+        graphics.SetTextureArrayStorage(id, m_Width, m_Height, capacity, m_Format);
+        graphics.SetTextureFilter(id, TextureMinFilter::Linear, TextureMagFilter::Nearest);
+        graphics.SetTextureWrap(id, Wrap());
+
+        if (m_ID != 0)
+        {
+            graphics.CopyTextureArray(m_ID, id, m_Width, m_Height, (unsigned int)m_Layers.size());
+            graphics.DeleteTexture(&m_ID);
+        }
+
+        m_ID = id;
+        m_Capacity = capacity;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "GraphicTypes.h"
+#include <vector>
+
+
+namespace GameDev2D
+{
+    class Graphics;
+    class Texture;
+
+    //Holds same format Textures as the layers of one OpenGL texture array, so a sprite batch can draw from
+    //any of them while only using a single texture slot. Every layer is the same size, a Texture smaller
+    //than the layer is copied into the bottom left corner and only uses part of it
+    class TextureArray
+    {
+    public:
+        //Creates an empty TextureArray, the layers are allocated as Textures are added
+        TextureArray(Graphics& graphics, unsigned int width, unsigned int height, PixelFormat format);
+        TextureArray() = delete;
+
+        //Prevent TextureArray from being copied
+        TextureArray(TextureArray& aTextureArray) = delete;
+        TextureArray& operator=(const TextureArray&) = delete;
+
+        ~TextureArray();
+
+        //Copies the Texture into a free layer, the array's storage doubles when it runs out of layers. Returns
+        //false if the Texture doesn't fit in a layer or the array already has the maximum number of layers
+        bool AddTexture(Texture* texture, unsigned int& layer);
+
+        //Frees the layer, its contents are left in place until another Texture is added
+        void RemoveTexture(unsigned int layer);
+
+        //Returns the width and height of every layer
+        unsigned int GetWidth();
+        unsigned int GetHeight();
+
+        //Returns the id of the texture array
+        unsigned int GetId();
+
+        //Returns the TextureArray's PixelFormat
+        PixelFormat GetPixelFormat();
+
+        //Returns the number of layers used by Textures and the number of layers allocated
+        unsigned int GetLayerCount();
+        unsigned int GetLayerCapacity();
+
+        //Returns the size of the allocated layers in bytes, and how many of those bytes hold the Textures' pixels
+        unsigned long long GetMemoryUsage();
+        unsigned long long GetUsedMemory();
+
+        //Bind the texture array to the slot
+        void Bind(unsigned int slot = 0);
+
+        //Used by SpriteRenderer to find the TextureArray's slot in the current batch, same as a Texture's
+        bool GetBatchSlot(unsigned int generation, unsigned int& slot) const;
+        void SetBatchSlot(unsigned int generation, unsigned int slot);
+
+        //The largest number of layers a TextureArray will grow to
+        static const unsigned int kMaxLayers = 256;
+
+    private:
+        void Grow();
+
+        //Member variables
+        Graphics& m_Graphics;
+        std::vector<Texture*> m_Layers;
+        PixelFormat m_Format;
+        unsigned int m_Width;
+        unsigned int m_Height;
+        unsigned int m_Capacity;
+        unsigned int m_Count;
+        unsigned int m_ID;
+        unsigned int m_BatchGeneration;
+        unsigned int m_BatchSlot;
+
+        static const unsigned int kInitialLayers = 4;
+    };
+}
\ No newline at end of file
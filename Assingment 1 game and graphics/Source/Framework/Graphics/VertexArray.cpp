@@ -1,39 +1,39 @@
 #include "VertexArray.h"
 #include "Graphics.h"
-#include "../Application/Application.h"
 #include <assert.h>
 
 
 namespace GameDev2D
 {
-	VertexArray::VertexArray() :
+	VertexArray::VertexArray(Graphics& graphics) :
+		m_Graphics(graphics),
 		m_ID(0),
 		m_VertexBufferIndex(0)
 	{
-		Application::Get().GetGraphics().CreateVertexArray(&m_ID);
+		m_Graphics.CreateVertexArray(&m_ID);
 	}
 
 	VertexArray::~VertexArray()
 	{
-		Application::Get().GetGraphics().DeleteVertexArray(&m_ID);
+		m_Graphics.DeleteVertexArray(&m_ID);
 	}
 
 	void VertexArray::Bind()
 	{
-		Application::Get().GetGraphics().BindVertexArray(m_ID);
+		m_Graphics.BindVertexArray(m_ID);
 	}
 
 	void VertexArray::Unbind()
 	{
-		Application::Get().GetGraphics().BindVertexArray(0);
+		m_Graphics.BindVertexArray(0);
 	}
 
-	void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer> vertexBuffer)
+	void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer> vertexBuffer, unsigned int divisor)
 	{
 		//Vertex Buffer has no layout!
 		assert(vertexBuffer->GetLayout().GetElements().size());
 
-		Application::Get().GetGraphics().BindVertexArray(m_ID);
+		m_Graphics.BindVertexArray(m_ID);
 		vertexBuffer->Bind();
 
 		const auto& layout = vertexBuffer->GetLayout();
@@ -51,8 +51,12 @@ namespace GameDev2D
 			case ShaderDataType::Int4:
 			case ShaderDataType::Bool:
 			{
-				Application::Get().GetGraphics().EnableVertexAttributeArray(m_VertexBufferIndex);
-				Application::Get().GetGraphics().SetVertexAttributePointer(m_VertexBufferIndex, element, layout.GetStride(), (const void*)element.offset);
+				m_Graphics.EnableVertexAttributeArray(m_VertexBufferIndex);
+				m_Graphics.SetVertexAttributePointer(m_VertexBufferIndex, element, layout.GetStride(), (const void*)element.offset);
+				if (divisor > 0)
+				{
+					m_Graphics.SetVertexAttributeDivisor(m_VertexBufferIndex, divisor);
+				}
 				m_VertexBufferIndex++;
 				break;
 			}
@@ -62,9 +66,9 @@ namespace GameDev2D
 				unsigned char count = element.GetComponentCount();
 				for (unsigned char i = 0; i < count; i++)
 				{
-					Application::Get().GetGraphics().EnableVertexAttributeArray(m_VertexBufferIndex);
-					Application::Get().GetGraphics().SetVertexAttributePointer(m_VertexBufferIndex, element, layout.GetStride(), (const void*)(element.offset + sizeof(float) * count * i));
-					Application::Get().GetGraphics().SetVertexAttributeDivisor(m_VertexBufferIndex, 1);
+					m_Graphics.EnableVertexAttributeArray(m_VertexBufferIndex);
+					m_Graphics.SetVertexAttributePointer(m_VertexBufferIndex, element, layout.GetStride(), (const void*)(element.offset + sizeof(float) * count * i));
+					m_Graphics.SetVertexAttributeDivisor(m_VertexBufferIndex, 1);
 					m_VertexBufferIndex++;
 				}
 				break;
@@ -77,7 +81,7 @@ namespace GameDev2D
 
 	void VertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer> indexBuffer)
 	{
-		Application::Get().GetGraphics().BindVertexArray(m_ID);
+		m_Graphics.BindVertexArray(m_ID);
 		indexBuffer->Bind();
 		m_IndexBuffer = indexBuffer;
 	}
@@ -6,22 +6,26 @@
 
 namespace GameDev2D
 {
+	class Graphics;
+
 	class VertexArray
 	{
 	public:
-		VertexArray();
+		VertexArray(Graphics& graphics);
 		~VertexArray();
 
 		void Bind();
 		void Unbind();
 
-		void AddVertexBuffer(const std::shared_ptr<VertexBuffer> vertexBuffer);
+		//A divisor of 0 advances the buffer's attributes per vertex, a divisor of N advances them once every N instances
+		void AddVertexBuffer(const std::shared_ptr<VertexBuffer> vertexBuffer, unsigned int divisor = 0);
 		void SetIndexBuffer(const std::shared_ptr<IndexBuffer> indexBuffer);
 
 		const std::vector<std::shared_ptr<VertexBuffer>>& GetVertexBuffers() const;
 		const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const;
 
 	private:
+		Graphics& m_Graphics;
 		unsigned int m_ID;
 		unsigned int m_VertexBufferIndex;
 		std::vector<std::shared_ptr<VertexBuffer>> m_VertexBuffers;
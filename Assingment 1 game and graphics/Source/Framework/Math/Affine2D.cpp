@@ -0,0 +1,160 @@
+#include "Affine2D.h"
+#include "Math.h"
+#include <math.h>
+
+
+namespace GameDev2D
+{
+    Affine2D Affine2D::Identity()
+    {
+        return Affine2D();
+    }
+
+    Affine2D Affine2D::Make(const Vector2& aTranslation, float aRadians, const Vector2& aScale)
+    {
+        float c = cosf(aRadians);
+        float s = sinf(aRadians);
+
+        Affine2D affine;
+        affine.m[0][0] = c * aScale.x;   affine.m[1][0] = -s * aScale.y;  affine.m[2][0] = aTranslation.x;
+        affine.m[0][1] = s * aScale.x;   affine.m[1][1] = c * aScale.y;   affine.m[2][1] = aTranslation.y;
+        return affine;
+    }
+
+    Affine2D Affine2D::MakeTranslation(const Vector2& aTranslation)
+    {
+        Affine2D affine;
+        affine.SetTranslation(aTranslation);
+        return affine;
+    }
+
+    Affine2D Affine2D::MakeTranslation(float aX, float aY)
+    {
+        return MakeTranslation(Vector2(aX, aY));
+    }
+
+    Affine2D Affine2D::MakeRotation(float aRadians)
+    {
+        return Make(Vector2(0.0f, 0.0f), aRadians);
+    }
+
+    Affine2D Affine2D::MakeScale(const Vector2& aScale)
+    {
+        Affine2D affine;
+        affine.m[0][0] = aScale.x;
+        affine.m[1][1] = aScale.y;
+        return affine;
+    }
+
+    Affine2D Affine2D::MakeScale(float aSx, float aSy)
+    {
+        return MakeScale(Vector2(aSx, aSy));
+    }
+
+    Affine2D::Affine2D()
+    {
+        m[0][0] = 1;  m[1][0] = 0;  m[2][0] = 0;
+        m[0][1] = 0;  m[1][1] = 1;  m[2][1] = 0;
+    }
+
+    Affine2D::Affine2D(const Matrix& aMatrix)
+    {
+        m[0][0] = aMatrix.m[0][0];  m[1][0] = aMatrix.m[1][0];  m[2][0] = aMatrix.m[3][0];
+        m[0][1] = aMatrix.m[0][1];  m[1][1] = aMatrix.m[1][1];  m[2][1] = aMatrix.m[3][1];
+    }
+
+    void Affine2D::SetTranslation(const Vector2& aTranslation)
+    {
+        m[2][0] = aTranslation.x;
+        m[2][1] = aTranslation.y;
+    }
+
+    void Affine2D::SetTranslation(float aX, float aY)
+    {
+        SetTranslation(Vector2(aX, aY));
+    }
+
+    Vector2 Affine2D::GetTranslation() const
+    {
+        return Vector2(m[2][0], m[2][1]);
+    }
+
+    float Affine2D::GetRadians() const
+    {
+        //Same as Matrix::GetRadians()
+        return atan2f(m[0][1], m[1][1]);
+    }
+
+    float Affine2D::GetDegrees() const
+    {
+        return Math::RadiansToDegrees(GetRadians());
+    }
+
+    Vector2 Affine2D::GetScale() const
+    {
+        Vector2 scale;
+        scale.x = Vector2(m[0][0], m[0][1]).Length();
+        scale.y = Vector2(m[1][0], m[1][1]).Length();
+        return scale;
+    }
+
+    Affine2D Affine2D::GetInverse() const
+    {
+        float determinant = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+        if (determinant == 0.0f)
+        {
+            //Matrix::GetInverse() returns a zero Matrix in this case
+            Affine2D zero;
+            zero.m[0][0] = 0.0f;
+            zero.m[1][1] = 0.0f;
+            return zero;
+        }
+
+        float inverseDeterminant = 1.0f / determinant;
+
+        Affine2D inverse;
+        inverse.m[0][0] = m[1][1] * inverseDeterminant;
+        inverse.m[0][1] = -m[0][1] * inverseDeterminant;
+        inverse.m[1][0] = -m[1][0] * inverseDeterminant;
+        inverse.m[1][1] = m[0][0] * inverseDeterminant;
+
+        //The inverse translation is the translation moved back through the inverse rotation and scale
+        inverse.m[2][0] = -(inverse.m[0][0] * m[2][0] + inverse.m[1][0] * m[2][1]);
+        inverse.m[2][1] = -(inverse.m[0][1] * m[2][0] + inverse.m[1][1] * m[2][1]);
+        return inverse;
+    }
+
+    Vector2 Affine2D::TransformVector(const Vector2& aVector2) const
+    {
+        return Vector2(m[0][0] * aVector2.x + m[1][0] * aVector2.y, m[0][1] * aVector2.x + m[1][1] * aVector2.y);
+    }
+
+    Matrix Affine2D::ToMatrix() const
+    {
+        Matrix matrix = Matrix::Identity();
+        matrix.m[0][0] = m[0][0];  matrix.m[1][0] = m[1][0];  matrix.m[3][0] = m[2][0];
+        matrix.m[0][1] = m[0][1];  matrix.m[1][1] = m[1][1];  matrix.m[3][1] = m[2][1];
+        return matrix;
+    }
+
+    Vector2 Affine2D::operator *(const Vector2& aVector2) const
+    {
+        float x = m[0][0] * aVector2.x + m[1][0] * aVector2.y + m[2][0];
+        float y = m[0][1] * aVector2.x + m[1][1] * aVector2.y + m[2][1];
+        return Vector2(x, y);
+    }
+
+    Affine2D Affine2D::operator *(const Affine2D& aAffine) const
+    {
+        Affine2D affine;
+
+        affine.m[0][0] = m[0][0] * aAffine.m[0][0] + m[1][0] * aAffine.m[0][1];
+        affine.m[0][1] = m[0][1] * aAffine.m[0][0] + m[1][1] * aAffine.m[0][1];
+        affine.m[1][0] = m[0][0] * aAffine.m[1][0] + m[1][0] * aAffine.m[1][1];
+        affine.m[1][1] = m[0][1] * aAffine.m[1][0] + m[1][1] * aAffine.m[1][1];
+        affine.m[2][0] = m[0][0] * aAffine.m[2][0] + m[1][0] * aAffine.m[2][1] + m[2][0];
+        affine.m[2][1] = m[0][1] * aAffine.m[2][0] + m[1][1] * aAffine.m[2][1] + m[2][1];
+
+        return affine;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Matrix.h"
+
+
+namespace GameDev2D
+{
+    //A 2D affine transform stored as a 2x3 Matrix, the same m[column][row] layout as Matrix without the z and w rows
+    //and columns. m[0] is the x axis, m[1] the y axis and m[2] the translation. It is a third of the size of a Matrix
+    //and composing two of them is 12 multiplies instead of 64, the renderers only convert to a Matrix for shaders
+    struct Affine2D
+    {
+        //Returns an Identity Affine2D
+        static Affine2D Identity();
+
+        //Returns an Affine2D that scales, then rotates, then translates
+        static Affine2D Make(const Vector2& translation, float radians, const Vector2& scale = Vector2(1.0f, 1.0f));
+
+        //Returns an Affine2D based on the translation
+        static Affine2D MakeTranslation(const Vector2& translation);
+        static Affine2D MakeTranslation(float x, float y);
+
+        //Returns an Affine2D based on the rotation
+        static Affine2D MakeRotation(float radians);
+
+        //Returns an Affine2D based on the scale
+        static Affine2D MakeScale(const Vector2& scale);
+        static Affine2D MakeScale(float sx, float sy);
+
+        //Creates an Identity Affine2D
+        Affine2D();
+
+        //Creates an Affine2D from the x and y columns and translation of a Matrix, the rest of the Matrix is dropped
+        explicit Affine2D(const Matrix& matrix);
+
+        //Translates the Affine2D
+        void SetTranslation(const Vector2& translation);
+        void SetTranslation(float x, float y);
+
+        //Returns the translation Vector2 value
+        Vector2 GetTranslation() const;
+
+        //Returns the angle (euler) value
+        float GetRadians() const;
+        float GetDegrees() const;
+
+        //Returns the scale Vector2 value
+        Vector2 GetScale() const;
+
+        //Returns an inversed Affine2D based on this Affine2D
+        Affine2D GetInverse() const;
+
+        //Returns the Vector2 rotated and scaled, but not translated
+        Vector2 TransformVector(const Vector2& vector2) const;
+
+        //Returns the Affine2D as a 4x4 Matrix, for uploading to a shader
+        Matrix ToMatrix() const;
+
+        //Multiplication operator override
+        Vector2 operator *(const Vector2& vector2) const;
+
+        //Multiplication operator override
+        Affine2D operator *(const Affine2D& affine) const;
+
+        //Member variable
+        float m[3][2];
+    };
+}
\ No newline at end of file
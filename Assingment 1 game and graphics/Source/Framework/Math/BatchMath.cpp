@@ -0,0 +1,414 @@
+#include "BatchMath.h"
+#include <math.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BATCH_MATH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define BATCH_MATH_X86 0
+#endif
+
+//GCC and Clang only emit SSE2 and AVX2 instructions in functions marked for them (unless the whole file is
+//compiled for them), MSVC emits them anywhere, the runtime check decides whether they are called
+#if BATCH_MATH_X86 && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_MATH_SSE2 __attribute__((target("sse2")))
+#define BATCH_MATH_AVX2 __attribute__((target("avx2")))
+#else
+#define BATCH_MATH_SSE2
+#define BATCH_MATH_AVX2
+#endif
+
+
+namespace GameDev2D
+{
+    //Both transforms work out to x' = x * d[0] + y * o[0] + t[0] and y' = y * d[1] + x * o[1] + t[1]
+    struct TransformKernel
+    {
+        float d[2];
+        float o[2];
+        float t[2];
+    };
+
+    static SimdLevel DetectSimdLevel()
+    {
+#if BATCH_MATH_X86
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+
+        //AVX2 also needs the OS to save the ymm registers
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#else
+        __builtin_cpu_init();
+        bool sse2 = __builtin_cpu_supports("sse2") != 0;
+        bool avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+
+        if (avx2)
+        {
+            return SimdLevel::AVX2;
+        }
+
+        if (sse2)
+        {
+            return SimdLevel::SSE2;
+        }
+#endif
+        return SimdLevel::Scalar;
+    }
+
+    static const SimdLevel s_SupportedLevel = DetectSimdLevel();
+    static SimdLevel s_Level = s_SupportedLevel;
+
+    static Vector2* OutputAt(Vector2* out, unsigned int outStride, unsigned int index)
+    {
+        return (Vector2*)((unsigned char*)out + (size_t)index * outStride);
+    }
+
+    static void TransformScalar(const TransformKernel& kernel, const Vector2* points, unsigned int count, Vector2* out, unsigned int outStride)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            float x = points[i].x;
+            float y = points[i].y;
+            Vector2* result = OutputAt(out, outStride, i);
+            result->x = (x * kernel.d[0] + y * kernel.o[0]) + kernel.t[0];
+            result->y = (y * kernel.d[1] + x * kernel.o[1]) + kernel.t[1];
+        }
+    }
+
+    //Folds a difference into [-size / 2, size / 2], the positions are inside the world so one step across the edge is enough
+    static float WrapDifference(float difference, float size)
+    {
+        if (difference > size * 0.5f)
+            return difference - size;
+        if (difference < -size * 0.5f)
+            return difference + size;
+        return difference;
+    }
+
+    static unsigned int CircleOverlapsScalar(const Vector2& center, float radius, const Vector2* centers, const float* radii, const unsigned int* indices, unsigned int count, const Vector2* worldSize, unsigned char* overlaps)
+    {
+        unsigned int numberOfOverlaps = 0;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            unsigned int index = indices != nullptr ? indices[i] : i;
+            float dx = centers[index].x - center.x;
+            float dy = centers[index].y - center.y;
+            if (worldSize != nullptr)
+            {
+                dx = WrapDifference(dx, worldSize->x);
+                dy = WrapDifference(dy, worldSize->y);
+            }
+            float radiiSum = radius + radii[index];
+            overlaps[i] = (dx * dx + dy * dy) <= (radiiSum * radiiSum) ? 1 : 0;
+            numberOfOverlaps += overlaps[i];
+        }
+        return numberOfOverlaps;
+    }
+
+    static unsigned int WriteOverlapMask(int mask, unsigned int lanes, unsigned char* overlaps)
+    {
+        unsigned int numberOfOverlaps = 0;
+        for (unsigned int lane = 0; lane < lanes; lane++)
+        {
+            overlaps[lane] = (unsigned char)((mask >> lane) & 1);
+            numberOfOverlaps += overlaps[lane];
+        }
+        return numberOfOverlaps;
+    }
+
+#if BATCH_MATH_X86
+    //Each of these handles as many points as fit in whole registers and returns how many that was, the caller finishes the rest
+    BATCH_MATH_SSE2 static unsigned int TransformSSE2(const TransformKernel& kernel, const Vector2* points, unsigned int count, Vector2* out)
+    {
+        //Two points per register, the swapped copy lines up each point's y with its x (and x with y)
+        const __m128 d = _mm_setr_ps(kernel.d[0], kernel.d[1], kernel.d[0], kernel.d[1]);
+        const __m128 o = _mm_setr_ps(kernel.o[0], kernel.o[1], kernel.o[0], kernel.o[1]);
+        const __m128 t = _mm_setr_ps(kernel.t[0], kernel.t[1], kernel.t[0], kernel.t[1]);
+
+        unsigned int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 v = _mm_loadu_ps(&points[i].x);
+            __m128 swapped = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, d), _mm_mul_ps(swapped, o)), t);
+            _mm_storeu_ps(&out[i].x, result);
+        }
+        return i;
+    }
+
+    BATCH_MATH_AVX2 static unsigned int TransformAVX2(const TransformKernel& kernel, const Vector2* points, unsigned int count, Vector2* out)
+    {
+        const __m256 d = _mm256_setr_ps(kernel.d[0], kernel.d[1], kernel.d[0], kernel.d[1], kernel.d[0], kernel.d[1], kernel.d[0], kernel.d[1]);
+        const __m256 o = _mm256_setr_ps(kernel.o[0], kernel.o[1], kernel.o[0], kernel.o[1], kernel.o[0], kernel.o[1], kernel.o[0], kernel.o[1]);
+        const __m256 t = _mm256_setr_ps(kernel.t[0], kernel.t[1], kernel.t[0], kernel.t[1], kernel.t[0], kernel.t[1], kernel.t[0], kernel.t[1]);
+
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256 v = _mm256_loadu_ps(&points[i].x);
+            __m256 swapped = _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+            __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(v, d), _mm256_mul_ps(swapped, o)), t);
+            _mm256_storeu_ps(&out[i].x, result);
+        }
+
+        //Avoids the penalty for mixing AVX and SSE instructions in the code that follows
+        _mm256_zeroupper();
+        return i;
+    }
+
+    BATCH_MATH_SSE2 static unsigned int DistanceSquaredSSE2(const Vector2& point, const Vector2* points, unsigned int count, float* out)
+    {
+        const __m128 px = _mm_set1_ps(point.x);
+        const __m128 py = _mm_set1_ps(point.y);
+
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            //Split four points into their x's and y's
+            __m128 a = _mm_loadu_ps(&points[i].x);
+            __m128 b = _mm_loadu_ps(&points[i + 2].x);
+            __m128 dx = _mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), px);
+            __m128 dy = _mm_sub_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), py);
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        }
+        return i;
+    }
+
+    //Subtracts the size where the difference is over half the size, then adds it where it's under minus half. The
+    //masked size is 0 in the other lanes and x - 0 is exactly x, so this matches WrapDifference()
+    BATCH_MATH_SSE2 static __m128 WrapDifferenceSSE2(__m128 difference, __m128 size, __m128 halfSize)
+    {
+        difference = _mm_sub_ps(difference, _mm_and_ps(_mm_cmpgt_ps(difference, halfSize), size));
+        return _mm_add_ps(difference, _mm_and_ps(_mm_cmplt_ps(difference, _mm_sub_ps(_mm_setzero_ps(), halfSize)), size));
+    }
+
+    BATCH_MATH_SSE2 static unsigned int CircleOverlapsSSE2(const Vector2& center, float radius, const Vector2* centers, const float* radii, const unsigned int* indices, unsigned int count, const Vector2* worldSize, unsigned char* overlaps, unsigned int& numberOfOverlaps)
+    {
+        const __m128 cx = _mm_set1_ps(center.x);
+        const __m128 cy = _mm_set1_ps(center.y);
+        const __m128 r = _mm_set1_ps(radius);
+        const __m128 width = _mm_set1_ps(worldSize != nullptr ? worldSize->x : 0.0f);
+        const __m128 height = _mm_set1_ps(worldSize != nullptr ? worldSize->y : 0.0f);
+        const __m128 halfWidth = _mm_set1_ps(worldSize != nullptr ? worldSize->x * 0.5f : 0.0f);
+        const __m128 halfHeight = _mm_set1_ps(worldSize != nullptr ? worldSize->y * 0.5f : 0.0f);
+
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 xs;
+            __m128 ys;
+            __m128 rs;
+            if (indices != nullptr)
+            {
+                const unsigned int* index = indices + i;
+                xs = _mm_setr_ps(centers[index[0]].x, centers[index[1]].x, centers[index[2]].x, centers[index[3]].x);
+                ys = _mm_setr_ps(centers[index[0]].y, centers[index[1]].y, centers[index[2]].y, centers[index[3]].y);
+                rs = _mm_setr_ps(radii[index[0]], radii[index[1]], radii[index[2]], radii[index[3]]);
+            }
+            else
+            {
+                __m128 a = _mm_loadu_ps(&centers[i].x);
+                __m128 b = _mm_loadu_ps(&centers[i + 2].x);
+                xs = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                ys = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                rs = _mm_loadu_ps(radii + i);
+            }
+
+            __m128 dx = _mm_sub_ps(xs, cx);
+            __m128 dy = _mm_sub_ps(ys, cy);
+            if (worldSize != nullptr)
+            {
+                dx = WrapDifferenceSSE2(dx, width, halfWidth);
+                dy = WrapDifferenceSSE2(dy, height, halfHeight);
+            }
+            __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 radiiSum = _mm_add_ps(r, rs);
+            int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(radiiSum, radiiSum)));
+            numberOfOverlaps += WriteOverlapMask(mask, 4, overlaps + i);
+        }
+        return i;
+    }
+
+    BATCH_MATH_AVX2 static __m256 WrapDifferenceAVX2(__m256 difference, __m256 size, __m256 halfSize)
+    {
+        difference = _mm256_sub_ps(difference, _mm256_and_ps(_mm256_cmp_ps(difference, halfSize, _CMP_GT_OQ), size));
+        return _mm256_add_ps(difference, _mm256_and_ps(_mm256_cmp_ps(difference, _mm256_sub_ps(_mm256_setzero_ps(), halfSize), _CMP_LT_OQ), size));
+    }
+
+    BATCH_MATH_AVX2 static unsigned int CircleOverlapsAVX2(const Vector2& center, float radius, const Vector2* centers, const float* radii, const unsigned int* indices, unsigned int count, const Vector2* worldSize, unsigned char* overlaps, unsigned int& numberOfOverlaps)
+    {
+        const __m256 cx = _mm256_set1_ps(center.x);
+        const __m256 cy = _mm256_set1_ps(center.y);
+        const __m256 r = _mm256_set1_ps(radius);
+        const __m256 width = _mm256_set1_ps(worldSize != nullptr ? worldSize->x : 0.0f);
+        const __m256 height = _mm256_set1_ps(worldSize != nullptr ? worldSize->y : 0.0f);
+        const __m256 halfWidth = _mm256_set1_ps(worldSize != nullptr ? worldSize->x * 0.5f : 0.0f);
+        const __m256 halfHeight = _mm256_set1_ps(worldSize != nullptr ? worldSize->y * 0.5f : 0.0f);
+
+        //The in-lane shuffle leaves the x's (and y's) of eight points in the order 0 1 4 5 2 3 6 7
+        const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 xs;
+            __m256 ys;
+            __m256 rs;
+            if (indices != nullptr)
+            {
+                //A Vector2's x is at float offset 2 * index, its y right after
+                __m256i index = _mm256_loadu_si256((const __m256i*)(indices + i));
+                __m256i offset = _mm256_add_epi32(index, index);
+                xs = _mm256_i32gather_ps(&centers[0].x, offset, 4);
+                ys = _mm256_i32gather_ps(&centers[0].y, offset, 4);
+                rs = _mm256_i32gather_ps(radii, index, 4);
+            }
+            else
+            {
+                __m256 a = _mm256_loadu_ps(&centers[i].x);
+                __m256 b = _mm256_loadu_ps(&centers[i + 4].x);
+                xs = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), order);
+                ys = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), order);
+                rs = _mm256_loadu_ps(radii + i);
+            }
+
+            __m256 dx = _mm256_sub_ps(xs, cx);
+            __m256 dy = _mm256_sub_ps(ys, cy);
+            if (worldSize != nullptr)
+            {
+                dx = WrapDifferenceAVX2(dx, width, halfWidth);
+                dy = WrapDifferenceAVX2(dy, height, halfHeight);
+            }
+            __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 radiiSum = _mm256_add_ps(r, rs);
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radiiSum, radiiSum), _CMP_LE_OQ));
+            numberOfOverlaps += WriteOverlapMask(mask, 8, overlaps + i);
+        }
+
+        _mm256_zeroupper();
+        return i;
+    }
+#endif
+
+    //Only packed output goes through the SIMD kernels. Storing each point of a register into its own interleaved
+    //vertex measured no faster than the scalar loop at the outline sizes (7 to 17 points), slower at most of them
+    static void TransformPoints(const TransformKernel& kernel, const Vector2* points, unsigned int count, Vector2* out, unsigned int outStride)
+    {
+        unsigned int i = 0;
+#if BATCH_MATH_X86
+        if (s_Level == SimdLevel::AVX2 && outStride == sizeof(Vector2))
+        {
+            i = TransformAVX2(kernel, points, count, out);
+        }
+
+        if (s_Level >= SimdLevel::SSE2 && outStride == sizeof(Vector2))
+        {
+            i += TransformSSE2(kernel, points + i, count - i, out + i);
+        }
+#endif
+        TransformScalar(kernel, points + i, count - i, OutputAt(out, outStride, i), outStride);
+    }
+
+    static unsigned int FindCircleOverlaps(const Vector2& center, float radius, const Vector2* centers, const float* radii, const unsigned int* indices, unsigned int count, const Vector2* worldSize, unsigned char* overlaps)
+    {
+        unsigned int numberOfOverlaps = 0;
+        unsigned int i = 0;
+#if BATCH_MATH_X86
+        if (s_Level == SimdLevel::AVX2)
+        {
+            i = CircleOverlapsAVX2(center, radius, centers, radii, indices, count, worldSize, overlaps, numberOfOverlaps);
+        }
+
+        if (s_Level >= SimdLevel::SSE2)
+        {
+            //The contiguous arrays are offset to the first unhandled circle, the indices already point into the whole arrays
+            const Vector2* remainingCenters = indices != nullptr ? centers : centers + i;
+            const float* remainingRadii = indices != nullptr ? radii : radii + i;
+            const unsigned int* remainingIndices = indices != nullptr ? indices + i : nullptr;
+            i += CircleOverlapsSSE2(center, radius, remainingCenters, remainingRadii, remainingIndices, count - i, worldSize, overlaps + i, numberOfOverlaps);
+        }
+#endif
+        const Vector2* remainingCenters = indices != nullptr ? centers : centers + i;
+        const float* remainingRadii = indices != nullptr ? radii : radii + i;
+        const unsigned int* remainingIndices = indices != nullptr ? indices + i : nullptr;
+        numberOfOverlaps += CircleOverlapsScalar(center, radius, remainingCenters, remainingRadii, remainingIndices, count - i, worldSize, overlaps + i);
+        return numberOfOverlaps;
+    }
+
+    SimdLevel BatchMath::GetSupportedLevel()
+    {
+        return s_SupportedLevel;
+    }
+
+    SimdLevel BatchMath::GetLevel()
+    {
+        return s_Level;
+    }
+
+    void BatchMath::SetLevel(SimdLevel aLevel)
+    {
+        s_Level = aLevel <= s_SupportedLevel ? aLevel : s_SupportedLevel;
+    }
+
+    void BatchMath::RotateTranslate(const Vector2* aPoints, unsigned int aCount, float aRadians, const Vector2& aPosition, Vector2* aOut, unsigned int aOutStride)
+    {
+        float c = cosf(aRadians);
+        float s = sinf(aRadians);
+        TransformKernel kernel = { { c, c }, { -s, s }, { aPosition.x, aPosition.y } };
+        TransformPoints(kernel, aPoints, aCount, aOut, aOutStride);
+    }
+
+    void BatchMath::Transform(const Affine2D& aTransform, const Vector2* aPoints, unsigned int aCount, Vector2* aOut, unsigned int aOutStride)
+    {
+        TransformKernel kernel = { { aTransform.m[0][0], aTransform.m[1][1] }, { aTransform.m[1][0], aTransform.m[0][1] }, { aTransform.m[2][0], aTransform.m[2][1] } };
+        TransformPoints(kernel, aPoints, aCount, aOut, aOutStride);
+    }
+
+    void BatchMath::DistanceSquared(const Vector2& aPoint, const Vector2* aPoints, unsigned int aCount, float* aOut)
+    {
+        unsigned int i = 0;
+#if BATCH_MATH_X86
+        if (s_Level >= SimdLevel::SSE2)
+        {
+            i = DistanceSquaredSSE2(aPoint, aPoints, aCount, aOut);
+        }
+#endif
+        for (; i < aCount; i++)
+        {
+            float dx = aPoints[i].x - aPoint.x;
+            float dy = aPoints[i].y - aPoint.y;
+            aOut[i] = dx * dx + dy * dy;
+        }
+    }
+
+    unsigned int BatchMath::CircleOverlaps(const Vector2& aCenter, float aRadius, const Vector2* aCenters, const float* aRadii, unsigned int aCount, unsigned char* aOverlaps)
+    {
+        return FindCircleOverlaps(aCenter, aRadius, aCenters, aRadii, nullptr, aCount, nullptr, aOverlaps);
+    }
+
+    unsigned int BatchMath::CircleOverlaps(const Vector2& aCenter, float aRadius, const Vector2* aCenters, const float* aRadii, const unsigned int* aIndices, unsigned int aCount, unsigned char* aOverlaps)
+    {
+        return FindCircleOverlaps(aCenter, aRadius, aCenters, aRadii, aIndices, aCount, nullptr, aOverlaps);
+    }
+
+    unsigned int BatchMath::CircleOverlaps(const Vector2& aCenter, float aRadius, const Vector2* aCenters, const float* aRadii, const unsigned int* aIndices, unsigned int aCount, const Vector2& aWorldSize, unsigned char* aOverlaps)
+    {
+        return FindCircleOverlaps(aCenter, aRadius, aCenters, aRadii, aIndices, aCount, &aWorldSize, aOverlaps);
+    }
+}
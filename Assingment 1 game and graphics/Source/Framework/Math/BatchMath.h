@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Affine2D.h"
+
+
+namespace GameDev2D
+{
+    //The instruction sets BatchMath can use, the best one the CPU supports is selected the first time it's needed
+    enum class SimdLevel
+    {
+        Scalar = 0,
+        SSE2,
+        AVX2
+    };
+
+    //Transforms and tests whole arrays of points at once using SSE2 or AVX2, falling back to scalar code on CPUs
+    //without them. Every level does the same float operations in the same order, so they all return the same results
+    struct BatchMath
+    {
+        //Returns the best SimdLevel the CPU (and OS) supports
+        static SimdLevel GetSupportedLevel();
+
+        //Returns the SimdLevel being used, it can be lowered (to compare levels), but never raised above the supported level
+        static SimdLevel GetLevel();
+        static void SetLevel(SimdLevel level);
+
+        //Rotates the points around the origin then offsets them by the position. The results are written every
+        //outStride bytes, so they can go straight into an interleaved vertex, out can't overlap the points. Only
+        //packed output (the default stride) uses the SIMD kernels, strided output is always written by the scalar loop
+        static void RotateTranslate(const Vector2* points, unsigned int count, float radians, const Vector2& position, Vector2* out, unsigned int outStride = sizeof(Vector2));
+
+        //Transforms the points by the Affine2D, the results are written the same way as RotateTranslate()
+        static void Transform(const Affine2D& transform, const Vector2* points, unsigned int count, Vector2* out, unsigned int outStride = sizeof(Vector2));
+
+        //Writes the squared distance between the point and each of the points
+        static void DistanceSquared(const Vector2& point, const Vector2* points, unsigned int count, float* out);
+
+        //Tests the circle against the circles centers[i], radii[i]. overlaps[i] is set to 1 if they overlap
+        //(or touch) and 0 if they don't, returns the number of overlapping circles
+        static unsigned int CircleOverlaps(const Vector2& center, float radius, const Vector2* centers, const float* radii, unsigned int count, unsigned char* overlaps);
+
+        //Same as above, for the circles centers[indices[i]], radii[indices[i]]
+        static unsigned int CircleOverlaps(const Vector2& center, float radius, const Vector2* centers, const float* radii, const unsigned int* indices, unsigned int count, unsigned char* overlaps);
+
+        //Same as above in a world that wraps at its edges, the distances go the short way across an edge the same
+        //way Math::WrappedDifference() does, so every circle has to be inside the world
+        static unsigned int CircleOverlaps(const Vector2& center, float radius, const Vector2* centers, const float* radii, const unsigned int* indices, unsigned int count, const Vector2& worldSize, unsigned char* overlaps);
+    };
+}
\ No newline at end of file
@@ -16,7 +16,7 @@ namespace GameDev2D
     const int Math::TopRightCorner = 2;
     const int Math::TopLeftCorner = 3;
 
-    void Math::CalculateCorners(const Matrix& inTransform, const Vector2& inAnchor, const Vector2& inSize, Vector2 outCorners[4])
+    void Math::CalculateCorners(const Affine2D& inTransform, const Vector2& inAnchor, const Vector2& inSize, Vector2 outCorners[4])
     {
         Vector2 p(inTransform.GetTranslation());
         float r = inTransform.GetRadians();
@@ -92,6 +92,48 @@ namespace GameDev2D
         return rotatedPoint;
     }
 
+    Vector2 Math::WrappedDifference(const Vector2& from, const Vector2& to, const Vector2& worldSize)
+    {
+        Vector2 difference = to - from;
+        if (difference.x > worldSize.x * 0.5f)
+            difference.x -= worldSize.x;
+        else if (difference.x < -worldSize.x * 0.5f)
+            difference.x += worldSize.x;
+
+        if (difference.y > worldSize.y * 0.5f)
+            difference.y -= worldSize.y;
+        else if (difference.y < -worldSize.y * 0.5f)
+            difference.y += worldSize.y;
+
+        return difference;
+    }
+
+    bool Math::DoCirclesOverlap(const Vector2& centerA, float radiusA, const Vector2& centerB, float radiusB, const Vector2& worldSize)
+    {
+        Vector2 difference = WrappedDifference(centerA, centerB, worldSize);
+        float radiiSum = radiusA + radiusB;
+        return (difference.x * difference.x + difference.y * difference.y) <= (radiiSum * radiiSum);
+    }
+
+    Vector2 Math::InterpolateWrapped(const Vector2& previous, const Vector2& current, float alpha, const Vector2& worldSize)
+    {
+        //If the object wrapped between the two positions, go across the edge instead of back across the world
+        Vector2 difference = WrappedDifference(previous, current, worldSize);
+
+        Vector2 position = previous + difference * alpha;
+        if (position.x < 0.0f)
+            position.x += worldSize.x;
+        else if (position.x >= worldSize.x)
+            position.x -= worldSize.x;
+
+        if (position.y < 0.0f)
+            position.y += worldSize.y;
+        else if (position.y >= worldSize.y)
+            position.y -= worldSize.y;
+
+        return position;
+    }
+
     bool Math::IsPointOnLineSegment(const LineSegment& lineSegment, const Vector2& point, float range)
     {
         Vector2 closestPoint = CalculateClosestPointOnLine(lineSegment, point);
@@ -114,11 +156,9 @@ namespace GameDev2D
         return point.x > rectLeftEdge && point.x < rectRightEdge && point.y > rectBottomEdge && point.y < rectTopEdge;
     }
 
-    LineSegment Math::CalculateWorldLineSegment(const Matrix& worldTransform, const Vector2& start, const Vector2& end)
+    LineSegment Math::CalculateWorldLineSegment(const Affine2D& worldTransform, const Vector2& start, const Vector2& end)
     {
-        Matrix startTransform = worldTransform * Matrix::MakeTranslation(start);
-        Matrix endTransform = worldTransform * Matrix::MakeTranslation(end);
-        return LineSegment(startTransform.GetTranslation(), endTransform.GetTranslation());
+        return LineSegment(worldTransform * start, worldTransform * end);
     }
 
     float Math::DegreesToRadians(float aDegrees)
@@ -186,6 +226,11 @@ namespace GameDev2D
         return s_Random.RandomDouble(aMin, aMax);
     }
 
+    void Math::SetRandomSeed(int aSeed)
+    {
+        s_Random = Random(aSeed);
+    }
+
     bool Math::IsClose(float aValue, float aTarget, float aRange)
     {
         if (aValue > aTarget - aRange && aValue < aTarget + aRange)
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "LineSegment.h"
-#include "Matrix.h"
+#include "Affine2D.h"
 #include "Vector2.h"
 #include "Random.h"
 
@@ -15,16 +15,27 @@ namespace GameDev2D
         static const int TopRightCorner;
         static const int TopLeftCorner;
 
-        static void CalculateCorners(const Matrix& inTransform, const Vector2& inAnchor, const Vector2& inSize, Vector2 outCorners[4]);
+        static void CalculateCorners(const Affine2D& inTransform, const Vector2& inAnchor, const Vector2& inSize, Vector2 outCorners[4]);
         static Vector2 CalculateClosestPointOnLine(const LineSegment& lineSegment, const Vector2& point);
       
         static Vector2 RotatePoint(const Vector2& point, const Vector2& targetPoint, float targetRadians);
 
+        //Returns to - from in a world that wraps at its edges, each axis is folded into [-size / 2, size / 2]
+        //so the difference goes the short way across an edge. Both positions have to be inside the world
+        static Vector2 WrappedDifference(const Vector2& from, const Vector2& to, const Vector2& worldSize);
+
+        //Returns true if the circles overlap in a world that wraps at its edges, it's the same test (and the same
+        //result) as BatchMath::CircleOverlaps() with a world size, for when there are too few circles to batch
+        static bool DoCirclesOverlap(const Vector2& centerA, float radiusA, const Vector2& centerB, float radiusB, const Vector2& worldSize);
+
+        //Interpolates between two positions in a world that wraps at its edges, taking the short way across an edge
+        static Vector2 InterpolateWrapped(const Vector2& previous, const Vector2& current, float alpha, const Vector2& worldSize);
+
         static bool IsPointOnLineSegment(const LineSegment& lineSegment, const Vector2& point, float range = 0.1);
         static bool IsPointInsideCircle(const Vector2& circleCenter, float circleRadius, const Vector2& point);
         static bool IsPointInsideRectangle(const Vector2& rectangleCenter, const Vector2& rectangleSize, const Vector2& point); //Rectangle is not rotated
 
-        static LineSegment CalculateWorldLineSegment(const Matrix& worldTransform, const Vector2& start, const Vector2& end);
+        static LineSegment CalculateWorldLineSegment(const Affine2D& worldTransform, const Vector2& start, const Vector2& end);
 
         static float DegreesToRadians(float degrees);
         static float RadiansToDegrees(float radians);
@@ -40,6 +51,9 @@ namespace GameDev2D
         static double RandomDouble();                         //Returns a double value between 0.0 and 1.0
         static double RandomDouble(double min, double max);   //Returns a double value between a min value and a max value
 
+        //Restarts the random numbers from seed, so a run can be repeated exactly (benchmarks, golden images)
+        static void SetRandomSeed(int seed);
+
         static bool IsClose(float value, float target, float range);
 
     private:
@@ -305,7 +305,7 @@ namespace GameDev2D
         return inverse;
     }
 
-    Vector2 Matrix::operator *(const Vector2 aVector2) const
+    Vector2 Matrix::operator *(const Vector2& aVector2) const
     {
         float x = m[0][0] * aVector2.x + m[1][0] * aVector2.y + 0.0f + m[3][0] * 1.0f;
         float y = m[0][1] * aVector2.x + m[1][1] * aVector2.y + 0.0f + m[3][1] * 1.0f;
@@ -320,7 +320,7 @@ namespace GameDev2D
         return Vector2(x / w, y / w);
     }
 
-    Matrix Matrix::operator *(const Matrix aMatrix) const
+    Matrix Matrix::operator *(const Matrix& aMatrix) const
     {
         Matrix matrix;
 
@@ -68,10 +68,10 @@ namespace GameDev2D
         Matrix GetInverse();
 
         //Multiplication operator override
-        Vector2 operator *(const Vector2 vector2) const;
+        Vector2 operator *(const Vector2& vector2) const;
 
         //Multiplication operator override
-        Matrix operator *(const Matrix matrix) const;
+        Matrix operator *(const Matrix& matrix) const;
 
         //Member variable
         float m[MATRIX_NUM_COLUMNS][MATRIX_NUM_ROWS];
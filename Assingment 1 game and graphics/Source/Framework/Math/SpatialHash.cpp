@@ -0,0 +1,152 @@
+#include "SpatialHash.h"
+#include <math.h>
+
+
+namespace GameDev2D
+{
+	SpatialHash::SpatialHash(float cellSize) :
+		m_CellSize(cellSize),
+		m_CellWidth(cellSize),
+		m_CellHeight(cellSize),
+		m_Columns(0),
+		m_Rows(0),
+		m_QueryStamp(0),
+		m_CandidateCount(0)
+	{
+	}
+
+	void SpatialHash::Reset(float worldWidth, float worldHeight)
+	{
+		//Stretch the cells slightly so that a whole number of them covers the world exactly, otherwise
+		//the last column and row wouldn't line up with the wrap around point
+		unsigned int columns = static_cast<unsigned int>(ceilf(worldWidth / m_CellSize));
+		unsigned int rows = static_cast<unsigned int>(ceilf(worldHeight / m_CellSize));
+		m_Columns = columns > 0 ? columns : 1;
+		m_Rows = rows > 0 ? rows : 1;
+		m_CellWidth = worldWidth > 0.0f ? worldWidth / m_Columns : m_CellSize;
+		m_CellHeight = worldHeight > 0.0f ? worldHeight / m_Rows : m_CellSize;
+
+		m_Entries.clear();
+		m_CellStart.clear();
+		m_CellIds.clear();
+		m_CandidateCount = 0;
+	}
+
+	void SpatialHash::Insert(unsigned int id, const Vector2& position, float radius)
+	{
+		CellRange range = CalculateCellRange(position, radius);
+		for (int row = range.firstRow; row <= range.lastRow; row++)
+		{
+			unsigned int wrappedRow = WrapRow(row);
+			for (int column = range.firstColumn; column <= range.lastColumn; column++)
+			{
+				Entry entry;
+				entry.cell = wrappedRow * m_Columns + WrapColumn(column);
+				entry.id = id;
+				m_Entries.push_back(entry);
+			}
+		}
+
+		if (id >= m_QueryStamps.size())
+		{
+			m_QueryStamps.resize(id + 1, m_QueryStamp);
+		}
+	}
+
+	void SpatialHash::Build()
+	{
+		//Counting sort of the entries by cell, m_CellStart[cell] to m_CellStart[cell + 1] is the cell's id range
+		const unsigned int numberOfCells = m_Columns * m_Rows;
+		m_CellStart.assign(numberOfCells + 1, 0);
+
+		for (const Entry& entry : m_Entries)
+		{
+			m_CellStart[entry.cell + 1]++;
+		}
+
+		for (unsigned int i = 0; i < numberOfCells; i++)
+		{
+			m_CellStart[i + 1] += m_CellStart[i];
+		}
+
+		m_CellIds.resize(m_Entries.size());
+		m_CellCursor.assign(m_CellStart.begin(), m_CellStart.end() - 1);
+
+		for (const Entry& entry : m_Entries)
+		{
+			m_CellIds[m_CellCursor[entry.cell]++] = entry.id;
+		}
+	}
+
+	unsigned int SpatialHash::CountEntries(const Vector2& position, float radius) const
+	{
+		if (m_CellStart.empty())
+		{
+			return 0;
+		}
+
+		unsigned int count = 0;
+		CellRange range = CalculateCellRange(position, radius);
+		for (int row = range.firstRow; row <= range.lastRow; row++)
+		{
+			unsigned int wrappedRow = WrapRow(row);
+			for (int column = range.firstColumn; column <= range.lastColumn; column++)
+			{
+				unsigned int cell = wrappedRow * m_Columns + WrapColumn(column);
+				count += m_CellStart[cell + 1] - m_CellStart[cell];
+			}
+		}
+		return count;
+	}
+
+	unsigned int SpatialHash::GetCandidateCount() const
+	{
+		return m_CandidateCount;
+	}
+
+	unsigned int SpatialHash::GetNumberOfColumns() const
+	{
+		return m_Columns;
+	}
+
+	unsigned int SpatialHash::GetNumberOfRows() const
+	{
+		return m_Rows;
+	}
+
+	SpatialHash::CellRange SpatialHash::CalculateCellRange(const Vector2& position, float radius) const
+	{
+		CellRange range;
+		range.firstColumn = static_cast<int>(floorf((position.x - radius) / m_CellWidth));
+		range.lastColumn = static_cast<int>(floorf((position.x + radius) / m_CellWidth));
+		range.firstRow = static_cast<int>(floorf((position.y - radius) / m_CellHeight));
+		range.lastRow = static_cast<int>(floorf((position.y + radius) / m_CellHeight));
+
+		//A circle wider than the world would otherwise visit the same wrapped cells more than once
+		if (range.lastColumn - range.firstColumn >= static_cast<int>(m_Columns))
+		{
+			range.firstColumn = 0;
+			range.lastColumn = m_Columns - 1;
+		}
+
+		if (range.lastRow - range.firstRow >= static_cast<int>(m_Rows))
+		{
+			range.firstRow = 0;
+			range.lastRow = m_Rows - 1;
+		}
+
+		return range;
+	}
+
+	unsigned int SpatialHash::WrapColumn(int column) const
+	{
+		int wrapped = column % static_cast<int>(m_Columns);
+		return static_cast<unsigned int>(wrapped < 0 ? wrapped + static_cast<int>(m_Columns) : wrapped);
+	}
+
+	unsigned int SpatialHash::WrapRow(int row) const
+	{
+		int wrapped = row % static_cast<int>(m_Rows);
+		return static_cast<unsigned int>(wrapped < 0 ? wrapped + static_cast<int>(m_Rows) : wrapped);
+	}
+}
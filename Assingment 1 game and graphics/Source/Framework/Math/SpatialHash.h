@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Vector2.h"
+#include <vector>
+
+
+namespace GameDev2D
+{
+	//Uniform grid broadphase over a toroidal (wrapping) world. Objects are inserted as circles every
+	//tick, Build() buckets them by cell, then Query() returns every object whose cells overlap a circle.
+	//Cells wrap at the world edges, so an object near the right edge is also found from the left edge.
+	class SpatialHash
+	{
+	public:
+		SpatialHash(float cellSize);
+		~SpatialHash() = default;
+
+		//Clears all the inserted objects and resizes the grid to cover a world of the given size
+		void Reset(float worldWidth, float worldHeight);
+
+		//Inserts an object into every cell its bounding circle overlaps, the id must be unique per Reset()
+		void Insert(unsigned int id, const Vector2& position, float radius);
+
+		//Buckets the inserted objects by cell, must be called after the last Insert() and before any Query()
+		void Build();
+
+		//Invokes the given function once for each object id whose cells overlap the circle
+		template <typename F>
+		void Query(const Vector2& position, float radius, const F func);
+
+		//Returns how many ids the cells overlapping the circle hold, without visiting them. It's an upper bound of
+		//what Query() returns for the circle, an object in several of the cells is counted once per cell
+		unsigned int CountEntries(const Vector2& position, float radius) const;
+
+		//Returns the number of ids returned by Query() since the last Reset()
+		unsigned int GetCandidateCount() const;
+
+		unsigned int GetNumberOfColumns() const;
+		unsigned int GetNumberOfRows() const;
+
+	private:
+		struct CellRange
+		{
+			int firstColumn;
+			int lastColumn;
+			int firstRow;
+			int lastRow;
+		};
+
+		struct Entry
+		{
+			unsigned int cell;
+			unsigned int id;
+		};
+
+		CellRange CalculateCellRange(const Vector2& position, float radius) const;
+		unsigned int WrapColumn(int column) const;
+		unsigned int WrapRow(int row) const;
+
+		std::vector<Entry> m_Entries;
+		std::vector<unsigned int> m_CellStart;
+		std::vector<unsigned int> m_CellIds;
+		std::vector<unsigned int> m_CellCursor;
+		std::vector<unsigned int> m_QueryStamps;
+		float m_CellSize;
+		float m_CellWidth;
+		float m_CellHeight;
+		unsigned int m_Columns;
+		unsigned int m_Rows;
+		unsigned int m_QueryStamp;
+		unsigned int m_CandidateCount;
+	};
+
+	template <typename F>
+	void SpatialHash::Query(const Vector2& position, float radius, const F func)
+	{
+		if (m_CellStart.empty())
+		{
+			return;
+		}
+
+		//Stamp each id the first time it's found, so objects spanning several cells are only returned once
+		m_QueryStamp++;
+
+		CellRange range = CalculateCellRange(position, radius);
+		for (int row = range.firstRow; row <= range.lastRow; row++)
+		{
+			unsigned int wrappedRow = WrapRow(row);
+			for (int column = range.firstColumn; column <= range.lastColumn; column++)
+			{
+				unsigned int cell = wrappedRow * m_Columns + WrapColumn(column);
+				for (unsigned int i = m_CellStart[cell]; i < m_CellStart[cell + 1]; i++)
+				{
+					unsigned int id = m_CellIds[i];
+					if (m_QueryStamps[id] != m_QueryStamp)
+					{
+						m_QueryStamps[id] = m_QueryStamp;
+						m_CandidateCount++;
+						func(id);
+					}
+				}
+			}
+		}
+	}
+}
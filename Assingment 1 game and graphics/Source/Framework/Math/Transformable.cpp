@@ -7,8 +7,8 @@ namespace GameDev2D
 		WorldPositionChangedSlot(m_WorldPositionChangedSignal),
 		WorldScaleChangedSlot(m_WorldScaleChangedSignal),
 		WorldRotationChangedSlot(m_WorldRotationChangedSignal),
-		m_LocalTransform(Matrix::Identity()),
-		m_WorldTransform(Matrix::Identity()),
+		m_LocalTransform(Affine2D::Identity()),
+		m_WorldTransform(Affine2D::Identity()),
 		m_LocalPosition(0.0f, 0.0f),
 		m_LocalScale(1.0f, 1.0f),
 		m_Children{},
@@ -31,13 +31,13 @@ namespace GameDev2D
 		m_Children.clear();
 	}
 
-	Matrix Transformable::GetWorldTransform()
+	const Affine2D& Transformable::GetWorldTransform()
 	{
 		CalculateWorldTransform();
 		return m_WorldTransform;
 	}
 
-	Matrix Transformable::GetLocalTransform()
+	const Affine2D& Transformable::GetLocalTransform()
 	{
 		CalculateLocalTransform();
 		return m_LocalTransform;
@@ -217,11 +217,7 @@ namespace GameDev2D
 		{
 			m_IsLocalTransformDirty = false;
 
-			Matrix translationMatrix = Matrix::MakeTranslation(m_LocalPosition);
-			Matrix rotationMatrix = Matrix::MakeRotation(m_LocalRadians);
-			Matrix scaleMatrix = Matrix::MakeScale(m_LocalScale);
-
-			m_LocalTransform = translationMatrix * rotationMatrix * scaleMatrix;
+			m_LocalTransform = Affine2D::Make(m_LocalPosition, m_LocalRadians, m_LocalScale);
 
 			//Re-calculate the world transform for any children
 			for (Transformable* t : m_Children)
@@ -237,7 +233,7 @@ namespace GameDev2D
 		{
 			m_IsWorldTransformDirty = false;
 
-			Matrix previousWorldTransform = m_WorldTransform;
+			Affine2D previousWorldTransform = m_WorldTransform;
 
 			//Calculate the world transform
 			if (m_Parent != nullptr)
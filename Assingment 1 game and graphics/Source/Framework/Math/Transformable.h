@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../Math/Vector2.h"
-#include "../Math/Matrix.h"
+#include "../Math/Affine2D.h"
 #include <entt.hpp>
 
 
@@ -18,10 +18,10 @@ namespace GameDev2D
 		entt::sink<void(Transformable* transformable, float radians, float previous)> WorldRotationChangedSlot; //In radians
 
 		//Returns the world Transformation matrix
-		Matrix GetWorldTransform();
+		const Affine2D& GetWorldTransform();
 
 		//Returns the local Transformation matrix
-		Matrix GetLocalTransform();
+		const Affine2D& GetLocalTransform();
 
 		//Returns the World Position of the Transformable object (factoring a parent's position)
 		Vector2 GetWorldPosition();
@@ -118,8 +118,8 @@ namespace GameDev2D
 		entt::sigh<void(Transformable* transformable, const Vector2& position, const Vector2& previous)> m_WorldPositionChangedSignal;
 		entt::sigh<void(Transformable* transformable, const Vector2& scale, const Vector2& previous)> m_WorldScaleChangedSignal;
 		entt::sigh<void(Transformable* transformable, float radians, float previous)> m_WorldRotationChangedSignal;
-		Matrix m_LocalTransform;
-		Matrix m_WorldTransform;
+		Affine2D m_LocalTransform;
+		Affine2D m_WorldTransform;
 		Vector2 m_LocalPosition;
 		Vector2 m_LocalScale;
 		std::vector<Transformable*> m_Children;
@@ -0,0 +1,94 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+
+namespace
+{
+    std::atomic<unsigned long long> s_Allocations(0);
+    std::atomic<unsigned long long> s_Deallocations(0);
+    std::atomic<unsigned long long> s_Bytes(0);
+    thread_local unsigned long long s_ThreadAllocations = 0;
+}
+
+#if COUNT_ALLOCATIONS
+namespace
+{
+    void* Allocate(size_t size)
+    {
+        s_Allocations.fetch_add(1, std::memory_order_relaxed);
+        s_Bytes.fetch_add(size, std::memory_order_relaxed);
+        s_ThreadAllocations++;
+
+        void* memory = malloc(size > 0 ? size : 1);
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void Deallocate(void* memory)
+    {
+        if (memory != nullptr)
+        {
+            s_Deallocations.fetch_add(1, std::memory_order_relaxed);
+            free(memory);
+        }
+    }
+}
+
+void* operator new(size_t size)
+{
+    return Allocate(size);
+}
+
+void* operator new[](size_t size)
+{
+    return Allocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    Deallocate(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    Deallocate(memory);
+}
+
+void operator delete(void* memory, size_t /*size*/) noexcept
+{
+    Deallocate(memory);
+}
+
+void operator delete[](void* memory, size_t /*size*/) noexcept
+{
+    Deallocate(memory);
+}
+#endif
+
+
+namespace GameDev2D
+{
+    AllocationCounter::Snapshot AllocationCounter::Get()
+    {
+        Snapshot snapshot;
+        snapshot.allocations = s_Allocations.load(std::memory_order_relaxed);
+        snapshot.deallocations = s_Deallocations.load(std::memory_order_relaxed);
+        snapshot.bytes = s_Bytes.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    unsigned long long AllocationCounter::GetNumberOfAllocations()
+    {
+        return s_Allocations.load(std::memory_order_relaxed);
+    }
+
+    unsigned long long AllocationCounter::GetNumberOfThreadAllocations()
+    {
+        return s_ThreadAllocations;
+    }
+}
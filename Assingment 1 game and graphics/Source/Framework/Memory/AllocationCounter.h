@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stddef.h>
+
+//Replaces the global operator new and delete to count every heap allocation. Off by default so the game uses the
+//default ones, define COUNT_ALLOCATIONS=1 in a debug or benchmark build to turn it on. While it's off every count is 0
+#ifndef COUNT_ALLOCATIONS
+#define COUNT_ALLOCATIONS 0
+#endif
+
+
+namespace GameDev2D
+{
+    //Counts every call to the global operator new and delete. Allocations made through the debug new
+    //macro in GameDev2D.h go to the CRT's debug heap directly and aren't counted
+    struct AllocationCounter
+    {
+        struct Snapshot
+        {
+            unsigned long long allocations;
+            unsigned long long deallocations;
+            unsigned long long bytes;
+        };
+
+        //Returns the totals since the program started, subtract two snapshots to count a section of code
+        static Snapshot Get();
+
+        //Returns the number of allocations since the program started
+        static unsigned long long GetNumberOfAllocations();
+
+        //Returns the number of allocations the calling thread has made since it started, subtract two calls on the
+        //same thread to count a section of code without picking up what other threads allocate in the meantime
+        static unsigned long long GetNumberOfThreadAllocations();
+    };
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //A pool that keeps all of its live objects packed at the front of one contiguous array. Every object is
+    //constructed once up front, acquiring hands out the first free one and releasing swaps the last live object
+    //into the released slot, so both are O(1) and iterating only ever touches live objects. Releasing moves an
+    //object, so don't hold on to pointers or indices across a Release() or ReleaseIf()
+    template <typename T>
+    class DensePool
+    {
+    public:
+        DensePool(unsigned int maxEntries);
+        ~DensePool() = default;
+
+        //Returns an unused object, it keeps whatever state it had when it was released.
+        //Returns nullptr if all the objects are in use
+        T* Acquire();
+
+        //Releases the object at the index, the last live object is moved into its place
+        void Release(unsigned int index);
+
+        //Releases every live object the predicate returns true for, use this to remove dead objects
+        //after a loop instead of releasing them while iterating. Returns the number of objects released
+        template <typename F>
+        unsigned int ReleaseIf(const F predicate);
+
+        //Releases all the objects
+        void ReleaseAll();
+
+        //Invokes the given function for all live objects
+        template <typename F>
+        void for_each(const F func);
+
+        T& operator[](unsigned int index) { return m_Objects[index]; }
+        const T& operator[](unsigned int index) const { return m_Objects[index]; }
+
+        //Iterates over the live objects only
+        T* begin() { return m_Objects.data(); }
+        T* end() { return m_Objects.data() + m_NumberOfUsed; }
+        const T* begin() const { return m_Objects.data(); }
+        const T* end() const { return m_Objects.data() + m_NumberOfUsed; }
+
+        //Returns the number of live objects
+        unsigned int NumberOfUsedAllocations() const { return m_NumberOfUsed; }
+
+        //Returns the number of objects that can still be acquired
+        unsigned int NumberOfAvailableAllocations() const { return MaxNumberOfAllocations() - m_NumberOfUsed; }
+
+        //Returns the max number of live objects
+        unsigned int MaxNumberOfAllocations() const { return static_cast<unsigned int>(m_Objects.size()); }
+
+    private:
+        std::vector<T> m_Objects;
+        unsigned int m_NumberOfUsed;
+
+        DensePool(const DensePool&) = delete;
+        DensePool& operator=(const DensePool&) = delete;
+    };
+}
+
+#include "DensePool.inl"
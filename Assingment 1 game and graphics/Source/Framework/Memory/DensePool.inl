@@ -0,0 +1,77 @@
+#include <cassert>
+#include <utility>
+
+
+namespace GameDev2D
+{
+    template <typename T>
+    DensePool<T>::DensePool(unsigned int maxEntries)
+        : m_Objects(maxEntries),
+        m_NumberOfUsed(0)
+    {}
+
+    template <typename T>
+    T* DensePool<T>::Acquire()
+    {
+        //The unused objects are all after the live ones, so the first one is the head of the free list
+        if (m_NumberOfUsed < m_Objects.size())
+        {
+            return &m_Objects[m_NumberOfUsed++];
+        }
+
+        //Returns nullptr if there is no available space
+        return nullptr;
+    }
+
+    template <typename T>
+    void DensePool<T>::Release(unsigned int index)
+    {
+        assert(index < m_NumberOfUsed); // assert that the index is live
+
+        //Swap the last live object into the released slot, the released object becomes the first free one
+        const unsigned int last = m_NumberOfUsed - 1;
+        if (index != last)
+        {
+            std::swap(m_Objects[index], m_Objects[last]);
+        }
+        m_NumberOfUsed--;
+    }
+
+    template <typename T>
+    template <typename F>
+    unsigned int DensePool<T>::ReleaseIf(const F predicate)
+    {
+        unsigned int released = 0;
+        unsigned int i = 0;
+        while (i < m_NumberOfUsed)
+        {
+            if (predicate(m_Objects[i]))
+            {
+                //Don't advance, the object swapped into this slot still has to be checked
+                Release(i);
+                released++;
+            }
+            else
+            {
+                i++;
+            }
+        }
+        return released;
+    }
+
+    template <typename T>
+    void DensePool<T>::ReleaseAll()
+    {
+        m_NumberOfUsed = 0;
+    }
+
+    template <typename T>
+    template <typename F>
+    void DensePool<T>::for_each(const F func)
+    {
+        for (unsigned int i = 0; i < m_NumberOfUsed; ++i)
+        {
+            func(&m_Objects[i]);
+        }
+    }
+}
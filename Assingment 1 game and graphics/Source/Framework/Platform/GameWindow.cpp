@@ -20,7 +20,8 @@ namespace GameDev2D
         m_Width(config.window.width),
         m_Height(config.window.height),
         m_IsFullscreen(config.window.fullscreen),
-        m_IsVSyncEnabled(config.window.vsync)
+        m_IsVSyncEnabled(config.window.vsync),
+        m_HasGraphicsContext(config.renderer.backend != "software")
     {
         //Initialize glfw
         int success = glfwInit();
@@ -28,9 +29,11 @@ namespace GameDev2D
 
         glfwSetErrorCallback(GLFWErrorCallback);
 
-        //Set the OpenGL version
+        //Set the OpenGL version, the software backend draws on the CPU and doesn't need a context
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, OPENGL_VERSION_MAJOR);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, OPENGL_VERSION_MINOR);
+        if (m_HasGraphicsContext == false)
+            glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 
         //
         glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
@@ -38,9 +41,12 @@ namespace GameDev2D
         //Create the window
         GLFWmonitor* monitor = glfwGetPrimaryMonitor();
         m_Window = glfwCreateWindow(static_cast<int>(m_Width), static_cast<int>(m_Height), config.window.title.c_str(), m_IsFullscreen ? monitor : nullptr, nullptr);
-        glfwMakeContextCurrent(m_Window);
-        int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
-        assert(status);
+        if (m_HasGraphicsContext)
+        {
+            glfwMakeContextCurrent(m_Window);
+            int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+            assert(status);
+        }
 
         if (!m_IsFullscreen)
         {
@@ -62,7 +68,8 @@ namespace GameDev2D
             glfwSetWindowIcon(m_Window, 1, &image);
         }
 
-        glfwSwapInterval(static_cast<int>(m_IsVSyncEnabled));
+        if (m_HasGraphicsContext)
+            glfwSwapInterval(static_cast<int>(m_IsVSyncEnabled));
         glfwSetWindowUserPointer(m_Window, this);
 
         // Set GLFW callbacks
@@ -228,7 +235,8 @@ namespace GameDev2D
     void GameWindow::EnableVerticalSync(bool isEnabled)
     {
         m_IsVSyncEnabled = isEnabled;
-        glfwSwapInterval(static_cast<int>(isEnabled));
+        if (m_HasGraphicsContext)
+            glfwSwapInterval(static_cast<int>(isEnabled));
     }
 
     bool GameWindow::IsVerticalSyncEnabled()
@@ -238,11 +246,24 @@ namespace GameDev2D
 
     void GameWindow::SwapDrawBuffer()
     {
-        glfwSwapBuffers(m_Window);
+        if (m_HasGraphicsContext)
+            glfwSwapBuffers(m_Window);
     }
 
     void GameWindow::PollEvents()
     {
         glfwPollEvents();
     }
+
+    void GameWindow::MakeContextCurrent()
+    {
+        if (m_HasGraphicsContext)
+            glfwMakeContextCurrent(m_Window);
+    }
+
+    void GameWindow::ReleaseContext()
+    {
+        if (m_HasGraphicsContext)
+            glfwMakeContextCurrent(nullptr);
+    }
 }
\ No newline at end of file
@@ -46,12 +46,18 @@ namespace GameDev2D
         bool IsVerticalSyncEnabled();
 
     private:
-        //Allow the Application class to access non-public members
+        //Allow the Application and RenderThread classes to access non-public members
         friend class Application;
+        friend class RenderThread;
 
         void SwapDrawBuffer();
         void PollEvents();
 
+        //The OpenGL context can only be current on one thread at a time, the render thread takes
+        //it over from the main thread. Neither does anything if the window has no context
+        void MakeContextCurrent();
+        void ReleaseContext();
+
         //Member variables
         GameWindowCallback* m_Callback;
         GLFWwindow* m_Window;
@@ -59,5 +65,6 @@ namespace GameDev2D
         unsigned int m_Height;
         bool m_IsFullscreen;
         bool m_IsVSyncEnabled;
+        bool m_HasGraphicsContext;
     };
 }
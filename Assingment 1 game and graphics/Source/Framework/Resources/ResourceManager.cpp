@@ -15,7 +15,9 @@
 
 namespace GameDev2D
 {
-    ResourceManager::ResourceManager(bool autoLoad) :
+    ResourceManager::ResourceManager(bool autoLoad, bool textureArrays) :
+        m_TextureArrays(),
+        m_UseTextureArrays(textureArrays),
         m_AudioCache(entt::connect_arg_t<&ResourceManager::LoadWaveData>()),
         m_TextureCache(entt::connect_arg_t<&ResourceManager::LoadTexure>()),
         m_ShaderCache(entt::connect_arg_t<&ResourceManager::LoadShader>()),
@@ -101,7 +103,7 @@ namespace GameDev2D
             index += checkerSize * colorSize;
         }
 
-        m_TextureCache.SetDefaultResource(CreateRef<Texture>(imageData));
+        m_TextureCache.SetDefaultResource(CreateRef<Texture>(Application::Get().GetGraphics(), imageData));
         m_TextureCache.ResourceLoadedSlot.connect<&ResourceManager::OnTextureLoaded>(this);
 
         std::unordered_map<std::string, Rect> defaultMap;
@@ -137,6 +139,11 @@ namespace GameDev2D
                 GetTextureCache().Load(imagesResources.at(i));
             }
 
+            if (m_UseTextureArrays)
+            {
+                LogTextureMemory();
+            }
+
             ignoreExtensions.clear();
             ignoreExtensions.push_back("json");
             std::vector<Resource> splashResources = AutoLoadResource("Splash", ignoreExtensions);
@@ -160,8 +167,20 @@ namespace GameDev2D
             Resource spriteRenderer("SpriteRenderer", "glsl", "Shaders");
             GetShaderCache().Load(spriteRenderer, SPRITE_RENDERER_SHADER_KEY);
 
+            Resource spriteInstanceRenderer("SpriteInstanceRenderer", "glsl", "Shaders");
+            GetShaderCache().Load(spriteInstanceRenderer, SPRITE_INSTANCE_RENDERER_SHADER_KEY);
+
             Resource lineRenderer("LineRenderer", "glsl", "Shaders");
             GetShaderCache().Load(lineRenderer, LINE_RENDERER_SHADER_KEY);
+
+            Resource lineShapeRenderer("LineShapeRenderer", "glsl", "Shaders");
+            GetShaderCache().Load(lineShapeRenderer, LINE_SHAPE_RENDERER_SHADER_KEY);
+
+            Resource lineInstanceRenderer("LineInstanceRenderer", "glsl", "Shaders");
+            GetShaderCache().Load(lineInstanceRenderer, LINE_INSTANCE_RENDERER_SHADER_KEY);
+
+            Resource lineQuadRenderer("LineQuadRenderer", "glsl", "Shaders");
+            GetShaderCache().Load(lineQuadRenderer, LINE_QUAD_RENDERER_SHADER_KEY);
         }
     }
 
@@ -200,6 +219,68 @@ namespace GameDev2D
         {
             GetAtlasCache().Load(atlasResource);
         }
+
+        if (m_UseTextureArrays)
+        {
+            AddToTextureArray(texture);
+        }
+    }
+
+    void ResourceManager::LogTextureMemory()
+    {
+        unsigned long long totalMemory = 0;
+        unsigned long long totalUsed = 0;
+
+        for (size_t i = 0; i < m_TextureArrays.size(); i++)
+        {
+            TextureArray* textureArray = m_TextureArrays[i].get();
+            unsigned long long memory = textureArray->GetMemoryUsage();
+            unsigned long long used = textureArray->GetUsedMemory();
+            const char* layout = textureArray->GetPixelFormat().layout == PixelLayout::RGBA ? "RGBA" : "RGB";
+
+            Log::Message(LogVerbosity::Profiling, "[Resource Manager] Texture array %zu: %ux%u %s, %u/%u layers, %.2f-KB allocated, %.2f-KB used (%.1f%%)",
+                i, textureArray->GetWidth(), textureArray->GetHeight(), layout, textureArray->GetLayerCount(), textureArray->GetLayerCapacity(),
+                (double)memory / 1024.0, (double)used / 1024.0, memory > 0 ? (double)used * 100.0 / (double)memory : 0.0);
+
+            totalMemory += memory;
+            totalUsed += used;
+        }
+
+        Log::Message(LogVerbosity::Profiling, "[Resource Manager] Texture arrays: %zu arrays, %.2f-MB allocated, %.2f-MB used", m_TextureArrays.size(), (double)totalMemory / 1024.0 / 1024.0, (double)totalUsed / 1024.0 / 1024.0);
+    }
+
+    void ResourceManager::AddToTextureArray(Texture* texture)
+    {
+        //Larger textures would waste too much of a layer when rounded up, they are drawn on their own
+        const unsigned int maxLayerSize = 1024;
+
+        unsigned int width = 1;
+        unsigned int height = 1;
+        while (width < texture->GetWidth()) width <<= 1;
+        while (height < texture->GetHeight()) height <<= 1;
+
+        if (width > maxLayerSize || height > maxLayerSize)
+        {
+            return;
+        }
+
+        unsigned int layer = 0;
+        for (size_t i = 0; i < m_TextureArrays.size(); i++)
+        {
+            TextureArray* textureArray = m_TextureArrays[i].get();
+            if (textureArray->GetWidth() == width && textureArray->GetHeight() == height && textureArray->AddTexture(texture, layer))
+            {
+                texture->SetArrayLayer(textureArray, layer);
+                return;
+            }
+        }
+
+        std::unique_ptr<TextureArray> textureArray = std::make_unique<TextureArray>(Application::Get().GetGraphics(), width, height, texture->GetPixelFormat());
+        if (textureArray->AddTexture(texture, layer))
+        {
+            texture->SetArrayLayer(textureArray.get(), layer);
+            m_TextureArrays.push_back(std::move(textureArray));
+        }
     }
 
     std::vector<Resource> ResourceManager::AutoLoadResource(const std::string& directory, std::vector<std::string>& ignoreExtensions)
@@ -269,7 +350,7 @@ namespace GameDev2D
             ImageData imageData;
             if (Png::LoadFromPath(path, imageData))
             {
-                texture = CreateRef<Texture>(imageData);
+                texture = CreateRef<Texture>(Application::Get().GetGraphics(), imageData);
             }
             else
             {
@@ -291,7 +372,7 @@ namespace GameDev2D
         if (source.length() > 0)
         {
             std::unordered_map<ShaderType, std::string> shaderSources = PreProcessShader(source);
-            shader = CreateRef<Shader>(shaderSources[ShaderType::Vertex], shaderSources[ShaderType::Fragment], shaderSources[ShaderType::Geometry]);
+            shader = CreateRef<Shader>(Application::Get().GetGraphics(), shaderSources[ShaderType::Vertex], shaderSources[ShaderType::Fragment], shaderSources[ShaderType::Geometry]);
         }
         else
         {
@@ -325,7 +406,7 @@ namespace GameDev2D
                     ImageData imageData;
                     if (Png::LoadFromPath(path, imageData))
                     {
-                        font = CreateRef<Font>(imageData, fontData);
+                        font = CreateRef<Font>(Application::Get().GetGraphics(), imageData, fontData);
                     }
                     else
                     {
@@ -435,6 +516,8 @@ namespace GameDev2D
             fontData.size = root["size"].asUInt();
             fontData.baseline = root["baseline"].asUInt();
             fontData.lineHeight = root["lineHeight"].asUInt();
+            fontData.distanceField = root["distanceField"].asBool();
+            fontData.distanceRange = root["distanceRange"].asUInt();
 
             //Get the glyphs
             const Json::Value glyphs = root["glyphs"];
@@ -6,17 +6,13 @@
 #include "../Graphics/Font.h"
 #include "../Graphics/Sprite.h"
 #include "../Graphics/Texture.h"
+#include "../Graphics/TextureArray.h"
 #include "../Graphics/GraphicTypes.h"
 #include <unordered_map>
+#include <memory>
 #include <string>
 
 
-//Shader constants
-const std::string SPRITE_RENDERER_SHADER_KEY = "SpriteRenderer";
-const std::string LINE_RENDERER_SHADER_KEY = "LineRenderer";
-const std::string POINT_RENDERER_SHADER_KEY = "PointRenderer";
-const std::string CIRCLE_RENDERER_SHADER_KEY = "CircleRenderer";
-
 namespace GameDev2D
 {
     class AtlasMap;
@@ -26,7 +22,7 @@ namespace GameDev2D
     class ResourceManager
     {
     public:
-        ResourceManager(bool autoLoad);
+        ResourceManager(bool autoLoad, bool textureArrays = false);
         ~ResourceManager() = default;
 
         ResourceCache<WaveData>& GetAudioCache();
@@ -35,9 +31,16 @@ namespace GameDev2D
         ResourceCache<Font>& GetFontCache();
         ResourceCache<AtlasMap>& GetAtlasCache();
 
+        //Logs the size, layers and memory used by each texture array, and the totals. A Texture in an array has no
+        //texture of its own, so this is all the memory the Textures in arrays use
+        void LogTextureMemory();
+
     private:
         void OnTextureLoaded(Texture* texture, const Resource& resource);
 
+        //Copies the Texture into an array with other Textures of the same format and (power of two) size
+        void AddToTextureArray(Texture* texture);
+
         std::vector<Resource> AutoLoadResource(const std::string& directory, std::vector<std::string>& ignoreExtensions);
 
         static void LoadWaveData(const Resource& resource, Ref<WaveData>& waveData);
@@ -51,7 +54,9 @@ namespace GameDev2D
         static bool ParseFontData(const std::string& jsonData, FontData& fontData);
         static bool ParseAtlasData(const std::string& jsonData, std::unordered_map<std::string, Rect>& atlasMap);
 
-        //Member variables
+        //Member variables, the texture arrays are declared first so they outlive the Textures in them
+        std::vector<std::unique_ptr<TextureArray>> m_TextureArrays;
+        bool m_UseTextureArrays;
         ResourceCache<WaveData> m_AudioCache;
         ResourceCache<Texture> m_TextureCache;
         ResourceCache<Shader> m_ShaderCache;
@@ -0,0 +1,110 @@
+#include "ThreadPool.h"
+
+
+namespace GameDev2D
+{
+    ThreadPool::ThreadPool(unsigned int aNumberOfThreads) :
+        m_Job(nullptr),
+        m_Count(0),
+        m_NextIndex(0),
+        m_BusyWorkers(0),
+        m_Generation(0),
+        m_IsRunning(true)
+    {
+        unsigned int numberOfThreads = aNumberOfThreads;
+        if (numberOfThreads == 0)
+        {
+            numberOfThreads = std::thread::hardware_concurrency();
+            if (numberOfThreads == 0)
+                numberOfThreads = 1;
+        }
+
+        //The calling thread is thread 0
+        for (unsigned int i = 1; i < numberOfThreads; i++)
+            m_Workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_IsRunning = false;
+        }
+        m_WorkReady.notify_all();
+
+        for (std::thread& worker : m_Workers)
+            worker.join();
+    }
+
+    void ThreadPool::ParallelFor(unsigned int aCount, const std::function<void(unsigned int, unsigned int)>& aJob)
+    {
+        if (aCount == 0)
+            return;
+
+        //Not worth waking the workers for a single iteration
+        if (m_Workers.empty() || aCount == 1)
+        {
+            for (unsigned int i = 0; i < aCount; i++)
+                aJob(i, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Job = &aJob;
+            m_Count = aCount;
+            m_NextIndex = 0;
+            m_BusyWorkers = (unsigned int)m_Workers.size();
+            m_Generation++;
+        }
+        m_WorkReady.notify_all();
+
+        RunJob(0);
+
+        //The job is owned by the caller, every worker has to be done with it before returning
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_WorkDone.wait(lock, [this] { return m_BusyWorkers == 0; });
+        m_Job = nullptr;
+    }
+
+    unsigned int ThreadPool::GetNumberOfThreads() const
+    {
+        return (unsigned int)m_Workers.size() + 1;
+    }
+
+    void ThreadPool::WorkerLoop(unsigned int aThread)
+    {
+        unsigned long long generation = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_WorkReady.wait(lock, [this, generation] { return m_IsRunning == false || m_Generation != generation; });
+                if (m_IsRunning == false)
+                    return;
+
+                generation = m_Generation;
+            }
+
+            RunJob(aThread);
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (--m_BusyWorkers == 0)
+                m_WorkDone.notify_one();
+        }
+    }
+
+    void ThreadPool::RunJob(unsigned int aThread)
+    {
+        //Each thread takes the next index until they're all taken, so uneven iterations balance themselves out
+        while (true)
+        {
+            unsigned int index = m_NextIndex.fetch_add(1);
+            if (index >= m_Count)
+                break;
+
+            (*m_Job)(index, aThread);
+        }
+    }
+}
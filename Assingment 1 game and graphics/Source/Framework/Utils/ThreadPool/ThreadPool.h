@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //A fixed set of worker threads that run the iterations of a loop in parallel. The thread calling ParallelFor()
+    //takes part in the loop and the call returns once every iteration is done, so there's nothing to wait on
+    class ThreadPool
+    {
+    public:
+        //0 uses one thread per hardware thread, the calling thread counts as one of them
+        ThreadPool(unsigned int numberOfThreads = 0);
+        ~ThreadPool();
+
+        //Calls job(index, thread) for every index in [0, count), thread is in [0, GetNumberOfThreads()) and is the
+        //same for every index run by the same thread, so it can be used to pick per thread scratch memory
+        void ParallelFor(unsigned int count, const std::function<void(unsigned int, unsigned int)>& job);
+
+        unsigned int GetNumberOfThreads() const;
+
+    private:
+        void WorkerLoop(unsigned int thread);
+        void RunJob(unsigned int thread);
+
+        //Member variables
+        std::vector<std::thread> m_Workers;
+        std::mutex m_Mutex;
+        std::condition_variable m_WorkReady;
+        std::condition_variable m_WorkDone;
+        const std::function<void(unsigned int, unsigned int)>* m_Job;
+        unsigned int m_Count;
+        std::atomic<unsigned int> m_NextIndex;
+        unsigned int m_BusyWorkers;
+        unsigned long long m_Generation;
+        bool m_IsRunning;
+    };
+}
\ No newline at end of file
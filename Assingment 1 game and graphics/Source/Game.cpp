@@ -1,18 +1,27 @@
 ﻿#include "Ship.h"
-#include "Asteroid.h"
+#include "AsteroidField.h"
 #include "Game.h"
 #include "Constants.h"
 
 
 namespace GameDev2D
 {
-	Game::Game() :
+	Game::Game(unsigned int numberOfAsteroids) :
 		m_Ship(nullptr),
-		m_Asteroid(NUM_OF_ASTEROIDS),
-		m_Lasers{},
-		m_Shields{},
+		m_Asteroids(numberOfAsteroids),
+		m_Lasers(LASER_POOL_SIZE),
+		m_Shields(SHEILD_POOL_SIZE),
 		m_Text("OpenSans-CondBold_32"),
 		m_Text2("OpenSans-CondBold_32"),
+		m_AsteroidHash(COLLISION_CELL_SIZE),
+		m_CandidatePairs(0),
+		m_BruteForcePairs(0),
+		m_CollisionTime(0.0),
+		m_PendingShieldSpawns{},
+		m_CollisionCandidates{},
+		m_CollisionOverlaps{},
+		m_Stats(),
+		m_NumberOfAsteroids(numberOfAsteroids),
 		m_asteroidsDestroyed(0),
 		m_Time(0.0f),
 		m_GameOver(false)
@@ -27,18 +36,17 @@ namespace GameDev2D
 
 		m_Ship = new Ship(this, Vector2(GetHalfScreenWidth(), GetHalfScreenHeight()));
 
-		//create all objects needed
-		for (int i = 0; i < LASER_POOL_SIZE; i++)
+		for (unsigned int i = 0; i < numberOfAsteroids; i++)
 		{
-			m_Lasers[i] = new Laser();
+			m_Asteroids.Spawn();
 		}
 
-		//create all objects needed
-		for (int i = 0; i < SHEILD_POOL_SIZE; i++)
-		{
-			m_Shields[i] = new Shield();
-		}
+		//a laser can destroy at most one asteroid per update, so this never has to grow
+		m_PendingShieldSpawns.reserve(LASER_POOL_SIZE);
 
+		//a query can't return an asteroid twice, so the candidates never outnumber the asteroids
+		m_CollisionCandidates.reserve(m_Asteroids.GetCapacity());
+		m_CollisionOverlaps.resize(m_Asteroids.GetCapacity());
 	}
 
 	Game::~Game()
@@ -48,32 +56,12 @@ namespace GameDev2D
 			delete m_Ship;
 			m_Ship = nullptr;
 		}
-
-
-
-		//laser
-		for (int i = 0; i < LASER_POOL_SIZE; i++)
-		{
-			if (m_Lasers[i] != nullptr)
-			{
-				delete m_Lasers[i];
-				m_Lasers[i] = nullptr;
-			}
-		}
-
-		//Shield
-		for (int i = 0; i < SHEILD_POOL_SIZE; i++)
-		{
-			if (m_Shields[i] != nullptr)
-			{
-				delete m_Shields[i];
-				m_Shields[i] = nullptr;
-			}
-		}
 	}
 
 	void Game::OnUpdate(float delta)
 	{
+		double updateStart = GameLoop::Now();
+
 		//if the games not over add more to the timer
 		if (!m_GameOver)
 		{
@@ -84,112 +72,142 @@ namespace GameDev2D
 
 		//updates for all game objects
 		m_Ship->OnUpdate(delta);
-		for (int i = 0; i < NUM_OF_ASTEROIDS; i++)
-		{
-			m_Asteroid[i].OnUpdate(delta);
-		}
+		m_Asteroids.OnUpdate(delta);
 
-		for (int i = 0; i < SHEILD_POOL_SIZE; i++)
+		for (Shield& shield : m_Shields)
 		{
-			m_Shields[i]->OnUpdate(delta);
+			shield.OnUpdate(delta);
 		}
 
-		//colision for ship and A
-		for (Asteroid& a : m_Asteroid)
+		//rebuild the broadphase grid with the asteroids positions for this tick
+		double collisionStart = GameLoop::Now();
+		const unsigned int numberOfAsteroids = m_Asteroids.GetCount();
+		const Vector2* asteroidPositions = m_Asteroids.GetPositions();
+		const float* asteroidRadii = m_Asteroids.GetRadii();
+		const unsigned char* asteroidActive = m_Asteroids.GetActiveFlags();
+		const unsigned int activeAsteroids = m_Asteroids.GetNumberOfActive();
+		const Vector2 screenSize((float)GetScreenWidth(), (float)GetScreenHeight());
+		m_AsteroidHash.Reset(screenSize.x, screenSize.y);
+		for (unsigned int i = 0; i < numberOfAsteroids; i++)
 		{
-			if (a.IsActive())
+			if (asteroidActive[i])
 			{
-				float distanceSquared = (a.getPosition().x - m_Ship->getPosition().x) * (a.getPosition().x - m_Ship->getPosition().x) + (a.getPosition().y - m_Ship->getPosition().y) * (a.getPosition().y - m_Ship->getPosition().y);
-				float radiiSquared = (m_Ship->getRadius() + a.getRadius()) * (m_Ship->getRadius() + a.getRadius());
-				bool didCollide = (distanceSquared <= radiiSquared);
-
-				if (didCollide)//if ship and asteroid colided
-				{
-					bool shieldActive = false;
-
-					for (int i = 0; i < SHEILD_POOL_SIZE; i++)//checks for a shield
-					{
-						if (m_Shields[i]->beingUsed() == true)
-						{
-						    m_Shields[i]->setPosition(Vector2(1000, 1000));
-							m_Shields[i]->setUsed(false);
-							shieldActive = true;
-							a.Colided();
-							m_asteroidsDestroyed++;
-							break;
-						}
-
-					}
-
-					if (shieldActive == false)
-					{
-						m_Ship->respawn();
-					
-					}
-					
+				m_AsteroidHash.Insert(i, asteroidPositions[i], asteroidRadii[i]);
+			}
+		}
+		m_AsteroidHash.Build();
+		m_CollisionTime = GameLoop::Now() - collisionStart;
 
+		//colision for ship and A, only the asteroids sharing a cell with the ship are tested
+		m_BruteForcePairs = activeAsteroids;
 
-				}
-			}
+		collisionStart = GameLoop::Now();
+		Vector2 shipPosition = m_Ship->getPosition();
+		float shipRadius = m_Ship->getRadius();
+		bool shipRespawned = false;
 
-		}
-		//colition for laser and A
-		for (int i = 0; i < LASER_POOL_SIZE; i++)
+		auto shipHit = [&](unsigned int index)//if ship and asteroid colided
 		{
-			m_Lasers[i]->OnUpdate(delta);
-			for (Asteroid& a : m_Asteroid)
+			bool shieldActive = false;
+
+			for (Shield& shield : m_Shields)//checks for a shield
 			{
-				if (m_Lasers[i]->IsActive() && a.IsActive())
+				if (shield.beingUsed() == true)
 				{
+				    shield.setPosition(Vector2(1000, 1000));
+					shield.setUsed(false);
+					shieldActive = true;
+					m_Asteroids.Colided(index);
+					m_asteroidsDestroyed++;
+					break;
+				}
 
+			}
 
-					float distanceSquared = (a.getPosition().x - m_Lasers[i]->getPosition().x) * (a.getPosition().x - m_Lasers[i]->getPosition().x) + (a.getPosition().y - m_Lasers[i]->getPosition().y) * (a.getPosition().y - m_Lasers[i]->getPosition().y);
-					float radiiSquared = (m_Lasers[i]->getRadius() + a.getRadius()) * (m_Lasers[i]->getRadius() + a.getRadius());
-					bool didCollide = (distanceSquared <= radiiSquared);
+			if (shieldActive == false)
+			{
+				m_Ship->respawn();
+				shipRespawned = true;
+			}
+		};
+		//the candidates left after a respawn were found around the old position, so they can't hit the ship anymore
+		TestAsteroids(shipPosition, shipRadius, screenSize, [&](unsigned int index)
+		{
+			return shipRespawned == false && asteroidActive[index] != 0;
+		}, shipHit);
+		m_CollisionTime += GameLoop::Now() - collisionStart;
 
-					if (didCollide)//if laser and asteroid colided
-					{
-						int rand = Math::RandomFloat(1, 7);
-						if (rand == 1)
-						{
-							SpawnShield(a.getPosition());
-						}
-						
-						m_Lasers[i]->Colided();
-						a.Colided();
-						m_asteroidsDestroyed++;
+		//colition for laser and A, each laser only tests the asteroids in the cells it overlaps
+		for (Laser& laser : m_Lasers)
+		{
+			laser.OnUpdate(delta);
+			if (laser.IsActive() == false)
+			{
+				continue;
+			}
 
-					}
+			m_BruteForcePairs += activeAsteroids;
 
+			collisionStart = GameLoop::Now();
+			auto laserHit = [&](unsigned int index)//if laser and asteroid colided
+			{
+				int rand = Math::RandomFloat(1, 7);
+				if (rand == 1)
+				{
+					m_PendingShieldSpawns.push_back(asteroidPositions[index]);
 				}
-			}
+				
+				laser.Colided();
+				m_Asteroids.Colided(index);
+				m_asteroidsDestroyed++;
+			};
+			TestAsteroids(laser.getPosition(), laser.getRadius(), screenSize, [&](unsigned int index)
+			{
+				return laser.IsActive() && asteroidActive[index];
+			}, laserHit);
+			m_CollisionTime += GameLoop::Now() - collisionStart;
 
 		}
+		m_CandidatePairs = m_AsteroidHash.GetCandidateCount();
 
-		//colition for sheild and ship
-		for (int i = 0; i < SHEILD_POOL_SIZE; i++)
+		//shields are dropped after all the collisions are done
+		double spawnStart = GameLoop::Now();
+		for (const Vector2& position : m_PendingShieldSpawns)
 		{
-			float distanceSquared = (m_Ship->getPosition().x - m_Shields[i]->getPosition().x) * (m_Ship->getPosition().x - m_Shields[i]->getPosition().x) + (m_Ship->getPosition().y - m_Shields[i]->getPosition().y) * (m_Ship->getPosition().y - m_Shields[i]->getPosition().y);
-			float radiiSquared = (m_Shields[i]->getRadius() + m_Ship->getRadius()) * (m_Shields[i]->getRadius() + m_Ship->getRadius());
+			SpawnShield(position);
+		}
+		m_PendingShieldSpawns.clear();
+		double spawnTime = GameLoop::Now() - spawnStart;
+
+		//colition for sheild and ship, only the diamonds are on the screen so only they can wrap
+		for (Shield& shield : m_Shields)
+		{
+			Vector2 difference = shield.isDiamond() ? Math::WrappedDifference(m_Ship->getPosition(), shield.getPosition(), screenSize) : shield.getPosition() - m_Ship->getPosition();
+			float distanceSquared = difference.x * difference.x + difference.y * difference.y;
+			float radiiSquared = (shield.getRadius() + m_Ship->getRadius()) * (shield.getRadius() + m_Ship->getRadius());
 			bool didCollide = (distanceSquared <= radiiSquared);
 
 			if (didCollide)
 			{
-				m_Shields[i]->setIsDiamond(false);
-				m_Shields[i]->setUsed(true);
+				shield.setIsDiamond(false);
+				shield.setUsed(true);
 
 			}
 
-			if (m_Shields[i]->beingUsed())
+			if (shield.beingUsed())
 			{
-				m_Shields[i]->setPosition(m_Ship->getPosition());
+				shield.setPosition(m_Ship->getPosition());
 			}
 		}
 
+		//the lasers and shields that died this update are swapped out of the live part of their pools
+		m_Lasers.ReleaseIf([](Laser& laser) { return laser.IsActive() == false; });
+		m_Shields.ReleaseIf([](Shield& shield) { return shield.isDiamond() == false && shield.beingUsed() == false; });
+
 
 
 		//if all the asteroids are gone end the game
-		if (m_asteroidsDestroyed == NUM_OF_ASTEROIDS)
+		if (m_asteroidsDestroyed == m_NumberOfAsteroids)
 
 		{
 			m_GameOver = true;
@@ -206,9 +224,15 @@ namespace GameDev2D
 
 
 
+		m_Stats.updateTime += GameLoop::Now() - updateStart - m_CollisionTime - spawnTime;
+		m_Stats.collisionTime += m_CollisionTime;
+		m_Stats.spawnTime += spawnTime;
+		m_Stats.candidatePairs += m_CandidatePairs;
+		m_Stats.bruteForcePairs += m_BruteForcePairs;
+		m_Stats.updates++;
 	}
 
-	void Game::OnRender(BatchRenderer& batchRenderer)
+	void Game::OnRender(BatchRenderer& batchRenderer, float alpha)
 	{
 		batchRenderer.BeginScene();
 
@@ -220,26 +244,23 @@ namespace GameDev2D
 		{
 
 
-			m_Ship->OnRender(batchRenderer);
+			m_Ship->OnRender(batchRenderer, alpha);
 
 
-			for (int i = 0; i < NUM_OF_ASTEROIDS; i++)
-			{
-				m_Asteroid[i].OnRender(batchRenderer);
-			}
+			m_Asteroids.OnRender(batchRenderer, alpha);
 
 
 
-			for (int i = 0; i < LASER_POOL_SIZE; i++)
+			for (Laser& laser : m_Lasers)
 			{
-				m_Lasers[i]->OnRender(batchRenderer);
+				laser.OnRender(batchRenderer, alpha);
 
 			}
 
 
-			for (int i = 0; i < SHEILD_POOL_SIZE; i++)
+			for (Shield& shield : m_Shields)
 			{
-				m_Shields[i]->OnRender(batchRenderer);
+				shield.OnRender(batchRenderer);
 
 			}
 		}
@@ -248,6 +269,23 @@ namespace GameDev2D
 		batchRenderer.EndScene();
 	}
 
+	const Game::Stats& Game::GetStats() const
+	{
+		return m_Stats;
+	}
+
+	void Game::ResetStats()
+	{
+		m_Stats = Stats();
+	}
+
+	std::string Game::GetCollisionStats()
+	{
+		char output[128];
+		snprintf(output, sizeof(output), "Collision pairs: %u / %u (%.3f ms)", m_CandidatePairs, m_BruteForcePairs, m_CollisionTime * 1000.0);
+		return std::string(output);
+	}
+
 	void Game::OnKeyEvent(KeyCode keyCode, KeyState keyState)
 	{
 		m_Ship->OnKeyEvent(keyCode, keyState);
@@ -264,36 +302,23 @@ namespace GameDev2D
 	}
 	void Game::SpawnLaser(const Vector2& position, const Vector2& velocity)
 	{
+		double spawnStart = GameLoop::Now();
 		Laser* laser = GetLaserFromPool();
 		if (laser != nullptr)
 		{
 			laser->Activate(position, velocity);
 		}
-
+		m_Stats.spawnTime += GameLoop::Now() - spawnStart;
 	}
 
 	Laser* Game::GetLaserFromPool()
 	{
-		for (int i = 0; i < LASER_POOL_SIZE; i++)
-		{
-			if (m_Lasers[i]->IsActive() == false)
-			{
-				return m_Lasers[i];
-			}
-		}
-		return nullptr;
+		return m_Lasers.Acquire();
 	}
 
 	Shield* Game::GetShieldFromPool()
 	{
-		for (int i = 0; i < SHEILD_POOL_SIZE; i++)
-		{
-			if (m_Shields[i]->isDiamond() == false)
-			{
-				return m_Shields[i];
-			}
-		}
-		return nullptr;
+		return m_Shields.Acquire();
 	}
 
 	void Game::SpawnShield(const Vector2& position)
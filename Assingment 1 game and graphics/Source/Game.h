@@ -2,7 +2,7 @@
 
 #include <GameDev2D.h>
 #include "Ship.h"
-#include "Asteroid.h"
+#include "AsteroidField.h"
 #include "Constants.h"
 #include "Laser.h"
 #include "Shield.h"
@@ -14,14 +14,28 @@ namespace GameDev2D
 	class Game
 	{
 	public:
-		Game();
+		Game(unsigned int numberOfAsteroids = NUM_OF_ASTEROIDS);
 		~Game();
 
+		//Time spent in each phase of the updates, totalled since the last ResetStats()
+		struct Stats
+		{
+			Stats() : updateTime(0.0), collisionTime(0.0), spawnTime(0.0), candidatePairs(0), bruteForcePairs(0), updates(0) {}
+
+			double updateTime;
+			double collisionTime;
+			double spawnTime;
+			unsigned long long candidatePairs;
+			unsigned long long bruteForcePairs;
+			unsigned int updates;
+		};
+
 		//Write game logic in the Update method
 		void OnUpdate(float delta);
 
 		//Render game objects in the Draw method
-		void OnRender(BatchRenderer& batchRenderer);
+		//alpha is how far the frame is between the previous and current update, used to smooth the movement
+		void OnRender(BatchRenderer& batchRenderer, float alpha);
 
 		//Input event methods
 		void OnKeyEvent(KeyCode keyCode, KeyState keyState);
@@ -31,18 +45,77 @@ namespace GameDev2D
 		void SpawnLaser(const Vector2& position, const Vector2& velocity);
 		void SpawnShield(const Vector2& position);
 
+		//Returns the broadphase pair count for the last tick (tested vs brute force) and the time spent on collisions
+		std::string GetCollisionStats();
+
+		const Stats& GetStats() const;
+		void ResetStats();
+
 	private:
 		Laser* GetLaserFromPool();
 		Shield* GetShieldFromPool();
+
+		//Calls hit(index) for each asteroid in the circle's cells that overlaps it and that canHit(index) allows, in the
+		//order the grid returns them. The grid wraps its cells, so the distances go across the screen edges too
+		template <typename CanHit, typename Hit>
+		void TestAsteroids(const Vector2& position, float radius, const Vector2& worldSize, const CanHit canHit, const Hit hit);
+
 		SpriteFont m_Text;
 		SpriteFont m_Text2;
 		//Member variables GO HERE 
 		Ship* m_Ship;
-		std::vector <Asteroid> m_Asteroid;
-		Laser* m_Lasers[LASER_POOL_SIZE];
-		Shield* m_Shields[SHEILD_POOL_SIZE];
-		int m_asteroidsDestroyed;
+		AsteroidField m_Asteroids;
+		DensePool<Laser> m_Lasers;
+		DensePool<Shield> m_Shields;
+		SpatialHash m_AsteroidHash;
+		unsigned int m_CandidatePairs;
+		unsigned int m_BruteForcePairs;
+		double m_CollisionTime;
+		std::vector<Vector2> m_PendingShieldSpawns;
+		std::vector<unsigned int> m_CollisionCandidates;
+		std::vector<unsigned char> m_CollisionOverlaps;
+		Stats m_Stats;
+		unsigned int m_NumberOfAsteroids;
+		unsigned int m_asteroidsDestroyed;
 		float m_Time;
 		bool m_GameOver;
 	};
+
+	template <typename CanHit, typename Hit>
+	void Game::TestAsteroids(const Vector2& position, float radius, const Vector2& worldSize, const CanHit canHit, const Hit hit)
+	{
+		const Vector2* asteroidPositions = m_Asteroids.GetPositions();
+		const float* asteroidRadii = m_Asteroids.GetRadii();
+
+		//a few candidates are tested as the grid returns them, gathering them for the batch test only pays off in crowded cells
+		if (m_AsteroidHash.CountEntries(position, radius) < COLLISION_MIN_BATCH_CANDIDATES)
+		{
+			m_AsteroidHash.Query(position, radius, [&](unsigned int index)
+			{
+				if (canHit(index) && Math::DoCirclesOverlap(position, radius, asteroidPositions[index], asteroidRadii[index], worldSize))
+				{
+					hit(index);
+				}
+			});
+			return;
+		}
+
+		m_CollisionCandidates.clear();
+		m_AsteroidHash.Query(position, radius, [&](unsigned int index)
+		{
+			m_CollisionCandidates.push_back(index);
+		});
+
+		//the candidates are all tested at once, then the hits are handled in the order the grid returned them
+		const unsigned int numberOfCandidates = (unsigned int)m_CollisionCandidates.size();
+		BatchMath::CircleOverlaps(position, radius, asteroidPositions, asteroidRadii, m_CollisionCandidates.data(), numberOfCandidates, worldSize, m_CollisionOverlaps.data());
+		for (unsigned int i = 0; i < numberOfCandidates; i++)
+		{
+			unsigned int index = m_CollisionCandidates[i];
+			if (canHit(index) && m_CollisionOverlaps[i] != 0)
+			{
+				hit(index);
+			}
+		}
+	}
 }
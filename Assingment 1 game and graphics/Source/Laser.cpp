@@ -7,6 +7,7 @@ namespace GameDev2D
 	Laser::Laser() :
 		m_Points{ },
 		m_Position(Vector2::Zero),
+		m_PreviousPosition(Vector2::Zero),
 		m_Velocity(Vector2::Zero),
 		m_IsActive(false),
 		m_Radians(m_Velocity.Angle()),
@@ -33,6 +34,8 @@ namespace GameDev2D
 
 	void Laser::OnUpdate(float delta)
 	{
+		//keep last update's position to draw in between updates
+		m_PreviousPosition = m_Position;
 
 		//moves if its active
 		if (m_IsActive)
@@ -74,11 +77,12 @@ namespace GameDev2D
 
 	}
 
-	void Laser::OnRender(BatchRenderer& batchRenderer)
+	void Laser::OnRender(BatchRenderer& batchRenderer, float alpha)
 	{
 		if (m_IsActive)
 		{
-			batchRenderer.RenderLineStrip(m_Points, ColorList::White, 2.0f, m_Position, m_Radians);
+			Vector2 position = Math::InterpolateWrapped(m_PreviousPosition, m_Position, alpha, Vector2((float)GetScreenWidth(), (float)GetScreenHeight()));
+			batchRenderer.RenderLineStrip(m_Points, ColorList::White, 2.0f, position, m_Radians);
 		}
 	}
 
@@ -99,6 +103,7 @@ namespace GameDev2D
 		m_IsActive = true;
 		m_Time = 0.0f;
 		m_Position = position;
+		m_PreviousPosition = position;
 		m_Velocity = velocity;
 	}
 
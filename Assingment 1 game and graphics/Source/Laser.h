@@ -10,7 +10,7 @@ namespace GameDev2D
 		Laser();
 
 		void OnUpdate(float delta);
-		void OnRender(BatchRenderer& batchRenderer);
+		void OnRender(BatchRenderer& batchRenderer, float alpha);
 
 		Vector2 getPosition();
 		float getRadius();
@@ -25,6 +25,7 @@ namespace GameDev2D
 	private:
 		std::vector<Vector2> m_Points;
 		Vector2 m_Position;
+		Vector2 m_PreviousPosition;
 		Vector2 m_Velocity;
 		float m_Radians;
 		bool m_IsActive;
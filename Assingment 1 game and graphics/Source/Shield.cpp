@@ -21,11 +21,6 @@ namespace GameDev2D
 
 	}
 
-	Shield::~Shield()
-	{
-
-	}
-
 	void Shield::Colide()
 	{
 		m_Active = false;
@@ -5,7 +5,6 @@ namespace GameDev2D
 	{
 	public:
 		Shield();
-		~Shield();
 
 		void Colide();
 
@@ -8,8 +8,10 @@ namespace GameDev2D
 		m_Game(game),
 		m_Points{ {-15.0f, 10.0f}, {15.0f, 0.0f},{-15.0f,-10.0f},{-10.0f,0.0f},{-15.0f,10.0f} },
 		m_Position(position),
+		m_PreviousPosition(position),
 		m_Velocity(Vector2::Zero),
 		m_Radians(0.0f),
+		m_PreviousRadians(0.0f),
 		m_Radius(15.0f)
 	{
 
@@ -17,6 +19,10 @@ namespace GameDev2D
 
 	void Ship::OnUpdate(float delta)
 	{
+		//keep last update's position and rotation to draw in between updates
+		m_PreviousPosition = m_Position;
+		m_PreviousRadians = m_Radians;
+
 		//warping if goes out of bounds
 		if (m_Position.x >= (float)GetScreenWidth())
 		{
@@ -30,10 +36,10 @@ namespace GameDev2D
 		{
 			m_Position.y -= GetScreenHeight();
 		}
-		//if (m_Position.y < 0)
-		//{
-		//	m_Position.y += GetScreenHeight();
-		//}
+		if (m_Position.y < 0)
+		{
+			m_Position.y += GetScreenHeight();
+		}
 
 
 
@@ -71,9 +77,11 @@ namespace GameDev2D
 
 	}
 
-	void Ship::OnRender(BatchRenderer& batchRenderer)
+	void Ship::OnRender(BatchRenderer& batchRenderer, float alpha)
 	{
-		batchRenderer.RenderLineStrip(m_Points, ColorList::White, 2.0f, m_Position, m_Radians);
+		Vector2 position = Math::InterpolateWrapped(m_PreviousPosition, m_Position, alpha, Vector2((float)GetScreenWidth(), (float)GetScreenHeight()));
+		float radians = m_PreviousRadians + (m_Radians - m_PreviousRadians) * alpha;
+		batchRenderer.RenderLineStrip(m_Points, ColorList::White, 2.0f, position, radians);
 	}
 
 	void Ship::OnKeyEvent(KeyCode keyCode, KeyState keyState)
@@ -100,12 +108,14 @@ namespace GameDev2D
 		m_Position.x = Math::RandomFloat(0, GetScreenWidth());
 		m_Position.y = Math::RandomFloat(0, GetScreenHeight());
 		m_Velocity = Vector2::Zero;
+		m_PreviousPosition = m_Position;
 	}
 
 
 	Vector2 Ship::setPosition(Vector2 v)
 	{
 		m_Position = v;
+		m_PreviousPosition = v;
 		return m_Position;
 	}
 
@@ -113,6 +123,7 @@ namespace GameDev2D
 	{
 		m_Position.x = w;
 		m_Position.y = h;
+		m_PreviousPosition = m_Position;
 		return m_Position;
 	}
 
@@ -12,7 +12,7 @@ namespace GameDev2D
 	public:
 		Ship(Game* game, const Vector2& position);
 		void OnUpdate(float delta);
-		void OnRender(BatchRenderer& batchRenderer);
+		void OnRender(BatchRenderer& batchRenderer, float alpha);
 
 		void OnKeyEvent(KeyCode keyCode, KeyState keyState);
 		void respawn();
@@ -28,8 +28,10 @@ namespace GameDev2D
 		Game* m_Game;
 		std::vector<Vector2> m_Points;
 		Vector2 m_Position;
+		Vector2 m_PreviousPosition;
 		Vector2 m_Velocity;
 		float m_Radians;
+		float m_PreviousRadians;
 		float m_Radius;
 
 	};
@@ -23,6 +23,7 @@ int main(int argc, char** argv)
     application.GetInputManager().GetKeyboard().KeyEventSlot.connect<&Game::OnKeyEvent>(game);
     application.GetInputManager().GetMouse().MouseButtonEventSlot.connect<&Game::OnMouseButtonEvent>(game);
     application.GetInputManager().GetMouse().MouseMovedEventSlot.connect<&Game::OnMouseMovedEvent>(game);
+    application.GetDebugUI().StringSlot.connect<&Game::GetCollisionStats>(game);
 
     //Trigger the application's game loop, it will not return until the application is ready to close
     application.Run();
@@ -122,11 +122,23 @@ bool FontMaker::Build(const std::string& aCharacterSet)
 		}
 	}
 
+	//A distance field font can be drawn at any size, so only one atlas is needed per font
+	std::cout << std::endl << "Would you like to build a signed distance field font, which can be drawn at any size (1 = yes, 0 = no)?\n";
+	int distanceField = -1;
+	while (distanceField != 0 && distanceField != 1)
+	{
+		distanceField = GetInteger();
+		if (distanceField != 0 && distanceField != 1)
+		{
+			std::cout << "Invalid input...\n\n";
+		}
+	}
+
     //Output a message indicating that building has begun
     std::cout << std::endl << "Building Font..." << std::endl;
 
 	//
-	Rasterize(m_Fonts[index], size, aCharacterSet);
+	Rasterize(m_Fonts[index], size, aCharacterSet, distanceField == 1);
 
 
 	system("pause");
@@ -147,7 +159,7 @@ int FontMaker::GetInteger()
 	return value;
 }
 
-bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const std::string& aCharacterSet)
+bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const std::string& aCharacterSet, bool aDistanceField)
 {
 	//The FreeType library used to load .ttf and .otf fonts
 	FT_Library freeType;
@@ -187,6 +199,9 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 	unsigned int lineHeight = 0;
 	std::map<char, unsigned char*> glyphBuffer;
 
+	//Distance field glyphs are padded on every side
+	const unsigned int padding = aDistanceField ? DISTANCE_FIELD_RANGE : 0;
+
 	//Cycle through all the characters in the character set
 	for (unsigned int i = 0; i < aCharacterSet.size(); i++)
 	{
@@ -207,7 +222,9 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 		GlyphData glyphData = fontData.glyphData[character];
 
 		//Calculate the buffer size needed for the glyph
-		size_t size = face->glyph->bitmap.rows * face->glyph->bitmap.width;
+		unsigned int bitmapWidth = face->glyph->bitmap.width;
+		unsigned int bitmapHeight = face->glyph->bitmap.rows;
+		size_t size = (bitmapWidth + padding * 2) * (bitmapHeight + padding * 2);
 
 		//Get the buffer
 		unsigned char* buffer = glyphBuffer[character];
@@ -216,18 +233,25 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 			buffer = new unsigned char[size];
 		}
 
-		//Copy the buffer over
-		memcpy(buffer, face->glyph->bitmap.buffer, size);
+		//Copy the buffer over, or convert it to a distance field
+		if (aDistanceField)
+		{
+			GenerateDistanceField(face->glyph->bitmap.buffer, bitmapWidth, bitmapHeight, buffer);
+		}
+		else
+		{
+			memcpy(buffer, face->glyph->bitmap.buffer, size);
+		}
 
 		//Set the buffer
 		glyphBuffer[character] = buffer;
 
-		//Set the glyph data properties
-		glyphData.width = face->glyph->bitmap.width;
-		glyphData.height = face->glyph->bitmap.rows;
+		//Set the glyph data properties, the padding moves the glyph's top-left corner up and to the left
+		glyphData.width = bitmapWidth + padding * 2;
+		glyphData.height = bitmapHeight + padding * 2;
 		glyphData.advanceX = (unsigned char)(face->glyph->advance.x / 64);
-		glyphData.bearingX = face->glyph->bitmap_left;
-		glyphData.bearingY = face->glyph->bitmap_top;
+		glyphData.bearingX = face->glyph->bitmap_left - padding;
+		glyphData.bearingY = face->glyph->bitmap_top + padding;
 
 		//Calculate max bearing
 		if (glyphData.bearingY > maxBearing)
@@ -241,10 +265,10 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 			cellWidth = glyphData.width;
 		}
 
-		//Calculate the line height
-		if (glyphData.height > lineHeight)
+		//Calculate the line height, the padding isn't part of the line
+		if (bitmapHeight > lineHeight)
 		{
-			lineHeight = glyphData.height;
+			lineHeight = bitmapHeight;
 		}
 
 		//Calculate gylph hang
@@ -262,7 +286,7 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 	cellHeight = maxBearing - minHang;
 
 	//Set the baseline and line height
-	fontData.baseLine = maxBearing;
+	fontData.baseLine = maxBearing - padding;
 	fontData.lineHeight = lineHeight;
 
 	//Local variables used below
@@ -293,12 +317,17 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 	//Allocate the JSON frames object
 	Json::Value outputJson;
 
+	//A distance field font is saved once per font instead of once per size
+	std::string outputName = aDistanceField ? file + "_SDF" : file + "_" + std::to_string(aSize);
+
 	//Set the file's name
-	outputJson["file"] = file + "_" + std::to_string(aSize);
+	outputJson["file"] = outputName;
 	outputJson["characterSet"] = aCharacterSet;
 	outputJson["size"] = aSize;
 	outputJson["baseline"] = fontData.baseLine;
 	outputJson["lineHeight"] = fontData.lineHeight;
+	outputJson["distanceField"] = aDistanceField;
+	outputJson["distanceRange"] = padding;
 
 	Json::Value glyphs;
 
@@ -360,9 +389,9 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 				unsigned char* buffer = glyphBuffer[character];
 				unsigned char value = buffer[j];
 				unsigned char color[4];
-				color[0] = value > 0 ? 255 : 0;
-				color[1] = value > 0 ? 255 : 0;
-				color[2] = value > 0 ? 255 : 0;
+				color[0] = value > 0 || aDistanceField ? 255 : 0;
+				color[1] = value > 0 || aDistanceField ? 255 : 0;
+				color[2] = value > 0 || aDistanceField ? 255 : 0;
 				color[3] = value;
 
 				int x = j % (int)glyphData.frame.w;
@@ -397,7 +426,7 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 	std::string output = styledWriter.write(outputJson);
 
 	//Open the output file stream for saving the JSON data
-	std::string outputJsonPath = m_OutputDirectory + file + "_" + std::to_string(aSize) + ".json";
+	std::string outputJsonPath = m_OutputDirectory + outputName + ".json";
 	std::ofstream outputStream;
 	outputStream.open(outputJsonPath, std::ofstream::out | std::ofstream::trunc);
 
@@ -409,7 +438,7 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 	}
 
 	//Save the output image data to a .png image
-	std::string outputImagePath = m_OutputDirectory + file + + "_" + std::to_string(aSize) + ".png";
+	std::string outputImagePath = m_OutputDirectory + outputName + ".png";
 	outputImage.save_png(outputImagePath.c_str());
 
 	//Free the face object
@@ -421,6 +450,54 @@ bool FontMaker::Rasterize(const std::string& aFile, unsigned int aSize, const st
 	return true;
 }
 
+void FontMaker::GenerateDistanceField(const unsigned char* aBitmap, unsigned int aWidth, unsigned int aHeight, unsigned char* aDistanceField)
+{
+	const int range = (int)DISTANCE_FIELD_RANGE;
+	const int width = (int)aWidth;
+	const int height = (int)aHeight;
+	const int outputWidth = width + range * 2;
+	const int outputHeight = height + range * 2;
+
+	//Returns true if the bitmap's pixel is inside the glyph, everything outside of the bitmap is outside the glyph
+	auto isInside = [&](int x, int y)
+	{
+		return x >= 0 && y >= 0 && x < width && y < height && aBitmap[y * width + x] >= 128;
+	};
+
+	//For every output pixel, search the pixels within range for the nearest one on the other side of the edge
+	for (int y = 0; y < outputHeight; y++)
+	{
+		for (int x = 0; x < outputWidth; x++)
+		{
+			int bitmapX = x - range;
+			int bitmapY = y - range;
+			bool inside = isInside(bitmapX, bitmapY);
+			float nearest = (float)range;
+
+			for (int offsetY = -range; offsetY <= range; offsetY++)
+			{
+				for (int offsetX = -range; offsetX <= range; offsetX++)
+				{
+					if (isInside(bitmapX + offsetX, bitmapY + offsetY) != inside)
+					{
+						float distance = sqrtf((float)(offsetX * offsetX + offsetY * offsetY));
+						if (distance < nearest)
+						{
+							nearest = distance;
+						}
+					}
+				}
+			}
+
+			//Map -range..range to 0..255, the edge is half way between the pixels on either side of it
+			float signedDistance = inside ? nearest - 0.5f : -(nearest - 0.5f);
+			float value = 0.5f + signedDistance / (2.0f * range);
+			value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+			aDistanceField[y * outputWidth + x] = (unsigned char)(value * 255.0f + 0.5f);
+		}
+	}
+}
+
 unsigned int FontMaker::GetNumberOfFontFilesFound()
 {
     return m_Fonts.size();
@@ -12,6 +12,10 @@
 const unsigned int MAX_IMAGE_SIZE = 4096;
 const unsigned int MAX_FONT_SIZE = 300;
 
+//The distance (in pixels) covered by a signed distance field glyph on each side of its edge, the glyphs
+//are padded by this much so the field doesn't get cut off
+const unsigned int DISTANCE_FIELD_RANGE = 8;
+
 struct Rect
 {
 	Rect(float x, float y, float w, float h)
@@ -99,7 +103,11 @@ private:
 	int GetInteger();
 
 	//
-	bool Rasterize(const std::string& file, unsigned int size, const std::string& characterSet);
+	bool Rasterize(const std::string& file, unsigned int size, const std::string& characterSet, bool distanceField);
+
+	//Converts a glyph's coverage bitmap into a signed distance field, the output is padded by DISTANCE_FIELD_RANGE
+	//on every side. 128 is on the glyph's edge, higher values are inside the glyph and lower values are outside
+	void GenerateDistanceField(const unsigned char* bitmap, unsigned int width, unsigned int height, unsigned char* distanceField);
 
     //Member variables
 	std::vector<std::string> m_Fonts;